@@ -0,0 +1,197 @@
+//
+//  Profiler.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 16/10/2026.
+//  Copyright 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef Profiler_h
+#define Profiler_h
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+#if defined(PROFILE_COMPONENTS) && __has_include(<cxxabi.h>)
+#include <cstdlib>
+#include <cxxabi.h>
+#define PROFILE_DEMANGLE
+#endif
+
+/*!
+	Provides optional instrumentation of the main components of each machine: time spent in
+	just-in-time actors, timed event loops, audio generation and the CRT, and in the machine's
+	run_for as a whole — which, net of the others, is predominantly its processor.
+
+	Instrumentation is compiled in only if PROFILE_COMPONENTS is defined; otherwise
+	PROFILE_SCOPE and PROFILE_TYPE_SCOPE produce no code and Activity::Profiler::report()
+	returns an empty list.
+
+	Time is recorded exclusively: time spent in one instrumented scope while inside another
+	is attributed only to the innermost.
+*/
+
+#ifdef PROFILE_COMPONENTS
+
+/// Attributes the remainder of the current block, and @c cycles units of work, to the component @c name.
+#define PROFILE_SCOPE(name, cycles)	\
+	static Activity::Profiler::Counter &profile_counter_ = Activity::Profiler::counter(name);	\
+	const Activity::Profiler::Scope profile_scope_(profile_counter_, cycles)
+
+/// Attributes the remainder of the current block, and @c cycles units of work, to the component @c name, specialised by @c type.
+#define PROFILE_TYPE_SCOPE(name, type, cycles)	\
+	static Activity::Profiler::Counter &profile_counter_ = Activity::Profiler::counter(name, &typeid(type));	\
+	const Activity::Profiler::Scope profile_scope_(profile_counter_, cycles)
+
+#else
+
+#define PROFILE_SCOPE(name, cycles)				while(false) {}
+#define PROFILE_TYPE_SCOPE(name, type, cycles)	while(false) {}
+
+#endif
+
+namespace Activity {
+namespace Profiler {
+
+/// Describes the totals accumulated by a single component.
+struct Entry {
+	std::string name;
+
+	/// Host time spent within this component, excluding any time spent in other instrumented components.
+	int64_t nanos = 0;
+
+	/// Units of work performed, in the component's own units: e.g. its own clock cycles or, for audio, samples.
+	uint64_t cycles = 0;
+
+	/// Number of times this component was entered.
+	uint64_t calls = 0;
+};
+
+/// Accumulates totals for one component; these are held globally and live for the duration of the process.
+struct Counter {
+	Counter(const char *name, const std::type_info *type) : name(name), type(type) {}
+
+	const char *const name;
+	const std::type_info *const type;
+
+	std::atomic<int64_t> nanos = 0;
+	std::atomic<uint64_t> cycles = 0;
+	std::atomic<uint64_t> calls = 0;
+};
+
+namespace Implementation {
+
+inline std::mutex &counters_mutex() {
+	static std::mutex mutex;
+	return mutex;
+}
+
+inline std::vector<std::unique_ptr<Counter>> &counters() {
+	static std::vector<std::unique_ptr<Counter>> counters;
+	return counters;
+}
+
+}
+
+/// @returns The counter for component @c name, optionally specialised by @c type, creating it if necessary.
+inline Counter &counter(const char *name, const std::type_info *type = nullptr) {
+	std::lock_guard lock(Implementation::counters_mutex());
+	auto &counters = Implementation::counters();
+	for(const auto &counter: counters) {
+		if(counter->type == type && std::string(counter->name) == name) {
+			return *counter;
+		}
+	}
+	counters.push_back(std::make_unique<Counter>(name, type));
+	return *counters.back();
+}
+
+/// Records time from construction to destruction against a Counter, net of any nested Scopes on the same thread.
+class Scope {
+	public:
+		Scope(Counter &counter, uint64_t cycles) : counter_(counter), parent_(current()) {
+			counter_.cycles.fetch_add(cycles, std::memory_order_relaxed);
+			counter_.calls.fetch_add(1, std::memory_order_relaxed);
+			current() = this;
+			start_ = now();
+		}
+
+		~Scope() {
+			const auto elapsed = now() - start_;
+			counter_.nanos.fetch_add(elapsed - nested_, std::memory_order_relaxed);
+			if(parent_) parent_->nested_ += elapsed;
+			current() = parent_;
+		}
+
+	private:
+		Counter &counter_;
+		Scope *const parent_;
+		int64_t start_ = 0;
+		int64_t nested_ = 0;
+
+		// Time::nanos_now() isn't used here because this header is widely included, and
+		// the Time namespace would collide with Storage::Time.
+		static int64_t now() {
+			return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+		}
+
+		static Scope *&current() {
+			static thread_local Scope *current = nullptr;
+			return current;
+		}
+};
+
+/// @returns The totals for all components that have been entered at least once since the last reset, most expensive first.
+inline std::vector<Entry> report() {
+	std::vector<Entry> entries;
+	std::lock_guard lock(Implementation::counters_mutex());
+	for(const auto &counter: Implementation::counters()) {
+		Entry entry;
+		entry.calls = counter->calls.load(std::memory_order_relaxed);
+		if(!entry.calls) continue;
+
+		entry.nanos = counter->nanos.load(std::memory_order_relaxed);
+		entry.cycles = counter->cycles.load(std::memory_order_relaxed);
+		entry.name = counter->name;
+		if(counter->type) {
+			entry.name += ": ";
+
+#ifdef PROFILE_DEMANGLE
+			int status;
+			char *const demangled = abi::__cxa_demangle(counter->type->name(), nullptr, nullptr, &status);
+			entry.name += demangled ? demangled : counter->type->name();
+			std::free(demangled);
+#else
+			entry.name += counter->type->name();
+#endif
+		}
+		entries.push_back(std::move(entry));
+	}
+
+	std::sort(entries.begin(), entries.end(), [] (const Entry &lhs, const Entry &rhs) {
+		return lhs.nanos > rhs.nanos;
+	});
+	return entries;
+}
+
+/// Zeroes all totals.
+inline void reset() {
+	std::lock_guard lock(Implementation::counters_mutex());
+	for(const auto &counter: Implementation::counters()) {
+		counter->nanos = 0;
+		counter->cycles = 0;
+		counter->calls = 0;
+	}
+}
+
+}
+}
+
+#endif /* Profiler_h */
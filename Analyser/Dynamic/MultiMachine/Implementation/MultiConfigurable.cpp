@@ -16,7 +16,7 @@ namespace {
 
 class MultiStruct: public Reflection::Struct {
 	public:
-		MultiStruct(const std::vector<Configurable::Device *> &devices) : devices_(devices) {
+		MultiStruct(const std::vector<Configurable::Device *> &devices) : devices_(devices), captured_devices_(devices) {
 			for(auto device: devices) {
 				options_.emplace_back(device->get_options());
 			}
@@ -24,8 +24,11 @@ class MultiStruct: public Reflection::Struct {
 
 		void apply() {
 			auto options = options_.begin();
-			for(auto device: devices_) {
-				device->set_options(*options);
+			for(auto device: captured_devices_) {
+				// Skip any device whose machine has been retired since these options were obtained.
+				if(std::find(devices_.begin(), devices_.end(), device) != devices_.end()) {
+					device->set_options(*options);
+				}
 				++options;
 			}
 		}
@@ -98,6 +101,7 @@ class MultiStruct: public Reflection::Struct {
 
 	private:
 		const std::vector<Configurable::Device *> &devices_;
+		const std::vector<Configurable::Device *> captured_devices_;
 		std::vector<std::unique_ptr<Reflection::Struct>> options_;
 };
 
@@ -118,3 +122,7 @@ void MultiConfigurable::set_options(const std::unique_ptr<Reflection::Struct> &s
 std::unique_ptr<Reflection::Struct> MultiConfigurable::get_options() {
 	return std::make_unique<MultiStruct>(devices_);
 }
+
+void MultiConfigurable::will_retire_machine(::Machine::DynamicMachine *machine) {
+	devices_.erase(std::remove(devices_.begin(), devices_.end(), machine->configurable_device()), devices_.end());
+}
@@ -32,6 +32,9 @@ class MultiConfigurable: public Configurable::Device {
 		void set_options(const std::unique_ptr<Reflection::Struct> &options) final;
 		std::unique_ptr<Reflection::Struct> get_options() final;
 
+		/// Removes all references to @c machine, which is about to be destroyed.
+		void will_retire_machine(::Machine::DynamicMachine *machine);
+
 	private:
 		std::vector<Configurable::Device *> devices_;
 };
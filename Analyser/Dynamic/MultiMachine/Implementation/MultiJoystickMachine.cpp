@@ -58,6 +58,12 @@ class MultiJoystick: public Inputs::Joystick {
 			}
 		}
 
+		void remove(MachineTypes::JoystickMachine *machine) {
+			for(const auto &joystick: machine->get_joysticks()) {
+				joysticks_.erase(std::remove(joysticks_.begin(), joysticks_.end(), joystick.get()), joysticks_.end());
+			}
+		}
+
 	private:
 		std::vector<Input> inputs;
 		std::vector<Inputs::Joystick *> joysticks_;
@@ -84,3 +90,12 @@ MultiJoystickMachine::MultiJoystickMachine(const std::vector<std::unique_ptr<::M
 const std::vector<std::unique_ptr<Inputs::Joystick>> &MultiJoystickMachine::get_joysticks() {
 	return joysticks_;
 }
+
+void MultiJoystickMachine::will_retire_machine(::Machine::DynamicMachine *machine) {
+	const auto joystick_machine = machine->joystick_machine();
+	if(!joystick_machine) return;
+
+	for(const auto &joystick: joysticks_) {
+		static_cast<MultiJoystick *>(joystick.get())->remove(joystick_machine);
+	}
+}
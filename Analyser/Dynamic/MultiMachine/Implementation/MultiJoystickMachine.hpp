@@ -30,6 +30,9 @@ class MultiJoystickMachine: public MachineTypes::JoystickMachine {
 		// Below is the standard JoystickMachine::Machine interface; see there for documentation.
 		const std::vector<std::unique_ptr<Inputs::Joystick>> &get_joysticks() final;
 
+		/// Removes all references to @c machine, which is about to be destroyed.
+		void will_retire_machine(::Machine::DynamicMachine *machine);
+
 	private:
 		std::vector<std::unique_ptr<Inputs::Joystick>> joysticks_;
 };
@@ -8,6 +8,8 @@
 
 #include "MultiKeyboardMachine.hpp"
 
+#include <algorithm>
+
 using namespace Analyser::Dynamic;
 
 MultiKeyboardMachine::MultiKeyboardMachine(const std::vector<std::unique_ptr<::Machine::DynamicMachine>> &machines) {
@@ -48,6 +50,11 @@ Inputs::Keyboard &MultiKeyboardMachine::get_keyboard() {
 	return *keyboard_;
 }
 
+void MultiKeyboardMachine::will_retire_machine(::Machine::DynamicMachine *machine) {
+	// The MultiKeyboard refers to machines_ directly, so will also cease to use this machine.
+	machines_.erase(std::remove(machines_.begin(), machines_.end(), machine->keyboard_machine()), machines_.end());
+}
+
 MultiKeyboardMachine::MultiKeyboard::MultiKeyboard(const std::vector<::MachineTypes::KeyboardMachine *> &machines)
 	: machines_(machines) {
 	for(const auto &machine: machines_) {
@@ -53,6 +53,9 @@ class MultiKeyboardMachine: public MachineTypes::KeyboardMachine {
 		void type_string(const std::string &) final;
 		bool can_type(char c) const final;
 		Inputs::Keyboard &get_keyboard() final;
+
+		/// Removes all references to @c machine, which is about to be destroyed.
+		void will_retire_machine(::Machine::DynamicMachine *machine);
 };
 
 }
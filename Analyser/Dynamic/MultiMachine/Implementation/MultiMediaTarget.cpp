@@ -8,6 +8,8 @@
 
 #include "MultiMediaTarget.hpp"
 
+#include <algorithm>
+
 using namespace Analyser::Dynamic;
 
 MultiMediaTarget::MultiMediaTarget(const std::vector<std::unique_ptr<::Machine::DynamicMachine>> &machines) {
@@ -17,6 +19,10 @@ MultiMediaTarget::MultiMediaTarget(const std::vector<std::unique_ptr<::Machine::
 	}
 }
 
+void MultiMediaTarget::will_retire_machine(::Machine::DynamicMachine *machine) {
+	targets_.erase(std::remove(targets_.begin(), targets_.end(), machine->media_target()), targets_.end());
+}
+
 bool MultiMediaTarget::insert_media(const Analyser::Static::Media &media) {
 	bool inserted = false;
 	for(const auto &target : targets_) {
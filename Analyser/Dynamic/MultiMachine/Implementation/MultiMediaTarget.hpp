@@ -31,6 +31,9 @@ struct MultiMediaTarget: public MachineTypes::MediaTarget {
 		// Below is the standard MediaTarget::Machine interface; see there for documentation.
 		bool insert_media(const Analyser::Static::Media &media) final;
 
+		/// Removes all references to @c machine, which is about to be destroyed.
+		void will_retire_machine(::Machine::DynamicMachine *machine);
+
 	private:
 		std::vector<MachineTypes::MediaTarget *> targets_;
 };
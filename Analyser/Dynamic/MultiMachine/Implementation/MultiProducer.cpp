@@ -8,8 +8,9 @@
 
 #include "MultiProducer.hpp"
 
-#include <condition_variable>
+#include <algorithm>
 #include <mutex>
+#include <thread>
 
 using namespace Analyser::Dynamic;
 
@@ -17,30 +18,26 @@ using namespace Analyser::Dynamic;
 
 template <typename MachineType>
 void MultiInterface<MachineType>::perform_parallel(const std::function<void(MachineType *)> &function) {
-	// Apply a blunt force parallelisation of the machines; each run_for is dispatched
-	// to a separate queue and this queue will block until all are done.
-	volatile std::size_t outstanding_machines;
-	std::condition_variable condition;
-	std::mutex mutex;
+	// Take a copy of the current machine list, so that the lock isn't held while machines run.
+	std::vector<MachineType *> machines;
 	{
 		std::lock_guard machines_lock(machines_mutex_);
-		std::lock_guard lock(mutex);
-		outstanding_machines = machines_.size();
-
-		for(std::size_t index = 0; index < machines_.size(); ++index) {
-			const auto machine = ::Machine::get<MachineType>(*machines_[index].get());
-			queues_[index].enqueue([&mutex, &condition, machine, function, &outstanding_machines]() {
-				if(machine) function(machine);
-
-				std::lock_guard lock(mutex);
-				outstanding_machines--;
-				condition.notify_all();
-			});
+		machines.reserve(machines_.size());
+		for(const auto &machine: machines_) {
+			machines.push_back(::Machine::get<MachineType>(*machine.get()));
 		}
 	}
 
-	std::unique_lock lock(mutex);
-	condition.wait(lock, [&outstanding_machines] { return !outstanding_machines; });
+	if(!pool_) {
+		const size_t cores = std::max(std::thread::hardware_concurrency(), 1u);
+		pool_ = std::make_unique<Concurrency::WorkerPool>(std::min(machines.size(), cores) - 1);
+	}
+
+	// Machines don't interact with one another, so each can be run in isolation; the calling
+	// thread will run the frontmost machine and the pool will balance the others.
+	pool_->parallel_for(machines.size(), [&machines, &function] (size_t index) {
+		if(machines[index]) function(machines[index]);
+	});
 }
 
 template <typename MachineType>
@@ -88,6 +85,18 @@ Outputs::Speaker::Speaker *MultiAudioProducer::get_speaker() {
 	return speaker_;
 }
 
+void MultiAudioProducer::wait_for_audio() {
+	perform_serial([](MachineTypes::AudioProducer *machine) {
+		machine->wait_for_audio();
+	});
+}
+
+void MultiAudioProducer::will_retire_machine(::Machine::DynamicMachine *machine) {
+	if(speaker_) {
+		speaker_->will_retire_machine(machine);
+	}
+}
+
 void MultiAudioProducer::did_change_machine_order() {
 	if(speaker_) {
 		speaker_->set_new_front_machine(machines_.front().get());
@@ -97,9 +106,14 @@ void MultiAudioProducer::did_change_machine_order() {
 // MARK: - MultiTimedMachine
 
 void MultiTimedMachine::run_for(Time::Seconds duration) {
-	perform_parallel([duration](::MachineTypes::TimedMachine *machine) {
-		if(machine->get_confidence() >= 0.01f) machine->run_for(duration);
-	});
+	while(duration > 0.0) {
+		const Time::Seconds slice = slice_duration_ > 0.0 ? std::min(duration, slice_duration_) : duration;
+		duration -= slice;
+
+		perform_parallel([slice](::MachineTypes::TimedMachine *machine) {
+			if(machine->get_confidence() >= 0.01f) machine->run_for(slice);
+		});
 
-	if(delegate_) delegate_->did_run_machines(this);
+		if(delegate_) delegate_->did_run_machines(this);
+	}
 }
@@ -9,7 +9,7 @@
 #ifndef MultiProducer_hpp
 #define MultiProducer_hpp
 
-#include "../../../../Concurrency/AsyncTaskQueue.hpp"
+#include "../../../../Concurrency/WorkerPool.hpp"
 #include "../../../../Machines/MachineTypes.hpp"
 #include "../../../../Machines/DynamicMachine.hpp"
 
@@ -25,14 +25,16 @@ namespace Dynamic {
 template <typename MachineType> class MultiInterface {
 	public:
 		MultiInterface(const std::vector<std::unique_ptr<::Machine::DynamicMachine>> &machines, std::recursive_mutex &machines_mutex) :
-			machines_(machines), machines_mutex_(machines_mutex), queues_(machines.size()) {}
+			machines_(machines), machines_mutex_(machines_mutex) {}
 
 	protected:
 		/*!
 			Performs a parallel for operation across all machines, performing the supplied
 			function on each and returning only once all applications have completed.
 
-			No guarantees are extended as to which thread operations will occur on.
+			No guarantees are extended as to which thread operations will occur on, other than that
+			the calling thread will participate and will always perform the function for the
+			frontmost machine.
 		*/
 		void perform_parallel(const std::function<void(MachineType *)> &);
 
@@ -47,7 +49,9 @@ template <typename MachineType> class MultiInterface {
 		std::recursive_mutex &machines_mutex_;
 
 	private:
-		std::vector<Concurrency::AsyncTaskQueue<true>> queues_;
+		/// Created upon first use of @c perform_parallel, with enough threads to run all machines
+		/// simultaneously, up to the number of available cores.
+		std::unique_ptr<Concurrency::WorkerPool> pool_;
 };
 
 class MultiTimedMachine: public MultiInterface<MachineTypes::TimedMachine>, public MachineTypes::TimedMachine {
@@ -66,11 +70,24 @@ class MultiTimedMachine: public MultiInterface<MachineTypes::TimedMachine>, publ
 			delegate_ = delegate;
 		}
 
+		/*!
+			Sets the longest period for which machines will be run between synchronisations; a call to
+			@c run_for for a longer period will be divided into slices of at most this length, with the delegate
+			being informed after each. Shorter slices allow earlier decisions about which machines to
+			retain, at the cost of more frequent synchronisation.
+
+			A slice duration of zero indicates that calls to @c run_for should never be subdivided.
+		*/
+		void set_slice_duration(Time::Seconds duration) {
+			slice_duration_ = duration;
+		}
+
 		void run_for(Time::Seconds duration) final;
 
 	private:
 		void run_for(const Cycles) final {}
 		Delegate *delegate_ = nullptr;
+		Time::Seconds slice_duration_ = 0.0;
 };
 
 class MultiScanProducer: public MultiInterface<MachineTypes::ScanProducer>, public MachineTypes::ScanProducer {
@@ -101,7 +118,11 @@ class MultiAudioProducer: public MultiInterface<MachineTypes::AudioProducer>, pu
 		*/
 		void did_change_machine_order();
 
+		/// Removes all references to @c machine, which is about to be destroyed.
+		void will_retire_machine(::Machine::DynamicMachine *machine);
+
 		Outputs::Speaker::Speaker *get_speaker() final;
+		void wait_for_audio() final;
 
 	private:
 		MultiSpeaker *speaker_ = nullptr;
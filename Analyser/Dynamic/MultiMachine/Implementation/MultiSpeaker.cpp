@@ -8,6 +8,8 @@
 
 #include "MultiSpeaker.hpp"
 
+#include <algorithm>
+
 using namespace Analyser::Dynamic;
 
 MultiSpeaker *MultiSpeaker::create(const std::vector<std::unique_ptr<::Machine::DynamicMachine>> &machines) {
@@ -80,6 +82,15 @@ void MultiSpeaker::speaker_did_change_input_clock(Speaker *speaker) {
 	delegate->speaker_did_change_input_clock(this);
 }
 
+void MultiSpeaker::will_retire_machine(::Machine::DynamicMachine *machine) {
+	const auto audio_producer = machine->audio_producer();
+	const auto speaker = audio_producer ? audio_producer->get_speaker() : nullptr;
+	if(!speaker) return;
+
+	speaker->set_delegate(nullptr);
+	speakers_.erase(std::remove(speakers_.begin(), speakers_.end(), speaker), speakers_.end());
+}
+
 void MultiSpeaker::set_new_front_machine(::Machine::DynamicMachine *machine) {
 	{
 		std::lock_guard lock_guard(front_speaker_mutex_);
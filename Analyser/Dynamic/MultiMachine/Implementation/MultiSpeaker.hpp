@@ -37,6 +37,9 @@ class MultiSpeaker: public Outputs::Speaker::Speaker, Outputs::Speaker::Speaker:
 		/// This class requires the caller to nominate changes in the frontmost machine.
 		void set_new_front_machine(::Machine::DynamicMachine *machine);
 
+		/// Ceases to use the speaker of @c machine, which is about to be destroyed. It must not be the frontmost machine.
+		void will_retire_machine(::Machine::DynamicMachine *machine);
+
 		// Below is the standard Outputs::Speaker::Speaker interface; see there for documentation.
 		float get_ideal_clock_rate_in_range(float minimum, float maximum) override;
 		void set_computed_output_rate(float cycles_per_second, int buffer_size, bool stereo) override;
@@ -13,6 +13,16 @@
 
 using namespace Analyser::Dynamic;
 
+namespace {
+
+/// Machines with a confidence less than this are retired regardless of the others.
+constexpr float MinimumConfidence = 0.01f;
+
+/// Machines with less than this proportion of the frontmost machine's confidence are retired.
+constexpr float MinimumRelativeConfidence = 0.25f;
+
+}
+
 MultiMachine::MultiMachine(std::vector<std::unique_ptr<DynamicMachine>> &&machines) :
 	machines_(std::move(machines)),
 	configurable_(machines_),
@@ -51,6 +61,14 @@ MachineTypes::MouseMachine *MultiMachine::mouse_machine() {
 	return nullptr;
 }
 
+MachineTypes::StateProducer *MultiMachine::state_producer() {
+	// Until a single machine has been picked there's no one state to produce.
+	if(has_picked_) {
+		return machines_.front()->state_producer();
+	}
+	return nullptr;
+}
+
 #undef Provider
 
 bool MultiMachine::would_collapse(const std::vector<std::unique_ptr<DynamicMachine>> &machines) {
@@ -59,6 +77,10 @@ bool MultiMachine::would_collapse(const std::vector<std::unique_ptr<DynamicMachi
 		(machines.front()->timed_machine()->get_confidence() >= 2.0f * machines[1]->timed_machine()->get_confidence());
 }
 
+void MultiMachine::set_slice_duration(Time::Seconds duration) {
+	timed_machine_.set_slice_duration(duration);
+}
+
 void MultiMachine::did_run_machines(MultiTimedMachine *) {
 	std::lock_guard machines_lock(machines_mutex_);
 #ifndef NDEBUG
@@ -82,11 +104,39 @@ void MultiMachine::did_run_machines(MultiTimedMachine *) {
 		audio_producer_.did_change_machine_order();
 	}
 
-	if(would_collapse(machines_)) {
+	if(has_picked_) {
+		return;
+	}
+
+	// Retire any machine that has fallen far behind the frontmost; it is very unlikely to recover,
+	// and otherwise continues to cost as much to run as the machine that will be kept.
+	const float retirement_threshold = std::max(
+		MinimumConfidence,
+		machines_.front()->timed_machine()->get_confidence() * MinimumRelativeConfidence);
+	for(std::size_t index = machines_.size() - 1; index > 0; --index) {
+		if(machines_[index]->timed_machine()->get_confidence() < retirement_threshold) {
+			retire(index);
+		}
+	}
+
+	if(machines_.size() == 1 || would_collapse(machines_)) {
 		pick_first();
 	}
 }
 
+void MultiMachine::retire(std::size_t index) {
+	std::lock_guard machines_lock(machines_mutex_);
+	const auto machine = machines_[index].get();
+
+	configurable_.will_retire_machine(machine);
+	audio_producer_.will_retire_machine(machine);
+	joystick_machine_.will_retire_machine(machine);
+	keyboard_machine_.will_retire_machine(machine);
+	media_target_.will_retire_machine(machine);
+
+	machines_.erase(machines_.begin() + std::ptrdiff_t(index));
+}
+
 void MultiMachine::pick_first() {
 	has_picked_ = true;
 
@@ -102,15 +152,10 @@ void MultiMachine::pick_first() {
 		}
 	}
 
-	// TODO: because it is not invalid for a caller to keep a reference to anything previously returned,
-	// this erase can be added only once the Multi machines that take static copies of the machines list
-	// are updated.
-	//
-	// Example failing use case otherwise: a caller still has reference to the MultiJoystickMachine, and
-	// it has dangling references to the various JoystickMachines.
-	//
-	// This gets into particularly long grass with the MultiConfigurable and its MultiStruct.
-//	machines_.erase(machines_.begin() + 1, machines_.end());
+	// All other machines can now be discarded.
+	while(machines_.size() > 1) {
+		retire(machines_.size() - 1);
+	}
 }
 
 void *MultiMachine::raw_pointer() {
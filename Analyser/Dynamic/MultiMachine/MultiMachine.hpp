@@ -37,7 +37,7 @@ namespace Dynamic {
 	confidence.
 
 	If confidence for any machine becomes disproportionately low compared to
-	the others in the set, that machine stops running.
+	the others in the set, that machine is retired: it stops running and is destroyed.
 */
 class MultiMachine: public ::Machine::DynamicMachine, public MultiTimedMachine::Delegate {
 	public:
@@ -60,10 +60,18 @@ class MultiMachine: public ::Machine::DynamicMachine, public MultiTimedMachine::
 		MachineTypes::KeyboardMachine *keyboard_machine() final;
 		MachineTypes::MouseMachine *mouse_machine() final;
 		MachineTypes::MediaTarget *media_target() final;
+		MachineTypes::StateProducer *state_producer() final;
 		void *raw_pointer() final;
 
+		/*!
+			Sets the longest period for which machines will run between reassessments of their confidence;
+			see MultiTimedMachine::set_slice_duration.
+		*/
+		void set_slice_duration(Time::Seconds duration);
+
 	private:
 		void did_run_machines(MultiTimedMachine *) final;
+		void retire(std::size_t index);
 
 		std::vector<std::unique_ptr<DynamicMachine>> machines_;
 		std::recursive_mutex machines_mutex_;
@@ -13,6 +13,7 @@
 #include "../Concurrency/AsyncTaskQueue.hpp"
 #include "ClockingHintSource.hpp"
 #include "ForceInline.hpp"
+#include "../Activity/Profiler.hpp"
 
 /*!
 	A JustInTimeActor holds (i) an embedded object with a run_for method; and (ii) an amount
@@ -169,11 +170,14 @@ template <class T, class LocalTimeScale = HalfCycles, int multiplier = 1, int di
 				did_flush_ = is_flushed_ = true;
 				if constexpr (divider == 1) {
 					const auto duration = time_since_update_.template flush<TargetTimeScale>();
+					PROFILE_TYPE_SCOPE("JustInTime", T, uint64_t(duration.as_integral()));
 					object_.run_for(duration);
 				} else {
 					const auto duration = time_since_update_.template divide<TargetTimeScale>(LocalTimeScale(divider));
-					if(duration > TargetTimeScale(0))
+					if(duration > TargetTimeScale(0)) {
+						PROFILE_TYPE_SCOPE("JustInTime", T, uint64_t(duration.as_integral()));
 						object_.run_for(duration);
+					}
 				}
 			}
 		}
@@ -221,7 +221,10 @@ void WD1770::posit_event(int new_event_type) {
 			status.interrupt_request = true;
 		});
 
+		// Bits from the disk are of no interest until the next command.
+		set_is_listening(false);
 		WAIT_FOR_EVENT(Event1770::Command);
+		set_is_listening(true);
 
 		update_status([] (Status &status) {
 			status.busy = true;
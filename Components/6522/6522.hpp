@@ -14,6 +14,9 @@
 #include "Implementation/6522Storage.hpp"
 
 #include "../../ClockReceiver/ClockReceiver.hpp"
+#include "../../Reflection/Struct.hpp"
+
+#include <cstring>
 
 namespace MOS {
 namespace MOS6522 {
@@ -136,6 +139,143 @@ template <class BusHandlerT> class MOS6522: public MOS6522Storage {
 		void set_control_line_output(Port port, Line line, LineState value);
 		void evaluate_cb2_output();
 		void evaluate_port_b_output();
+
+		friend struct State;
+};
+
+struct State: public Reflection::StructImpl<State> {
+	uint8_t output[2]{};
+	uint8_t input[2]{};
+	uint8_t data_direction[2]{};
+	uint16_t timer[2]{};
+	uint16_t timer_latch[2]{};
+	uint16_t last_timer[2]{};
+	int next_timer[2] = {-1, -1};
+	uint8_t shift = 0;
+	uint8_t auxiliary_control = 0;
+	uint8_t peripheral_control = 0;
+	uint8_t interrupt_flags = 0;
+	uint8_t interrupt_enable = 0;
+	bool timer_needs_reload = false;
+	uint8_t timer_port_b_output = 0xff;
+
+	// Control lines are listed in the order CA1, CA2, CB1, CB2; outputs
+	// are 0 for on, 1 for off and 2 for input.
+	bool control_inputs[4]{};
+	uint8_t control_outputs[4] = {2, 2, 2, 2};
+	uint8_t handshake_modes[2]{};
+
+	bool timer_is_running[2]{};
+	bool last_posted_interrupt_status = false;
+	int shift_bits_remaining = 8;
+	bool is_phase2 = false;
+
+	State() {
+		if(needs_declare()) {
+			DeclareField(output);
+			DeclareField(input);
+			DeclareField(data_direction);
+			DeclareField(timer);
+			DeclareField(timer_latch);
+			DeclareField(last_timer);
+			DeclareField(next_timer);
+			DeclareField(shift);
+			DeclareField(auxiliary_control);
+			DeclareField(peripheral_control);
+			DeclareField(interrupt_flags);
+			DeclareField(interrupt_enable);
+			DeclareField(timer_needs_reload);
+			DeclareField(timer_port_b_output);
+
+			DeclareField(control_inputs);
+			DeclareField(control_outputs);
+			DeclareField(handshake_modes);
+
+			DeclareField(timer_is_running);
+			DeclareField(last_posted_interrupt_status);
+			DeclareField(shift_bits_remaining);
+			DeclareField(is_phase2);
+		}
+	}
+
+	template <typename VIA> State(const VIA &source) : State() {
+		const auto &registers = source.registers_;
+		memcpy(output, registers.output, sizeof(output));
+		memcpy(input, registers.input, sizeof(input));
+		memcpy(data_direction, registers.data_direction, sizeof(data_direction));
+		memcpy(timer, registers.timer, sizeof(timer));
+		memcpy(timer_latch, registers.timer_latch, sizeof(timer_latch));
+		memcpy(last_timer, registers.last_timer, sizeof(last_timer));
+		memcpy(next_timer, registers.next_timer, sizeof(next_timer));
+		shift = registers.shift;
+		auxiliary_control = registers.auxiliary_control;
+		peripheral_control = registers.peripheral_control;
+		interrupt_flags = registers.interrupt_flags;
+		interrupt_enable = registers.interrupt_enable;
+		timer_needs_reload = registers.timer_needs_reload;
+		timer_port_b_output = registers.timer_port_b_output;
+
+		for(int c = 0; c < 4; c++) {
+			control_inputs[c] = source.control_inputs_[c >> 1].lines[c & 1];
+			control_outputs[c] = uint8_t(source.control_outputs_[c >> 1].lines[c & 1]);
+		}
+		for(int c = 0; c < 2; c++) {
+			handshake_modes[c] = uint8_t(source.handshake_modes_[c]);
+			timer_is_running[c] = source.timer_is_running_[c];
+		}
+
+		last_posted_interrupt_status = source.last_posted_interrupt_status_;
+		shift_bits_remaining = source.shift_bits_remaining_;
+		is_phase2 = source.is_phase2_;
+	}
+
+	template <typename VIA> void apply(VIA &target) const {
+		using LineState = typename VIA::LineState;
+		using HandshakeMode = typename VIA::HandshakeMode;
+
+		// Bring the bus handler up to date, so that it is unaffected by the change in state.
+		target.bus_handler_.run_for(target.time_since_bus_handler_call_.template flush<HalfCycles>());
+
+		auto &registers = target.registers_;
+		memcpy(registers.output, output, sizeof(output));
+		memcpy(registers.input, input, sizeof(input));
+		memcpy(registers.data_direction, data_direction, sizeof(data_direction));
+		memcpy(registers.timer, timer, sizeof(timer));
+		memcpy(registers.timer_latch, timer_latch, sizeof(timer_latch));
+		memcpy(registers.last_timer, last_timer, sizeof(last_timer));
+		memcpy(registers.next_timer, next_timer, sizeof(next_timer));
+		registers.shift = shift;
+		registers.auxiliary_control = auxiliary_control;
+		registers.peripheral_control = peripheral_control;
+		registers.interrupt_flags = interrupt_flags;
+		registers.interrupt_enable = interrupt_enable;
+		registers.timer_needs_reload = timer_needs_reload;
+		registers.timer_port_b_output = timer_port_b_output;
+
+		for(int c = 0; c < 4; c++) {
+			target.control_inputs_[c >> 1].lines[c & 1] = control_inputs[c];
+			target.control_outputs_[c >> 1].lines[c & 1] = LineState(control_outputs[c]);
+		}
+		for(int c = 0; c < 2; c++) {
+			target.handshake_modes_[c] = HandshakeMode(handshake_modes[c]);
+			target.timer_is_running_[c] = timer_is_running[c];
+		}
+
+		target.last_posted_interrupt_status_ = last_posted_interrupt_status;
+		target.shift_bits_remaining_ = shift_bits_remaining;
+		target.is_phase2_ = is_phase2;
+
+		// Announce all outputs, so that the bus handler is consistent with the new state.
+		target.bus_handler_.set_port_output(Port::A, output[0], data_direction[0]);
+		target.evaluate_port_b_output();
+		for(int c = 0; c < 3; c++) {
+			if(target.control_outputs_[c >> 1].lines[c & 1] != LineState::Input) {
+				target.bus_handler_.set_control_line_output(Port(c >> 1), Line(c & 1), target.control_outputs_[c >> 1].lines[c & 1] != LineState::Off);
+			}
+		}
+		target.evaluate_cb2_output();
+		target.bus_handler_.set_interrupt_status(last_posted_interrupt_status);
+	}
 };
 
 }
@@ -14,6 +14,9 @@
 #include "../../Outputs/CRT/CRT.hpp"
 #include "../../Outputs/Speaker/Implementation/LowpassSpeaker.hpp"
 #include "../../Outputs/Speaker/Implementation/SampleSource.hpp"
+#include "../../Reflection/Struct.hpp"
+
+#include <cstring>
 
 namespace MOS {
 namespace MOS6560 {
@@ -53,6 +56,8 @@ enum class OutputMode {
 	PAL, NTSC
 };
 
+struct State;
+
 /*!
 	The 6560 Video Interface Chip ('VIC') is a video and audio output chip; it therefore vends both a @c CRT and a @c Speaker.
 
@@ -89,6 +94,7 @@ template <class BusHandler> class MOS6560 {
 		void set_display_type(Outputs::Display::DisplayType display_type)	{ crt_.set_display_type(display_type); 			}
 		Outputs::Display::DisplayType get_display_type() const				{ return crt_.get_display_type(); 				}
 		Outputs::Speaker::Speaker *get_speaker()	 						{ return &speaker_; 							}
+		void wait_for_audio()												{ audio_queue_.flush();							}
 
 		void set_high_frequency_cutoff(float cutoff) {
 			speaker_.set_high_frequency_cutoff(cutoff);
@@ -518,6 +524,99 @@ template <class BusHandler> class MOS6560 {
 			bool supports_interlacing = 0;
 		} timing_;
 		OutputMode output_mode_ = OutputMode::NTSC;
+
+		friend struct ::MOS::MOS6560::State;
+};
+
+struct State: public Reflection::StructImpl<State> {
+	uint8_t registers[16]{};
+
+	int horizontal_counter = 0, vertical_counter = 0;
+	bool vertical_drawing_latch = false, horizontal_drawing_latch = false;
+	int rows_this_field = 0, columns_this_line = 0;
+	int pixel_line_cycle = 0, column_counter = 0;
+	int current_row = 0;
+	uint16_t current_character_row = 0;
+	uint16_t video_matrix_address_counter = 0, base_video_matrix_address_counter = 0;
+	uint8_t character_code = 0, character_colour = 0, character_value = 0;
+	bool is_odd_frame = false, is_odd_line = false;
+
+	// TODO: all audio-production thread state.
+
+	State() {
+		if(needs_declare()) {
+			DeclareField(registers);
+
+			DeclareField(horizontal_counter);
+			DeclareField(vertical_counter);
+			DeclareField(vertical_drawing_latch);
+			DeclareField(horizontal_drawing_latch);
+			DeclareField(rows_this_field);
+			DeclareField(columns_this_line);
+			DeclareField(pixel_line_cycle);
+			DeclareField(column_counter);
+			DeclareField(current_row);
+			DeclareField(current_character_row);
+			DeclareField(video_matrix_address_counter);
+			DeclareField(base_video_matrix_address_counter);
+			DeclareField(character_code);
+			DeclareField(character_colour);
+			DeclareField(character_value);
+			DeclareField(is_odd_frame);
+			DeclareField(is_odd_line);
+		}
+	}
+
+	template <typename VIC> State(const VIC &source) : State() {
+		memcpy(registers, source.registers_.direct_values, sizeof(registers));
+
+		horizontal_counter = source.horizontal_counter_;
+		vertical_counter = source.vertical_counter_;
+		vertical_drawing_latch = source.vertical_drawing_latch_;
+		horizontal_drawing_latch = source.horizontal_drawing_latch_;
+		rows_this_field = source.rows_this_field_;
+		columns_this_line = source.columns_this_line_;
+		pixel_line_cycle = source.pixel_line_cycle_;
+		column_counter = source.column_counter_;
+		current_row = source.current_row_;
+		current_character_row = source.current_character_row_;
+		video_matrix_address_counter = source.video_matrix_address_counter_;
+		base_video_matrix_address_counter = source.base_video_matrix_address_counter_;
+		character_code = source.character_code_;
+		character_colour = source.character_colour_;
+		character_value = source.character_value_;
+		is_odd_frame = source.is_odd_frame_;
+		is_odd_line = source.is_odd_line_;
+	}
+
+	template <typename VIC> void apply(VIC &target) const {
+		// Rewrite all registers, to regenerate derived values and audio state.
+		for(int c = 0; c < 16; c++) {
+			target.write(c, registers[c]);
+		}
+
+		target.horizontal_counter_ = horizontal_counter;
+		target.vertical_counter_ = vertical_counter;
+		target.vertical_drawing_latch_ = vertical_drawing_latch;
+		target.horizontal_drawing_latch_ = horizontal_drawing_latch;
+		target.rows_this_field_ = rows_this_field;
+		target.columns_this_line_ = columns_this_line;
+		target.pixel_line_cycle_ = pixel_line_cycle;
+		target.column_counter_ = column_counter;
+		target.current_row_ = current_row;
+		target.current_character_row_ = current_character_row;
+		target.video_matrix_address_counter_ = video_matrix_address_counter;
+		target.base_video_matrix_address_counter_ = base_video_matrix_address_counter;
+		target.character_code_ = character_code;
+		target.character_colour_ = character_colour;
+		target.character_value_ = character_value;
+		target.is_odd_frame_ = is_odd_frame;
+		target.is_odd_line_ = is_odd_line;
+
+		// Pixels for any partially-output run no longer correspond to the counters,
+		// so discard them rather than potentially running beyond the end of the buffer.
+		target.pixel_pointer = nullptr;
+	}
 };
 
 }
@@ -10,9 +10,11 @@
 #define CRTC6845_hpp
 
 #include "../../ClockReceiver/ClockReceiver.hpp"
+#include "../../Reflection/Struct.hpp"
 
 #include <cstdint>
 #include <cstdio>
+#include <cstring>
 
 namespace Motorola {
 namespace CRTC {
@@ -267,6 +269,116 @@ template <class T> class CRTC6845 {
 
 		int display_skew_mask_ = 1;
 		unsigned int character_is_visible_shifter_ = 0;
+
+		friend struct State;
+};
+
+struct State: public Reflection::StructImpl<State> {
+	uint8_t registers[18]{};
+	uint8_t dummy_register = 0;
+	uint8_t selected_register = 0;
+	uint8_t status = 0;
+
+	bool display_enable = false;
+	bool hsync = false;
+	bool vsync = false;
+	bool cursor = false;
+	uint16_t refresh_address = 0;
+	uint16_t row_address = 0;
+
+	uint8_t character_counter = 0;
+	uint8_t line_counter = 0;
+	bool character_is_visible = false;
+	bool line_is_visible = false;
+	int hsync_counter = 0;
+	int vsync_counter = 0;
+	bool is_in_adjustment_period = false;
+	uint16_t line_address = 0;
+	uint16_t end_of_line_address = 0;
+	int display_skew_mask = 1;
+	uint32_t character_is_visible_shifter = 0;
+
+	State() {
+		if(needs_declare()) {
+			DeclareField(registers);
+			DeclareField(dummy_register);
+			DeclareField(selected_register);
+			DeclareField(status);
+
+			DeclareField(display_enable);
+			DeclareField(hsync);
+			DeclareField(vsync);
+			DeclareField(cursor);
+			DeclareField(refresh_address);
+			DeclareField(row_address);
+
+			DeclareField(character_counter);
+			DeclareField(line_counter);
+			DeclareField(character_is_visible);
+			DeclareField(line_is_visible);
+			DeclareField(hsync_counter);
+			DeclareField(vsync_counter);
+			DeclareField(is_in_adjustment_period);
+			DeclareField(line_address);
+			DeclareField(end_of_line_address);
+			DeclareField(display_skew_mask);
+			DeclareField(character_is_visible_shifter);
+		}
+	}
+
+	template <typename CRTC> State(const CRTC &source) : State() {
+		memcpy(registers, source.registers_, sizeof(registers));
+		dummy_register = source.dummy_register_;
+		selected_register = uint8_t(source.selected_register_);
+		status = source.status_;
+
+		display_enable = source.bus_state_.display_enable;
+		hsync = source.bus_state_.hsync;
+		vsync = source.bus_state_.vsync;
+		cursor = source.bus_state_.cursor;
+		refresh_address = source.bus_state_.refresh_address;
+		row_address = source.bus_state_.row_address;
+
+		character_counter = source.character_counter_;
+		line_counter = source.line_counter_;
+		character_is_visible = source.character_is_visible_;
+		line_is_visible = source.line_is_visible_;
+		hsync_counter = source.hsync_counter_;
+		vsync_counter = source.vsync_counter_;
+		is_in_adjustment_period = source.is_in_adjustment_period_;
+		line_address = source.line_address_;
+		end_of_line_address = source.end_of_line_address_;
+		display_skew_mask = source.display_skew_mask_;
+		character_is_visible_shifter = uint32_t(source.character_is_visible_shifter_);
+	}
+
+	template <typename CRTC> void apply(CRTC &target) const {
+		// Registers are copied directly rather than written, as the skew mask
+		// is part of the captured state and writes are subject to masking.
+		memcpy(target.registers_, registers, sizeof(registers));
+		target.dummy_register_ = dummy_register;
+		target.selected_register_ = selected_register;
+		target.status_ = status;
+
+		target.bus_state_.display_enable = display_enable;
+		target.bus_state_.hsync = hsync;
+		target.bus_state_.vsync = vsync;
+		target.bus_state_.cursor = cursor;
+		target.bus_state_.refresh_address = refresh_address;
+		target.bus_state_.row_address = row_address;
+
+		target.character_counter_ = character_counter;
+		target.line_counter_ = line_counter;
+		target.character_is_visible_ = character_is_visible;
+		target.line_is_visible_ = line_is_visible;
+		target.hsync_counter_ = hsync_counter;
+		target.vsync_counter_ = vsync_counter;
+		target.is_in_adjustment_period_ = is_in_adjustment_period;
+		target.line_address_ = line_address;
+		target.end_of_line_address_ = end_of_line_address;
+		target.display_skew_mask_ = display_skew_mask;
+		target.character_is_visible_shifter_ = character_is_visible_shifter;
+	}
 };
 
 }
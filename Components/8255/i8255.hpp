@@ -9,7 +9,10 @@
 #ifndef i8255_hpp
 #define i8255_hpp
 
+#include "../../Reflection/Struct.hpp"
+
 #include <cstdint>
+#include <cstring>
 
 namespace Intel {
 namespace i8255 {
@@ -86,6 +89,32 @@ template <class T> class i8255 {
 		uint8_t control_;
 		uint8_t outputs_[3];
 		T &port_handler_;
+
+		friend struct State;
+};
+
+struct State: public Reflection::StructImpl<State> {
+	uint8_t control = 0;
+	uint8_t outputs[3]{};
+
+	State() {
+		if(needs_declare()) {
+			DeclareField(control);
+			DeclareField(outputs);
+		}
+	}
+
+	template <typename i8255> State(const i8255 &source) : State() {
+		control = source.control_;
+		memcpy(outputs, source.outputs_, sizeof(outputs));
+	}
+
+	template <typename i8255> void apply(i8255 &target) const {
+		// Announce all outputs, so that the port handler is consistent with the new state.
+		target.control_ = control;
+		memcpy(target.outputs_, outputs, sizeof(outputs));
+		target.update_outputs();
+	}
 };
 
 }
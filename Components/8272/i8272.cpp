@@ -287,6 +287,9 @@ void i8272::posit_event(int event_type) {
 			ResetNonDMAExecution();
 			command_.clear();
 
+			// Bits from the disk are of no interest until the next command.
+			set_is_listening(false);
+
 	// Sets the data request bit, and waits for a byte. Then sets the busy bit. Continues accepting bytes
 	// until it has a quantity that make up an entire command, then resets the data request bit and
 	// branches to that command.
@@ -304,6 +307,7 @@ void i8272::posit_event(int event_type) {
 			};
 
 			if(command_.size() < required_lengths[command_[0] & 0x1f]) goto wait_for_complete_command_sequence;
+			set_is_listening(true);
 			if(command_.size() == 9) {
 				cylinder_ = command_[2];
 				head_ = command_[3];
@@ -9,6 +9,8 @@
 #ifndef z8530_hpp
 #define z8530_hpp
 
+#include "../../Reflection/Struct.hpp"
+
 #include <cstdint>
 
 namespace Zilog {
@@ -96,6 +98,8 @@ class z8530 {
 				uint8_t external_interrupt_status_ = 0;
 
 				bool dcd_ = false;
+
+				friend struct State;
 		} channels_[2];
 
 		uint8_t pointer_ = 0;
@@ -107,6 +111,109 @@ class z8530 {
 		bool previous_interrupt_line_ = false;
 		void update_delegate();
 		Delegate *delegate_ = nullptr;
+
+		friend struct State;
+};
+
+struct State: public Reflection::StructImpl<State> {
+	struct Channel: public Reflection::StructImpl<Channel> {
+		uint8_t data = 0xff;
+
+		// Parity, stop bits and sync mode are stored as the ordinals
+		// of their respective enums.
+		uint8_t parity = 2;
+		uint8_t stop_bits = 0;
+		uint8_t sync_mode = 0;
+		int clock_rate_multiplier = 1;
+
+		uint8_t interrupt_mask = 0;
+		uint8_t external_interrupt_mask = 0;
+		bool external_status_interrupt = false;
+		uint8_t external_interrupt_status = 0;
+
+		bool dcd = false;
+
+		Channel() {
+			if(needs_declare()) {
+				DeclareField(data);
+				DeclareField(parity);
+				DeclareField(stop_bits);
+				DeclareField(sync_mode);
+				DeclareField(clock_rate_multiplier);
+				DeclareField(interrupt_mask);
+				DeclareField(external_interrupt_mask);
+				DeclareField(external_status_interrupt);
+				DeclareField(external_interrupt_status);
+				DeclareField(dcd);
+			}
+		}
+
+		template <typename ChannelT> Channel(const ChannelT &source) : Channel() {
+			data = source.data_;
+			parity = uint8_t(source.parity_);
+			stop_bits = uint8_t(source.stop_bits_);
+			sync_mode = uint8_t(source.sync_mode_);
+			clock_rate_multiplier = source.clock_rate_multiplier_;
+			interrupt_mask = source.interrupt_mask_;
+			external_interrupt_mask = source.external_interrupt_mask_;
+			external_status_interrupt = source.external_status_interrupt_;
+			external_interrupt_status = source.external_interrupt_status_;
+			dcd = source.dcd_;
+		}
+
+		template <typename ChannelT> void apply(ChannelT &target) const {
+			target.data_ = data;
+			target.parity_ = decltype(target.parity_)(parity);
+			target.stop_bits_ = decltype(target.stop_bits_)(stop_bits);
+			target.sync_mode_ = decltype(target.sync_mode_)(sync_mode);
+			target.clock_rate_multiplier_ = clock_rate_multiplier;
+			target.interrupt_mask_ = interrupt_mask;
+			target.external_interrupt_mask_ = external_interrupt_mask;
+			target.external_status_interrupt_ = external_status_interrupt;
+			target.external_interrupt_status_ = external_interrupt_status;
+			target.dcd_ = dcd;
+		}
+	};
+
+	// Reflection doesn't support arrays of structs, so the channels are named individually.
+	Channel channel_a, channel_b;
+
+	uint8_t pointer = 0;
+	uint8_t interrupt_vector = 0;
+	uint8_t master_interrupt_control = 0;
+	bool interrupt_line = false;
+
+	State() {
+		if(needs_declare()) {
+			DeclareField(channel_a);
+			DeclareField(channel_b);
+			DeclareField(pointer);
+			DeclareField(interrupt_vector);
+			DeclareField(master_interrupt_control);
+			DeclareField(interrupt_line);
+		}
+	}
+
+	template <typename z8530> State(const z8530 &source) : State() {
+		channel_a = Channel(source.channels_[0]);
+		channel_b = Channel(source.channels_[1]);
+
+		pointer = source.pointer_;
+		interrupt_vector = source.interrupt_vector_;
+		master_interrupt_control = source.master_interrupt_control_;
+		interrupt_line = source.previous_interrupt_line_;
+	}
+
+	template <typename z8530> void apply(z8530 &target) const {
+		channel_a.apply(target.channels_[0]);
+		channel_b.apply(target.channels_[1]);
+
+		target.pointer_ = pointer;
+		target.interrupt_vector_ = interrupt_vector;
+		target.master_interrupt_control_ = master_interrupt_control;
+		target.previous_interrupt_line_ = interrupt_line;
+		target.update_delegate();
+	}
 };
 
 }
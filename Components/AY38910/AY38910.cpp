@@ -123,40 +123,7 @@ template <bool is_stereo> void AY38910<is_stereo>::get_samples(std::size_t numbe
 	}
 
 	while(c < number_of_samples) {
-#define step_channel(c) \
-	if(tone_counters_[c]) tone_counters_[c]--;\
-	else {\
-		tone_outputs_[c] ^= 1;\
-		tone_counters_[c] = tone_periods_[c] << 1;\
-	}
-
-		// Update the tone channels.
-		step_channel(0);
-		step_channel(1);
-		step_channel(2);
-
-#undef step_channel
-
-		// Update the noise generator. This recomputes the new bit repeatedly but harmlessly, only shifting
-		// it into the official 17 upon divider underflow.
-		if(noise_counter_) noise_counter_--;
-		else {
-			noise_counter_ = noise_period_ << 1;	// To cover the double resolution of envelopes.
-			noise_output_ ^= noise_shift_register_&1;
-			noise_shift_register_ |= ((noise_shift_register_ ^ (noise_shift_register_ >> 3))&1) << 17;
-			noise_shift_register_ >>= 1;
-		}
-
-		// Update the envelope generator. Table based for pattern lookup, with a 'refill' step: a way of
-		// implementing non-repeating patterns by locking them to the final table position.
-		if(envelope_divider_) envelope_divider_--;
-		else {
-			envelope_divider_ = envelope_period_;
-			envelope_position_ ++;
-			if(envelope_position_ == 64) envelope_position_ = envelope_overflow_masks_[output_registers_[13]];
-		}
-
-		evaluate_output_volume();
+		advance();
 
 		for(int ic = 0; ic < 4 && c < number_of_samples; ic++) {
 			if constexpr (is_stereo) {
@@ -172,6 +139,43 @@ template <bool is_stereo> void AY38910<is_stereo>::get_samples(std::size_t numbe
 	master_divider_ &= 3;
 }
 
+template <bool is_stereo> void AY38910<is_stereo>::advance() {
+#define step_channel(c) \
+	if(tone_counters_[c]) tone_counters_[c]--;\
+	else {\
+		tone_outputs_[c] ^= 1;\
+		tone_counters_[c] = tone_periods_[c] << 1;\
+	}
+
+	// Update the tone channels.
+	step_channel(0);
+	step_channel(1);
+	step_channel(2);
+
+#undef step_channel
+
+	// Update the noise generator. This recomputes the new bit repeatedly but harmlessly, only shifting
+	// it into the official 17 upon divider underflow.
+	if(noise_counter_) noise_counter_--;
+	else {
+		noise_counter_ = noise_period_ << 1;	// To cover the double resolution of envelopes.
+		noise_output_ ^= noise_shift_register_&1;
+		noise_shift_register_ |= ((noise_shift_register_ ^ (noise_shift_register_ >> 3))&1) << 17;
+		noise_shift_register_ >>= 1;
+	}
+
+	// Update the envelope generator. Table based for pattern lookup, with a 'refill' step: a way of
+	// implementing non-repeating patterns by locking them to the final table position.
+	if(envelope_divider_) envelope_divider_--;
+	else {
+		envelope_divider_ = envelope_period_;
+		envelope_position_ ++;
+		if(envelope_position_ == 64) envelope_position_ = envelope_overflow_masks_[output_registers_[13]];
+	}
+
+	evaluate_output_volume();
+}
+
 template <bool is_stereo> void AY38910<is_stereo>::evaluate_output_volume() {
 	int envelope_volume = envelope_shapes_[output_registers_[13]][envelope_position_ | envelope_position_mask_];
 
@@ -249,47 +253,16 @@ template <bool is_stereo> void AY38910<is_stereo>::set_register_value(uint8_t va
 	// There are only 16 registers.
 	if(selected_register_ > 15) return;
 
-	// If this is a register that affects audio output, enqueue a mutation onto the
-	// audio generation thread.
+	// If this is a register that affects audio output, log it or enqueue a mutation
+	// onto the audio generation thread.
 	if(selected_register_ < 14) {
-		task_queue_.enqueue([this, selected_register = selected_register_, value] () {
-			// Perform any register-specific mutation to output generation.
-			uint8_t masked_value = value;
-			switch(selected_register) {
-				case 0: case 2: case 4:
-				case 1: case 3: case 5: {
-					int channel = selected_register >> 1;
-
-					if(selected_register & 1)
-						tone_periods_[channel] = (tone_periods_[channel] & 0xff) | uint16_t((value&0xf) << 8);
-					else
-						tone_periods_[channel] = (tone_periods_[channel] & ~0xff) | value;
-				}
-				break;
-
-				case 6:
-					noise_period_ = value & 0x1f;
-				break;
-
-				case 11:
-					envelope_period_ = (envelope_period_ & ~0xff) | value;
-				break;
-
-				case 12:
-					envelope_period_ = (envelope_period_ & 0xff) | int(value << 8);
-				break;
-
-				case 13:
-					masked_value &= 0xf;
-					envelope_position_ = 0;
-				break;
-			}
-
-			// Store a copy of the current register within the storage used by the audio generation
-			// thread, and apply any changes to output volume.
-			output_registers_[selected_register] = masked_value;
-			evaluate_output_volume();
-		});
+		if(register_write_log_) {
+			register_write_log_->push(register_write_log_chip_, uint16_t(selected_register_), value);
+		} else {
+			task_queue_.enqueue([this, selected_register = selected_register_, value] () {
+				set_output_register(selected_register, value);
+			});
+		}
 	}
 
 	// Decide which outputs are going to need updating (if any).
@@ -314,6 +287,54 @@ template <bool is_stereo> void AY38910<is_stereo>::set_register_value(uint8_t va
 	if(update_port_a) set_port_output(false);
 }
 
+template <bool is_stereo> void AY38910<is_stereo>::set_output_register(int selected_register, uint8_t value) {
+	// Perform any register-specific mutation to output generation.
+	uint8_t masked_value = value;
+	switch(selected_register) {
+		case 0: case 2: case 4:
+		case 1: case 3: case 5: {
+			int channel = selected_register >> 1;
+
+			if(selected_register & 1)
+				tone_periods_[channel] = (tone_periods_[channel] & 0xff) | uint16_t((value&0xf) << 8);
+			else
+				tone_periods_[channel] = (tone_periods_[channel] & ~0xff) | value;
+		}
+		break;
+
+		case 6:
+			noise_period_ = value & 0x1f;
+		break;
+
+		case 11:
+			envelope_period_ = (envelope_period_ & ~0xff) | value;
+		break;
+
+		case 12:
+			envelope_period_ = (envelope_period_ & 0xff) | int(value << 8);
+		break;
+
+		case 13:
+			masked_value &= 0xf;
+			envelope_position_ = 0;
+		break;
+	}
+
+	// Store a copy of the current register within the storage used by the audio generation
+	// thread, and apply any changes to output volume.
+	output_registers_[selected_register] = masked_value;
+	evaluate_output_volume();
+}
+
+template <bool is_stereo> void AY38910<is_stereo>::set_register_write_log(Concurrency::RegisterWriteLog<> *log, uint8_t chip) {
+	register_write_log_ = log;
+	register_write_log_chip_ = chip;
+}
+
+template <bool is_stereo> void AY38910<is_stereo>::apply_register_write(const Concurrency::RegisterWrite &write) {
+	set_output_register(write.address, write.value);
+}
+
 template <bool is_stereo> uint8_t AY38910<is_stereo>::get_register_value() {
 	// This table ensures that bits that aren't defined within the AY are returned as 0s
 	// when read, conforming to CPC-sourced unit tests.
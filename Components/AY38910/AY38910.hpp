@@ -11,6 +11,7 @@
 
 #include "../../Outputs/Speaker/Implementation/SampleSource.hpp"
 #include "../../Concurrency/AsyncTaskQueue.hpp"
+#include "../../Concurrency/RegisterWriteLog.hpp"
 
 #include "../../Reflection/Struct.hpp"
 
@@ -107,14 +108,41 @@ template <bool is_stereo> class AY38910: public ::Outputs::Speaker::SampleSource
 		*/
 		void set_output_mixing(float a_left, float b_left, float c_left, float a_right = 1.0, float b_right = 1.0, float c_right = 1.0);
 
+		/*!
+			Directs all subsequent writes to audio-affecting registers to @c log, tagged as being for @c chip,
+			rather than posting them to the task queue. The owner is then responsible for replaying the log
+			into apply_register_write, e.g. via an Outputs::Speaker::ReplayingSource.
+		*/
+		void set_register_write_log(Concurrency::RegisterWriteLog<> *log, uint8_t chip = 0);
+
+		/// Applies @c write, as recorded in a register write log, to audio generation.
+		void apply_register_write(const Concurrency::RegisterWrite &write);
+
 		// to satisfy ::Outputs::Speaker (included via ::Outputs::Filter.
 		void get_samples(std::size_t number_of_samples, int16_t *target);
 		bool is_zero_level() const;
 		void set_sample_volume_range(std::int16_t range);
 		static constexpr bool get_is_stereo() { return is_stereo; }
 
+		// To satisfy ::Outputs::Speaker::StepSource; output can change only once every four cycles,
+		// as per get_samples.
+		template <typename TargetT> void get_steps(std::size_t number_of_cycles, TargetT &target) {
+			announce(0, target);
+
+			std::size_t c = (4 - (master_divider_ & 3)) & 3;
+			while(c < number_of_cycles) {
+				advance();
+				announce(c, target);
+				c += 4;
+			}
+
+			master_divider_ = int((std::size_t(master_divider_) + number_of_cycles) & 3);
+		}
+
 	private:
 		Concurrency::AsyncTaskQueue<false> &task_queue_;
+		Concurrency::RegisterWriteLog<> *register_write_log_ = nullptr;
+		uint8_t register_write_log_chip_ = 0;
 
 		int selected_register_ = 0;
 		uint8_t registers_[16] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
@@ -148,6 +176,7 @@ template <bool is_stereo> class AY38910: public ::Outputs::Speaker::SampleSource
 
 		void select_register(uint8_t r);
 		void set_register_value(uint8_t value);
+		void set_output_register(int selected_register, uint8_t value);
 		uint8_t get_register_value();
 
 		uint8_t data_input_, data_output_;
@@ -160,6 +189,19 @@ template <bool is_stereo> class AY38910: public ::Outputs::Speaker::SampleSource
 
 		void evaluate_output_volume();
 
+		/// Advances the tone, noise and envelope generators by one step of the divide-by-four clock,
+		/// and updates output_volume_ accordingly.
+		void advance();
+
+		template <typename TargetT> void announce(std::size_t offset, TargetT &target) {
+			if constexpr (is_stereo) {
+				const int16_t *const output_volumes = reinterpret_cast<const int16_t *>(&output_volume_);
+				target.step(offset, output_volumes[0], output_volumes[1]);
+			} else {
+				target.step(offset, int16_t(output_volume_));
+			}
+		}
+
 		// Output mixing control.
 		uint8_t a_left_ = 255, a_right_ = 255;
 		uint8_t b_left_ = 255, b_right_ = 255;
@@ -209,7 +251,12 @@ struct State: public Reflection::StructImpl<State> {
 		}
 	}
 
-	template <typename AY> void apply(AY &target) {
+	template <typename AY> State(const AY &source) : State() {
+		memcpy(registers, source.registers_, sizeof(registers));
+		selected_register = uint8_t(source.selected_register_);
+	}
+
+	template <typename AY> void apply(AY &target) const {
 		// Establish emulator-thread state
 		for(uint8_t c = 0; c < 16; c++) {
 			target.select_register(c);
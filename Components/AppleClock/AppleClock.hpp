@@ -9,7 +9,11 @@
 #ifndef Apple_RealTimeClock_hpp
 #define Apple_RealTimeClock_hpp
 
+#include "../../Reflection/Struct.hpp"
+
+#include <algorithm>
 #include <array>
+#include <vector>
 
 namespace Apple {
 namespace Clock {
@@ -185,6 +189,7 @@ class ClockStorage {
 		};
 		Phase phase_ = Phase::Command;
 
+		friend struct State;
 };
 
 /*!
@@ -248,6 +253,66 @@ class SerialClock: public ClockStorage {
 		uint8_t result_ = 0;
 
 		bool previous_clock_ = false;
+
+		friend struct State;
+};
+
+/*!
+	Captures the state of a @c SerialClock, including its [P/B]RAM.
+*/
+struct State: public Reflection::StructImpl<State> {
+	std::vector<uint8_t> data;
+	uint8_t seconds[4]{};
+	uint8_t write_protect = 0;
+	uint16_t address = 0;
+	uint8_t storage_phase = 0;		// The ordinal of a ClockStorage::Phase.
+
+	int serial_phase = 0;
+	uint16_t command = 0;
+	uint8_t result = 0;
+	bool previous_clock = false;
+
+	State() {
+		if(needs_declare()) {
+			DeclareField(data);
+			DeclareField(seconds);
+			DeclareField(write_protect);
+			DeclareField(address);
+			DeclareField(storage_phase);
+			DeclareField(serial_phase);
+			DeclareField(command);
+			DeclareField(result);
+			DeclareField(previous_clock);
+		}
+	}
+
+	State(const SerialClock &source) : State() {
+		const ClockStorage &storage = source;
+		data.assign(storage.data_.begin(), storage.data_.end());
+		std::copy(storage.seconds_.begin(), storage.seconds_.end(), seconds);
+		write_protect = storage.write_protect_;
+		address = uint16_t(storage.address_);
+		storage_phase = uint8_t(storage.phase_);
+
+		serial_phase = source.phase_;
+		command = source.command_;
+		result = source.result_;
+		previous_clock = source.previous_clock_;
+	}
+
+	void apply(SerialClock &target) const {
+		ClockStorage &storage = target;
+		std::copy_n(data.begin(), std::min(data.size(), storage.data_.size()), storage.data_.begin());
+		std::copy(std::begin(seconds), std::end(seconds), storage.seconds_.begin());
+		storage.write_protect_ = write_protect;
+		storage.address_ = address;
+		storage.phase_ = ClockStorage::Phase(storage_phase);
+
+		target.phase_ = serial_phase;
+		target.command_ = command;
+		target.result_ = result;
+		target.previous_clock_ = previous_clock;
+	}
 };
 
 /*!
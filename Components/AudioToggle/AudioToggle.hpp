@@ -25,6 +25,11 @@ class Toggle: public Outputs::Speaker::SampleSource {
 		void set_sample_volume_range(std::int16_t range);
 		void skip_samples(const std::size_t number_of_samples);
 
+		// To satisfy ::StepSource; the level changes only between calls.
+		template <typename TargetT> void get_steps(std::size_t, TargetT &target) {
+			target.step(0, level_);
+		}
+
 		void set_output(bool enabled);
 		bool get_output() const;
 
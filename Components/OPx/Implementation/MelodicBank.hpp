@@ -0,0 +1,214 @@
+//
+//  MelodicBank.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 16/10/2026.
+//  Copyright 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef MelodicBank_h
+#define MelodicBank_h
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+
+#include "Tables.hpp"
+#include "WaveformGenerator.hpp"
+#include "../../../Numeric/CPUFeatures.hpp"
+
+namespace Yamaha {
+namespace OPL {
+
+/*!
+	Evaluates a bank of up to @c count two-operator FM channels, each a modulator feeding a carrier,
+	all at once. State is held as a structure of arrays, with one entry per channel.
+
+	The owner is responsible for phase and envelope generation; before each update it should fill in
+	@c carrier_attenuation and @c modulator_attenuation with each operator's total attenuation, and
+	supply the phase generators' raw phase accumulators.
+
+	If the host supports AVX2, eight channels are evaluated at a time with log-sin and exponent lookups
+	performed as gathers. Otherwise channels are evaluated in turn. Both produce identical results.
+*/
+template <int phase_precision, int count> class MelodicBank {
+	static constexpr int padded_count = (count + 7) & ~7;
+
+	public:
+		/// The total attenuation to apply to each channel's carrier, in the same units as @c LogSign::log.
+		alignas(32) int carrier_attenuation[padded_count]{};
+
+		/// The total attenuation to apply to each channel's modulator, in the same units as @c LogSign::log.
+		alignas(32) int modulator_attenuation[padded_count]{};
+
+		/// The output of each channel as of the most recent update.
+		alignas(32) int output[padded_count]{};
+
+		MelodicBank() {
+			// Begin with every modulator silent.
+			std::fill(std::begin(modulator_log_), std::end(modulator_log_), 1 << 13);
+		}
+
+		/// Sets the waveforms used by channel @c channel.
+		void set_waveforms(int channel, Waveform carrier, Waveform modulator) {
+			carrier_waveform_[channel] = WaveformGenerator<phase_precision>::quadrant_shifts(carrier);
+			modulator_waveform_[channel] = WaveformGenerator<phase_precision>::quadrant_shifts(modulator);
+		}
+
+		/// Sets the degree of modulator self-feedback, in the range 0–7, for channel @c channel.
+		void set_feedback(int channel, int level) {
+			feedback_shift_[channel] = 8 - level;
+			feedback_mask_[channel] = level ? ~0 : 0;
+		}
+
+		/*!
+			Evaluates the first @c channels channels, posting results to @c output.
+
+			@param carrier_phases The raw phase accumulators of each channel's carrier, as per PhaseGeneratorBank::raw_phases.
+			@param modulator_phases The raw phase accumulators of each channel's modulator, to which feedback will be applied.
+		*/
+		void update(int channels, const int *carrier_phases, int *modulator_phases) {
+#ifdef AVX2_TARGET
+			if(Numeric::has_avx2()) {
+				update_avx2(channels, carrier_phases, modulator_phases);
+				return;
+			}
+#endif
+			update_scalar(channels, carrier_phases, modulator_phases);
+		}
+
+		/// Performs the same function as @c update, evaluating one channel at a time.
+		void update_scalar(int channels, const int *carrier_phases, int *modulator_phases) {
+			for(int c = 0; c < channels; ++c) {
+				// The modulator always updates after the carrier, oddly enough. So calculate actual output first,
+				// based on the modulator's last value.
+				const int previous = level(modulator_log_[c], modulator_negative_[c], phase_precision);
+				int negative;
+				const int carrier_log =
+					wave(((carrier_phases[c] >> 1) + previous) >> phase_precision, carrier_waveform_[c], negative) +
+					carrier_attenuation[c];
+				output[c] = level(carrier_log, negative, 0);
+
+				// Get the modulator's new value.
+				const int modulator_log =
+					wave(modulator_phases[c] >> (phase_precision + 1), modulator_waveform_[c], negative) +
+					modulator_attenuation[c];
+
+				// Apply feedback, if any.
+				const int modulation = level(modulator_log, negative, phase_precision);
+				modulator_phases[c] += ((modulation + previous) >> feedback_shift_[c]) & feedback_mask_[c];
+
+				modulator_log_[c] = modulator_log;
+				modulator_negative_[c] = negative;
+			}
+		}
+
+#ifdef AVX2_TARGET
+		/// Performs the same function as @c update, evaluating eight channels at a time.
+		/// This may be called only if Numeric::has_avx2() is @c true.
+		AVX2_TARGET void update_avx2(int channels, const int *carrier_phases, int *modulator_phases) {
+			const __m256i lane_indices = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+			for(int base = 0; base < channels; base += 8) {
+				const __m256i lanes = _mm256_cmpgt_epi32(_mm256_set1_epi32(channels - base), lane_indices);
+
+				const __m256i previous_log = vector(modulator_log_, base);
+				const __m256i previous_negative = vector(modulator_negative_, base);
+				const __m256i previous = level(previous_log, previous_negative, phase_precision);
+
+				// Carrier.
+				__m256i negative;
+				__m256i carrier_phase = _mm256_maskload_epi32(&carrier_phases[base], lanes);
+				carrier_phase = _mm256_srai_epi32(_mm256_add_epi32(_mm256_srai_epi32(carrier_phase, 1), previous), phase_precision);
+				const __m256i carrier_log = _mm256_add_epi32(
+					wave(carrier_phase, vector(carrier_waveform_, base), negative),
+					vector(carrier_attenuation, base));
+				_mm256_maskstore_epi32(&output[base], lanes, level(carrier_log, negative, 0));
+
+				// Modulator.
+				__m256i modulator_phase = _mm256_maskload_epi32(&modulator_phases[base], lanes);
+				const __m256i modulator_log = _mm256_add_epi32(
+					wave(_mm256_srai_epi32(modulator_phase, phase_precision + 1), vector(modulator_waveform_, base), negative),
+					vector(modulator_attenuation, base));
+
+				// Feedback.
+				const __m256i modulation = level(modulator_log, negative, phase_precision);
+				modulator_phase = _mm256_add_epi32(modulator_phase, _mm256_and_si256(
+					_mm256_srav_epi32(_mm256_add_epi32(modulation, previous), vector(feedback_shift_, base)),
+					vector(feedback_mask_, base)));
+				_mm256_maskstore_epi32(&modulator_phases[base], lanes, modulator_phase);
+
+				_mm256_maskstore_epi32(&modulator_log_[base], lanes, modulator_log);
+				_mm256_maskstore_epi32(&modulator_negative_[base], lanes, negative);
+			}
+		}
+#endif
+
+	private:
+		alignas(32) int carrier_waveform_[padded_count]{};
+		alignas(32) int modulator_waveform_[padded_count]{};
+		alignas(32) int feedback_shift_[padded_count]{};
+		alignas(32) int feedback_mask_[padded_count]{};
+
+		// The modulator's most recent output, as a log and a sign mask (i.e. 0 for positive, ~0 for negative).
+		alignas(32) int modulator_log_[padded_count]{};
+		alignas(32) int modulator_negative_[padded_count]{};
+
+		/// 32-bit copies of the log-sin and exponent tables, as used by negative_log_sin and power_two,
+		/// so that they can be gathered from.
+		struct Lookups {
+			int log_sin[256];
+			int exp[256];
+		};
+		static constexpr Lookups make_lookups() {
+			Lookups lookups{};
+			for(int c = 0; c < 256; ++c) {
+				lookups.log_sin[c] = negative_log_sin(c).log;
+				lookups.exp[c] = power_two(LogSign{c, 1});
+			}
+			return lookups;
+		}
+		static constexpr Lookups lookups_ = make_lookups();
+
+		/// Equivalent to power_two with a sign mask rather than a sign.
+		static int level(int log, int negative, int fractional) {
+			const int shift = log >> 8;
+			const int magnitude = (lookups_.exp[log & 0xff] << fractional) >> (shift < 31 ? shift : 31);
+			return (magnitude ^ negative) - negative;
+		}
+
+		/// Equivalent to WaveformGenerator::wave; returns the log and sets @c negative to the sign mask.
+		static int wave(int phase, int quadrant_shifts, int &negative) {
+			const int x = phase & (1023 >> ((quadrant_shifts >> ((phase >> 6) & 12)) & 15));
+			negative = -((x >> 9) & 1);
+			return lookups_.log_sin[(x & 255) ^ (-((x >> 8) & 1) & 255)];
+		}
+
+#ifdef AVX2_TARGET
+		AVX2_TARGET static __m256i vector(const int *source, int base) {
+			return _mm256_load_si256(reinterpret_cast<const __m256i *>(&source[base]));
+		}
+
+		AVX2_TARGET static __m256i level(__m256i log, __m256i negative, int fractional) {
+			const __m256i shift = _mm256_min_epi32(_mm256_srai_epi32(log, 8), _mm256_set1_epi32(31));
+			__m256i magnitude = _mm256_i32gather_epi32(lookups_.exp, _mm256_and_si256(log, _mm256_set1_epi32(0xff)), 4);
+			magnitude = _mm256_srav_epi32(_mm256_sll_epi32(magnitude, _mm_cvtsi32_si128(fractional)), shift);
+			return _mm256_sub_epi32(_mm256_xor_si256(magnitude, negative), negative);
+		}
+
+		AVX2_TARGET static __m256i wave(__m256i phase, __m256i quadrant_shifts, __m256i &negative) {
+			const __m256i quadrant = _mm256_and_si256(_mm256_srai_epi32(phase, 6), _mm256_set1_epi32(12));
+			const __m256i shift = _mm256_and_si256(_mm256_srlv_epi32(quadrant_shifts, quadrant), _mm256_set1_epi32(15));
+			const __m256i x = _mm256_and_si256(phase, _mm256_srlv_epi32(_mm256_set1_epi32(1023), shift));
+
+			negative = _mm256_srai_epi32(_mm256_slli_epi32(x, 22), 31);
+			const __m256i flip = _mm256_and_si256(_mm256_srai_epi32(_mm256_slli_epi32(x, 23), 31), _mm256_set1_epi32(0xff));
+			const __m256i index = _mm256_xor_si256(_mm256_and_si256(x, _mm256_set1_epi32(0xff)), flip);
+			return _mm256_i32gather_epi32(lookups_.log_sin, index, 4);
+		}
+#endif
+};
+
+}
+}
+
+#endif /* MelodicBank_h */
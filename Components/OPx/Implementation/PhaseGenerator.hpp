@@ -17,106 +17,111 @@ namespace Yamaha {
 namespace OPL {
 
 /*!
-	Models an OPL-style phase generator of templated precision; having been told its period ('f-num'), octave ('block') and
-	multiple, and whether to apply vibrato, this will then appropriately update and return phase.
+	Models a bank of @c count OPL-style phase generators of templated precision; having been told each generator's period ('f-num'),
+	octave ('block') and multiple, and whether to apply vibrato, this will then appropriately update and return phases.
+
+	State is held as a structure of arrays so that all generators can be advanced together, and so that
+	the raw phases can be consumed directly by a MelodicBank.
 */
-template <int precision> class PhaseGenerator {
+template <int precision, int count> class PhaseGeneratorBank {
 	public:
 		/*!
-			Advances the phase generator a single step, given the current state of the low-frequency oscillator, @c oscillator.
+			Advances all phase generators a single step, given the current state of the low-frequency oscillator, @c oscillator.
 		*/
 		void update(const LowFrequencyOscillator &oscillator) {
 			constexpr int vibrato_shifts[4] = {3, 1, 0, 1};
 			constexpr int vibrato_signs[2] = {1, -1};
 
-			// Get just the top three bits of the period_.
-			const int top_freq = period_ >> (precision - 3);
+			// Vibrato is a function of (i) the top three bits of each oscillator's period; (ii) the current
+			// low-frequency oscillator vibrato output; and (iii) whether vibrato is enabled. Only the first
+			// of those varies by generator.
+			const int vibrato_shift = vibrato_shifts[oscillator.vibrato & 3];
+			const int vibrato_sign = vibrato_signs[oscillator.vibrato >> 2];
 
-			// Cacluaute applicable vibrato as a function of (i) the top three bits of the
-			// oscillator period; (ii) the current low-frequency oscillator vibrato output; and
-			// (iii) whether vibrato is enabled.
-			const int vibrato = (top_freq >> vibrato_shifts[oscillator.vibrato & 3]) * vibrato_signs[oscillator.vibrato >> 2] * enable_vibrato_;
+			for(int c = 0; c < count; ++c) {
+				// Get just the top three bits of the period.
+				const int top_freq = period_[c] >> (precision - 3);
+				const int vibrato = (top_freq >> vibrato_shift) * vibrato_sign * enable_vibrato_[c];
 
-			// Apply phase update with vibrato from the low-frequency oscillator.
-			phase_ += (multiple_ * ((period_ << 1) + vibrato) << octave_) >> 1;
+				// Apply phase update with vibrato from the low-frequency oscillator.
+				phase_[c] += (multiple_[c] * ((period_[c] << 1) + vibrato) << octave_[c]) >> 1;
+			}
 		}
 
-
 		/*!
-			@returns Current phase; real hardware provides only the low ten bits of this result.
+			@returns Current phase of generator @c index; real hardware provides only the low ten bits of this result.
 		*/
-		int phase() const {
+		int phase(int index) const {
 			// My table if multipliers is multiplied by two, so shift by one more
 			// than the stated precision.
-			return phase_ >> precision_shift;
+			return phase_[index] >> precision_shift;
 		}
 
 		/*!
-			@returns Current phase, scaled up by (1 << precision).
+			@returns Current phase of generator @c index, scaled up by (1 << precision).
 		*/
-		int scaled_phase() const {
-			return phase_ >> 1;
+		int scaled_phase(int index) const {
+			return phase_[index] >> 1;
 		}
 
 		/*!
-			Applies feedback based on two historic samples of a total output level,
-			plus the degree of feedback to apply
+			@returns The internal phase accumulators, from which phase(x) = raw_phases()[x] >> (precision + 1)
+				and scaled_phase(x) = raw_phases()[x] >> 1.
 		*/
-		void apply_feedback(LogSign first, LogSign second, int level) {
-			constexpr int masks[] = {0, ~0, ~0, ~0, ~0, ~0, ~0, ~0};
-			phase_ += ((second.level(precision) + first.level(precision)) >> (8 - level)) & masks[level];
+		int *raw_phases() {
+			return phase_;
 		}
 
 		/*!
-			Sets the multiple for this phase generator, in the same terms as an OPL programmer,
+			Sets the multiple for generator @c index, in the same terms as an OPL programmer,
 			i.e. a 4-bit number that is used as a lookup into the internal multiples table.
 		*/
-		void set_multiple(int multiple) {
+		void set_multiple(int index, int multiple) {
 			// This encodes the MUL -> multiple table given on page 12,
 			// multiplied by two.
 			constexpr int multipliers[] = {
 				1, 2, 4, 6, 8, 10, 12, 14, 16, 18, 20, 20, 24, 24, 30, 30
 			};
 			assert(multiple < 16);
-			multiple_ = multipliers[multiple];
+			multiple_[index] = multipliers[multiple];
 		}
 
 		/*!
-			Sets the period of this generator, along with its current octave.
+			Sets the period of generator @c index, along with its current octave.
 
 			Yamaha tends to refer to the period as the 'f-number', and used both 'octave' and 'block' for octave.
 		*/
-		void set_period(int period, int octave) {
-			period_ = period;
-			octave_ = octave;
+		void set_period(int index, int period, int octave) {
+			period_[index] = period;
+			octave_[index] = octave;
 
-			assert(octave_ < 8);
-			assert(period_ < (1 << precision));
+			assert(octave < 8);
+			assert(period < (1 << precision));
 		}
 
 		/*!
-			Enables or disables vibrato.
+			Enables or disables vibrato for generator @c index.
 		*/
-		void set_vibrato_enabled(bool enabled) {
-			enable_vibrato_ = int(enabled);
+		void set_vibrato_enabled(int index, bool enabled) {
+			enable_vibrato_[index] = int(enabled);
 		}
 
 		/*!
-			Resets the current phase.
+			Resets the current phase of generator @c index.
 		*/
-		void reset() {
-			phase_ = 0;
+		void reset(int index) {
+			phase_[index] = 0;
 		}
 
 	private:
 		static constexpr int precision_shift =  1 + precision;
 
-		int phase_ = 0;
+		alignas(32) int phase_[count]{};
 
-		int multiple_ = 0;
-		int period_ = 0;
-		int octave_ = 0;
-		int enable_vibrato_ = 0;
+		alignas(32) int multiple_[count]{};
+		alignas(32) int period_[count]{};
+		alignas(32) int octave_[count]{};
+		alignas(32) int enable_vibrato_[count]{};
 };
 
 }
@@ -161,7 +161,9 @@ constexpr int power_two(LogSign ls, int fractional = 0) {
 		2088,	2082,	2076,	2070,	2064,	2060,	2054,	2048,
 	};
 
-	return ((mapped_exp[ls.log & 0xff] << fractional) >> (ls.log >> 8)) * ls.sign;
+	// Shifts of 32 or more would be undefined; every such shift should produce 0 anyway.
+	const int shift = ls.log >> 8;
+	return ((mapped_exp[ls.log & 0xff] << fractional) >> (shift < 31 ? shift : 31)) * ls.sign;
 }
 
 /*
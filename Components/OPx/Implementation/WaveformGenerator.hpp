@@ -73,6 +73,23 @@ template <int phase_precision> class WaveformGenerator {
 			]);
 		}
 
+		/*!
+			@returns A packed description of waveform @c form for vector evaluation: the output at [integral] phase @c phase
+				is @c negative_log_sin(phase & (1023 >> ((quadrant_shifts(form) >> (((phase >> 8) & 3) * 4)) & 15))),
+				which is identical to @c wave(form, phase).
+		*/
+		static constexpr int quadrant_shifts(Waveform form) {
+			// Each nibble, from least significant, gives the right shift of 1023 that produces the mask for the
+			// corresponding quadrant as per wave(); 11 is used to produce a mask of 0.
+			constexpr int shifts[4] = {
+				0x0000,		// Sine.
+				0xbb11,		// Half sine.
+				0x1111,		// AbsSine.
+				0xb2b2,		// PulseSine.
+			};
+			return shifts[int(form)];
+		}
+
 	private:
 		/*!
 			@returns The phase bit used for cymbal and high-hat generation, which is a function of two operators' phases.
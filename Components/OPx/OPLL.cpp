@@ -24,13 +24,13 @@ OPLL::OPLL(Concurrency::AsyncTaskQueue<false> &task_queue, int audio_divider, bo
 	rhythm_envelope_generators_[BassCarrier].set_should_damp([this] {
 		// Propagate attack mode to the modulator, and reset both phases.
 		rhythm_envelope_generators_[BassModulator].set_key_on(true);
-		phase_generators_[6 + 0].reset();
-		phase_generators_[6 + 9].reset();
+		phase_generators_.reset(6 + 0);
+		phase_generators_.reset(6 + 9);
 	});
 
 	// Set the other drums to damp, but only the TomTom to affect phase.
 	rhythm_envelope_generators_[TomTom].set_should_damp([this] {
-		phase_generators_[8 + 9].reset();
+		phase_generators_.reset(8 + 9);
 	});
 	rhythm_envelope_generators_[Snare].set_should_damp({});
 	rhythm_envelope_generators_[Cymbal].set_should_damp({});
@@ -58,8 +58,8 @@ OPLL::OPLL(Concurrency::AsyncTaskQueue<false> &task_queue, int audio_divider, bo
 		envelope_generators_[c].set_should_damp([this, c] {
 			// Propagate attack mode to the modulator, and reset both phases.
 			envelope_generators_[c + 9].set_key_on(true);
-			phase_generators_[c + 0].reset();
-			phase_generators_[c + 9].reset();
+			phase_generators_.reset(c + 0);
+			phase_generators_.reset(c + 9);
 		});
 	}
 
@@ -159,6 +159,7 @@ void OPLL::write_register(uint8_t address, uint8_t value) {
 			// from the stored instrument values.
 			case 0x30:
 				channels_[index].attenuation = value & 0xf;
+				set_fixed_attenuations(index);
 
 				// Install an instrument only if it's new.
 				if(channels_[index].instrument != value >> 4) {
@@ -173,14 +174,16 @@ void OPLL::write_register(uint8_t address, uint8_t value) {
 }
 
 void OPLL::set_channel_period(int channel) {
-	phase_generators_[channel + 0].set_period(channels_[channel].period, channels_[channel].octave);
-	phase_generators_[channel + 9].set_period(channels_[channel].period, channels_[channel].octave);
+	phase_generators_.set_period(channel + 0, channels_[channel].period, channels_[channel].octave);
+	phase_generators_.set_period(channel + 9, channels_[channel].period, channels_[channel].octave);
 
 	envelope_generators_[channel + 0].set_period(channels_[channel].period, channels_[channel].octave);
 	envelope_generators_[channel + 9].set_period(channels_[channel].period, channels_[channel].octave);
 
 	key_level_scalers_[channel + 0].set_period(channels_[channel].period, channels_[channel].octave);
 	key_level_scalers_[channel + 9].set_period(channels_[channel].period, channels_[channel].octave);
+
+	set_fixed_attenuations(channel);
 }
 
 const uint8_t *OPLL::instrument_definition(int instrument, int channel) {
@@ -199,11 +202,9 @@ const uint8_t *OPLL::instrument_definition(int instrument, int channel) {
 
 void OPLL::install_instrument(int channel) {
 	auto &carrier_envelope = envelope_generators_[channel + 0];
-	auto &carrier_phase = phase_generators_[channel + 0];
 	auto &carrier_scaler = key_level_scalers_[channel + 0];
 
 	auto &modulator_envelope = envelope_generators_[channel + 9];
-	auto &modulator_phase = phase_generators_[channel + 9];
 	auto &modulator_scaler = key_level_scalers_[channel + 9];
 
 	const uint8_t *const instrument = instrument_definition(channels_[channel].instrument, channel);
@@ -215,14 +216,14 @@ void OPLL::install_instrument(int channel) {
 	//	b5:		sustain-level enable;
 	//	b6:		vibrato enable;
 	//	b7:		tremolo enable.
-	modulator_phase.set_multiple(instrument[0] & 0xf);
+	phase_generators_.set_multiple(channel + 9, instrument[0] & 0xf);
 	channels_[channel].modulator_key_rate_scale_multiplier = (instrument[0] >> 4) & 1;
-	modulator_phase.set_vibrato_enabled(instrument[0] & 0x40);
+	phase_generators_.set_vibrato_enabled(channel + 9, instrument[0] & 0x40);
 	modulator_envelope.set_tremolo_enabled(instrument[0] & 0x80);
 
-	carrier_phase.set_multiple(instrument[1] & 0xf);
+	phase_generators_.set_multiple(channel + 0, instrument[1] & 0xf);
 	channels_[channel].carrier_key_rate_scale_multiplier = (instrument[1] >> 4) & 1;
-	carrier_phase.set_vibrato_enabled(instrument[1] & 0x40);
+	phase_generators_.set_vibrato_enabled(channel + 0, instrument[1] & 0x40);
 	carrier_envelope.set_tremolo_enabled(instrument[1] & 0x80);
 
 	// Pass off bit 5.
@@ -242,9 +243,8 @@ void OPLL::install_instrument(int channel) {
 	//	b4:		carrier waveform selection;
 	//	b5:		[unused]
 	//	b6–b7:	carrier key-scale level.
-	channels_[channel].modulator_feedback = instrument[3] & 7;
-	channels_[channel].modulator_waveform = Waveform((instrument[3] >> 3) & 1);
-	channels_[channel].carrier_waveform = Waveform((instrument[3] >> 4) & 1);
+	melodic_channels_.set_feedback(channel, instrument[3] & 7);
+	melodic_channels_.set_waveforms(channel, Waveform((instrument[3] >> 4) & 1), Waveform((instrument[3] >> 3) & 1));
 	carrier_scaler.set_key_scaling_level(instrument[3] >> 6);
 
 	// Bytes 4 (modulator) and 5 (carrier):
@@ -264,6 +264,8 @@ void OPLL::install_instrument(int channel) {
 	modulator_envelope.set_sustain_level(instrument[6] >> 4);
 	carrier_envelope.set_release_rate(instrument[7] & 0xf);
 	carrier_envelope.set_sustain_level(instrument[7] >> 4);
+
+	set_fixed_attenuations(channel);
 }
 
 void OPLL::set_use_sustain(int channel) {
@@ -299,9 +301,7 @@ void OPLL::update_all_channels() {
 	oscillator_.update();
 
 	// Update all phase generators. That's guaranteed.
-	for(int c = 0; c < 18; ++c) {
-		phase_generators_[c].update(oscillator_);
-	}
+	phase_generators_.update(oscillator_);
 
 	// Update the ADSR envelopes that are guaranteed to be melodic.
 	for(int c = 0; c < 6; ++c) {
@@ -318,13 +318,14 @@ void OPLL::update_all_channels() {
 		}
 
 		// Fill in the melodic channels.
-		output_levels_[3] = VOLUME(melodic_output(0));
-		output_levels_[4] = VOLUME(melodic_output(1));
-		output_levels_[5] = VOLUME(melodic_output(2));
+		update_melodic_channels(6);
+		output_levels_[3] = VOLUME(melodic_channels_.output[0]);
+		output_levels_[4] = VOLUME(melodic_channels_.output[1]);
+		output_levels_[5] = VOLUME(melodic_channels_.output[2]);
 
-		output_levels_[9] = VOLUME(melodic_output(3));
-		output_levels_[10] = VOLUME(melodic_output(4));
-		output_levels_[11] = VOLUME(melodic_output(5));
+		output_levels_[9] = VOLUME(melodic_channels_.output[3]);
+		output_levels_[10] = VOLUME(melodic_channels_.output[4]);
+		output_levels_[11] = VOLUME(melodic_channels_.output[5]);
 
 		// Bass drum, which is a regular FM effect.
 		output_levels_[2] = output_levels_[15] = VOLUME(bass_drum());
@@ -360,17 +361,18 @@ void OPLL::update_all_channels() {
 		output_levels_[6] = output_levels_[7] = output_levels_[8] =
 		output_levels_[12] = output_levels_[13] = output_levels_[14] = 0;
 
-		output_levels_[3] = VOLUME(melodic_output(0));
-		output_levels_[4] = VOLUME(melodic_output(1));
-		output_levels_[5] = VOLUME(melodic_output(2));
+		update_melodic_channels(9);
+		output_levels_[3] = VOLUME(melodic_channels_.output[0]);
+		output_levels_[4] = VOLUME(melodic_channels_.output[1]);
+		output_levels_[5] = VOLUME(melodic_channels_.output[2]);
 
-		output_levels_[9] = VOLUME(melodic_output(3));
-		output_levels_[10] = VOLUME(melodic_output(4));
-		output_levels_[11] = VOLUME(melodic_output(5));
+		output_levels_[9] = VOLUME(melodic_channels_.output[3]);
+		output_levels_[10] = VOLUME(melodic_channels_.output[4]);
+		output_levels_[11] = VOLUME(melodic_channels_.output[5]);
 
-		output_levels_[15] = VOLUME(melodic_output(6));
-		output_levels_[16] = VOLUME(melodic_output(7));
-		output_levels_[17] = VOLUME(melodic_output(8));
+		output_levels_[15] = VOLUME(melodic_channels_.output[6]);
+		output_levels_[16] = VOLUME(melodic_channels_.output[7]);
+		output_levels_[17] = VOLUME(melodic_channels_.output[8]);
 	}
 
 #undef VOLUME
@@ -382,35 +384,34 @@ void OPLL::update_all_channels() {
 
 #define ATTENUATION(x)	((x) << 7)
 
-int OPLL::melodic_output(int channel) {
-	// The modulator always updates after the carrier, oddly enough. So calculate actual output first, based on the modulator's last value.
-	auto carrier = WaveformGenerator<period_precision>::wave(channels_[channel].carrier_waveform, phase_generators_[channel].scaled_phase(), channels_[channel].modulator_output);
-	carrier += envelope_generators_[channel].attenuation() + ATTENUATION(channels_[channel].attenuation) + key_level_scalers_[channel].attenuation();
-
-	// Get the modulator's new value.
-	auto modulation = WaveformGenerator<period_precision>::wave(channels_[channel].modulator_waveform, phase_generators_[channel + 9].phase());
-	modulation += envelope_generators_[channel + 9].attenuation() + (channels_[channel].modulator_attenuation << 5) + key_level_scalers_[channel + 9].attenuation();
+void OPLL::set_fixed_attenuations(int channel) {
+	fixed_attenuations_[channel + 0] = ATTENUATION(channels_[channel].attenuation) + key_level_scalers_[channel + 0].attenuation();
+	fixed_attenuations_[channel + 9] = (channels_[channel].modulator_attenuation << 5) + key_level_scalers_[channel + 9].attenuation();
+}
 
-	// Apply feedback, if any.
-	phase_generators_[channel + 9].apply_feedback(channels_[channel].modulator_output, modulation, channels_[channel].modulator_feedback);
-	channels_[channel].modulator_output = modulation;
+void OPLL::update_melodic_channels(int channels) {
+	for(int c = 0; c < channels; ++c) {
+		melodic_channels_.carrier_attenuation[c] = envelope_generators_[c + 0].attenuation() + fixed_attenuations_[c + 0];
+		melodic_channels_.modulator_attenuation[c] = envelope_generators_[c + 9].attenuation() + fixed_attenuations_[c + 9];
+	}
 
-	return carrier.level();
+	int *const phases = phase_generators_.raw_phases();
+	melodic_channels_.update(channels, phases, phases + 9);
 }
 
 int OPLL::bass_drum() {
 	// Use modulator 6 and carrier 6, attenuated as per the bass-specific envelope generators and the attenuation level for channel 6.
-	auto modulation = WaveformGenerator<period_precision>::wave(Waveform::Sine, phase_generators_[6 + 9].phase());
+	auto modulation = WaveformGenerator<period_precision>::wave(Waveform::Sine, phase_generators_.phase(6 + 9));
 	modulation += rhythm_envelope_generators_[RhythmIndices::BassModulator].attenuation();
 
-	auto carrier = WaveformGenerator<period_precision>::wave(Waveform::Sine, phase_generators_[6].scaled_phase(), modulation);
+	auto carrier = WaveformGenerator<period_precision>::wave(Waveform::Sine, phase_generators_.scaled_phase(6), modulation);
 	carrier += rhythm_envelope_generators_[RhythmIndices::BassCarrier].attenuation() + ATTENUATION(channels_[6].attenuation);
 	return carrier.level();
 }
 
 int OPLL::tom_tom() {
 	// Use modulator 8 and the 'instrument' selection for channel 8 as an attenuation.
-	auto tom_tom = WaveformGenerator<period_precision>::wave(Waveform::Sine, phase_generators_[8 + 9].phase());
+	auto tom_tom = WaveformGenerator<period_precision>::wave(Waveform::Sine, phase_generators_.phase(8 + 9));
 	tom_tom += rhythm_envelope_generators_[RhythmIndices::TomTom].attenuation();
 	tom_tom += ATTENUATION(channels_[8].instrument);
 	return tom_tom.level();
@@ -418,7 +419,7 @@ int OPLL::tom_tom() {
 
 int OPLL::snare_drum() {
 	// Use modulator 7 and the carrier attenuation level for channel 7.
-	LogSign snare = WaveformGenerator<period_precision>::snare(oscillator_, phase_generators_[7 + 9].phase());
+	LogSign snare = WaveformGenerator<period_precision>::snare(oscillator_, phase_generators_.phase(7 + 9));
 	snare += rhythm_envelope_generators_[RhythmIndices::Snare].attenuation();
 	snare += ATTENUATION(channels_[7].attenuation);
 	return snare.level();
@@ -426,7 +427,7 @@ int OPLL::snare_drum() {
 
 int OPLL::cymbal() {
 	// Use modulator 7, carrier 8 and the attenuation level for channel 8.
-	LogSign cymbal = WaveformGenerator<period_precision>::cymbal(phase_generators_[8].phase(), phase_generators_[7 + 9].phase());
+	LogSign cymbal = WaveformGenerator<period_precision>::cymbal(phase_generators_.phase(8), phase_generators_.phase(7 + 9));
 	cymbal += rhythm_envelope_generators_[RhythmIndices::Cymbal].attenuation();
 	cymbal += ATTENUATION(channels_[8].attenuation);
 	return cymbal.level();
@@ -434,7 +435,7 @@ int OPLL::cymbal() {
 
 int OPLL::high_hat() {
 	// Use modulator 7, carrier 8 a and the 'instrument' selection for channel 7 as an attenuation.
-	LogSign high_hat = WaveformGenerator<period_precision>::high_hat(oscillator_, phase_generators_[8].phase(), phase_generators_[7 + 9].phase());
+	LogSign high_hat = WaveformGenerator<period_precision>::high_hat(oscillator_, phase_generators_.phase(8), phase_generators_.phase(7 + 9));
 	high_hat += rhythm_envelope_generators_[RhythmIndices::HighHat].attenuation();
 	high_hat += ATTENUATION(channels_[7].instrument);
 	return high_hat.level();
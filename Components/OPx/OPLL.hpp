@@ -14,6 +14,7 @@
 #include "Implementation/KeyLevelScaler.hpp"
 #include "Implementation/PhaseGenerator.hpp"
 #include "Implementation/LowFrequencyOscillator.hpp"
+#include "Implementation/MelodicBank.hpp"
 #include "Implementation/WaveformGenerator.hpp"
 
 #include <atomic>
@@ -48,7 +49,7 @@ class OPLL: public OPLBase<OPLL> {
 		int16_t output_levels_[18];
 		void update_all_channels();
 
-		int melodic_output(int channel);
+		void update_melodic_channels(int channels);
 		int bass_drum();
 		int tom_tom();
 		int snare_drum();
@@ -65,10 +66,16 @@ class OPLL: public OPLBase<OPLL> {
 		//		[x], 0 <= x < 9		= carrier for channel x;
 		//		[x+9]				= modulator for channel x.
 		//
-		PhaseGenerator<period_precision> phase_generators_[18];
+		PhaseGeneratorBank<period_precision, 18> phase_generators_;
 		EnvelopeGenerator<envelope_precision, period_precision> envelope_generators_[18];
 		KeyLevelScaler<period_precision> key_level_scalers_[18];
 
+		// Attenuation from all sources other than envelope generators, indexed as above.
+		int fixed_attenuations_[18]{};
+
+		// Carrier and modulator evaluation for the melodic channels.
+		MelodicBank<period_precision, 9> melodic_channels_;
+
 		// Dedicated rhythm envelope generators and attenuations.
 		EnvelopeGenerator<envelope_precision, period_precision> rhythm_envelope_generators_[6];
 		enum RhythmIndices {
@@ -89,15 +96,9 @@ class OPLL: public OPLBase<OPLL> {
 			int attenuation = 0;
 			int modulator_attenuation = 0;
 
-			Waveform carrier_waveform = Waveform::Sine;
-			Waveform modulator_waveform = Waveform::Sine;
-
 			int carrier_key_rate_scale_multiplier = 0;
 			int modulator_key_rate_scale_multiplier = 0;
 
-			LogSign modulator_output;
-			int modulator_feedback = 0;
-
 			bool use_sustain = false;
 		} channels_[9];
 
@@ -117,6 +118,10 @@ class OPLL: public OPLBase<OPLL> {
 		/// Installs the appropriate instrument on channel @c channel.
 		void install_instrument(int channel);
 
+		/// Updates the fixed attenuations of channel @c channel's operators, following a change in
+		/// attenuation, instrument or period.
+		void set_fixed_attenuations(int channel);
+
 		/// Sets whether the sustain level is used for channel @c channel based on its current instrument
 		/// and the user's selection.
 		void set_use_sustain(int channel);
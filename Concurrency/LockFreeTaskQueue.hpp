@@ -0,0 +1,365 @@
+//
+//  LockFreeTaskQueue.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 16/10/2026.
+//  Copyright 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef LockFreeTaskQueue_hpp
+#define LockFreeTaskQueue_hpp
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#include "AsyncTaskQueue.hpp"
+
+namespace Concurrency {
+
+/*!
+	A type-erased @c void(void) callable that keeps its target in a fixed-size inline buffer
+	rather than on the heap.
+
+	Targets larger than @c size bytes are rejected at compile time; capture a pointer to
+	any larger state instead.
+*/
+template <size_t size> class InplaceAction {
+	public:
+		InplaceAction() = default;
+		InplaceAction(const InplaceAction &) = delete;
+		InplaceAction &operator =(const InplaceAction &) = delete;
+
+		~InplaceAction() {
+			reset();
+		}
+
+		/// Sets @c func as the target of this action, destroying any previous target.
+		template <typename FuncT> void set(FuncT &&func) {
+			using TargetT = std::decay_t<FuncT>;
+			static_assert(sizeof(TargetT) <= size, "Action is too large to be stored inline");
+			static_assert(alignof(TargetT) <= alignof(std::max_align_t), "Action is over-aligned");
+
+			reset();
+			new (storage_) TargetT(std::forward<FuncT>(func));
+			perform_ = [] (void *target) {
+				(*static_cast<TargetT *>(target))();
+			};
+			destroy_ = [] (void *target) {
+				static_cast<TargetT *>(target)->~TargetT();
+			};
+		}
+
+		/// Destroys the current target, if any.
+		void reset() {
+			if(destroy_) {
+				destroy_(storage_);
+				destroy_ = nullptr;
+				perform_ = nullptr;
+			}
+		}
+
+		/// Performs the current target. Undefined if there is no target.
+		void operator()() {
+			perform_(storage_);
+		}
+
+	private:
+		alignas(std::max_align_t) std::byte storage_[size];
+		void (*perform_)(void *) = nullptr;
+		void (*destroy_)(void *) = nullptr;
+};
+
+/*!
+	Provides the same interface and guarantees as AsyncTaskQueue, but posts actions through a bounded,
+	lock-free ring rather than a mutex-guarded vector of std::functions.
+
+	Any number of threads may enqueue; actions are performed serially on the queue's own thread.
+	Enqueuing never allocates: actions are stored inline in ring slots of @c action_size bytes. If the
+	ring is full then enqueuing spins until the queue's thread has made space; if @c perform_automatically
+	is false then doing so also schedules everything enqueued so far, as if @c perform() had been called.
+
+	The queue's thread waits adaptively: it spins for a while in anticipation of further work, and parks
+	on a condition variable only if none arrives. The length of the spin grows when spinning proves
+	fruitful and shrinks when it doesn't, so bursty producers are served without context switches
+	and idle queues don't burn a core. On a single-core host it never spins, as doing so could only
+	delay the producer.
+
+	@c capacity must be a power of two.
+*/
+template <
+	bool perform_automatically,
+	bool start_immediately = true,
+	typename Performer = void,
+	size_t capacity = 2048,
+	size_t action_size = 48
+> class LockFreeTaskQueue: public TaskQueueStorage<Performer> {
+	static_assert(capacity && !(capacity & (capacity - 1)), "Capacity must be a power of two");
+
+	public:
+		template <typename... Args> LockFreeTaskQueue(Args&&... args) :
+			TaskQueueStorage<Performer>(std::forward<Args>(args)...) {
+			for(size_t c = 0; c < capacity; ++c) {
+				slots_[c].sequence.store(c, std::memory_order_relaxed);
+			}
+
+			if constexpr (start_immediately) {
+				start();
+			}
+		}
+
+		/// Enqueues @c post_action to be performed asynchronously at some point
+		/// in the future. If @c perform_automatically is @c true then the action
+		/// will be performed as soon as possible. Otherwise it will sit unscheduled until
+		/// a call to @c perform().
+		///
+		/// If this TaskQueue has a @c Performer then the action will be performed
+		/// on the same thread as the performer, after the performer has been updated
+		/// to 'now'.
+		template <typename FuncT> void enqueue(FuncT &&post_action) {
+			while(!try_enqueue(std::forward<FuncT>(post_action))) {
+				// The ring is full; make sure the queue's thread is draining it
+				// even if nobody has yet asked for that, then give it time to do so.
+				perform();
+				std::this_thread::yield();
+			}
+
+			if constexpr (perform_automatically) {
+				wake(false);
+			}
+		}
+
+		/// Causes any enqueued actions that are not yet scheduled to be scheduled.
+		/// Actions enqueued after this call remain unscheduled until the next.
+		void perform() {
+			if constexpr (!perform_automatically) {
+				const size_t position = enqueue_position_.load(std::memory_order_acquire);
+				size_t scheduled = scheduled_position_.load(std::memory_order_relaxed);
+				while(
+					intptr_t(position - scheduled) > 0 &&
+					!scheduled_position_.compare_exchange_weak(scheduled, position, std::memory_order_release)
+				);
+			}
+			wake(true);
+		}
+
+		/// Permanently stops this task queue, blocking until that has happened.
+		/// All pending actions will be performed first.
+		///
+		/// The queue cannot be restarted; this is a destructive action.
+		void stop() {
+			if(thread_.joinable()) {
+				should_quit_ = true;
+				wake(true);
+				thread_.join();
+			}
+		}
+
+		/// Starts the queue if it has never been started before.
+		///
+		/// This is not guaranteed safely to restart a stopped queue.
+		void start() {
+			thread_ = std::thread{
+				[this] {
+					while(!should_quit_) {
+						wait();
+
+						// Update to now (which is possibly a no-op).
+						TaskQueueStorage<Performer>::update();
+						if constexpr (perform_automatically) {
+							drain();
+						} else {
+							drain(scheduled_position_.load(std::memory_order_acquire));
+						}
+					}
+
+					// Perform anything that was enqueued prior to the request to stop.
+					drain();
+				}
+			};
+		}
+
+		/// Schedules any remaining unscheduled work, then blocks synchronously
+		/// until all scheduled work has been performed.
+		void flush() {
+			std::mutex flush_mutex;
+			std::condition_variable flush_condition;
+			bool has_run = false;
+			std::unique_lock lock(flush_mutex);
+
+			enqueue([&flush_mutex, &flush_condition, &has_run] () {
+				std::unique_lock inner_lock(flush_mutex);
+				has_run = true;
+				flush_condition.notify_all();
+			});
+
+			if constexpr (!perform_automatically) {
+				perform();
+			}
+
+			flush_condition.wait(lock, [&has_run] { return has_run; });
+		}
+
+		~LockFreeTaskQueue() {
+			stop();
+		}
+
+	private:
+		// Ring slots follow Dmitry Vyukov's bounded queue: each slot's sequence number
+		// indicates whether it is free for the producer claiming position n (sequence == n),
+		// or holds an action ready for the consumer at position n (sequence == n + 1).
+		struct Slot {
+			std::atomic<size_t> sequence;
+			InplaceAction<action_size> action;
+		};
+		std::array<Slot, capacity> slots_;
+		static constexpr size_t Mask = capacity - 1;
+
+		alignas(64) std::atomic<size_t> enqueue_position_ = 0;
+		alignas(64) size_t dequeue_position_ = 0;		// Accessed only by the queue's thread.
+
+		// If actions aren't performed automatically, the position up to which
+		// they have been scheduled by calls to perform().
+		std::atomic<size_t> scheduled_position_ = 0;
+
+		template <typename FuncT> bool try_enqueue(FuncT &&post_action) {
+			size_t position = enqueue_position_.load(std::memory_order_relaxed);
+			Slot *slot;
+			while(true) {
+				slot = &slots_[position & Mask];
+				const size_t sequence = slot->sequence.load(std::memory_order_acquire);
+				const auto difference = intptr_t(sequence) - intptr_t(position);
+
+				if(!difference) {
+					if(enqueue_position_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+						break;
+					}
+				} else if(difference < 0) {
+					return false;
+				} else {
+					position = enqueue_position_.load(std::memory_order_relaxed);
+				}
+			}
+
+			slot->action.set(std::forward<FuncT>(post_action));
+			slot->sequence.store(position + 1, std::memory_order_release);
+			return true;
+		}
+
+		bool has_action() const {
+			return slots_[dequeue_position_ & Mask].sequence.load(std::memory_order_acquire) == dequeue_position_ + 1;
+		}
+
+		void perform_next() {
+			Slot &slot = slots_[dequeue_position_ & Mask];
+			slot.action();
+			slot.action.reset();
+			slot.sequence.store(dequeue_position_ + capacity, std::memory_order_release);
+			++dequeue_position_;
+		}
+
+		/// Performs all actions that are ready.
+		void drain() {
+			while(has_action()) {
+				perform_next();
+			}
+		}
+
+		/// Performs all actions prior to position @c limit, waiting for any that
+		/// have been claimed by a producer but not yet stored.
+		void drain(size_t limit) {
+			while(intptr_t(limit - dequeue_position_) > 0) {
+				while(!has_action()) {
+					relax();
+				}
+				perform_next();
+			}
+		}
+
+		// Wake-up logic: the queue's thread has work to do either if there's anything in
+		// the ring and actions are performed automatically, or if perform() has been called.
+		std::atomic<bool> should_quit_ = false;
+		std::atomic<bool> perform_requested_ = false;
+		std::atomic<bool> is_parked_ = false;
+		std::mutex park_mutex_;
+		std::condition_variable park_condition_;
+
+		static constexpr int MinSpins = 16;
+		static constexpr int MaxSpins = 16384;
+		const bool should_spin_ = std::thread::hardware_concurrency() != 1;
+		int spin_limit_ = 1024;		// Accessed only by the queue's thread.
+
+		bool has_work() {
+			if(should_quit_.load(std::memory_order_relaxed)) {
+				return true;
+			}
+			if constexpr (perform_automatically) {
+				return has_action();
+			} else {
+				return perform_requested_.exchange(false, std::memory_order_acquire);
+			}
+		}
+
+		void wake(bool request_perform) {
+			if(request_perform) {
+				perform_requested_.store(true, std::memory_order_release);
+			}
+
+			// Pairs with the fence in wait(): either this thread sees that the queue's thread
+			// is parked, or the queue's thread sees the new work before parking. Only the first
+			// thread to spot a parked queue need notify it.
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			if(is_parked_.load(std::memory_order_relaxed) && is_parked_.exchange(false, std::memory_order_relaxed)) {
+				std::lock_guard lock(park_mutex_);
+				park_condition_.notify_one();
+			}
+		}
+
+		void wait() {
+			if(should_spin_) {
+				for(int spin = 0; spin < spin_limit_; ++spin) {
+					if(has_work()) {
+						spin_limit_ = std::min(spin_limit_ * 2, MaxSpins);
+						return;
+					}
+					relax();
+				}
+				spin_limit_ = std::max(spin_limit_ / 2, MinSpins);
+			}
+
+			std::unique_lock lock(park_mutex_);
+			while(true) {
+				is_parked_.store(true, std::memory_order_relaxed);
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+				if(has_work()) break;
+				park_condition_.wait(lock);
+			}
+			is_parked_.store(false, std::memory_order_relaxed);
+		}
+
+		static void relax() {
+			#if defined(__x86_64__) || defined(__i386__)
+				__builtin_ia32_pause();
+			#elif defined(__aarch64__)
+				asm volatile("yield");
+			#else
+				std::this_thread::yield();
+			#endif
+		}
+
+		// Ensure the thread isn't constructed until after the ring and
+		// synchronisation primitives.
+		std::thread thread_;
+};
+
+}
+
+#endif /* LockFreeTaskQueue_hpp */
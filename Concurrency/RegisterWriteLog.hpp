@@ -0,0 +1,107 @@
+//
+//  RegisterWriteLog.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 16/10/2026.
+//  Copyright 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef RegisterWriteLog_hpp
+#define RegisterWriteLog_hpp
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+
+namespace Concurrency {
+
+/*!
+	A single register write, as recorded by a RegisterWriteLog: at @c time, @c value was written
+	to @c address of the chip identified by @c chip.
+*/
+struct RegisterWrite {
+	uint64_t time;
+	uint16_t address;
+	uint8_t value;
+	uint8_t chip;
+};
+
+/*!
+	A fixed-size, single-producer, single-consumer ring of timestamped register writes.
+
+	This is intended as an alternative to posting a closure per write to an AsyncTaskQueue:
+	the emulation thread advances the log's clock and pushes writes, and the audio thread
+	later replays them at their proper times, e.g. via Outputs::Speaker::ReplayingSource.
+	Nothing is allocated after construction.
+
+	If the ring is full then push spins until the consumer has made space; the owner must
+	therefore ensure that the consumer is periodically given the opportunity to run, using
+	@c size to spot when that is becoming urgent.
+
+	Times are in whatever units the producer and consumer agree upon, usually cycles of
+	the consuming speaker's input clock. @c capacity must be a power of two.
+*/
+template <size_t capacity = 8192> class RegisterWriteLog {
+	static_assert(capacity && !(capacity & (capacity - 1)), "Capacity must be a power of two");
+
+	public:
+		// MARK: - Producer interface.
+
+		/// Advances the time that will be attached to subsequent writes by @c cycles.
+		void advance(uint64_t cycles) {
+			time_ += cycles;
+		}
+
+		/// @returns The time that will be attached to the next write.
+		uint64_t time() const {
+			return time_;
+		}
+
+		/// Records a write of @c value to @c address on @c chip, at the current time.
+		void push(uint8_t chip, uint16_t address, uint8_t value) {
+			const size_t write = write_position_.load(std::memory_order_relaxed);
+			while(write - read_position_.load(std::memory_order_acquire) == capacity) {
+				std::this_thread::yield();
+			}
+
+			writes_[write & Mask] = RegisterWrite{time_, address, value, chip};
+			write_position_.store(write + 1, std::memory_order_release);
+		}
+
+		/// @returns The number of writes that have been pushed but not yet consumed.
+		size_t size() const {
+			return write_position_.load(std::memory_order_relaxed) - read_position_.load(std::memory_order_relaxed);
+		}
+
+		static constexpr size_t Capacity = capacity;
+
+		// MARK: - Consumer interface.
+
+		/// @returns The oldest unconsumed write, or @c nullptr if there is none.
+		const RegisterWrite *front() const {
+			const size_t read = read_position_.load(std::memory_order_relaxed);
+			if(read == write_position_.load(std::memory_order_acquire)) {
+				return nullptr;
+			}
+			return &writes_[read & Mask];
+		}
+
+		/// Discards the write most recently returned by @c front.
+		void pop() {
+			read_position_.store(read_position_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+		}
+
+	private:
+		static constexpr size_t Mask = capacity - 1;
+		std::array<RegisterWrite, capacity> writes_;
+
+		alignas(64) std::atomic<size_t> write_position_ = 0;
+		uint64_t time_ = 0;			// Accessed only by the producer.
+		alignas(64) std::atomic<size_t> read_position_ = 0;
+};
+
+}
+
+#endif /* RegisterWriteLog_hpp */
@@ -0,0 +1,207 @@
+//
+//  WorkerPool.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 16/10/2026.
+//  Copyright 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef WorkerPool_hpp
+#define WorkerPool_hpp
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Concurrency {
+
+/*!
+	A fixed set of worker threads that cooperate with the calling thread to perform
+	a batch of independent, indexed tasks and then rendezvous.
+
+	Each participant — the calling thread plus each worker — has a home list of tasks, being
+	every task whose index modulo the number of participants equals its own, so that repeated
+	batches of the same shape tend to perform each task on the same thread. Participants that
+	exhaust their home lists steal unclaimed tasks from the lists of others.
+
+	Claiming a task is a single atomic increment. So the costs per batch are one wake-up of the
+	workers and, if the calling thread finishes first, one wait for the last task.
+*/
+class WorkerPool {
+	public:
+		/*!
+			Creates a pool with @c workers threads in addition to whichever thread
+			calls @c parallel_for. A pool with no workers performs all tasks on the calling thread.
+		*/
+		WorkerPool(size_t workers) : cursors_(std::make_unique<Cursor[]>(workers + 1)) {
+			threads_.reserve(workers);
+			for(size_t c = 0; c < workers; ++c) {
+				threads_.emplace_back([this, c] { work(c + 1); });
+			}
+		}
+
+		~WorkerPool() {
+			{
+				std::lock_guard lock(mutex_);
+				should_quit_ = true;
+			}
+			start_condition_.notify_all();
+			for(auto &thread: threads_) {
+				thread.join();
+			}
+		}
+
+		/// @returns The number of threads that may perform tasks, including the caller.
+		size_t participants() const {
+			return threads_.size() + 1;
+		}
+
+		/*!
+			Calls @c function(index) once for each index in [0, @c count), across the pool,
+			returning only once all calls have completed.
+
+			Tasks are performed in no particular order; @c function must be safe to call
+			concurrently for different indices. The calling thread performs tasks too, always
+			starting with task 0.
+		*/
+		template <typename FunctionT> void parallel_for(size_t count, const FunctionT &function) {
+			if(threads_.empty() || count < 2) {
+				for(size_t c = 0; c < count; ++c) {
+					function(c);
+				}
+				return;
+			}
+
+			// Publish the job.
+			{
+				std::lock_guard lock(mutex_);
+				job_.perform = [] (const void *context, size_t index) {
+					(*static_cast<const FunctionT *>(context))(index);
+				};
+				job_.context = &function;
+				job_.count = count;
+				for(size_t c = 0; c < participants(); ++c) {
+					cursors_[c].next.store(0, std::memory_order_relaxed);
+				}
+
+				// Reserve task 0 for the caller.
+				cursors_[0].next.store(1, std::memory_order_relaxed);
+				remaining_.store(count, std::memory_order_relaxed);
+				is_open_ = true;
+				++generation_;
+			}
+			start_condition_.notify_all();
+
+			// Participate.
+			function(0);
+			perform(job_, 0, 1);
+
+			// Wait for the final task to complete, spinning briefly on the assumption that it
+			// is close to done before blocking.
+			for(int spin = 0; spin < 1024 && remaining_.load(std::memory_order_acquire); ++spin) {
+				std::this_thread::yield();
+			}
+
+			// Close the job to late-waking workers, and wait for any that did join to leave;
+			// thereafter nothing can reference function.
+			std::unique_lock lock(mutex_);
+			is_open_ = false;
+			done_condition_.wait(lock, [this] {
+				return !remaining_.load(std::memory_order_acquire) && !active_workers_;
+			});
+		}
+
+	private:
+		struct Job {
+			void (*perform)(const void *, size_t) = nullptr;
+			const void *context = nullptr;
+			size_t count = 0;
+		} job_;
+
+		struct alignas(64) Cursor {
+			/// The number of tasks so far claimed from this participant's home list.
+			std::atomic<size_t> next = 0;
+		};
+		std::unique_ptr<Cursor[]> cursors_;
+		std::atomic<size_t> remaining_ = 0;
+
+		// Guarded by mutex_.
+		std::mutex mutex_;
+		std::condition_variable start_condition_, done_condition_;
+		uint64_t generation_ = 0;
+		size_t active_workers_ = 0;
+		bool is_open_ = false;
+		bool should_quit_ = false;
+
+		std::vector<std::thread> threads_;
+
+		/// Claims the next task from @c owner's home list, if any remains, storing its index to @c index.
+		bool claim(size_t owner, size_t count, size_t &index) {
+			const size_t stride = participants();
+			if(owner >= count) return false;
+
+			const size_t home_count = (count - owner + stride - 1) / stride;
+			if(cursors_[owner].next.load(std::memory_order_relaxed) >= home_count) return false;
+
+			const size_t claimed = cursors_[owner].next.fetch_add(1, std::memory_order_relaxed);
+			if(claimed >= home_count) return false;
+
+			index = owner + claimed * stride;
+			return true;
+		}
+
+		/// Performs tasks from @c self's home list, then steals from all others, until none remain;
+		/// @c completed is the number of tasks already performed by this participant outside of this call.
+		void perform(const Job &job, size_t self, size_t completed = 0) {
+			size_t index;
+			for(size_t offset = 0; offset < participants(); ++offset) {
+				const size_t owner = (self + offset) % participants();
+				while(claim(owner, job.count, index)) {
+					job.perform(job.context, index);
+					++completed;
+				}
+			}
+
+			if(completed && remaining_.fetch_sub(completed, std::memory_order_acq_rel) == completed) {
+				// This was the final batch; make sure the caller is woken if blocked.
+				std::lock_guard lock(mutex_);
+				done_condition_.notify_all();
+			}
+		}
+
+		void work(size_t self) {
+			uint64_t generation = 0;
+			while(true) {
+				Job job;
+				{
+					std::unique_lock lock(mutex_);
+					start_condition_.wait(lock, [&] {
+						return should_quit_ || (is_open_ && generation_ != generation);
+					});
+					if(should_quit_) return;
+
+					generation = generation_;
+					job = job_;
+					++active_workers_;
+				}
+
+				perform(job, self);
+
+				{
+					std::lock_guard lock(mutex_);
+					--active_workers_;
+				}
+				done_condition_.notify_all();
+			}
+		}
+};
+
+}
+
+#endif /* WorkerPool_hpp */
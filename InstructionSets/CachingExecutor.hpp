@@ -11,6 +11,7 @@
 
 #include "../Numeric/Sizes.hpp"
 
+#include <algorithm>
 #include <array>
 #include <cstdint>
 #include <limits>
@@ -18,6 +19,7 @@
 #include <map>
 #include <queue>
 #include <unordered_map>
+#include <vector>
 
 namespace InstructionSet {
 
@@ -29,6 +31,14 @@ namespace InstructionSet {
 	costs sit behind using the C ABI for calling. Since there'll always be exactly one parameter, being the specific executor,
 	hopefully the calling costs are acceptable.
 
+	Translated code is cached by page: each page holds the performer sequences for every entry point within it that has
+	so far been branched to, each sequence ending when the parser finds a terminating instruction or the first
+	instruction to begin beyond the end of the page. Up to @c max_cached_pages are retained; beyond that the least-recently
+	entered page is discarded.
+
+	Specific executors should call @c invalidate for any write that might modify code, and @c invalidate_all
+	for any wholesale change to memory.
+
 	Intended usage is for specific executors to subclass from this and declare it a friend.
 
 	TODO: determine promises re: interruption, amongst other things.
@@ -43,24 +53,43 @@ template <
 	/// Provides the type of Instruction to expect.
 	typename InstructionType,
 	/// Indicates whether instructions should be treated as ephemeral or included in the cache.
-	bool retain_instructions
+	bool retain_instructions,
+	/// Indicates the maximum length of a single instruction, in the same units as the program counter.
+	uint64_t max_instruction_length
 > class CachingExecutor {
 	public:
 		using Performer = void (Executor::*)();
-		using PerformerIndex = typename MinIntTypeValue<max_performer_count>::type;
+		using PerformerIndex = typename MinIntTypeValue<max_performer_count + 1>::type;
 		using ProgramCounterType = typename MinIntTypeValue<max_address>::type;
 
+		CachingExecutor() {
+			performers_[ContinuationPerformer] = &CachingExecutor::continue_at_program_counter;
+			for(auto &page: pages_) {
+				free_pages_.push_back(&page);
+			}
+		}
+
+		// Pages are tracked by pointer, so a copy would refer to the original's pages.
+		CachingExecutor(const CachingExecutor &) = delete;
+		CachingExecutor &operator =(const CachingExecutor &) = delete;
+
 		// MARK: - Parser call-ins.
 
 		void announce_overflow(ProgramCounterType) {
-			/*
-				Should be impossible for now; this is intended to provide information
-				when page caching.
-			*/
+			// Overflow implies an instruction that runs beyond the closing bound, which is
+			// always at least one instruction's length after the end of the page being
+			// translated; there's therefore nothing to do.
 		}
-		void announce_instruction(ProgramCounterType, InstructionType instruction) {
+		void announce_instruction(ProgramCounterType address, InstructionType instruction) {
+			// Instructions that begin beyond the current page are the responsibility
+			// of the sequence that will be entered when execution reaches them.
+			if(!translation_ || address > translation_bound_) {
+				translation_ = nullptr;
+				return;
+			}
+
 			// Dutifully map the instruction to a performer and keep it.
-			program_.push_back(static_cast<Executor *>(this)->action_for(instruction));
+			translation_->push_back(static_cast<Executor *>(this)->action_for(instruction));
 
 			if constexpr (retain_instructions) {
 				// TODO.
@@ -72,7 +101,9 @@ template <
 		// Storage for the statically-allocated list of performers. It's a bit more
 		// work for executors to fill this array, but subsequently performers can be
 		// indexed by array position, which is a lot more compact than a generic pointer.
-		std::array<Performer, max_performer_count+1> performers_;
+		//
+		// The final entry is reserved for the performer that links one sequence to the next.
+		std::array<Performer, max_performer_count+2> performers_;
 		ProgramCounterType program_counter_;
 
 		/*!
@@ -85,18 +116,42 @@ template <
 			has_branched_ = true;
 			program_counter_ = address;
 
-			// Temporary implementation: just interpret.
-			program_.clear();
+			Page &page = find_page(address);
+			auto entry = page.entry_points.find(address);
+			if(entry == page.entry_points.end()) {
+				entry = page.entry_points.emplace(address, std::vector<PerformerIndex>()).first;
+				translate(address, entry->second);
+			}
+
+			program_ = entry->second.data();
 			program_index_ = 0;
-			static_cast<Executor *>(this)->parse(address, ProgramCounterType(max_address));
-
-//			const auto page = find_page(address);
-//			const auto entry = page->entry_points.find(address);
-//			if(entry == page->entry_points.end()) {
-//				// Requested segment wasn't found; check whether it was
-//				// within the recently translated list and otherwise
-//				// translate it.
-//			}
+			needs_resync_ = false;
+		}
+
+		/*!
+			Discards any translations that might include @c address, which is about to be
+			or has just been modified.
+		*/
+		void invalidate(ProgramCounterType address) {
+			// Fast exit for the common case of nothing being cached.
+			if(cached_pages_.empty()) return;
+
+			const auto page_address = ProgramCounterType(address >> PageShift);
+			invalidate_page(page_address);
+
+			// An instruction that starts at the end of the previous page may extend into this one.
+			if((address & PageMask) < max_instruction_length - 1 && page_address) {
+				invalidate_page(page_address - 1);
+			}
+		}
+
+		/*!
+			Discards all translations.
+		*/
+		void invalidate_all() {
+			while(!touched_pages_.empty()) {
+				invalidate_page(touched_pages_.back());
+			}
 		}
 
 		/*!
@@ -111,10 +166,14 @@ template <
 		*/
 		void run_to_branch() {
 			has_branched_ = false;
-			for(auto index: program_) {
-				const auto performer = performers_[index];
-				(static_cast<Executor *>(this)->*performer)();
-				if(has_branched_) break;
+			resync();
+
+			Executor *const executor = static_cast<Executor *>(this);
+			while(!has_branched_) {
+				const auto performer = performers_[program_[program_index_]];
+				++program_index_;
+
+				(executor->*performer)();
 			}
 		}
 
@@ -128,6 +187,8 @@ template <
 
 			while(remaining_duration_ > 0) {
 				has_branched_ = false;
+				resync();
+
 				Executor *const executor = static_cast<Executor *>(this);
 				while(remaining_duration_ > 0 && !has_branched_) {
 					const auto performer = performers_[program_[program_index_]];
@@ -149,50 +210,119 @@ template <
 	private:
 		bool has_branched_ = false;
 		int remaining_duration_ = 0;
-		std::vector<PerformerIndex> program_;
+		const PerformerIndex *program_ = nullptr;
 		size_t program_index_ = 0;
 
-		/* TODO: almost below here can be shoved off into an LRUCache object, or similar. */
+		// Indicates that the sequence currently being executed has been discarded,
+		// so execution should resume via a fresh lookup of the program counter.
+		bool needs_resync_ = false;
 
-//		static constexpr size_t max_cached_pages = 64;
+		static constexpr PerformerIndex ContinuationPerformer = PerformerIndex(max_performer_count + 1);
 
-//		struct Page {
-//			std::map<ProgramCounterType, PerformerIndex> entry_points;
+		/*!
+			Appended to every translated sequence; picks up wherever execution has flowed to
+			without a branch, which will be the start of an instruction on a subsequent page.
+		*/
+		void continue_at_program_counter() {
+			set_program_counter(program_counter_);
+		}
+
+		void resync() {
+			if(needs_resync_) {
+				needs_resync_ = false;
+				set_program_counter(program_counter_);
+				has_branched_ = false;
+			}
+		}
+
+		// MARK: - Translation.
+
+		ProgramCounterType translation_bound_ = 0;
+		std::vector<PerformerIndex> *translation_ = nullptr;
+
+		void translate(ProgramCounterType address, std::vector<PerformerIndex> &destination) {
+			translation_ = &destination;
+			translation_bound_ = ProgramCounterType(address | PageMask);
+
+			// Parse far enough to include an instruction that begins at the very end of the page.
+			const auto closing_bound =
+				ProgramCounterType(std::min(uint64_t(translation_bound_) + max_instruction_length - 1, max_address));
+			static_cast<Executor *>(this)->parse(address, closing_bound);
+
+			destination.push_back(ContinuationPerformer);
+			translation_ = nullptr;
+		}
 
-			// TODO: can I statically these two? Should I?
-//			std::vector<PerformerIndex> actions_;
-//			std::vector<typename std::enable_if<!std::is_same<InstructionType, void>::value, InstructionType>::type> instructions_;
-//		};
-//		std::array<Page, max_cached_pages> pages_;
+		// MARK: - Page cache.
+
+		static constexpr int PageShift = 8;
+		static constexpr ProgramCounterType PageMask = (1 << PageShift) - 1;
+		static constexpr size_t max_cached_pages = 64;
+
+		struct Page {
+			std::unordered_map<ProgramCounterType, std::vector<PerformerIndex>> entry_points;
+			typename std::list<ProgramCounterType>::iterator lru_position;
+		};
+		std::array<Page, max_cached_pages> pages_;
+		std::vector<Page *> free_pages_;
 
 		// Maps from page numbers to pages.
-//		std::unordered_map<ProgramCounterType, Page *> cached_pages_;
+		std::unordered_map<ProgramCounterType, Page *> cached_pages_;
 
-		// Maintains an LRU of recently-used pages in case of a need for reuse.
-//		std::list<ProgramCounterType> touched_pages_;
+		// Maintains an LRU of recently-used pages in case of a need for reuse;
+		// the most-recently used is at the front.
+		std::list<ProgramCounterType> touched_pages_;
 
 		/*!
 			Finds or creates the page that contains @c address.
 		*/
-/*		Page *find_page(ProgramCounterType address) {
-			// TODO: are 1kb pages always appropriate? Is 64 the correct amount to keep?
-			const auto page_address = ProgramCounterType(address >> 10);
+		Page &find_page(ProgramCounterType address) {
+			const auto page_address = ProgramCounterType(address >> PageShift);
+
+			const auto cached = cached_pages_.find(page_address);
+			if(cached != cached_pages_.end()) {
+				// Page was found; LRU shuffle it.
+				Page *const page = cached->second;
+				touched_pages_.splice(touched_pages_.begin(), touched_pages_, page->lru_position);
+				return *page;
+			}
+
+			// Page wasn't found; either use a free one or
+			// reuse the least-recently used.
+			if(free_pages_.empty()) {
+				invalidate_page(touched_pages_.back());
+			}
+
+			Page *const page = free_pages_.back();
+			free_pages_.pop_back();
+
+			touched_pages_.push_front(page_address);
+			page->lru_position = touched_pages_.begin();
+			cached_pages_[page_address] = page;
+			return *page;
+		}
 
-			auto page = cached_pages_.find(page_address);
-			if(page == cached_pages_.end()) {
-				// Page wasn't found; either allocate a new one or
-				// reuse one that already exists.
-				if(cached_pages_.size() == max_cached_pages) {
+		void invalidate_page(ProgramCounterType page_address) {
+			const auto cached = cached_pages_.find(page_address);
+			if(cached == cached_pages_.end()) return;
 
-				} else {
+			Page *const page = cached->second;
 
+			// If the sequence currently being executed is about to be discarded then
+			// stop executing it once the current performer is complete.
+			for(const auto &entry: page->entry_points) {
+				if(entry.second.data() == program_) {
+					program_ = nullptr;
+					has_branched_ = needs_resync_ = true;
+					break;
 				}
-			} else {
-				// Page was found; LRU shuffle it.
 			}
 
-			return nullptr;
-		}*/
+			page->entry_points.clear();
+			touched_pages_.erase(page->lru_position);
+			cached_pages_.erase(cached);
+			free_pages_.push_back(page);
+		}
 };
 
 }
@@ -47,6 +47,7 @@ void Executor::set_rom(const std::vector<uint8_t> &rom) {
 	// Copy into place, and reset.
 	const auto length = std::min(size_t(0x1000), rom.size());
 	memcpy(&memory_[0x2000 - length], rom.data(), length);
+	invalidate_all();
 	reset();
 }
 
@@ -128,9 +129,10 @@ void Executor::set_port_output(int port) {
 void Executor::write(uint16_t address, uint8_t value) {
 	address &= 0x1fff;
 
-	// RAM writes are easy.
+	// RAM writes are easy, other than that they may modify code.
 	if(address < 0x60) {
 		memory_[address] = value;
+		invalidate(address);
 		return;
 	}
 
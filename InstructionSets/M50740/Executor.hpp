@@ -22,7 +22,7 @@ namespace InstructionSet {
 namespace M50740 {
 
 class Executor;
-using CachingExecutor = CachingExecutor<Executor, 0x1fff, 255, Instruction, false>;
+using CachingExecutor = CachingExecutor<Executor, 0x1fff, 255, Instruction, false, 3>;
 
 struct PortHandler {
 	virtual void run_ports_for(Cycles) = 0;
@@ -52,7 +52,7 @@ void Executor<model, BusHandler>::signal_bus_error(FunctionCode code, uint32_t a
 
 template <Model model, typename BusHandler>
 void Executor<model, BusHandler>::set_interrupt_level(int level) {
-	state_.interrupt_input_ = level;
+	state_.interrupt_input = level;
 	state_.stopped &= !state_.status.would_accept_interrupt(level);
 }
 
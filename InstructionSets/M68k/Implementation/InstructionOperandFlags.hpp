@@ -26,6 +26,7 @@ template <Model model, Operation t_operation> constexpr uint8_t operand_flags(Op
 		case Operation::MOVEPw:		case Operation::MOVEPl:
 		case Operation::TAS:
 		case Operation::RTR:		case Operation::RTS:		case Operation::RTE:
+		case Operation::STOP:		case Operation::RESET:
 			return 0;
 
 		//
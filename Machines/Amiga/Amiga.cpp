@@ -176,6 +176,18 @@ class ConcreteMachine:
 			return total_length - cycle.length;
 		}
 
+		template <typename Microcycle> uint8_t *direct_access(const Microcycle &cycle, int) {
+			// Memory beyond the chip bus — e.g. fast RAM and Kickstart, other than when
+			// overlaid — can be accessed without synchronising with the chipset.
+			const uint32_t address = cycle.host_endian_byte_address();
+			if(address < 0x20'0000) return nullptr;
+
+			const auto &region = memory_.regions[address >> 18];
+			const auto permission = (cycle.operation & Microcycle::Read) ? Microcycle::PermitRead : Microcycle::PermitWrite;
+			if(!(region.read_write_mask & permission)) return nullptr;
+			return &region.contents[address];
+		}
+
 	private:
 		CPU::MC68000Mk2::Processor<ConcreteMachine, true, true> mc68000_;
 
@@ -199,6 +211,10 @@ class ConcreteMachine:
 			return chipset_.get_speaker();
 		}
 
+		void wait_for_audio() final {
+			chipset_.wait_for_audio();
+		}
+
 		// MARK: - MachineTypes::ScanProducer.
 
 		void set_scan_target(Outputs::Display::ScanTarget *scan_target) final {
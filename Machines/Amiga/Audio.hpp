@@ -62,6 +62,11 @@ class Audio: public DMADevice<4> {
 			return &speaker_;
 		}
 
+		/// Blocks until all audio so far produced has been supplied to the speaker.
+		void wait_for_audio() {
+			queue_.flush();
+		}
+
 	private:
 		struct Channel {
 			// The data latch plus a count of unused samples
@@ -104,6 +104,10 @@ class Chipset: private ClockingHint::Observer {
 			return audio_.get_speaker();
 		}
 
+		void wait_for_audio() {
+			audio_.wait_for_audio();
+		}
+
 	private:
 		friend class DMADeviceBase;
 
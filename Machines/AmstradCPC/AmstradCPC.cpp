@@ -10,6 +10,7 @@
 
 #include "Keyboard.hpp"
 #include "FDC.hpp"
+#include "State.hpp"
 
 #include "../../Processors/Z80/Z80.hpp"
 
@@ -27,7 +28,9 @@
 #include "../../Storage/Tape/Parsers/Spectrum.hpp"
 
 #include "../../ClockReceiver/ForceInline.hpp"
-#include "../../Outputs/Speaker/Implementation/LowpassSpeaker.hpp"
+#include "../../Outputs/Speaker/Implementation/BLEPSpeaker.hpp"
+#include "../../Outputs/Speaker/Implementation/ReplayingSource.hpp"
+#include "../../Concurrency/RegisterWriteLog.hpp"
 #include "../../Outputs/CRT/CRT.hpp"
 
 #include "../../Analyser/Static/AmstradCPC/Target.hpp"
@@ -104,6 +107,22 @@ class InterruptTimer {
 			interrupt_request_ = false;
 		}
 
+		/// Captures the timer's state into @c state.
+		void get_state(State::GateArray &state) const {
+			state.timer = timer_;
+			state.reset_counter = reset_counter_;
+			state.interrupt_request = interrupt_request_;
+			state.last_interrupt_request = last_interrupt_request_;
+		}
+
+		/// Replaces the timer's state with that in @c state.
+		void set_state(const State::GateArray &state) {
+			timer_ = state.timer;
+			reset_counter_ = state.reset_counter;
+			interrupt_request_ = state.interrupt_request;
+			last_interrupt_request_ = state.last_interrupt_request;
+		}
+
 	private:
 		int reset_counter_ = 0;
 		bool interrupt_request_ = false;
@@ -119,11 +138,12 @@ class InterruptTimer {
 class AYDeferrer {
 	public:
 		/// Constructs a new AY instance and sets its clock rate.
-		AYDeferrer() : ay_(GI::AY38910::Personality::AY38910, audio_queue_), speaker_(ay_) {
+		AYDeferrer() : ay_(GI::AY38910::Personality::AY38910, audio_queue_), source_(ay_, register_write_log_), speaker_(source_) {
 			speaker_.set_input_rate(1000000);
 			// Per the CPC Wiki:
 			// "A is output to the right, channel C is output left, and channel B is output to both left and right".
 			ay_.set_output_mixing(0.0, 0.5, 1.0, 1.0, 0.5, 0.0);
+			ay_.set_register_write_log(&register_write_log_);
 		}
 
 		~AYDeferrer() {
@@ -135,13 +155,25 @@ class AYDeferrer {
 			cycles_since_update_ += half_cycles;
 		}
 
-		/// Enqueues an update-to-now into the AY's deferred queue.
+		/// Brings the AY's register write log up to now, so that subsequent writes are timestamped correctly.
 		inline void update() {
-			speaker_.run_for(audio_queue_, cycles_since_update_.divide_cycles(Cycles(4)));
+			register_write_log_.advance(uint64_t(cycles_since_update_.divide_cycles(Cycles(4)).as_integral()));
+
+			// Don't allow the log to fill up between calls to flush.
+			if(register_write_log_.size() >= register_write_log_.Capacity / 2) {
+				flush();
+			}
 		}
 
 		/// Issues a request to the AY to perform all processing up to the current time.
 		inline void flush() {
+			const auto time = register_write_log_.time();
+			speaker_.run_for(audio_queue_, Cycles(Cycles::IntType(time - posted_time_)));
+			audio_queue_.enqueue([this, time] {
+				source_.catch_up(time);
+			});
+			posted_time_ = time;
+
 			audio_queue_.perform();
 		}
 
@@ -150,16 +182,27 @@ class AYDeferrer {
 			return &speaker_;
 		}
 
+		/// Blocks until all scheduled audio generation has been performed.
+		void wait_for_audio() {
+			audio_queue_.flush();
+		}
+
 		/// @returns the AY itself.
 		GI::AY38910::AY38910<true> &ay() {
 			return ay_;
 		}
 
 	private:
+		using AY = GI::AY38910::AY38910<true>;
+		using Log = Concurrency::RegisterWriteLog<>;
+
 		Concurrency::AsyncTaskQueue<false> audio_queue_;
-		GI::AY38910::AY38910<true> ay_;
-		Outputs::Speaker::PullLowpass<GI::AY38910::AY38910<true>> speaker_;
+		Log register_write_log_;
+		AY ay_;
+		Outputs::Speaker::ReplayingSource<AY, Log> source_;
+		Outputs::Speaker::PullBLEP<Outputs::Speaker::ReplayingSource<AY, Log>> speaker_;
 		HalfCycles cycles_since_update_;
+		uint64_t posted_time_ = 0;
 };
 
 /*!
@@ -217,21 +260,7 @@ class CRTCBusHandler {
 			// If a transition between sync/border/pixels just occurred, flush whatever was
 			// in progress to the CRT and reset counting.
 			if(output_mode != previous_output_mode_) {
-				if(cycles_) {
-					switch(previous_output_mode_) {
-						default:
-						case OutputMode::Blank:			crt_.output_blank(cycles_ * 16);				break;
-						case OutputMode::Sync:			crt_.output_sync(cycles_ * 16);					break;
-						case OutputMode::Border:		output_border(cycles_);							break;
-						case OutputMode::ColourBurst:	crt_.output_default_colour_burst(cycles_ * 16);	break;
-						case OutputMode::Pixels:
-							crt_.output_data(cycles_ * 16, size_t(cycles_ * 16 / pixel_divider_));
-							pixel_pointer_ = pixel_data_ = nullptr;
-						break;
-					}
-				}
-
-				cycles_ = 0;
+				flush_run();
 				previous_output_mode_ = output_mode;
 			}
 
@@ -312,14 +341,7 @@ class CRTCBusHandler {
 			// Check for a trailing CRTC hsync; if one occurred then that's the trigger potentially to change modes.
 			if(!was_hsync_ && state.hsync) {
 				if(mode_ != next_mode_) {
-					mode_ = next_mode_;
-					switch(mode_) {
-						default:
-						case 0:		pixel_divider_ = 4;	break;
-						case 1:		pixel_divider_ = 2;	break;
-						case 2:		pixel_divider_ = 1;	break;
-					}
-					build_mode_table();
+					set_mode(next_mode_);
 				}
 			}
 
@@ -382,7 +404,65 @@ class CRTCBusHandler {
 			}
 		}
 
+		/// Captures palette, mode and sync state into @c state.
+		void get_state(State::GateArray &state) const {
+			memcpy(state.palette, palette_, sizeof(state.palette));
+			state.border = border_;
+			state.pen = uint8_t(pen_);
+			state.mode = uint8_t(mode_);
+			state.next_mode = uint8_t(next_mode_);
+			state.cycles_into_hsync = cycles_into_hsync_;
+			state.was_hsync = was_hsync_;
+			state.was_vsync = was_vsync_;
+		}
+
+		/// Replaces palette, mode and sync state with that in @c state.
+		void set_state(const State::GateArray &state) {
+			// Complete the output in progress, as the mode in which it is being
+			// collected may be about to change.
+			flush_run();
+
+			memcpy(palette_, state.palette, sizeof(palette_));
+			border_ = state.border;
+			pen_ = state.pen;
+			next_mode_ = state.next_mode & 3;
+			set_mode(state.mode & 3);
+			cycles_into_hsync_ = state.cycles_into_hsync;
+			was_hsync_ = state.was_hsync;
+			was_vsync_ = state.was_vsync;
+		}
+
 	private:
+		/// Outputs whatever has been collected since the last change in output mode, and resets counting.
+		forceinline void flush_run() {
+			if(cycles_) {
+				switch(previous_output_mode_) {
+					default:
+					case OutputMode::Blank:			crt_.output_blank(cycles_ * 16);				break;
+					case OutputMode::Sync:			crt_.output_sync(cycles_ * 16);					break;
+					case OutputMode::Border:		output_border(cycles_);							break;
+					case OutputMode::ColourBurst:	crt_.output_default_colour_burst(cycles_ * 16);	break;
+					case OutputMode::Pixels:
+						crt_.output_data(cycles_ * 16, size_t(cycles_ * 16 / pixel_divider_));
+						pixel_pointer_ = pixel_data_ = nullptr;
+					break;
+				}
+			}
+
+			cycles_ = 0;
+		}
+
+		void set_mode(int mode) {
+			mode_ = mode;
+			switch(mode_) {
+				default:
+				case 0:		pixel_divider_ = 4;	break;
+				case 1:		pixel_divider_ = 2;	break;
+				case 2:		pixel_divider_ = 1;	break;
+			}
+			build_mode_table();
+		}
+
 		void output_border(int length) {
 			assert(length >= 0);
 
@@ -712,7 +792,9 @@ class i8255PortHandler : public Intel::i8255::PortHandler {
 					// Bit 5 sets the current tape output level
 					tape_player_.set_tape_output((value & 0x20) ? true : false);
 
-					// Bits 6 and 7 set BDIR and BC1 for the AY.
+					// Bits 6 and 7 set BDIR and BC1 for the AY; bring it up to date first
+					// in case they trigger a register write.
+					ay_.update();
 					ay_.ay().set_control_lines(
 						(GI::AY38910::ControlLines)(
 							((value & 0x80) ? GI::AY38910::BDIR : 0) |
@@ -757,6 +839,7 @@ template <bool has_fdc> class ConcreteMachine:
 	public MachineTypes::MediaTarget,
 	public MachineTypes::MappedKeyboardMachine,
 	public MachineTypes::JoystickMachine,
+	public MachineTypes::StateProducer,
 	public Utility::TypeRecipient<CharacterMapper>,
 	public CPU::Z80::BusHandler,
 	public ClockingHint::Observer,
@@ -848,6 +931,11 @@ template <bool has_fdc> class ConcreteMachine:
 			}
 
 			insert_media(target.media);
+
+			// Install state if supplied.
+			if(target.state) {
+				set_state(*target.state);
+			}
 		}
 
 		/// The entry point for performing a partial Z80 machine cycle.
@@ -1085,6 +1173,10 @@ template <bool has_fdc> class ConcreteMachine:
 			return ay_.get_speaker();
 		}
 
+		void wait_for_audio() final {
+			ay_.wait_for_audio();
+		}
+
 		/// Wires virtual-dispatched CRTMachine run_for requests to the static Z80 method.
 		void run_for(const Cycles cycles) final {
 			z80_.run_for(cycles);
@@ -1170,6 +1262,67 @@ template <bool has_fdc> class ConcreteMachine:
 			return key_state_.get_joysticks();
 		}
 
+		// MARK: - StateProducer.
+
+		std::unique_ptr<Reflection::Struct> get_state() final {
+			auto state = std::make_unique<State>();
+			get_state(*state);
+			return state;
+		}
+
+		void get_state(Reflection::Struct &target) final {
+			auto &state = static_cast<State &>(target);
+
+			state.z80 = CPU::Z80::State(z80_);
+			state.crtc = Motorola::CRTC::State(crtc_);
+			state.i8255 = Intel::i8255::State(i8255_);
+			state.ay = GI::AY38910::State(ay_.ay());
+
+			crtc_bus_handler_.get_state(state.gate_array);
+			interrupt_timer_.get_state(state.gate_array);
+			state.gate_array.lower_rom_is_paged = read_pointers_[0] == roms_[ROMType::OS].data();
+			state.gate_array.upper_rom_is_paged = upper_rom_is_paged_;
+			state.gate_array.ram_configuration = ram_configuration_;
+			state.upper_rom_is_amsdos = upper_rom_ == ROMType::AMSDOS;
+
+			state.clock_offset = clock_offset_.as<int>();
+			state.crtc_counter = crtc_counter_.as<int>();
+
+			state.ram.assign(ram_, ram_ + (has_128k_ ? 128*1024 : 64*1024));
+		}
+
+		void set_state(const Reflection::Struct &target) final {
+			// Bring audio up to date before applying the new state, so that
+			// output already owed is produced from the old.
+			const auto &state = static_cast<const State &>(target);
+			ay_.update();
+
+			state.z80.apply(z80_);
+			state.crtc.apply(crtc_);
+			crtc_bus_handler_.set_state(state.gate_array);
+			interrupt_timer_.set_state(state.gate_array);
+
+			// Apply the 8255 after the AY, as it drives the AY's data bus and control lines;
+			// it also selects the keyboard row and sets the tape motor.
+			state.ay.apply(ay_.ay());
+			state.i8255.apply(i8255_);
+
+			if(has_128k_) {
+				page_ram(state.gate_array.ram_configuration);
+			}
+			if constexpr (has_fdc) {
+				upper_rom_ = state.upper_rom_is_amsdos ? ROMType::AMSDOS : ROMType::BASIC;
+			}
+			upper_rom_is_paged_ = state.gate_array.upper_rom_is_paged;
+			read_pointers_[0] = state.gate_array.lower_rom_is_paged ? roms_[ROMType::OS].data() : write_pointers_[0];
+			read_pointers_[3] = upper_rom_is_paged_ ? roms_[upper_rom_].data() : write_pointers_[3];
+
+			memcpy(ram_, state.ram.data(), std::min(size_t(has_128k_ ? 128*1024 : 64*1024), state.ram.size()));
+
+			clock_offset_ = HalfCycles(state.clock_offset);
+			crtc_counter_ = HalfCycles(state.crtc_counter);
+		}
+
 	private:
 		inline void write_to_gate_array(uint8_t value) {
 			switch(value >> 6) {
@@ -1191,29 +1344,35 @@ template <bool has_fdc> class ConcreteMachine:
 				case 3:
 					// Perform RAM paging, if 128kb is permitted.
 					if(has_128k_) {
-						const bool adjust_low_read_pointer = read_pointers_[0] == write_pointers_[0];
-						const bool adjust_high_read_pointer = read_pointers_[3] == write_pointers_[3];
+						page_ram(value & 7);
+					}
+				break;
+			}
+		}
+
+		void page_ram(uint8_t configuration) {
+			ram_configuration_ = configuration;
+
+			const bool adjust_low_read_pointer = read_pointers_[0] == write_pointers_[0];
+			const bool adjust_high_read_pointer = read_pointers_[3] == write_pointers_[3];
 #define RAM_BANK(x) &ram_[x * 16384]
 #define RAM_CONFIG(a, b, c, d) write_pointers_[0] = RAM_BANK(a); write_pointers_[1] = RAM_BANK(b); write_pointers_[2] = RAM_BANK(c); write_pointers_[3] = RAM_BANK(d);
-						switch(value & 7) {
-							case 0:	RAM_CONFIG(0, 1, 2, 3);	break;
-							case 1:	RAM_CONFIG(0, 1, 2, 7);	break;
-							case 2:	RAM_CONFIG(4, 5, 6, 7);	break;
-							case 3:	RAM_CONFIG(0, 3, 2, 7);	break;
-							case 4:	RAM_CONFIG(0, 4, 2, 3);	break;
-							case 5:	RAM_CONFIG(0, 5, 2, 3);	break;
-							case 6:	RAM_CONFIG(0, 6, 2, 3);	break;
-							case 7:	RAM_CONFIG(0, 7, 2, 3);	break;
-						}
+			switch(configuration & 7) {
+				case 0:	RAM_CONFIG(0, 1, 2, 3);	break;
+				case 1:	RAM_CONFIG(0, 1, 2, 7);	break;
+				case 2:	RAM_CONFIG(4, 5, 6, 7);	break;
+				case 3:	RAM_CONFIG(0, 3, 2, 7);	break;
+				case 4:	RAM_CONFIG(0, 4, 2, 3);	break;
+				case 5:	RAM_CONFIG(0, 5, 2, 3);	break;
+				case 6:	RAM_CONFIG(0, 6, 2, 3);	break;
+				case 7:	RAM_CONFIG(0, 7, 2, 3);	break;
+			}
 #undef RAM_CONFIG
 #undef RAM_BANK
-						if(adjust_low_read_pointer) read_pointers_[0] = write_pointers_[0];
-						read_pointers_[1] = write_pointers_[1];
-						read_pointers_[2] = write_pointers_[2];
-						if(adjust_high_read_pointer) read_pointers_[3] = write_pointers_[3];
-					}
-				break;
-			}
+			if(adjust_low_read_pointer) read_pointers_[0] = write_pointers_[0];
+			read_pointers_[1] = write_pointers_[1];
+			read_pointers_[2] = write_pointers_[2];
+			if(adjust_high_read_pointer) read_pointers_[3] = write_pointers_[3];
 		}
 
 		CPU::Z80::Processor<ConcreteMachine, false, true> z80_;
@@ -1266,6 +1425,7 @@ template <bool has_fdc> class ConcreteMachine:
 		std::vector<uint8_t> roms_[3];
 		bool upper_rom_is_paged_ = false;
 		ROMType upper_rom_;
+		uint8_t ram_configuration_ = 0;
 
 		uint8_t *ram_pages_[4]{};
 		const uint8_t *read_pointers_[4]{};
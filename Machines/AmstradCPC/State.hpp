@@ -0,0 +1,101 @@
+//
+//  State.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 16/10/2026.
+//  Copyright 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef Machines_AmstradCPC_State_hpp
+#define Machines_AmstradCPC_State_hpp
+
+#include "../../Reflection/Struct.hpp"
+#include "../../Processors/Z80/State/State.hpp"
+
+#include "../../Components/6845/CRTC6845.hpp"
+#include "../../Components/8255/i8255.hpp"
+#include "../../Components/AY38910/AY38910.hpp"
+
+namespace AmstradCPC {
+
+/*!
+	Captures the CPC itself; any inserted tape and the 664 and 6128's disk controller
+	and drives are not included.
+*/
+struct State: public Reflection::StructImpl<State> {
+	CPU::Z80::State z80;
+	Motorola::CRTC::State crtc;
+	Intel::i8255::State i8255;
+	GI::AY38910::State ay;
+
+	struct GateArray: public Reflection::StructImpl<GateArray> {
+		// Colours are as output, i.e. in Red2Green2Blue2 form.
+		uint8_t palette[16]{};
+		uint8_t border = 0;
+		uint8_t pen = 0;
+		uint8_t mode = 2, next_mode = 2;
+
+		int cycles_into_hsync = 0;
+		bool was_hsync = false, was_vsync = false;
+
+		// Interrupt timer.
+		int timer = 0;
+		int reset_counter = 0;
+		bool interrupt_request = false;
+		bool last_interrupt_request = false;
+
+		// Paging; the RAM configuration is meaningful for 128kb machines only.
+		bool lower_rom_is_paged = true;
+		bool upper_rom_is_paged = true;
+		uint8_t ram_configuration = 0;
+
+		GateArray() {
+			if(needs_declare()) {
+				DeclareField(palette);
+				DeclareField(border);
+				DeclareField(pen);
+				DeclareField(mode);
+				DeclareField(next_mode);
+				DeclareField(cycles_into_hsync);
+				DeclareField(was_hsync);
+				DeclareField(was_vsync);
+				DeclareField(timer);
+				DeclareField(reset_counter);
+				DeclareField(interrupt_request);
+				DeclareField(last_interrupt_request);
+				DeclareField(lower_rom_is_paged);
+				DeclareField(upper_rom_is_paged);
+				DeclareField(ram_configuration);
+			}
+		}
+	} gate_array;
+
+	// Meaningful for machines with AMSDOS only.
+	bool upper_rom_is_amsdos = false;
+
+	// Phase of the CPU relative to the gate array's memory accesses and to the CRTC,
+	// in half cycles.
+	int clock_offset = 0;
+	int crtc_counter = 0;
+
+	// 64kb or 128kb, the latter for the 6128 only, in bank order.
+	std::vector<uint8_t> ram;
+
+	State() {
+		if(needs_declare()) {
+			DeclareField(z80);
+			DeclareField(crtc);
+			DeclareField(i8255);
+			DeclareField(ay);
+			DeclareField(gate_array);
+			DeclareField(upper_rom_is_amsdos);
+			DeclareField(clock_offset);
+			DeclareField(crtc_counter);
+			DeclareField(ram);
+		}
+	}
+};
+
+}
+
+#endif /* Machines_AmstradCPC_State_hpp */
@@ -16,7 +16,7 @@
 #include "../../../Processors/6502/6502.hpp"
 #include "../../../Components/AudioToggle/AudioToggle.hpp"
 
-#include "../../../Outputs/Speaker/Implementation/LowpassSpeaker.hpp"
+#include "../../../Outputs/Speaker/Implementation/BLEPSpeaker.hpp"
 #include "../../../Outputs/Log.hpp"
 
 #include "AuxiliaryMemorySwitches.hpp"
@@ -97,7 +97,7 @@ template <Analyser::Static::AppleII::Target::Model model> class ConcreteMachine:
 
 		Concurrency::AsyncTaskQueue<false> audio_queue_;
 		Audio::Toggle audio_toggle_;
-		Outputs::Speaker::PullLowpass<Audio::Toggle> speaker_;
+		Outputs::Speaker::PullBLEP<Audio::Toggle> speaker_;
 		Cycles cycles_since_audio_update_;
 
 		// MARK: - Cards
@@ -518,6 +518,10 @@ template <Analyser::Static::AppleII::Target::Model model> class ConcreteMachine:
 			return &speaker_;
 		}
 
+		void wait_for_audio() final {
+			audio_queue_.flush();
+		}
+
 		forceinline Cycles perform_bus_operation(const CPU::MOS6502::BusOperation operation, const uint16_t address, uint8_t *const value) {
 			++ cycles_since_video_update_;
 			++ cycles_since_card_update_;
@@ -359,6 +359,10 @@ class ConcreteMachine:
 			return &speaker_;
 		}
 
+		void wait_for_audio() final {
+			audio_queue_.flush();
+		}
+
 		// MARK: MediaTarget.
 		bool insert_media(const Analyser::Static::Media &media) final {
 			if(!media.disks.empty()) {
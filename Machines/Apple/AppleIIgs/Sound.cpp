@@ -12,6 +12,8 @@
 #include <cstdio>
 #include <numeric>
 
+#include "../../../Numeric/CPUFeatures.hpp"
+
 // TODO: is it safe not to check for back-pressure in pending_stores_?
 
 using namespace Apple::IIgs::Sound;
@@ -187,6 +189,18 @@ void GLU::set_sample_volume_range(std::int16_t range) {
 	output_range_ = range;
 }
 
+void GLU::set_oscillator_bank_enabled(bool enabled) {
+	audio_queue_.enqueue([this, enabled] () {
+		use_oscillator_bank_ = enabled;
+	});
+}
+
+void GLU::set_avx2_enabled(bool enabled) {
+	audio_queue_.enqueue([this, enabled] () {
+		use_avx2_ = enabled;
+	});
+}
+
 // MARK: - Interface boilerplate.
 
 void GLU::set_control(uint8_t control) {
@@ -256,7 +270,189 @@ void GLU::skip_audio(EnsoniqState &state, size_t number_of_samples) {
 	}
 }
 
+// MARK: - Oscillator bank.
+
+/*!
+	Holds a structure-of-arrays copy of those oscillators whose output depends only on their own state
+	and on sound RAM, i.e. running oscillators in free-run or one-shot mode that don't have a partner in
+	swap mode, so that they can be advanced in parallel.
+
+	All other oscillators are listed in @c dependents, to be advanced individually.
+*/
+struct GLU::OscillatorBank {
+	static constexpr int Lanes = 8;
+
+	alignas(32) uint32_t position[32];
+	alignas(32) uint32_t velocity[32];
+	alignas(32) uint32_t halted[32];		// ~0 if halted; 0 otherwise.
+	alignas(32) uint32_t one_shot[32];		// ~0 if in one-shot mode; 0 otherwise.
+	alignas(32) uint32_t overflow_mask[32];
+	alignas(32) uint32_t address_base[32];	// The bits of each sample address supplied by the address register.
+	alignas(32) uint32_t table_shift[32];	// The shift from position to table pointer.
+	alignas(32) uint32_t table_mask[32];	// The bits of each sample address supplied by the table pointer.
+	alignas(32) int32_t volume[32];			// Doubled in free-run mode, in which output is accumulated twice.
+	int oscillator[32];
+	int count = 0;
+
+	int dependents[32];
+	int dependent_count = 0;
+
+	/// Set to use AVX2 when advancing; this may be set only if Numeric::has_avx2() is @c true.
+	bool use_avx2 = false;
+
+	/// Populates this bank from @c state, returning @c false if it can't be used because some oscillator
+	/// is in sync/AM mode, in which output depends on the neighbouring oscillator.
+	bool load(const EnsoniqState &state) {
+		count = dependent_count = 0;
+		for(int c = 0; c < state.oscillator_count; c++) {
+			const auto &source = state.oscillators[c];
+			const int mode = source.control & 6;
+			if(mode == 4) return false;
+
+			const int partner = c ^ 1;
+			if(mode == 6 || (partner < state.oscillator_count && (state.oscillators[partner].control & 6) == 6)) {
+				dependents[dependent_count++] = c;
+				continue;
+			}
+
+			// Only swap mode can restart a halted oscillator, so those not in the dependents list
+			// will stay halted.
+			if(source.control & 1) continue;
+
+			// Cf. Oscillator::sample.
+			const int pointer_shift = 8 - ((source.table_size >> 3) & 7);
+			const uint32_t mask = 0xffff >> pointer_shift;
+
+			oscillator[count] = c;
+			position[count] = source.position;
+			velocity[count] = source.velocity;
+			halted[count] = 0;
+			one_shot[count] = mode == 2 ? ~0 : 0;
+			overflow_mask[count] = source.overflow_mask;
+			address_base[count] = (source.address << 8) & ~mask;
+			table_shift[count] = (source.table_size & 7) + pointer_shift;
+			table_mask[count] = mask;
+			volume[count] = source.volume * (mode == 0 ? 2 : 1);
+			++count;
+		}
+
+		// Fill any remaining lanes with permanently-halted oscillators.
+		for(int c = count; c < ((count + Lanes - 1) & ~(Lanes - 1)); c++) {
+			position[c] = velocity[c] = overflow_mask[c] = 0;
+			address_base[c] = table_shift[c] = table_mask[c] = one_shot[c] = 0;
+			volume[c] = 0;
+			halted[c] = ~0;
+		}
+		return true;
+	}
+
+	/// Copies positions and halts back to @c state.
+	void store(EnsoniqState &state) const {
+		for(int c = 0; c < count; c++) {
+			auto &target = state.oscillators[oscillator[c]];
+			target.position = position[c];
+			target.control |= halted[c] & 1;
+		}
+	}
+
+	/// Advances all oscillators in the bank by a single sample, returning their summed output.
+	int advance(const uint8_t *ram) {
+#ifdef AVX2_TARGET
+		if(use_avx2) return advance_avx2(ram);
+#endif
+
+		int output = 0;
+		for(int c = 0; c < count; c++) {
+			if(halted[c]) continue;
+			position[c] += velocity[c];
+
+			// One-shot oscillators halt and reset upon overflow.
+			if(position[c] & overflow_mask[c] & one_shot[c]) {
+				position[c] = 0;
+				halted[c] = ~0;
+				continue;
+			}
+
+			// A zero sample halts its oscillator.
+			const uint8_t level = ram[address_base[c] | ((position[c] >> table_shift[c]) & table_mask[c])];
+			if(!level) {
+				halted[c] = ~0;
+				continue;
+			}
+
+			output += int8_t(level ^ 128) * volume[c];
+		}
+		return output;
+	}
+
+#ifdef AVX2_TARGET
+	/// Performs the same function as @c advance, eight oscillators at a time.
+	AVX2_TARGET int advance_avx2(const uint8_t *ram) {
+		const __m256i zero = _mm256_setzero_si256();
+		__m256i total = zero;
+
+		for(int c = 0; c < count; c += Lanes) {
+			__m256i halt = lanes(halted, c);
+			__m256i pos = _mm256_add_epi32(lanes(position, c), _mm256_andnot_si256(halt, lanes(velocity, c)));
+
+			// One-shot oscillators halt and reset upon overflow.
+			const __m256i overflow = _mm256_andnot_si256(halt, _mm256_andnot_si256(
+				_mm256_cmpeq_epi32(_mm256_and_si256(pos, lanes(overflow_mask, c)), zero),
+				lanes(one_shot, c)));
+			pos = _mm256_andnot_si256(overflow, pos);
+			halt = _mm256_or_si256(halt, overflow);
+
+			// Gather the aligned word that contains each sample, then shift the sample out.
+			const __m256i address = _mm256_or_si256(
+				lanes(address_base, c),
+				_mm256_and_si256(_mm256_srlv_epi32(pos, lanes(table_shift, c)), lanes(table_mask, c)));
+			const __m256i words = _mm256_i32gather_epi32(
+				reinterpret_cast<const int *>(ram),
+				_mm256_srli_epi32(address, 2),
+				4);
+			const __m256i level = _mm256_and_si256(
+				_mm256_srlv_epi32(words, _mm256_slli_epi32(_mm256_and_si256(address, _mm256_set1_epi32(3)), 3)),
+				_mm256_set1_epi32(0xff));
+
+			// A zero sample halts its oscillator.
+			halt = _mm256_or_si256(halt, _mm256_cmpeq_epi32(level, zero));
+
+			// Convert samples to signed, apply volume and add to the total.
+			const __m256i sample = _mm256_srai_epi32(
+				_mm256_slli_epi32(_mm256_xor_si256(level, _mm256_set1_epi32(0x80)), 24),
+				24);
+			total = _mm256_add_epi32(total, _mm256_andnot_si256(halt, _mm256_mullo_epi32(sample, lanes(volume, c))));
+
+			_mm256_store_si256(reinterpret_cast<__m256i *>(&position[c]), pos);
+			_mm256_store_si256(reinterpret_cast<__m256i *>(&halted[c]), halt);
+		}
+
+		__m128i sum = _mm_add_epi32(_mm256_castsi256_si128(total), _mm256_extracti128_si256(total, 1));
+		sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0x4e));
+		sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0xb1));
+		return _mm_cvtsi128_si32(sum);
+	}
+
+	/// @returns The eight entries of @c source beginning at @c c.
+	template <typename IntT> AVX2_TARGET static __m256i lanes(const IntT *source, int c) {
+		return _mm256_load_si256(reinterpret_cast<const __m256i *>(&source[c]));
+	}
+#endif
+};
+
+// MARK: - Audio generation.
+
 void GLU::generate_audio(size_t number_of_samples, std::int16_t *target) {
+	OscillatorBank bank;
+	if(use_oscillator_bank_ && bank.load(remote_)) {
+		bank.use_avx2 = use_avx2_ && Numeric::has_avx2();
+		generate_audio_bank(bank, number_of_samples, target);
+	} else {
+		generate_audio_scalar(number_of_samples, target);
+	}
+}
+
+void GLU::generate_audio_scalar(size_t number_of_samples, std::int16_t *target) {
 	auto next_store = pending_stores_[pending_store_read_].load(std::memory_order::memory_order_acquire);
 	uint8_t next_amplitude = 255;
 	for(size_t sample = 0; sample < number_of_samples; sample++) {
@@ -269,73 +465,102 @@ void GLU::generate_audio(size_t number_of_samples, std::int16_t *target) {
 
 		// Apply phase updates to all enabled oscillators.
 		for(int c = 0; c < remote_.oscillator_count; c++) {
-			// Don't do anything for halted oscillators.
-			if(remote_.oscillators[c].control&1) continue;
+			output += remote_.advance_oscillator(c, next_amplitude);
+		}
 
-			remote_.oscillators[c].position += remote_.oscillators[c].velocity;
+		// Maximum total output was 32 channels times a 16-bit range. Map that down.
+		// TODO: dynamic total volume?
+		target[sample] = (output * output_range_) >> 20;
 
-			// Test for a new halting event.
-			switch(remote_.oscillators[c].control & 6) {
-				case 0:	// Free-run mode; don't truncate the position at all, in case the
-						// accumulator bits in use changes.
-					output += remote_.oscillators[c].output(remote_.ram_);
-				break;
+		apply_pending_store(next_store);
+	}
+}
 
-				case 2:	// One-shot mode; check for end of run. Otherwise update sample.
-					if(remote_.oscillators[c].position & remote_.oscillators[c].overflow_mask) {
-						remote_.oscillators[c].position = 0;
-						remote_.oscillators[c].control |= 1;
-					}
-				break;
+void GLU::generate_audio_bank(OscillatorBank &bank, size_t number_of_samples, std::int16_t *target) {
+	auto next_store = pending_stores_[pending_store_read_].load(std::memory_order::memory_order_acquire);
+	for(size_t sample = 0; sample < number_of_samples; sample++) {
+		int output = bank.advance(remote_.ram_);
 
-				case 4:	// Sync/AM mode.
-					if(c&1) {
-						// Oscillator is odd-numbered; it will amplitude-modulate the next voice.
-						next_amplitude = remote_.oscillators[c].sample(remote_.ram_);
-						continue;
-					} else {
-						// Oscillator is even-numbered; it will 'sync' to the even voice, i.e. any
-						// time it wraps around, it will reset the next oscillator.
-						if(remote_.oscillators[c].position & remote_.oscillators[c].overflow_mask) {
-							remote_.oscillators[c].position &= remote_.oscillators[c].overflow_mask;
-							remote_.oscillators[c+1].position = 0;
-						}
-					}
-				break;
+		// No oscillator is in sync/AM mode, so there's no amplitude to carry between oscillators.
+		for(int c = 0; c < bank.dependent_count; c++) {
+			uint8_t next_amplitude = 255;
+			output += remote_.advance_oscillator(bank.dependents[c], next_amplitude);
+		}
 
-				case 6:	// Swap mode; possibly trigger partner, and update sample.
-						// Per tech note #11: "Whenever a swap occurs from a higher-numbered
-						// oscillator to a lower-numbered one, the output signal from the corresponding
-						// generator temporarily falls to the zero-crossing level (silence)"
-					if(remote_.oscillators[c].position & remote_.oscillators[c].overflow_mask) {
-						remote_.oscillators[c].control |= 1;
-						remote_.oscillators[c].position = 0;
-						remote_.oscillators[c^1].control &= ~1;
-					}
-				break;
-			}
+		target[sample] = (output * output_range_) >> 20;
 
-			// Don't add output for newly-halted oscillators.
-			if(remote_.oscillators[c].control&1) continue;
+		apply_pending_store(next_store);
+	}
+	bank.store(remote_);
+}
 
-			// Append new output.
-			output += (remote_.oscillators[c].output(remote_.ram_) * next_amplitude) / 255;
-			next_amplitude = 255;
-		}
+void GLU::apply_pending_store(MemoryWrite &next_store) {
+	// Apply any RAM writes that interleave here.
+	++pending_store_read_time_;
+	if(!next_store.enabled) return;
+	if(next_store.time != pending_store_read_time_) return;
+	remote_.ram_[next_store.address] = next_store.value;
+	next_store.enabled = false;
+	pending_stores_[pending_store_read_].store(next_store, std::memory_order::memory_order_relaxed);
+	pending_store_read_ = (pending_store_read_ + 1) & (StoreBufferSize - 1);
+}
 
-		// Maximum total output was 32 channels times a 16-bit range. Map that down.
-		// TODO: dynamic total volume?
-		target[sample] = (output * output_range_) >> 20;
+int GLU::EnsoniqState::advance_oscillator(int c, uint8_t &next_amplitude) {
+	// Don't do anything for halted oscillators.
+	if(oscillators[c].control&1) return 0;
 
-		// Apply any RAM writes that interleave here.
-		++pending_store_read_time_;
-		if(!next_store.enabled) continue;
-		if(next_store.time != pending_store_read_time_) continue;
-		remote_.ram_[next_store.address] = next_store.value;
-		next_store.enabled = false;
-		pending_stores_[pending_store_read_].store(next_store, std::memory_order::memory_order_relaxed);
-		pending_store_read_ = (pending_store_read_ + 1) & (StoreBufferSize - 1);
+	oscillators[c].position += oscillators[c].velocity;
+
+	int output = 0;
+
+	// Test for a new halting event.
+	switch(oscillators[c].control & 6) {
+		case 0:	// Free-run mode; don't truncate the position at all, in case the
+				// accumulator bits in use changes.
+			output += oscillators[c].output(ram_);
+		break;
+
+		case 2:	// One-shot mode; check for end of run. Otherwise update sample.
+			if(oscillators[c].position & oscillators[c].overflow_mask) {
+				oscillators[c].position = 0;
+				oscillators[c].control |= 1;
+			}
+		break;
+
+		case 4:	// Sync/AM mode.
+			if(c&1) {
+				// Oscillator is odd-numbered; it will amplitude-modulate the next voice.
+				next_amplitude = oscillators[c].sample(ram_);
+				return 0;
+			} else {
+				// Oscillator is even-numbered; it will 'sync' to the even voice, i.e. any
+				// time it wraps around, it will reset the next oscillator.
+				if(oscillators[c].position & oscillators[c].overflow_mask) {
+					oscillators[c].position &= oscillators[c].overflow_mask;
+					oscillators[c+1].position = 0;
+				}
+			}
+		break;
+
+		case 6:	// Swap mode; possibly trigger partner, and update sample.
+				// Per tech note #11: "Whenever a swap occurs from a higher-numbered
+				// oscillator to a lower-numbered one, the output signal from the corresponding
+				// generator temporarily falls to the zero-crossing level (silence)"
+			if(oscillators[c].position & oscillators[c].overflow_mask) {
+				oscillators[c].control |= 1;
+				oscillators[c].position = 0;
+				oscillators[c^1].control &= ~1;
+			}
+		break;
 	}
+
+	// Don't add output for newly-halted oscillators.
+	if(oscillators[c].control&1) return output;
+
+	// Append new output.
+	output += (oscillators[c].output(ram_) * next_amplitude) / 255;
+	next_amplitude = 255;
+	return output;
 }
 
 uint8_t GLU::EnsoniqState::Oscillator::sample(uint8_t *ram) {
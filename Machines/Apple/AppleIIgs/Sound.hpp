@@ -41,6 +41,15 @@ class GLU: public Outputs::Speaker::SampleSource {
 		void set_sample_volume_range(std::int16_t range);
 		void skip_samples(const std::size_t number_of_samples);
 
+		/// Enables or disables use of the oscillator bank, which mixes those oscillators that
+		/// can't affect one another in parallel. It is enabled by default, and output is
+		/// identical either way; this exists for testing and benchmarking.
+		void set_oscillator_bank_enabled(bool);
+
+		/// Enables or disables use of AVX2 by the oscillator bank, if the host supports it. It is enabled by
+		/// default, and output is identical either way; this exists for testing and benchmarking.
+		void set_avx2_enabled(bool);
+
 	private:
 		Concurrency::AsyncTaskQueue<false> &audio_queue_;
 
@@ -69,17 +78,17 @@ class GLU: public Outputs::Speaker::SampleSource {
 		struct EnsoniqState {
 			uint8_t ram_[65536];
 			struct Oscillator {
-				uint32_t position;
+				uint32_t position = 0;
 
 				// Programmer-set values.
-				uint16_t velocity;
-				uint8_t volume;
-				uint8_t address;
-				uint8_t control;
-				uint8_t table_size;
+				uint16_t velocity = 0;
+				uint8_t volume = 0;
+				uint8_t address = 0;
+				uint8_t control = 0;
+				uint8_t table_size = 0;
 
 				// Derived state.
-				uint32_t overflow_mask;			// If a non-zero bit gets anywhere into the overflow mask, this channel
+				uint32_t overflow_mask = 0;			// If a non-zero bit gets anywhere into the overflow mask, this channel
 												// has wrapped around. It's a function of table_size.
 				bool interrupt_request = false;	// Will be non-zero if this channel would request an interrupt, were
 												// it currently enabled to do so.
@@ -93,6 +102,10 @@ class GLU: public Outputs::Speaker::SampleSource {
 			int oscillator_count = 1;
 
 			void set_register(uint16_t address, uint8_t value);
+
+			/// Advances oscillator @c c by a single sample, returning its contribution to output.
+			/// @c next_amplitude carries amplitude modulation from an odd oscillator to its successor.
+			int advance_oscillator(int c, uint8_t &next_amplitude);
 		} local_, remote_;
 
 		// Functions to update an EnsoniqState; these don't belong to the state itself
@@ -100,8 +113,15 @@ class GLU: public Outputs::Speaker::SampleSource {
 		void generate_audio(size_t number_of_samples, std::int16_t *target);
 		void skip_audio(EnsoniqState &state, size_t number_of_samples);
 
+		void generate_audio_scalar(size_t number_of_samples, std::int16_t *target);
+		struct OscillatorBank;
+		void generate_audio_bank(OscillatorBank &, size_t number_of_samples, std::int16_t *target);
+		void apply_pending_store(MemoryWrite &next_store);
+
 		// Audio-thread state.
 		int16_t output_range_ = 0;
+		bool use_oscillator_bank_ = true;
+		bool use_avx2_ = true;
 };
 
 }
@@ -11,6 +11,7 @@
 
 #include "../../KeyboardMachine.hpp"
 #include "../../../ClockReceiver/ClockReceiver.hpp"
+#include "../../../Reflection/Struct.hpp"
 
 #include <mutex>
 #include <vector>
@@ -220,6 +221,56 @@ class Keyboard {
 			key_queue_.insert(key_queue_.begin(), (is_pressed ? 0x00 : 0x80) | uint8_t(key));
 		}
 
+		/*!
+			Captures the keyboard's protocol state and any key events not yet
+			communicated to the Macintosh.
+		*/
+		struct State: public Reflection::StructImpl<State> {
+			uint8_t mode = 0;		// The ordinal of a Keyboard::Mode.
+			int phase = 0;
+			int command = 0;
+			int response = 0;
+			bool data_input = false;
+			bool clock_output = false;
+			std::vector<uint8_t> key_queue;
+
+			State() {
+				if(needs_declare()) {
+					DeclareField(mode);
+					DeclareField(phase);
+					DeclareField(command);
+					DeclareField(response);
+					DeclareField(data_input);
+					DeclareField(clock_output);
+					DeclareField(key_queue);
+				}
+			}
+
+			State(Keyboard &source) : State() {
+				mode = uint8_t(source.mode_);
+				phase = source.phase_;
+				command = source.command_;
+				response = source.response_;
+				data_input = source.data_input_;
+				clock_output = source.clock_output_;
+
+				std::lock_guard lock(source.key_queue_mutex_);
+				key_queue = source.key_queue_;
+			}
+
+			void apply(Keyboard &target) const {
+				target.mode_ = Mode(mode);
+				target.phase_ = phase;
+				target.command_ = command;
+				target.response_ = response;
+				target.data_input_ = data_input;
+				target.clock_output_ = clock_output;
+
+				std::lock_guard lock(target.key_queue_mutex_);
+				target.key_queue_ = key_queue;
+			}
+		};
+
 	private:
 		/// Performs the pre-ADB Apple keyboard protocol command @c command, returning
 		/// the proper result if the command were to terminate now. So, it treats inquiry
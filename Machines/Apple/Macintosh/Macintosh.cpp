@@ -13,6 +13,7 @@
 #include "DeferredAudio.hpp"
 #include "DriveSpeedAccumulator.hpp"
 #include "Keyboard.hpp"
+#include "State.hpp"
 #include "Video.hpp"
 
 #include "../../MachineTypes.hpp"
@@ -38,6 +39,7 @@
 
 #include "../../../Processors/68000Mk2/68000Mk2.hpp"
 
+#include "../../../Storage/MassStorage/CopyOnWriteDevice.hpp"
 #include "../../../Storage/MassStorage/SCSI/SCSI.hpp"
 #include "../../../Storage/MassStorage/SCSI/DirectAccessDevice.hpp"
 #include "../../../Storage/MassStorage/Encodings/MacintoshVolume.hpp"
@@ -74,6 +76,7 @@ template <Analyser::Static::Macintosh::Target::Model model> class ConcreteMachin
 	public MachineTypes::MediaTarget,
 	public MachineTypes::MouseMachine,
 	public MachineTypes::MappedKeyboardMachine,
+	public MachineTypes::StateProducer,
 	public CPU::MC68000Mk2::BusHandler,
 	public Zilog::SCC::z8530::Delegate,
 	public Activity::Source,
@@ -170,6 +173,11 @@ template <Analyser::Static::Macintosh::Target::Model model> class ConcreteMachin
 
 			// Set the immutables of the memory map.
 			setup_memory_map();
+
+			// Install state if supplied.
+			if(target.state) {
+				set_state(*target.state);
+			}
 		}
 
 		~ConcreteMachine() {
@@ -188,6 +196,10 @@ template <Analyser::Static::Macintosh::Target::Model model> class ConcreteMachin
 			return &audio_.speaker;
 		}
 
+		void wait_for_audio() final {
+			audio_.queue.flush();
+		}
+
 		void run_for(const Cycles cycles) final {
 			mc68000_.run_for(cycles);
 		}
@@ -365,6 +377,16 @@ template <Analyser::Static::Macintosh::Target::Model model> class ConcreteMachin
 			return delay;
 		}
 
+		uint8_t *direct_access(const Microcycle &cycle, int) {
+			// ROM reads have no side effects and are never delayed; RAM is subject to
+			// video contention so isn't offered.
+			if(!(cycle.operation & Microcycle::Read)) return nullptr;
+
+			const auto address = cycle.host_endian_byte_address();
+			if(memory_map_[address >> 17] != BusDevice::ROM) return nullptr;
+			return &rom_[address & rom_mask_];
+		}
+
 		void flush_output(int) {
 			// Flush the video before the audio queue; in a Mac the
 			// video is responsible for providing part of the
@@ -452,7 +474,13 @@ template <Analyser::Static::Macintosh::Target::Model model> class ConcreteMachin
 
 			// TODO: allow this only at machine startup?
 			if(!media.mass_storage_devices.empty()) {
-				const auto volume = dynamic_cast<Storage::MassStorage::Encodings::Macintosh::Volume *>(media.mass_storage_devices.front().get());
+				// Look through any overlay to find the volume.
+				Storage::MassStorage::MassStorageDevice *device = media.mass_storage_devices.front().get();
+				if(const auto overlay = dynamic_cast<Storage::MassStorage::CopyOnWriteDevice *>(device)) {
+					device = &overlay->base();
+				}
+
+				const auto volume = dynamic_cast<Storage::MassStorage::Encodings::Macintosh::Volume *>(device);
 				if(volume) {
 					volume->set_drive_type(Storage::MassStorage::Encodings::Macintosh::DriveType::SCSI);
 				}
@@ -501,6 +529,66 @@ template <Analyser::Static::Macintosh::Target::Model model> class ConcreteMachin
 			}
 		}
 
+		// MARK: - StateProducer.
+
+		std::unique_ptr<Reflection::Struct> get_state() final {
+			auto state = std::make_unique<State>();
+			get_state(*state);
+			return state;
+		}
+
+		void get_state(Reflection::Struct &target) final {
+			auto &state = static_cast<State &>(target);
+
+			// Bring video up to date, so that its state is current.
+			update_video();
+
+			state.mc68000 = CPU::MC68000Mk2::Snapshot(mc68000_);
+			state.via = MOS::MOS6522::State(via_);
+			state.scc = Zilog::SCC::State(scc_);
+			state.clock = Apple::Clock::State(clock_);
+			state.video = Video::State(video_);
+			state.keyboard = Keyboard::State(keyboard_);
+
+			state.ram = ram_;
+			state.rom_is_overlay = ROM_is_overlay_;
+			state.phase = phase_;
+			state.ram_subcycle = ram_subcycle_;
+
+			state.via_clock = via_clock_.as<int>();
+			state.real_time_clock = real_time_clock_.as<int>();
+			state.keyboard_clock = keyboard_clock_.as<int>();
+		}
+
+		void set_state(const Reflection::Struct &target) final {
+			const auto &state = static_cast<const State &>(target);
+			update_video();
+
+			// The VIA re-announces its outputs, which select the screen and audio
+			// buffers, set the volume and are clocked into the real-time clock and
+			// keyboard; so apply it before the video, clock and keyboard.
+			state.via.apply(via_);
+			state.clock.apply(clock_);
+			state.keyboard.apply(keyboard_);
+			state.scc.apply(scc_);
+
+			state.video.apply(video_);
+			time_until_video_event_ = video_.get_next_sequence_point();
+
+			std::copy_n(state.ram.begin(), std::min(state.ram.size(), ram_.size()), ram_.begin());
+			set_rom_is_overlay(state.rom_is_overlay);
+			phase_ = state.phase;
+			ram_subcycle_ = state.ram_subcycle;
+
+			via_clock_ = HalfCycles(state.via_clock);
+			real_time_clock_ = HalfCycles(state.real_time_clock);
+			keyboard_clock_ = HalfCycles(state.keyboard_clock);
+
+			// Apply the 68000 last, as it also holds the interrupt level.
+			update_interrupt_input();
+			state.mc68000.apply(mc68000_);
+		}
+
 		// MARK: - Configuration options.
 		std::unique_ptr<Reflection::Struct> get_options() final {
 			auto options = std::make_unique<Options>(Configurable::OptionsType::UserFriendly);
@@ -0,0 +1,73 @@
+//
+//  State.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 16/10/2026.
+//  Copyright 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef Machines_Apple_Macintosh_State_hpp
+#define Machines_Apple_Macintosh_State_hpp
+
+#include "../../../Reflection/Struct.hpp"
+#include "../../../Processors/68000Mk2/State/State.hpp"
+
+#include "../../../Components/6522/6522.hpp"
+#include "../../../Components/8530/z8530.hpp"
+#include "../../../Components/AppleClock/AppleClock.hpp"
+
+#include "Keyboard.hpp"
+#include "Video.hpp"
+
+namespace Apple {
+namespace Macintosh {
+
+/*!
+	Captures the Macintosh itself; the IWM and any attached drives, the SCSI
+	bus and any attached devices, and the mouse are not included.
+*/
+struct State: public Reflection::StructImpl<State> {
+	CPU::MC68000Mk2::Snapshot mc68000;
+	MOS::MOS6522::State via;
+	Zilog::SCC::State scc;
+	Apple::Clock::State clock;
+	Video::State video;
+	Keyboard::State keyboard;
+
+	// The RAM size is implied by the model.
+	std::vector<uint8_t> ram;
+	bool rom_is_overlay = true;
+
+	// Bus phase and the position of the CPU relative to RAM access slots.
+	int phase = 1;
+	int ram_subcycle = 0;
+
+	// Partial progress towards the next VIA, real-time clock and keyboard ticks,
+	// in half cycles.
+	int via_clock = 0;
+	int real_time_clock = 0;
+	int keyboard_clock = 0;
+
+	State() {
+		if(needs_declare()) {
+			DeclareField(mc68000);
+			DeclareField(via);
+			DeclareField(scc);
+			DeclareField(clock);
+			DeclareField(video);
+			DeclareField(keyboard);
+			DeclareField(ram);
+			DeclareField(rom_is_overlay);
+			DeclareField(phase);
+			DeclareField(ram_subcycle);
+			DeclareField(via_clock);
+			DeclareField(real_time_clock);
+			DeclareField(keyboard_clock);
+		}
+	}
+};
+
+}
+}
+
+#endif /* Machines_Apple_Macintosh_State_hpp */
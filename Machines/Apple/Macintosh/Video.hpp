@@ -6,11 +6,12 @@
 //  Copyright © 2019 Thomas Harte. All rights reserved.
 //
 
-#ifndef Video_hpp
-#define Video_hpp
+#ifndef Apple_Macintosh_Video_hpp
+#define Apple_Macintosh_Video_hpp
 
 #include "../../../Outputs/CRT/CRT.hpp"
 #include "../../../ClockReceiver/ClockReceiver.hpp"
+#include "../../../Reflection/Struct.hpp"
 #include "DeferredAudio.hpp"
 #include "DriveSpeedAccumulator.hpp"
 
@@ -83,6 +84,47 @@ class Video {
 		*/
 		HalfCycles get_next_sequence_point();
 
+		/*!
+			Captures the current raster position and buffer selections; the CRT
+			and any partially-output line are not included.
+		*/
+		struct State: public Reflection::StructImpl<State> {
+			int frame_position = 0;
+			uint32_t video_address = 0;
+			uint32_t audio_address = 0;
+			bool use_alternate_screen_buffer = false;
+			bool use_alternate_audio_buffer = false;
+
+			State() {
+				if(needs_declare()) {
+					DeclareField(frame_position);
+					DeclareField(video_address);
+					DeclareField(audio_address);
+					DeclareField(use_alternate_screen_buffer);
+					DeclareField(use_alternate_audio_buffer);
+				}
+			}
+
+			State(const Video &source) : State() {
+				frame_position = source.frame_position_.as<int>();
+				video_address = uint32_t(source.video_address_);
+				audio_address = uint32_t(source.audio_address_);
+				use_alternate_screen_buffer = source.use_alternate_screen_buffer_;
+				use_alternate_audio_buffer = source.use_alternate_audio_buffer_;
+			}
+
+			void apply(Video &target) const {
+				target.frame_position_ = HalfCycles(frame_position);
+				target.video_address_ = video_address;
+				target.audio_address_ = audio_address;
+				target.use_alternate_screen_buffer_ = use_alternate_screen_buffer;
+				target.use_alternate_audio_buffer_ = use_alternate_audio_buffer;
+
+				// Abandon pixels for any line currently in progress.
+				target.pixel_buffer_ = nullptr;
+			}
+		};
+
 	private:
 		DeferredAudio &audio_;
 		DriveSpeedAccumulator &drive_speed_accumulator_;
@@ -105,4 +147,4 @@ class Video {
 }
 }
 
-#endif /* Video_hpp */
+#endif /* Apple_Macintosh_Video_hpp */
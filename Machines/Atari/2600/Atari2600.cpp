@@ -169,6 +169,10 @@ class ConcreteMachine:
 			return &bus_->speaker_;
 		}
 
+		void wait_for_audio() final {
+			bus_->audio_queue_.flush();
+		}
+
 		void run_for(const Cycles cycles) final {
 			bus_->run_for(cycles);
 			bus_->apply_confidence(confidence_counter_);
@@ -16,7 +16,7 @@
 
 #include "../../../Analyser/Dynamic/ConfidenceCounter.hpp"
 #include "../../../ClockReceiver/ClockReceiver.hpp"
-#include "../../../Outputs/Speaker/Implementation/LowpassSpeaker.hpp"
+#include "../../../Outputs/Speaker/Implementation/BLEPSpeaker.hpp"
 
 namespace Atari2600 {
 
@@ -41,7 +41,7 @@ class Bus {
 
 		Concurrency::AsyncTaskQueue<false> audio_queue_;
 		TIASound tia_sound_;
-		Outputs::Speaker::PullLowpass<TIASound> speaker_;
+		Outputs::Speaker::PullBLEP<TIASound> speaker_;
 
 		// joystick state
 		uint8_t tia_input_value_[2] = {0xff, 0xff};
@@ -31,20 +31,30 @@ class TIASound: public Outputs::Speaker::SampleSource {
 		void set_sample_volume_range(std::int16_t range);
 		static constexpr bool get_is_stereo() { return false; }
 
+		// To satisfy ::StepSource.
+		template <typename TargetT> void get_steps(std::size_t number_of_cycles, TargetT &target) {
+			for(std::size_t c = 0; c < number_of_cycles; c++) {
+				target.step(c, next_sample());
+			}
+		}
+
 	private:
 		Concurrency::AsyncTaskQueue<false> &audio_queue_;
 
-		uint8_t volume_[2];
-		uint8_t divider_[2];
-		uint8_t control_[2];
+		uint8_t volume_[2]{};
+		uint8_t divider_[2]{};
+		uint8_t control_[2]{};
 
 		int poly4_counter_[2];
 		int poly5_counter_[2];
 		int poly9_counter_[2];
-		int output_state_[2];
+		int output_state_[2]{};
 
-		int divider_counter_[2];
+		int divider_counter_[2]{};
 		int16_t per_channel_volume_ = 0;
+
+		/// Advances both channels by a single cycle, returning their combined output.
+		int16_t next_sample();
 };
 
 }
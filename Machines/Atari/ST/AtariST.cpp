@@ -27,7 +27,7 @@
 #include "../../../ClockReceiver/ForceInline.hpp"
 #include "../../../Configurable/StandardOptions.hpp"
 
-#include "../../../Outputs/Speaker/Implementation/LowpassSpeaker.hpp"
+#include "../../../Outputs/Speaker/Implementation/BLEPSpeaker.hpp"
 
 #define LOG_PREFIX "[ST] "
 #include "../../../Outputs/Log.hpp"
@@ -164,6 +164,10 @@ class ConcreteMachine:
 			return &speaker_;
 		}
 
+		void wait_for_audio() final {
+			audio_queue_.flush();
+		}
+
 		void run_for(const Cycles cycles) final {
 			// Give the keyboard an opportunity to consume any events.
 			if(!keyboard_needs_clock_) {
@@ -430,6 +434,16 @@ class ConcreteMachine:
 			return HalfCycles(0);
 		}
 
+		template <typename Microcycle> uint8_t *direct_access(const Microcycle &cycle, int) {
+			// ROM reads have no side effects and, unlike RAM, aren't aligned to the video's
+			// bus phase; ROM is never the subject of a bus error.
+			if(!(cycle.operation & Microcycle::Read)) return nullptr;
+
+			const auto address = cycle.host_endian_byte_address();
+			if(memory_map_[address >> 16] != BusDevice::ROM) return nullptr;
+			return &rom_[address - rom_start_];
+		}
+
 		void flush_output(int outputs) final {
 			dma_.flush();
 			mfp_.flush();
@@ -504,7 +518,7 @@ class ConcreteMachine:
 
 		Concurrency::AsyncTaskQueue<false> audio_queue_;
 		GI::AY38910::AY38910<false> ay_;
-		Outputs::Speaker::PullLowpass<GI::AY38910::AY38910<false>> speaker_;
+		Outputs::Speaker::PullBLEP<GI::AY38910::AY38910<false>> speaker_;
 		HalfCycles cycles_since_audio_update_;
 
 		JustInTimeActor<DMAController> dma_;
@@ -20,6 +20,10 @@ class AudioProducer {
 	public:
 		/// @returns The speaker that receives this machine's output, or @c nullptr if this machine is mute.
 		virtual Outputs::Speaker::Speaker *get_speaker() = 0;
+
+		/// Blocks until all audio that this machine has so far scheduled for generation has been delivered to
+		/// its speaker's delegate. Machines that generate audio asynchronously should override this.
+		virtual void wait_for_audio() {}
 };
 
 }
@@ -195,6 +195,10 @@ class ConcreteMachine:
 			return &speaker_;
 		}
 
+		void wait_for_audio() final {
+			audio_queue_.flush();
+		}
+
 		void run_for(const Cycles cycles) final {
 			z80_.run_for(cycles);
 		}
@@ -0,0 +1,50 @@
+//
+//  State.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 16/10/2026.
+//  Copyright 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef Machines_Commodore_Vic20_State_hpp
+#define Machines_Commodore_Vic20_State_hpp
+
+#include "../../../Reflection/Struct.hpp"
+#include "../../../Processors/6502/State/State.hpp"
+
+#include "../../../Components/6522/6522.hpp"
+#include "../../../Components/6560/6560.hpp"
+
+namespace Commodore {
+namespace Vic20 {
+
+/*!
+	Captures the Vic-20 itself; any attached tape or C1540 is not included.
+*/
+struct State: public Reflection::StructImpl<State> {
+	CPU::MOS6502::State m6502;
+	MOS::MOS6560::State mos6560;
+	MOS::MOS6522::State user_port_via;
+	MOS::MOS6522::State keyboard_via;
+
+	// All 64kb of RAM is included regardless of the amount enabled; colour
+	// RAM is 1kb.
+	std::vector<uint8_t> ram;
+	std::vector<uint8_t> colour_ram;
+
+	State() {
+		if(needs_declare()) {
+			DeclareField(m6502);
+			DeclareField(mos6560);
+			DeclareField(user_port_via);
+			DeclareField(keyboard_via);
+			DeclareField(ram);
+			DeclareField(colour_ram);
+		}
+	}
+};
+
+}
+}
+
+#endif /* Machines_Commodore_Vic20_State_hpp */
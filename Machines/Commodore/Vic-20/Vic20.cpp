@@ -9,6 +9,7 @@
 #include "Vic20.hpp"
 
 #include "Keyboard.hpp"
+#include "State.hpp"
 
 #include "../../../Activity/Source.hpp"
 #include "../../MachineTypes.hpp"
@@ -277,6 +278,7 @@ class ConcreteMachine:
 	public MachineTypes::MediaTarget,
 	public MachineTypes::MappedKeyboardMachine,
 	public MachineTypes::JoystickMachine,
+	public MachineTypes::StateProducer,
 	public Configurable::Device,
 	public CPU::MOS6502::BusHandler,
 	public MOS::MOS6522::IRQDelegatePortHandler::Delegate,
@@ -440,6 +442,11 @@ class ConcreteMachine:
 			if(!target.loading_command.empty()) {
 				type_string(target.loading_command);
 			}
+
+			// Install state if supplied.
+			if(target.state) {
+				set_state(*target.state);
+			}
 		}
 
 		bool insert_media(const Analyser::Static::Media &media) final {
@@ -653,6 +660,10 @@ class ConcreteMachine:
 			return mos6560_.get_speaker();
 		}
 
+		void wait_for_audio() final {
+			mos6560_.wait_for_audio();
+		}
+
 		void mos6522_did_change_interrupt_status(void *) final {
 			m6502_.set_nmi_line(user_port_via_.get_interrupt_line());
 			m6502_.set_irq_line(keyboard_via_.get_interrupt_line());
@@ -674,6 +685,45 @@ class ConcreteMachine:
 			return &keyboard_mapper_;
 		}
 
+		// MARK: - StateProducer.
+
+		std::unique_ptr<Reflection::Struct> get_state() final {
+			auto state = std::make_unique<State>();
+			get_state(*state);
+			return state;
+		}
+
+		void get_state(Reflection::Struct &target) final {
+			auto &state = static_cast<State &>(target);
+
+			update_video();
+			state.m6502 = CPU::MOS6502::State(m6502_);
+			state.mos6560 = MOS::MOS6560::State(mos6560_);
+			state.user_port_via = MOS::MOS6522::State(user_port_via_);
+			state.keyboard_via = MOS::MOS6522::State(keyboard_via_);
+
+			state.ram.assign(std::begin(ram_), std::end(ram_));
+			state.colour_ram.assign(std::begin(colour_ram_), std::end(colour_ram_));
+		}
+
+		void set_state(const Reflection::Struct &target) final {
+			// Bring video up to date before applying its new state, so that
+			// output already owed is produced from the old.
+			const auto &state = static_cast<const State &>(target);
+			update_video();
+
+			state.mos6560.apply(mos6560_);
+			state.user_port_via.apply(user_port_via_);
+			state.keyboard_via.apply(keyboard_via_);
+
+			memcpy(ram_, state.ram.data(), std::min(sizeof(ram_), state.ram.size()));
+			memcpy(colour_ram_, state.colour_ram.data(), std::min(sizeof(colour_ram_), state.colour_ram.size()));
+
+			// Apply CPU state last, as the VIAs will have announced their interrupt
+			// outputs to it, possibly triggering an NMI.
+			state.m6502.apply(m6502_);
+		}
+
 		// MARK: - Configuration options.
 		std::unique_ptr<Reflection::Struct> get_options() final {
 			auto options = std::make_unique<Options>(Configurable::OptionsType::UserFriendly);
@@ -15,7 +15,7 @@
 #include "../../ClockReceiver/ClockReceiver.hpp"
 #include "../../ClockReceiver/ForceInline.hpp"
 #include "../../Configurable/StandardOptions.hpp"
-#include "../../Outputs/Speaker/Implementation/LowpassSpeaker.hpp"
+#include "../../Outputs/Speaker/Implementation/BLEPSpeaker.hpp"
 #include "../../Processors/6502/6502.hpp"
 
 #include "../../Storage/MassStorage/SCSI/SCSI.hpp"
@@ -531,6 +531,10 @@ template <bool has_scsi_bus> class ConcreteMachine:
 			return &speaker_;
 		}
 
+		void wait_for_audio() final {
+			audio_queue_.flush();
+		}
+
 		void run_for(const Cycles cycles) final {
 			m6502_.run_for(cycles);
 		}
@@ -772,7 +776,7 @@ template <bool has_scsi_bus> class ConcreteMachine:
 
 		Concurrency::AsyncTaskQueue<false> audio_queue_;
 		SoundGenerator sound_generator_;
-		Outputs::Speaker::PullLowpass<SoundGenerator> speaker_;
+		Outputs::Speaker::PullBLEP<SoundGenerator> speaker_;
 
 		bool speaker_is_enabled_ = false;
 
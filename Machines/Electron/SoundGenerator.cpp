@@ -22,7 +22,7 @@ void SoundGenerator::set_sample_volume_range(std::int16_t range) {
 void SoundGenerator::get_samples(std::size_t number_of_samples, int16_t *target) {
 	if(is_enabled_) {
 		while(number_of_samples--) {
-			*target = int16_t((counter_ / (divider_+1)) * volume_);
+			*target = level();
 			target++;
 			counter_ = (counter_ + 1) % ((divider_+1) * 2);
 		}
@@ -30,12 +30,41 @@ class SoundGenerator: public ::Outputs::Speaker::SampleSource {
 		void set_sample_volume_range(std::int16_t range);
 		static constexpr bool get_is_stereo() { return false; }
 
+		// To satisfy ::StepSource.
+		template <typename TargetT> void get_steps(std::size_t number_of_cycles, TargetT &target) {
+			if(!is_enabled_) {
+				target.step(0, 0);
+				return;
+			}
+
+			// The output is low for the first divider_+1 counts of each period, then high for the same.
+			const unsigned int half_period = divider_ + 1;
+			target.step(0, level());
+
+			std::size_t offset = 0;
+			while(true) {
+				const unsigned int next_change = half_period - (counter_ % half_period);
+				if(offset + next_change >= number_of_cycles) {
+					counter_ = unsigned((counter_ + (number_of_cycles - offset)) % (half_period * 2));
+					return;
+				}
+
+				offset += next_change;
+				counter_ = (counter_ + next_change) % (half_period * 2);
+				target.step(offset, level());
+			}
+		}
+
 	private:
 		Concurrency::AsyncTaskQueue<false> &audio_queue_;
 		unsigned int counter_ = 0;
 		unsigned int divider_ = 0;
 		bool is_enabled_ = false;
 		unsigned int volume_ = 0;
+
+		int16_t level() const {
+			return int16_t((counter_ / (divider_+1)) * volume_);
+		}
 };
 
 }
@@ -100,113 +100,121 @@ void Audio::update_channel(int c) {
 }
 
 void Audio::get_samples(std::size_t number_of_samples, int16_t *target) {
-	struct Frame {
-		int16_t left, right;
-	} output_level;
 	Frame *target_frames = reinterpret_cast<Frame *>(target);
 
 	size_t c = 0;
 	while(c < number_of_samples) {
-		// I'm unclear on the details of the time division multiplexing so,
-		// for now, just sum the outputs.
-		output_level.left =
-			volume_ *
-				(use_direct_output_[0] ?
-					channels_[0].amplitude[0]
-					: (
-						channels_[0].amplitude[0] * (channels_[0].output & 1) +
-						channels_[1].amplitude[0] * (channels_[1].output & 1) +
-						channels_[2].amplitude[0] * (channels_[2].output & 1) +
-						noise_.amplitude[0] * noise_.final_output
-				));
-
-		output_level.right =
-			volume_ *
-				(use_direct_output_[1] ?
-					channels_[0].amplitude[1]
-					: (
-						channels_[0].amplitude[1] * (channels_[0].output & 1) +
-						channels_[1].amplitude[1] * (channels_[1].output & 1) +
-						channels_[2].amplitude[1] * (channels_[2].output & 1) +
-						noise_.amplitude[1] * noise_.final_output
-				));
-
+		const Frame output_level = level();
 		while(global_divider_ && c < number_of_samples) {
 			--global_divider_;
 			target_frames[c] = output_level;
 			++c;
 		}
 
+		advance();
+	}
+}
+
+Audio::Frame Audio::level() const {
+	Frame output_level;
+
+	// I'm unclear on the details of the time division multiplexing so,
+	// for now, just sum the outputs.
+	output_level.left =
+		volume_ *
+			(use_direct_output_[0] ?
+				channels_[0].amplitude[0]
+				: (
+					channels_[0].amplitude[0] * (channels_[0].output & 1) +
+					channels_[1].amplitude[0] * (channels_[1].output & 1) +
+					channels_[2].amplitude[0] * (channels_[2].output & 1) +
+					noise_.amplitude[0] * noise_.final_output
+			));
+
+	output_level.right =
+		volume_ *
+			(use_direct_output_[1] ?
+				channels_[0].amplitude[1]
+				: (
+					channels_[0].amplitude[1] * (channels_[0].output & 1) +
+					channels_[1].amplitude[1] * (channels_[1].output & 1) +
+					channels_[2].amplitude[1] * (channels_[2].output & 1) +
+					noise_.amplitude[1] * noise_.final_output
+			));
+
+	return output_level;
+}
+
+void Audio::advance() {
+	global_divider_ = global_divider_reload_;
+	if(!global_divider_) {
 		global_divider_ = global_divider_reload_;
-		if(!global_divider_) {
-			global_divider_ = global_divider_reload_;
-		}
-		poly_state_[int(Channel::Distortion::FourBit)] = poly4_.next();
-		poly_state_[int(Channel::Distortion::FiveBit)] = poly5_.next();
-		poly_state_[int(Channel::Distortion::SevenBit)] = poly7_.next();
-		if(noise_.swap_polynomial) {
-			poly_state_[int(Channel::Distortion::SevenBit)] = poly_state_[int(Channel::Distortion::None)];
-		}
+	}
+	poly_state_[int(Channel::Distortion::FourBit)] = poly4_.next();
+	poly_state_[int(Channel::Distortion::FiveBit)] = poly5_.next();
+	poly_state_[int(Channel::Distortion::SevenBit)] = poly7_.next();
+	if(noise_.swap_polynomial) {
+		poly_state_[int(Channel::Distortion::SevenBit)] = poly_state_[int(Channel::Distortion::None)];
+	}
 
-		// Update tone channels.
-		update_channel(0);
-		update_channel(1);
-		update_channel(2);
-
-		// Update noise channel.
-
-		// Step 1: decide whether there is a tick to apply.
-		bool noise_tick = false;
-		if(noise_.frequency == Noise::Frequency::DivideByFour) {
-			if(!noise_.count) {
-				noise_tick = true;
-				noise_.count = 3;
-			} else {
-				--noise_.count;
-			}
-		} else {
-			noise_tick = (channels_[int(noise_.frequency) - 1].output&3) == 2;
-		}
+	// Update tone channels.
+	update_channel(0);
+	update_channel(1);
+	update_channel(2);
 
-		// Step 2: tick if necessary.
-		int noise_output = noise_.output & 1;
-		noise_.output <<= 1;
-		if(noise_tick) {
-			switch(noise_.polynomial) {
-				case Noise::Polynomial::SeventeenBit:
-					poly_state_[int(Channel::Distortion::None)] = uint8_t(poly17_.next());
-				break;
-				case Noise::Polynomial::FifteenBit:
-					poly_state_[int(Channel::Distortion::None)] = uint8_t(poly15_.next());
-				break;
-				case Noise::Polynomial::ElevenBit:
-					poly_state_[int(Channel::Distortion::None)] = uint8_t(poly11_.next());
-				break;
-				case Noise::Polynomial::NineBit:
-					poly_state_[int(Channel::Distortion::None)] = uint8_t(poly9_.next());
-				break;
-			}
+	// Update noise channel.
 
-			noise_output = poly_state_[int(Channel::Distortion::None)];
+	// Step 1: decide whether there is a tick to apply.
+	bool noise_tick = false;
+	if(noise_.frequency == Noise::Frequency::DivideByFour) {
+		if(!noise_.count) {
+			noise_tick = true;
+			noise_.count = 3;
+		} else {
+			--noise_.count;
 		}
-		noise_.output |= noise_output;
+	} else {
+		noise_tick = (channels_[int(noise_.frequency) - 1].output&3) == 2;
+	}
 
-		// Low pass: sample channel 2 on downward transitions of the prima facie output.
-		if(noise_.low_pass && (noise_.output & 3) == 2) {
-			noise_.output = (noise_.output & ~1) | (channels_[2].output & 1);
+	// Step 2: tick if necessary.
+	int noise_output = noise_.output & 1;
+	noise_.output <<= 1;
+	if(noise_tick) {
+		switch(noise_.polynomial) {
+			case Noise::Polynomial::SeventeenBit:
+				poly_state_[int(Channel::Distortion::None)] = uint8_t(poly17_.next());
+			break;
+			case Noise::Polynomial::FifteenBit:
+				poly_state_[int(Channel::Distortion::None)] = uint8_t(poly15_.next());
+			break;
+			case Noise::Polynomial::ElevenBit:
+				poly_state_[int(Channel::Distortion::None)] = uint8_t(poly11_.next());
+			break;
+			case Noise::Polynomial::NineBit:
+				poly_state_[int(Channel::Distortion::None)] = uint8_t(poly9_.next());
+			break;
 		}
 
-		// Apply noise high-pass.
-		if(noise_.high_pass && (channels_[0].output & 3) == 2) {
-			noise_.output &= ~1;
-		}
+		noise_output = poly_state_[int(Channel::Distortion::None)];
+	}
+	noise_.output |= noise_output;
 
-		// Update noise ring modulation, if any.
-		if(noise_.ring_modulate) {
-			noise_.final_output = !((noise_.output ^ channels_[1].output) & 1);
-		} else {
-			noise_.final_output = noise_.output & 1;
-		}
+	// Low pass: sample channel 2 on downward transitions of the prima facie output.
+	if(noise_.low_pass && (noise_.output & 3) == 2) {
+		noise_.output = (noise_.output & ~1) | (channels_[2].output & 1);
+	}
+
+	// Apply noise high-pass.
+	if(noise_.high_pass && (channels_[0].output & 3) == 2) {
+		noise_.output &= ~1;
+	}
+
+	// Update noise ring modulation, if any.
+	if(noise_.ring_modulate) {
+		noise_.final_output = !((noise_.output ^ channels_[1].output) & 1);
+	} else {
+		noise_.final_output = noise_.output & 1;
 	}
 }
 
@@ -9,6 +9,7 @@
 #ifndef Dave_hpp
 #define Dave_hpp
 
+#include <algorithm>
 #include <cstdint>
 
 #include "../../ClockReceiver/ClockReceiver.hpp"
@@ -42,11 +43,36 @@ class Audio: public Outputs::Speaker::SampleSource {
 		static constexpr bool get_is_stereo() { return true; }	// Dave produces stereo sound.
 		void get_samples(std::size_t number_of_samples, int16_t *target);
 
+		// MARK: - StepSource.
+		template <typename TargetT> void get_steps(std::size_t number_of_cycles, TargetT &target) {
+			std::size_t c = 0;
+			while(c < number_of_cycles) {
+				const Frame output_level = level();
+				target.step(c, output_level.left, output_level.right);
+
+				const auto length = std::min(std::size_t(global_divider_), number_of_cycles - c);
+				global_divider_ -= uint8_t(length);
+				c += length;
+
+				advance();
+			}
+		}
+
 	private:
 		Concurrency::AsyncTaskQueue<false> &audio_queue_;
 
+		struct Frame {
+			int16_t left, right;
+		};
+
+		/// @returns The current output level.
+		Frame level() const;
+
+		/// Reloads the global divider and advances all tone and noise generators by a single step.
+		void advance();
+
 		// Global divider (i.e. 8MHz/12Mhz switch).
-		uint8_t global_divider_;
+		uint8_t global_divider_ = 0;
 		uint8_t global_divider_reload_ = 2;
 
 		// Tone channels.
@@ -115,7 +141,7 @@ class Audio: public Outputs::Speaker::SampleSource {
 		Numeric::LFSRv<0x12000> poly17_;
 
 		// Current state of the active polynomials.
-		uint8_t poly_state_[4];
+		uint8_t poly_state_[4]{};
 };
 
 /*!
@@ -18,7 +18,7 @@
 
 #include "../../Analyser/Static/Enterprise/Target.hpp"
 #include "../../ClockReceiver/JustInTime.hpp"
-#include "../../Outputs/Speaker/Implementation/LowpassSpeaker.hpp"
+#include "../../Outputs/Speaker/Implementation/BLEPSpeaker.hpp"
 #include "../../Processors/Z80/Z80.hpp"
 
 #define LOG_PREFIX "[Enterprise] "
@@ -632,6 +632,10 @@ template <bool has_disk_controller, bool is_6mhz> class ConcreteMachine:
 			return &speaker_;
 		}
 
+		void wait_for_audio() final {
+			audio_queue_.flush();
+		}
+
 		// MARK: - TimedMachine
 		void run_for(const Cycles cycles) override {
 			z80_.run_for(cycles);
@@ -707,7 +711,7 @@ template <bool has_disk_controller, bool is_6mhz> class ConcreteMachine:
 
 		Concurrency::AsyncTaskQueue<false> audio_queue_;
 		Dave::Audio dave_audio_;
-		Outputs::Speaker::PullLowpass<Dave::Audio> speaker_;
+		Outputs::Speaker::PullBLEP<Dave::Audio> speaker_;
 		HalfCycles time_since_audio_update_;
 
 		HalfCycles dave_delay_ = HalfCycles(2);
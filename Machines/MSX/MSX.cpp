@@ -39,6 +39,7 @@
 #include "../../Outputs/Log.hpp"
 #include "../../Outputs/Speaker/Implementation/CompoundSource.hpp"
 #include "../../Outputs/Speaker/Implementation/LowpassSpeaker.hpp"
+#include "../../Outputs/Speaker/Implementation/ReplayingSource.hpp"
 #include "../../Outputs/Speaker/Implementation/SampleSource.hpp"
 
 #include "../../Configurable/StandardOptions.hpp"
@@ -149,9 +150,10 @@ class ConcreteMachine:
 			vdp_(TI::TMS::TMS9918A),
 			i8255_(i8255_port_handler_),
 			ay_(GI::AY38910::Personality::AY38910, audio_queue_),
+			ay_source_(ay_, ay_register_write_log_),
 			audio_toggle_(audio_queue_),
 			scc_(audio_queue_),
-			mixer_(ay_, audio_toggle_, scc_),
+			mixer_(ay_source_, audio_toggle_, scc_),
 			speaker_(mixer_),
 			tape_player_(3579545 * 2),
 			i8255_port_handler_(*this, audio_toggle_, tape_player_),
@@ -161,6 +163,7 @@ class ConcreteMachine:
 			clear_all_keys();
 
 			ay_.set_port_handler(&ay_port_handler_);
+			ay_.set_register_write_log(&ay_register_write_log_);
 			speaker_.set_input_rate(3579545.0f / 2.0f);
 			tape_player_.set_clocking_hint_observer(this);
 
@@ -298,6 +301,10 @@ class ConcreteMachine:
 			return &speaker_;
 		}
 
+		void wait_for_audio() final {
+			audio_queue_.flush();
+		}
+
 		void run_for(const Cycles cycles) final {
 			z80_.run_for(cycles);
 		}
@@ -531,7 +538,7 @@ class ConcreteMachine:
 							break;
 
 							case 0xa2:
-								update_audio();
+								update_ay();
 								*cycle.value = GI::AY38910::Utility::read(ay_);
 							break;
 
@@ -555,7 +562,7 @@ class ConcreteMachine:
 							break;
 
 							case 0xa0:	case 0xa1:
-								update_audio();
+								update_ay();
 								GI::AY38910::Utility::write(ay_, port == 0xa1, *cycle.value);
 							break;
 
@@ -620,8 +627,7 @@ class ConcreteMachine:
 				vdp_.flush();
 			}
 			if(outputs & Output::Audio) {
-				update_audio();
-				audio_queue_.perform();
+				flush_audio();
 			}
 		}
 
@@ -686,8 +692,35 @@ class ConcreteMachine:
 		DiskROM *get_disk_rom() {
 			return dynamic_cast<DiskROM *>(memory_slots_[2].handler.get());
 		}
+
+		/// Brings the AY's register write log up to now, so that subsequent writes are timestamped correctly.
+		void update_ay() {
+			ay_register_write_log_.advance(uint64_t(time_since_ay_update_.divide_cycles(Cycles(2)).as_integral()));
+
+			// Don't allow the log to fill up between calls to flush_audio.
+			if(ay_register_write_log_.size() >= AYLog::Capacity / 2) {
+				flush_audio();
+			}
+		}
+
+		/// Issues a request for the speaker to run up to the current time; this must precede any change
+		/// to the audio toggle or to the SCC, which post their changes to the audio queue.
 		void update_audio() {
-			speaker_.run_for(audio_queue_, time_since_ay_update_.divide_cycles(Cycles(2)));
+			ay_register_write_log_.advance(uint64_t(time_since_ay_update_.divide_cycles(Cycles(2)).as_integral()));
+
+			const auto time = ay_register_write_log_.time();
+			speaker_.run_for(audio_queue_, Cycles(Cycles::IntType(time - posted_audio_time_)));
+			posted_audio_time_ = time;
+		}
+
+		/// Issues a request to perform all audio processing up to the current time, including draining
+		/// the AY's register write log if the speaker isn't currently consuming samples.
+		void flush_audio() {
+			update_audio();
+			audio_queue_.enqueue([this, time = posted_audio_time_] {
+				ay_source_.catch_up(time);
+			});
+			audio_queue_.perform();
 		}
 
 		class i8255PortHandler: public Intel::i8255::PortHandler {
@@ -747,12 +780,18 @@ class ConcreteMachine:
 		JustInTimeActor<TI::TMS::TMS9918> vdp_;
 		Intel::i8255::i8255<i8255PortHandler> i8255_;
 
+		using AY = GI::AY38910::AY38910<false>;
+		using AYLog = Concurrency::RegisterWriteLog<>;
+		using AYSource = Outputs::Speaker::ReplayingSource<AY, AYLog>;
+
 		Concurrency::AsyncTaskQueue<false> audio_queue_;
-		GI::AY38910::AY38910<false> ay_;
+		AYLog ay_register_write_log_;
+		AY ay_;
+		AYSource ay_source_;
 		Audio::Toggle audio_toggle_;
 		Konami::SCC scc_;
-		Outputs::Speaker::CompoundSource<GI::AY38910::AY38910<false>, Audio::Toggle, Konami::SCC> mixer_;
-		Outputs::Speaker::PullLowpass<Outputs::Speaker::CompoundSource<GI::AY38910::AY38910<false>, Audio::Toggle, Konami::SCC>> speaker_;
+		Outputs::Speaker::CompoundSource<AYSource, Audio::Toggle, Konami::SCC> mixer_;
+		Outputs::Speaker::PullLowpass<Outputs::Speaker::CompoundSource<AYSource, Audio::Toggle, Konami::SCC>> speaker_;
 
 		Storage::Tape::BinaryTapePlayer tape_player_;
 		bool tape_player_is_sleeping_ = false;
@@ -789,6 +828,7 @@ class ConcreteMachine:
 		uint8_t unpopulated_[8192];
 
 		HalfCycles time_since_ay_update_;
+		uint64_t posted_audio_time_ = 0;
 
 		uint8_t key_states_[16];
 		int selected_key_line_ = 0;
@@ -30,7 +30,7 @@
 
 #include "../../ClockReceiver/ForceInline.hpp"
 #include "../../Configurable/StandardOptions.hpp"
-#include "../../Outputs/Speaker/Implementation/LowpassSpeaker.hpp"
+#include "../../Outputs/Speaker/Implementation/BLEPSpeaker.hpp"
 
 #include "../../Analyser/Static/Oric/Target.hpp"
 
@@ -84,7 +84,7 @@ namespace Oric {
 using DiskInterface = Analyser::Static::Oric::Target::DiskInterface;
 using Processor = Analyser::Static::Oric::Target::Processor;
 using AY = GI::AY38910::AY38910<false>;
-using Speaker = Outputs::Speaker::PullLowpass<AY>;
+using Speaker = Outputs::Speaker::PullBLEP<AY>;
 
 enum ROM {
 	BASIC10 = 0, BASIC11, Microdisc, Colour
@@ -609,6 +609,10 @@ template <Analyser::Static::Oric::Target::DiskInterface disk_interface, CPU::MOS
 			return &speaker_;
 		}
 
+		void wait_for_audio() final {
+			audio_queue_.flush();
+		}
+
 		void run_for(const Cycles cycles) final {
 			m6502_.run_for(cycles);
 		}
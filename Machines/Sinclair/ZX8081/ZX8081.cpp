@@ -20,7 +20,7 @@
 #include "../../Utility/MemoryFuzzer.hpp"
 #include "../../Utility/Typer.hpp"
 
-#include "../../../Outputs/Speaker/Implementation/LowpassSpeaker.hpp"
+#include "../../../Outputs/Speaker/Implementation/BLEPSpeaker.hpp"
 
 #include "../../../Analyser/Static/ZX8081/Target.hpp"
 
@@ -317,6 +317,10 @@ template<bool is_zx81> class ConcreteMachine:
 			return is_zx81 ? &speaker_ : nullptr;
 		}
 
+		void wait_for_audio() final {
+			audio_queue_.flush();
+		}
+
 		void run_for(const Cycles cycles) final {
 			z80_.run_for(cycles);
 		}
@@ -471,7 +475,7 @@ template<bool is_zx81> class ConcreteMachine:
 		Concurrency::AsyncTaskQueue<false> audio_queue_;
 		using AY = GI::AY38910::AY38910<false>;
 		AY ay_;
-		Outputs::Speaker::PullLowpass<AY> speaker_;
+		Outputs::Speaker::PullBLEP<AY> speaker_;
 		HalfCycles time_since_ay_update_;
 		inline void ay_set_register(uint8_t value) {
 			update_audio();
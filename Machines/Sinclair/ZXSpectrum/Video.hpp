@@ -267,7 +267,7 @@ template <Timing timing> class Video {
 			return HalfCycles(timings.half_cycles_per_line * timings.lines_per_frame);
 		}
 
-		HalfCycles time_since_interrupt() {
+		HalfCycles time_since_interrupt() const {
 			const auto timings = get_timings();
 			if(time_into_frame_ >= timings.interrupt_time) {
 				return HalfCycles(time_into_frame_ - timings.interrupt_time);
@@ -286,13 +286,13 @@ template <Timing timing> class Video {
 			if(target == now) return;
 
 			// Is the time within this frame?
-			if(time > now) {
-				run_for(target - time);
+			if(target > now) {
+				run_for(target - now);
 				return;
 			}
 
 			// Then it's necessary to finish this frame and run into the next.
-			run_for(frame_duration() - now + time);
+			run_for(frame_duration() - now + target);
 		}
 
 	public:
@@ -483,12 +483,14 @@ struct State: public Reflection::StructImpl<State> {
 		half_cycles_since_interrupt = source.time_since_interrupt().template as<int>();
 	}
 
-	template <typename Video> void apply(Video &target) {
+	template <typename Video> void apply(Video &target) const {
+		// Seek first, as doing so runs the video forward and may therefore
+		// affect all the other fields.
+		target.set_time_since_interrupt(HalfCycles(half_cycles_since_interrupt));
 		target.set_border_colour(border_colour);
 		target.flash_mask_ = flash ? 0xff : 0x00;
 		target.flash_counter_ = flash_counter;
 		target.is_alternate_line_ = is_alternate_line;
-		target.set_time_since_interrupt(HalfCycles(half_cycles_since_interrupt));
 	}
 };
 
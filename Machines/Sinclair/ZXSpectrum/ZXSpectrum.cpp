@@ -128,6 +128,7 @@ template<Model model> class ConcreteMachine:
 	public MachineTypes::MappedKeyboardMachine,
 	public MachineTypes::MediaTarget,
 	public MachineTypes::ScanProducer,
+	public MachineTypes::StateProducer,
 	public MachineTypes::TimedMachine,
 	public Utility::TypeRecipient<CharacterMapper> {
 	public:
@@ -189,25 +190,7 @@ template<Model model> class ConcreteMachine:
 
 			// Install state if supplied.
 			if(target.state) {
-				const auto state = static_cast<State *>(target.state.get());
-				state->z80.apply(z80_);
-				state->video.apply(*video_.last_valid());
-				state->ay.apply(ay_);
-
-				// If this is a 48k or 16k machine, remap source data from its original
-				// linear form to whatever the banks end up being; otherwise copy as is.
-				if(model <= Model::FortyEightK) {
-					const size_t num_banks = std::min(size_t(48*1024), state->ram.size()) >> 14;
-					for(size_t c = 0; c < num_banks; c++) {
-						memcpy(&write_pointers_[c + 1][(c+1) * 0x4000], &state->ram[c * 0x4000], 0x4000);
-					}
-				} else {
-					memcpy(ram_.data(), state->ram.data(), std::min(ram_.size(), state->ram.size()));
-
-					port1ffd_ = state->last_1ffd;
-					port7ffd_ = state->last_7ffd;
-					update_memory_map();
-				}
+				set_state(*target.state);
 			}
 		}
 
@@ -296,6 +279,68 @@ template<Model model> class ConcreteMachine:
 			return video_->get_display_type();
 		}
 
+		// MARK: - StateProducer.
+
+		std::unique_ptr<Reflection::Struct> get_state() final {
+			auto state = std::make_unique<State>();
+			get_state(*state);
+			return state;
+		}
+
+		void get_state(Reflection::Struct &target) final {
+			auto &state = static_cast<State &>(target);
+
+			state.z80 = CPU::Z80::State(z80_);
+			video_.flush();
+			state.video = Video::State(*video_.last_valid());
+			state.ay = GI::AY38910::State(ay_);
+
+			// As per set_state, 16kb and 48kb machines are captured in linear
+			// order, others by bank.
+			if constexpr (model <= Model::FortyEightK) {
+				constexpr size_t num_banks = model == Model::SixteenK ? 1 : 3;
+				state.ram.resize(num_banks * 0x4000);
+				for(size_t c = 0; c < num_banks; c++) {
+					memcpy(&state.ram[c * 0x4000], &read_pointers_[c + 1][(c+1) * 0x4000], 0x4000);
+				}
+			} else {
+				state.ram.assign(ram_.begin(), ram_.end());
+			}
+
+			state.last_7ffd = port7ffd_;
+			state.last_1ffd = port1ffd_;
+		}
+
+		void set_state(const Reflection::Struct &target) final {
+			// Bring audio and video up to date before applying their new state,
+			// so that output already owed is produced from the old.
+			const auto &state = static_cast<const State &>(target);
+			update_audio();
+			video_.flush();
+
+			state.z80.apply(z80_);
+			state.video.apply(*video_.last_valid());
+			video_.update_sequence_point();
+			state.ay.apply(ay_);
+
+			// If this is a 48k or 16k machine, remap source data from its original
+			// linear form to whatever the banks end up being; otherwise copy as is.
+			if constexpr (model <= Model::FortyEightK) {
+				const size_t num_banks = std::min(size_t(48*1024), state.ram.size()) >> 14;
+				for(size_t c = 0; c < num_banks; c++) {
+					memcpy(&write_pointers_[c + 1][(c+1) * 0x4000], &state.ram[c * 0x4000], 0x4000);
+				}
+			} else {
+				memcpy(ram_.data(), state.ram.data(), std::min(ram_.size(), state.ram.size()));
+
+				port1ffd_ = state.last_1ffd;
+				port7ffd_ = state.last_7ffd;
+				disable_paging_ = false;
+				update_memory_map();
+				set_video_address();
+			}
+		}
+
 		// MARK: - BusHandler.
 
 		forceinline HalfCycles perform_machine_cycle(const CPU::Z80::PartialMachineCycle &cycle) {
@@ -743,6 +788,10 @@ template<Model model> class ConcreteMachine:
 			return &speaker_;
 		}
 
+		void wait_for_audio() override {
+			audio_queue_.flush();
+		}
+
 		// MARK: - Activity Source.
 		void set_activity_observer(Activity::Observer *observer) override {
 			if constexpr (model == Model::Plus3) fdc_->set_activity_observer(observer);
@@ -9,18 +9,75 @@
 #ifndef State_h
 #define State_h
 
+#include "../Reflection/Struct.hpp"
+
+#include <cstdint>
 #include <memory>
-#include "../Analyser/Static/StaticAnalyser.hpp"
+#include <vector>
 
 namespace MachineTypes {
 
+/*!
+	A StateProducer is any machine that can capture the entirety of its current state and later
+	restore it, e.g. for snapshots, rewinding or deterministic replay.
+
+	States are Reflection::Structs, so can be serialised to and from BSON; the exact type is
+	specific to the machine and is the same type that the machine would accept as the
+	@c state of its Analyser::Static::Target.
+
+	Capturing and applying state are in-memory operations, intended to be cheap enough to perform
+	on every frame.
+
+	Currently implemented by the ZX Spectrum, Amstrad CPC, Vic-20 and 128k, 512k, 512ke and Plus
+	Macintoshes. States cover the processor, RAM and the machine's own chips; they do not include
+	disk or tape drives and their media, SCSI devices, state internal to the audio-generation thread
+	or the current state of host inputs such as the mouse.
+*/
 struct StateProducer {
-	// TODO.
-//	virtual bool get_state(Analyser::Static::State *, [[maybe_unused]] bool advance_to_simple = false) {
-//		return false;
-//	}
-};
+	/*!
+		@returns A newly-allocated snapshot of the machine's current state.
+	*/
+	virtual std::unique_ptr<Reflection::Struct> get_state() = 0;
+
+	/*!
+		Captures the machine's current state into @c state, which must have been obtained from an
+		earlier call to @c get_state() on a machine of the same type.
 
+		Storage within @c state is reused, so repeated captures into the same object do not allocate.
+	*/
+	virtual void get_state(Reflection::Struct &state) = 0;
+
+	/*!
+		Replaces the machine's current state with @c state, which must have been obtained from
+		@c get_state() on a machine of the same type, possibly via a round trip through BSON.
+	*/
+	virtual void set_state(const Reflection::Struct &state) = 0;
+
+	/*!
+		@returns The machine's current state, serialised as BSON.
+	*/
+	std::vector<uint8_t> serialise_state() {
+		return get_state()->serialise();
+	}
+
+	/*!
+		Replaces the machine's current state with that described by @c bson, as previously
+		produced by @c serialise_state().
+
+		@returns @c true if @c bson was well-formed and has been applied; @c false otherwise,
+			in which case the machine's state is unchanged.
+	*/
+	bool deserialise_state(const std::vector<uint8_t> &bson) {
+		// Start from the current state so that anything absent from the BSON is left as-is.
+		const auto state = get_state();
+		if(!state->deserialise(bson)) {
+			return false;
+		}
+		set_state(*state);
+		return true;
+	}
 };
 
+}
+
 #endif /* State_h */
@@ -11,6 +11,7 @@
 
 #include "../ClockReceiver/ClockReceiver.hpp"
 #include "../ClockReceiver/TimeTypes.hpp"
+#include "../Activity/Profiler.hpp"
 
 #include "AudioProducer.hpp"
 #include "ScanProducer.hpp"
@@ -30,6 +31,8 @@ class TimedMachine {
 		virtual void run_for(Time::Seconds duration) {
 			const double cycles = (duration * clock_rate_ * speed_multiplier_) + clock_conversion_error_;
 			clock_conversion_error_ = std::fmod(cycles, 1.0);
+
+			PROFILE_SCOPE("Machine", uint64_t(cycles));
 			run_for(Cycles(int(cycles)));
 		}
 
@@ -61,6 +64,29 @@ class TimedMachine {
 			return speed_multiplier_;
 		}
 
+		/// @returns This machine's clock rate.
+		double get_clock_rate() const {
+			return clock_rate_;
+		}
+
+		/*!
+			@returns The time spent in each instrumented component since the last call to @c reset_profile(),
+			most expensive first, if this build defines PROFILE_COMPONENTS; otherwise an empty list.
+
+			The "Machine" entry is time spent within run_for that isn't attributable to any other
+			component, which is predominantly time spent in the processor.
+
+			Totals are currently process-wide, so will include all machines that are running.
+		*/
+		std::vector<Activity::Profiler::Entry> get_profile() const {
+			return Activity::Profiler::report();
+		}
+
+		/// Resets the totals reported by @c get_profile().
+		void reset_profile() {
+			Activity::Profiler::reset();
+		}
+
 		/// @returns The confidence that this machine is running content it understands.
 		virtual float get_confidence() { return 0.5f; }
 		virtual std::string debug_type() { return ""; }
@@ -84,11 +110,6 @@ class TimedMachine {
 			clock_rate_ = clock_rate;
 		}
 
-		/// Gets this machine's clock rate.
-		double get_clock_rate() const {
-			return clock_rate_;
-		}
-
 	private:
 		// Give the ScanProducer access to this machine's clock rate.
 		friend class ScanProducer;
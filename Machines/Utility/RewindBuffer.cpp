@@ -0,0 +1,311 @@
+//
+//  RewindBuffer.cpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 16/10/2026.
+//  Copyright 2026 Thomas Harte. All rights reserved.
+//
+
+#include "RewindBuffer.hpp"
+
+#include "../../Reflection/TypeInfo.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+using namespace Machine;
+
+namespace {
+
+/// Equal runs shorter than this are folded into the surrounding literal, as
+/// ending and restarting a literal would cost at least as much.
+constexpr size_t MinimumSkip = 4;
+
+void push_length(std::vector<uint8_t> &target, size_t length) {
+	while(length >= 0x80) {
+		target.push_back(uint8_t(length | 0x80));
+		length >>= 7;
+	}
+	target.push_back(uint8_t(length));
+}
+
+size_t pop_length(const uint8_t *&source) {
+	size_t length = 0;
+	int shift = 0;
+	while(*source & 0x80) {
+		length |= size_t(*source & 0x7f) << shift;
+		shift += 7;
+		++source;
+	}
+	length |= size_t(*source) << shift;
+	++source;
+	return length;
+}
+
+/// @returns The number of bytes from @c offset onwards that are identical in @c lhs and @c rhs.
+size_t equal_run(const uint8_t *lhs, const uint8_t *rhs, size_t offset, size_t size) {
+	const size_t start = offset;
+	while(offset + sizeof(uint64_t) <= size) {
+		uint64_t left, right;
+		memcpy(&left, &lhs[offset], sizeof(left));
+		memcpy(&right, &rhs[offset], sizeof(right));
+		if(left != right) break;
+		offset += sizeof(uint64_t);
+	}
+	while(offset < size && lhs[offset] == rhs[offset]) {
+		++offset;
+	}
+	return offset - start;
+}
+
+// MARK: - State images.
+//
+// Captures are stored as flat images of a state's fields, in the order provided by all_keys().
+// Unlike BSON these have a fixed layout for fixed-size fields, so consecutive images align
+// byte-for-byte, and they're cheaper to produce; they need to be meaningful only within
+// this process.
+
+/// @returns The size of a single instance of the plain-old-data type @c type, or 0 if it isn't one.
+size_t plain_size(const std::type_info &type) {
+	if(type == typeid(bool)) return sizeof(bool);
+	if(!Reflection::Enum::name(type).empty()) return sizeof(int);
+	return TypeInfo::size(&type);
+}
+
+void append(std::vector<uint8_t> &image, const void *source, size_t size) {
+	const auto bytes = reinterpret_cast<const uint8_t *>(source);
+	image.insert(image.end(), bytes, bytes + size);
+}
+
+void flatten(Reflection::Struct &state, std::vector<uint8_t> &image) {
+	for(const auto &key: state.all_keys()) {
+		const auto &type = *state.type_of(key);
+		void *const field = state.get(key);
+
+		if(type == typeid(Reflection::Struct)) {
+			flatten(*static_cast<Reflection::Struct *>(field), image);
+		} else if(type == typeid(std::vector<uint8_t>)) {
+			const auto &vector = *static_cast<std::vector<uint8_t> *>(field);
+			const uint32_t size = uint32_t(vector.size());
+			append(image, &size, sizeof(size));
+			append(image, vector.data(), size);
+		} else if(type == typeid(std::string)) {
+			const auto &string = *static_cast<std::string *>(field);
+			const uint32_t size = uint32_t(string.size());
+			append(image, &size, sizeof(size));
+			append(image, string.data(), size);
+		} else {
+			append(image, field, plain_size(type) * state.count_of(key));
+		}
+	}
+}
+
+/// Restores fields in @c state from @c image, returning @c false if the image would be overrun.
+bool unflatten(Reflection::Struct &state, const uint8_t *&image, const uint8_t *end) {
+	auto read = [&image, end] (void *target, size_t size) {
+		if(size_t(end - image) < size) return false;
+		memcpy(target, image, size);
+		image += size;
+		return true;
+	};
+
+	for(const auto &key: state.all_keys()) {
+		const auto &type = *state.type_of(key);
+		void *const field = state.get(key);
+
+		if(type == typeid(Reflection::Struct)) {
+			if(!unflatten(*static_cast<Reflection::Struct *>(field), image, end)) return false;
+		} else if(type == typeid(std::vector<uint8_t>) || type == typeid(std::string)) {
+			uint32_t size;
+			if(!read(&size, sizeof(size)) || size_t(end - image) < size) return false;
+			if(type == typeid(std::string)) {
+				static_cast<std::string *>(field)->assign(reinterpret_cast<const char *>(image), size);
+			} else {
+				static_cast<std::vector<uint8_t> *>(field)->assign(image, image + size);
+			}
+			image += size;
+		} else {
+			if(!read(field, plain_size(type) * state.count_of(key))) return false;
+		}
+	}
+	return true;
+}
+
+}
+
+RewindBuffer::RewindBuffer(DynamicMachine &machine, size_t max_captures, size_t max_bytes, size_t keyframe_interval) :
+	producer_(machine.state_producer()),
+	max_captures_(std::max(max_captures, size_t(1))),
+	max_bytes_(max_bytes),
+	keyframe_interval_(std::max(keyframe_interval, size_t(1))) {
+	if(producer_) {
+		state_ = producer_->get_state();
+	}
+}
+
+bool RewindBuffer::is_supported() const {
+	return producer_;
+}
+
+size_t RewindBuffer::size() const {
+	return captures_.size();
+}
+
+size_t RewindBuffer::memory_usage() const {
+	return memory_usage_;
+}
+
+void RewindBuffer::clear() {
+	captures_.clear();
+	latest_.clear();
+	memory_usage_ = 0;
+	captures_since_keyframe_ = 0;
+}
+
+void RewindBuffer::capture() {
+	if(!producer_) return;
+
+	producer_->get_state(*state_);
+	image_.clear();
+	flatten(*state_, image_);
+
+	Capture capture;
+	if(captures_.empty() || captures_since_keyframe_ >= keyframe_interval_ || image_.size() != latest_.size()) {
+		capture.is_keyframe = true;
+		capture.data = image_;
+		captures_since_keyframe_ = 1;
+	} else {
+		// Encode into reusable space, then copy out so that only the exact size is retained.
+		encode_delta(latest_, image_, delta_);
+		capture.data.assign(delta_.begin(), delta_.end());
+		++captures_since_keyframe_;
+	}
+	std::swap(latest_, image_);
+
+	memory_usage_ += capture.data.size();
+	captures_.push_back(std::move(capture));
+
+	while(captures_.size() > max_captures_ || (memory_usage_ > max_bytes_ && captures_.size() > 1)) {
+		discard_oldest();
+	}
+}
+
+bool RewindBuffer::rewind(size_t count) {
+	if(!producer_ || count >= captures_.size()) {
+		return false;
+	}
+
+	const size_t target = captures_.size() - 1 - count;
+	size_t keyframe = target;
+	while(!captures_[keyframe].is_keyframe) {
+		--keyframe;
+	}
+
+	// Deltas can be walked backwards from the latest state only if there are no
+	// keyframes in the way; otherwise, or if it's cheaper, walk forwards from the
+	// keyframe. The front capture is always a keyframe so one will be found.
+	const size_t latest_keyframe = captures_.size() - captures_since_keyframe_;
+	if(latest_keyframe <= target && count < target - keyframe + 1) {
+		for(size_t index = captures_.size() - 1; index > target; --index) {
+			apply_delta(captures_[index].data, latest_);
+		}
+	} else {
+		latest_ = captures_[keyframe].data;
+		for(size_t index = keyframe + 1; index <= target; ++index) {
+			apply_delta(captures_[index].data, latest_);
+		}
+	}
+
+	while(captures_.size() > target + 1) {
+		memory_usage_ -= captures_.back().data.size();
+		captures_.pop_back();
+	}
+	captures_since_keyframe_ = target - keyframe + 1;
+
+	const uint8_t *image = latest_.data();
+	if(!unflatten(*state_, image, latest_.data() + latest_.size())) {
+		clear();
+		return false;
+	}
+	producer_->set_state(*state_);
+	return true;
+}
+
+void RewindBuffer::discard_oldest() {
+	// The oldest capture is always a keyframe. If the next is a delta, fold that delta
+	// into it and promote the result so that the history remains decodable.
+	auto &oldest = captures_.front();
+	memory_usage_ -= oldest.data.size();
+
+	if(captures_.size() > 1 && !captures_[1].is_keyframe) {
+		auto &next = captures_[1];
+		memory_usage_ -= next.data.size();
+
+		apply_delta(next.data, oldest.data);
+		next.data = std::move(oldest.data);
+		next.is_keyframe = true;
+
+		memory_usage_ += next.data.size();
+	}
+
+	captures_.pop_front();
+	if(captures_.empty()) {
+		clear();
+	} else if(captures_since_keyframe_ > captures_.size()) {
+		captures_since_keyframe_ = captures_.size();
+	}
+}
+
+// MARK: - Delta encoding.
+//
+// A delta is a sequence of (skip, length, bytes) records: skip is the number of bytes that are
+// unchanged, length is the number that follow which have changed, and bytes are the XOR of
+// old and new values for that range. Both counts are stored as little-endian base-128 varints.
+
+void RewindBuffer::encode_delta(const std::vector<uint8_t> &from, const std::vector<uint8_t> &to, std::vector<uint8_t> &delta) {
+	delta.clear();
+
+	const size_t size = to.size();
+	size_t offset = 0;
+	while(true) {
+		const size_t skip = equal_run(from.data(), to.data(), offset, size);
+		if(offset + skip == size) break;
+
+		// Find the end of the changed range, absorbing any short runs of equal bytes.
+		const size_t start = offset + skip;
+		size_t end = start;
+		while(end < size) {
+			if(from[end] != to[end]) {
+				++end;
+				continue;
+			}
+			const size_t gap = equal_run(from.data(), to.data(), end, size);
+			if(gap >= MinimumSkip || end + gap == size) break;
+			end += gap;
+		}
+
+		push_length(delta, skip);
+		push_length(delta, end - start);
+		for(size_t c = start; c < end; ++c) {
+			delta.push_back(from[c] ^ to[c]);
+		}
+		offset = end;
+	}
+}
+
+void RewindBuffer::apply_delta(const std::vector<uint8_t> &delta, std::vector<uint8_t> &target) {
+	const uint8_t *source = delta.data();
+	const uint8_t *const end = source + delta.size();
+	uint8_t *destination = target.data();
+
+	while(source < end) {
+		destination += pop_length(source);
+		const size_t length = pop_length(source);
+		for(size_t c = 0; c < length; ++c) {
+			destination[c] ^= source[c];
+		}
+		destination += length;
+		source += length;
+	}
+}
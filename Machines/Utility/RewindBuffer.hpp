@@ -0,0 +1,102 @@
+//
+//  RewindBuffer.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 16/10/2026.
+//  Copyright 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef RewindBuffer_hpp
+#define RewindBuffer_hpp
+
+#include "../DynamicMachine.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <vector>
+
+namespace Machine {
+
+/*!
+	Maintains a bounded history of a machine's state, from which it can be rewound.
+
+	The owner calls @c capture() at regular intervals, conventionally once per frame. Each capture
+	flattens the machine's state into an image and stores it as a run-length encoding of its XOR with
+	the capture before, so that storage and restoration costs are proportional to what changed rather than to the
+	size of the machine. A full keyframe is retained periodically and whenever the image size changes.
+
+	Because XOR deltas apply in either direction, rewinding by a few captures walks backwards from the most
+	recent state; rewinding further starts from whichever keyframe is closer.
+
+	This works for any DynamicMachine that provides a StateProducer; for others @c is_supported() is @c false
+	and captures are ignored.
+*/
+class RewindBuffer {
+	public:
+		/*!
+			Creates a buffer for @c machine that will hold at most @c max_captures captures and aim to use at
+			most @c max_bytes of storage, discarding the oldest captures as necessary. A keyframe is stored
+			at least once every @c keyframe_interval captures.
+		*/
+		RewindBuffer(
+			DynamicMachine &machine,
+			size_t max_captures = 60 * 50,
+			size_t max_bytes = 64 * 1024 * 1024,
+			size_t keyframe_interval = 60);
+
+		/// @returns @c true if the machine can be captured and restored; @c false otherwise.
+		bool is_supported() const;
+
+		/// Appends the machine's current state to the history, discarding the oldest capture if limits are exceeded.
+		void capture();
+
+		/// @returns The number of captures currently held.
+		size_t size() const;
+
+		/// @returns The number of bytes of storage currently in use for captures.
+		size_t memory_usage() const;
+
+		/*!
+			Restores the machine to the state it had @c count captures before the most recent, discarding
+			all later captures. So @c rewind(0) restores the most recent capture.
+
+			@returns @c true if the machine was rewound; @c false if there are insufficient captures
+				or the captured state could not be applied.
+		*/
+		bool rewind(size_t count);
+
+		/// Discards all captures.
+		void clear();
+
+	private:
+		MachineTypes::StateProducer *const producer_;
+		const size_t max_captures_, max_bytes_, keyframe_interval_;
+
+		struct Capture {
+			/// Either the full state image or, for non-keyframes, its delta against the previous capture.
+			std::vector<uint8_t> data;
+			bool is_keyframe = false;
+		};
+		std::deque<Capture> captures_;
+		size_t memory_usage_ = 0;
+		size_t captures_since_keyframe_ = 0;
+
+		/// The image of the most recent capture.
+		std::vector<uint8_t> latest_;
+		/// Working space for image production and delta encoding.
+		std::vector<uint8_t> image_, delta_;
+
+		/// A reusable state object, for capture and restoration without allocation.
+		std::unique_ptr<Reflection::Struct> state_;
+
+		void discard_oldest();
+
+		static void encode_delta(const std::vector<uint8_t> &from, const std::vector<uint8_t> &to, std::vector<uint8_t> &delta);
+		static void apply_delta(const std::vector<uint8_t> &delta, std::vector<uint8_t> &target);
+};
+
+}
+
+#endif /* RewindBuffer_hpp */
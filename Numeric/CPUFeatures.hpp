@@ -0,0 +1,40 @@
+//
+//  CPUFeatures.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 16/10/2026.
+//  Copyright 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef CPUFeatures_hpp
+#define CPUFeatures_hpp
+
+/*
+	If AVX2_TARGET is defined then functions declared with it may use AVX2 intrinsics regardless of
+	the target selected for the build as a whole; they should be called only if Numeric::has_avx2()
+	returns @c true.
+*/
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define AVX2_TARGET __attribute__((target("avx2")))
+#include <immintrin.h>
+#endif
+
+namespace Numeric {
+
+/// @returns @c true if the host processor supports AVX2, and functions declared with AVX2_TARGET can
+/// therefore be used.
+inline bool has_avx2() {
+#ifdef AVX2_TARGET
+	static const bool has_avx2 = [] {
+		__builtin_cpu_init();
+		return bool(__builtin_cpu_supports("avx2"));
+	}();
+	return has_avx2;
+#else
+	return false;
+#endif
+}
+
+}
+
+#endif /* CPUFeatures_hpp */
@@ -0,0 +1,41 @@
+//
+//  LeadingZeroes.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 16/10/2026.
+//  Copyright 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef LeadingZeroes_hpp
+#define LeadingZeroes_hpp
+
+#include <cstdint>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace Numeric {
+
+/// @returns The number of zero bits above the most-significant set bit of @c input,
+/// which must be non-zero.
+inline int leading_zeroes(uint64_t input) {
+#if defined(__GNUC__)
+	return __builtin_clzll(input);
+#elif defined(_MSC_VER) && defined(_M_X64)
+	unsigned long index;
+	_BitScanReverse64(&index, input);
+	return 63 - int(index);
+#else
+	int result = 0;
+	while(!(input & 0x8000'0000'0000'0000)) {
+		input <<= 1;
+		++result;
+	}
+	return result;
+#endif
+}
+
+}
+
+#endif /* LeadingZeroes_hpp */
@@ -9,6 +9,7 @@
 #ifndef Sizes_h
 #define Sizes_h
 
+#include <cstdint>
 #include <limits>
 #include <type_traits>
 
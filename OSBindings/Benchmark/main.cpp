@@ -0,0 +1,632 @@
+//
+//  main.cpp
+//  Clock Signal Benchmark
+//
+//  Created by Thomas Harte on 16/10/2026.
+//  Copyright 2026 Thomas Harte. All rights reserved.
+//
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+#include <unistd.h>
+#endif
+
+#include "../../Analyser/Static/Atari2600/Target.hpp"
+#include "../../ClockReceiver/TimeTypes.hpp"
+#include "../../Machines/MachineTypes.hpp"
+#include "../../Machines/Utility/MachineForTarget.hpp"
+#include "../../Outputs/ScanTarget.hpp"
+#include "../../Storage/Cartridge/Cartridge.hpp"
+
+#include "../../Processors/6502/AllRAM/6502AllRAM.hpp"
+#include "../../Processors/68000/68000.hpp"
+#include "../../Processors/68000Mk2/68000Mk2.hpp"
+#include "../../Processors/Z80/AllRAM/Z80AllRAM.hpp"
+
+/*
+	A headless benchmark suite: boots each available machine from its default target and
+	runs it for a fixed period of emulated time with all output discarded, then separately
+	measures the raw throughput of each processor core on a fixed loop in all-RAM harnesses,
+	and of the 6502 on the Klaus Dormann and Wolfgang Lorenz test suites, if they can be found.
+	Ahead of both, the time and memory cost of constructing the 68000 cores is measured.
+
+	System ROMs are sought as per the SDL frontend; any that can't be found are replaced by
+	zero-filled stubs of the proper size. Stubbed machines will not execute meaningful code
+	but do still exercise their full clocking, video and audio paths.
+*/
+
+namespace {
+
+struct Arguments {
+	Time::Seconds seconds = 10.0;
+	int64_t cycles = 50'000'000;
+	std::string rompath;
+	std::string testpath = "../Mac/Clock SignalTests";
+	std::string filter;
+	bool run_machines = true;
+	bool run_processors = true;
+};
+
+/// Parses @c argv into @c arguments, returning false if any option is unrecognised.
+bool parse_arguments(int argc, char *argv[], Arguments &arguments) {
+	for(int c = 1; c < argc; ++c) {
+		std::string argument = argv[c];
+		std::string value;
+		const auto equals = argument.find('=');
+		if(equals != std::string::npos) {
+			value = argument.substr(equals + 1);
+			argument = argument.substr(0, equals);
+		}
+
+		if(argument == "--seconds") {
+			char *end;
+			arguments.seconds = strtod(value.c_str(), &end);
+			if(value.empty() || *end) {
+				std::cerr << "Unable to parse run time: " << value << std::endl;
+				return false;
+			}
+			if(!std::isfinite(arguments.seconds) || arguments.seconds <= 0.0) {
+				std::cerr << "Cannot run for " << value << " seconds; run times must be positive." << std::endl;
+				return false;
+			}
+		} else if(argument == "--cycles") {
+			char *end;
+			errno = 0;
+			arguments.cycles = strtoll(value.c_str(), &end, 10);
+			if(value.empty() || *end) {
+				std::cerr << "Unable to parse cycle count: " << value << std::endl;
+				return false;
+			}
+
+			// Cycles are doubled to half-cycles for the 68000s, so must leave room for that.
+			if(errno == ERANGE || arguments.cycles <= 0 || arguments.cycles > std::numeric_limits<int64_t>::max() / 2) {
+				std::cerr << "Cannot run for " << value << " cycles; cycle counts must be positive and representable." << std::endl;
+				return false;
+			}
+		} else if(argument == "--rompath") {
+			arguments.rompath = value;
+		} else if(argument == "--testpath") {
+			arguments.testpath = value;
+		} else if(argument == "--only") {
+			arguments.filter = value;
+		} else if(argument == "--machines-only") {
+			arguments.run_processors = false;
+		} else if(argument == "--processors-only") {
+			arguments.run_machines = false;
+		} else {
+			return false;
+		}
+	}
+	return true;
+}
+
+bool matches(const Arguments &arguments, const std::string &name) {
+	return arguments.filter.empty() || name.find(arguments.filter) != std::string::npos;
+}
+
+void print_result(const std::string &name, Time::Seconds wall, double speed, const char *units, const std::string &note = "") {
+	std::cout << std::left << std::setw(28) << name << std::right;
+	std::cout << std::fixed << std::setprecision(3) << std::setw(9) << wall << "s  ";
+	std::cout << std::setprecision(2) << std::setw(10) << speed << ' ' << units;
+	if(!note.empty()) std::cout << "  (" << note << ")";
+	std::cout << std::endl;
+}
+
+/// @returns The entire contents of the file at @c path, or an empty vector if it can't be read.
+std::vector<uint8_t> read_file(const std::string &path) {
+	FILE *const file = std::fopen(path.c_str(), "rb");
+	if(!file) return {};
+
+	std::vector<uint8_t> data;
+	std::fseek(file, 0, SEEK_END);
+	data.resize(size_t(std::max(std::ftell(file), 0l)));
+	std::fseek(file, 0, SEEK_SET);
+	const bool did_read = std::fread(data.data(), 1, data.size(), file) == data.size();
+	std::fclose(file);
+
+	if(!did_read) return {};
+	return data;
+}
+
+// MARK: - Whole machines.
+
+/// Supplies ROMs from the usual locations, substituting stubs for any that are missing.
+ROM::Map fetch_roms(const ROM::Request &request, const std::string &rompath, bool &used_stubs) {
+	std::vector<std::string> paths = {
+		"/usr/local/share/CLK/",
+		"/usr/share/CLK/"
+	};
+	if(!rompath.empty()) {
+		paths.push_back(rompath.back() == '/' ? rompath : rompath + '/');
+	}
+
+	ROM::Map results;
+	for(const auto &description: request.all_descriptions()) {
+		for(const auto &file_name: description.file_names) {
+			for(const auto &path: paths) {
+				auto data = read_file(path + description.machine_name + "/" + file_name);
+				if(!data.empty()) {
+					results[description.name] = std::move(data);
+					break;
+				}
+			}
+			if(results.find(description.name) != results.end()) break;
+		}
+
+		if(results.find(description.name) == results.end()) {
+			results[description.name] = std::vector<uint8_t>(description.size);
+			used_stubs = true;
+		}
+	}
+	return results;
+}
+
+/// Receives and discards all audio; audio is still generated so that its cost is measured.
+struct NullSpeakerDelegate: public Outputs::Speaker::Speaker::Delegate {
+	void speaker_did_complete_samples(Outputs::Speaker::Speaker *, const std::vector<int16_t> &) final {}
+};
+
+/// Runs a single machine for the requested period and prints the result.
+void benchmark_machine(const Arguments &arguments, const std::string &name, const Analyser::Static::Target *target) {
+	bool used_stubs = false;
+	Machine::Error error;
+	std::unique_ptr<Machine::DynamicMachine> machine(
+		Machine::MachineForTarget(target, [&] (const ROM::Request &request) {
+			return fetch_roms(request, arguments.rompath, used_stubs);
+		}, error)
+	);
+	if(!machine) {
+		std::cout << std::left << std::setw(28) << name << "could not be created" << std::endl;
+		return;
+	}
+
+	NullSpeakerDelegate speaker_delegate;
+	machine->scan_producer()->set_scan_target(&Outputs::Display::NullScanTarget::singleton);
+	const auto audio_producer = machine->audio_producer();
+	if(audio_producer && audio_producer->get_speaker()) {
+		auto speaker = audio_producer->get_speaker();
+		speaker->set_output_rate(48000, 1024, speaker->get_is_stereo());
+		speaker->set_delegate(&speaker_delegate);
+	}
+
+	// Run in the same hundredth-of-a-second slices as the SDL frontend's headless mode, rounding
+	// the requested time to the nearest whole slice, but running at least one.
+	constexpr Time::Seconds slice = 0.01;
+	const int64_t slices = std::max(std::llround(arguments.seconds / slice), 1ll);
+	const auto timed_machine = machine->timed_machine();
+	const auto start_time = Time::nanos_now();
+	for(int64_t c = 0; c < slices; ++c) {
+		timed_machine->run_for(slice);
+		timed_machine->flush_output(MachineTypes::TimedMachine::Output::All);
+	}
+	const auto wall = Time::seconds(Time::nanos_now() - start_time);
+
+	print_result(name, wall, double(slices) * slice / wall, "x real time", used_stubs ? "stub ROMs" : "");
+
+	if(audio_producer && audio_producer->get_speaker()) {
+		// Ensure no audio is still in flight to the delegate before it goes out of scope.
+		audio_producer->wait_for_audio();
+		audio_producer->get_speaker()->set_delegate(nullptr);
+	}
+}
+
+void benchmark_machines(const Arguments &arguments) {
+	std::cout << "Machines, " << arguments.seconds << " emulated seconds each:" << std::endl;
+
+	auto targets = Machine::TargetsByMachineName(false);
+	for(auto &pair: targets) {
+		if(!matches(arguments, pair.first)) continue;
+		auto &target = pair.second;
+
+		// The Atari 2600 needs a cartridge; supply 4kb of NOPs.
+		if(target->machine == Analyser::Machine::Atari2600) {
+			std::vector<uint8_t> rom(4096, 0xea);
+			rom[0xffc] = rom[0xffe] = 0x00;
+			rom[0xffd] = rom[0xfff] = 0xf0;
+			target->media.cartridges.push_back(
+				std::make_shared<Storage::Cartridge::Cartridge>(
+					std::vector<Storage::Cartridge::Cartridge::Segment>{{0x1000, std::move(rom)}}
+				)
+			);
+		}
+
+		benchmark_machine(arguments, pair.first, target.get());
+	}
+	std::cout << std::endl;
+}
+
+// MARK: - Processors.
+
+/// Times @c function, which should perform @c cycles cycles of work, and prints the result.
+void time_processor(const std::string &name, int64_t cycles, const std::function<void(void)> &function) {
+	const auto start_time = Time::nanos_now();
+	function();
+	const auto wall = Time::seconds(Time::nanos_now() - start_time);
+	print_result(name, wall, double(cycles) / (wall * 1e6), "MHz");
+}
+
+void benchmark_z80(const Arguments &arguments) {
+	if(!matches(arguments, "Z80")) return;
+
+	const uint8_t program[] = {
+		0x21, 0x00, 0x80,		// LD HL, 8000h
+		0x06, 0x00,				// LD B, 0
+		0x7e,					// loop: LD A, (HL)
+		0x80,					// ADD A, B
+		0x77,					// LD (HL), A
+		0x23,					// INC HL
+		0x10, 0xfa,				// DJNZ loop
+		0xc3, 0x00, 0x00,		// JP 0
+	};
+
+	std::unique_ptr<CPU::Z80::AllRAMProcessor> z80(CPU::Z80::AllRAMProcessor::Processor());
+	z80->set_data_at_address(0, sizeof(program), program);
+	z80->reset_power_on();
+
+	time_processor("Z80", arguments.cycles, [&] {
+		z80->run_for(Cycles(arguments.cycles));
+	});
+}
+
+void benchmark_6502(const Arguments &arguments, CPU::MOS6502Esque::Type type, const char *name) {
+	if(!matches(arguments, name)) return;
+
+	const uint8_t program[] = {
+		0xa2, 0x00,				// LDX #0
+		0xbd, 0x00, 0x30,		// loop: LDA $3000, X
+		0x18,					// CLC
+		0x69, 0x01,				// ADC #1
+		0x9d, 0x00, 0x30,		// STA $3000, X
+		0xe8,					// INX
+		0xd0, 0xf4,				// BNE loop
+		0x4c, 0x00, 0x02,		// JMP $0200
+	};
+	const uint8_t vectors[] = {0x00, 0x02, 0x00, 0x02, 0x00, 0x02};
+
+	std::unique_ptr<CPU::MOS6502::AllRAMProcessor> processor(CPU::MOS6502::AllRAMProcessor::Processor(type));
+	processor->set_data_at_address(0x200, sizeof(program), program);
+	processor->set_data_at_address(0xfffa, sizeof(vectors), vectors);
+
+	time_processor(name, arguments.cycles, [&] {
+		processor->run_for(Cycles(arguments.cycles));
+	});
+}
+
+/// @returns A description of the outcome of a test suite that ended at @c address, having expected to end at @c success_address.
+std::string outcome(uint16_t address, uint16_t success_address) {
+	if(address == success_address) return "passed";
+
+	char description[32];
+	snprintf(description, sizeof(description), "failed at $%04x", address);
+	return description;
+}
+
+/// Runs Klaus Dormann's functional test @c file_name to completion, i.e. until the processor is found to
+/// be looping in place, and prints the rate of execution.
+void benchmark_dormann(const Arguments &arguments, CPU::MOS6502Esque::Type type, const char *name, const char *file_name, uint16_t success_address) {
+	if(!matches(arguments, name)) return;
+
+	const auto test = read_file(arguments.testpath + "/Klaus Dormann/" + file_name);
+	if(test.empty()) {
+		std::cout << std::left << std::setw(28) << name << "skipped; " << file_name << " not found" << std::endl;
+		return;
+	}
+
+	std::unique_ptr<CPU::MOS6502::AllRAMProcessor> processor(CPU::MOS6502::AllRAMProcessor::Processor(type));
+	processor->set_data_at_address(0, test.size(), test.data());
+	processor->set_value_of_register(CPU::MOS6502::Register::ProgramCounter, 0x400);
+
+	// Every test ends in a branch or jump to itself; as per KlausDormannTests.swift, check for that at an
+	// interval, and then again just after to exclude coincidences.
+	constexpr int slice = 1000, recheck = 7;
+	int64_t cycles = 0;
+	uint16_t address, last_address = 0xffff;
+	const auto start_time = Time::nanos_now();
+	while(true) {
+		processor->run_for(Cycles(slice));
+		cycles += slice;
+
+		address = processor->get_value_of_register(CPU::MOS6502::Register::LastOperationAddress);
+		if(address == last_address) {
+			processor->run_for(Cycles(recheck));
+			cycles += recheck;
+			if(processor->get_value_of_register(CPU::MOS6502::Register::LastOperationAddress) == address) break;
+		}
+		last_address = address;
+	}
+	const auto wall = Time::seconds(Time::nanos_now() - start_time);
+
+	print_result(name, wall, double(cycles) / (wall * 1e6), "MHz", outcome(address, success_address));
+}
+
+/// Runs those of Wolfgang Lorenz's tests that are relevant to a stock 6502 in an all-RAM machine,
+/// with the minimum of Commodore 64 KERNAL functionality substituted, and prints the rate of execution.
+class LorenzSuite: public CPU::AllRAMProcessor::TrapHandler {
+	public:
+		LorenzSuite(const Arguments &arguments) : arguments_(arguments) {}
+
+		void run(const char *name) {
+			if(!matches(arguments_, name)) return;
+
+			// Names are as per WolfgangLorenzTests.swift; each group is a prefix followed by its suffixes.
+			const std::vector<std::vector<const char *>> groups = {
+				{" start", ""},
+				{"lda", "b", "z", "zx", "a", "ax", "ay", "ix", "iy"},	{"sta", "z", "zx", "a", "ax", "ay", "ix", "iy"},
+				{"ldx", "b", "z", "zy", "a", "ay"},						{"stx", "z", "zy", "a"},
+				{"ldy", "b", "z", "zx", "a", "ax"},						{"sty", "z", "zx", "a"},
+				{"", "taxn", "tayn", "txan", "tyan", "tsxn", "txsn"},
+				{"", "phan", "plan", "phpn", "plpn"},
+				{"", "inxn", "inyn", "dexn", "deyn", "incz", "inczx", "inca", "incax", "decz", "deczx", "deca", "decax"},
+				{"asl", "n", "z", "zx", "a", "ax"},						{"lsr", "n", "z", "zx", "a", "ax"},
+				{"rol", "n", "z", "zx", "a", "ax"},						{"ror", "n", "z", "zx", "a", "ax"},
+				{"and", "b", "z", "zx", "a", "ax", "ay", "ix", "iy"},	{"ora", "b", "z", "zx", "a", "ax", "ay", "ix", "iy"},
+				{"eor", "b", "z", "zx", "a", "ax", "ay", "ix", "iy"},
+				{"", "clcn", "secn", "cldn", "sedn", "clin", "sein", "clvn"},
+				{"adc", "b", "z", "zx", "a", "ax", "ay", "ix", "iy"},	{"sbc", "b", "z", "zx", "a", "ax", "ay", "ix", "iy"},
+				{"", "cmpb", "cmpz", "cmpzx", "cmpa", "cmpax", "cmpay", "cmpix", "cmpiy", "cpxb", "cpxz", "cpxa", "cpyb", "cpyz", "cpya"},
+				{"bit", "z", "a"},
+				{"", "brkn", "rtin", "jsrw", "rtsn", "jmpi", "jmpw"},
+				{"", "beqr", "bner", "bmir", "bplr", "bcsr", "bccr", "bvsr", "bvcr"},
+				{"nop", "n", "b", "z", "zx", "a", "ax"},
+				{"aso", "z", "zx", "a", "ax", "ay", "ix", "iy"},		{"rla", "z", "zx", "a", "ax", "ay", "ix", "iy"},
+				{"lse", "z", "zx", "a", "ax", "ay", "ix", "iy"},		{"rra", "z", "zx", "a", "ax", "ay", "ix", "iy"},
+				{"dcm", "z", "zx", "a", "ax", "ay", "ix", "iy"},		{"ins", "z", "zx", "a", "ax", "ay", "ix", "iy"},
+				{"lax", "z", "zy", "a", "ay", "ix", "iy"},				{"axs", "z", "zy", "a", "ix"},
+				{"", "alrb", "arrb", "sbxb", "shaay", "shaiy", "shxay", "shyax", "shsay", "lxab", "aneb", "ancb", "lasay", "sbcb(eb)"},
+			};
+
+			int64_t cycles = 0;
+			int tests = 0;
+			std::string failures;
+			const auto start_time = Time::nanos_now();
+			for(const auto &group: groups) {
+				for(size_t c = 1; c < group.size(); c++) {
+					const auto result = run_test(std::string(group[0]) + group[c], cycles);
+					if(result.empty()) return;
+					++tests;
+					if(result != "passed") failures += (failures.empty() ? "" : ", ") + std::string(group[0]) + group[c] + " " + result;
+				}
+			}
+			const auto wall = Time::seconds(Time::nanos_now() - start_time);
+
+			print_result(name, wall, double(cycles) / (wall * 1e6), "MHz", failures.empty() ? std::to_string(tests) + " passed" : failures);
+		}
+
+	private:
+		const Arguments &arguments_;
+		std::unique_ptr<CPU::MOS6502::AllRAMProcessor> processor_;
+		uint16_t failure_address_ = 0;
+
+		/// Runs the test @c name, adding the time it took to @c cycles; returns a description of the outcome, or an empty string if it couldn't be found.
+		std::string run_test(const std::string &name, int64_t &cycles) {
+			auto test = read_file(arguments_.testpath + "/Wolfgang Lorenz 6502 test suite/" + name);
+			if(test.size() < 2) {
+				std::cout << std::left << std::setw(28) << "6502 (Lorenz)" << "skipped; " << name << " not found" << std::endl;
+				return "";
+			}
+
+			processor_.reset(CPU::MOS6502::AllRAMProcessor::Processor(CPU::MOS6502Esque::Type::T6502));
+			processor_->set_trap_handler(this);
+			failure_address_ = 0;
+
+			const uint16_t load_address = uint16_t(test[0] | (test[1] << 8));
+			processor_->set_data_at_address(load_address, test.size() - 2, test.data() + 2);
+
+			// Cf. http://www.softwolves.com/arkiv/cbm-hackers/7/7114.html for the steps being taken here, and
+			// WolfgangLorenzTests.swift for the original of this set up.
+			store(0xd011, {0xff});			// In-border.
+			store(0x0314, {0x31, 0xea});	// IRQ vector.
+			store(0x0316, {0x66, 0xfe});	// BRK vector.
+			store(0x0002, {0x00});
+			store(0xa002, {0x00, 0x80});
+			store(0x01fe, {0xff, 0x7f});
+			store(0xfffe, {0x48, 0xff});
+
+			// The Commodore's default IRQ handler and, in place of the KERNAL, an immediate return from it.
+			store(0xff48, {
+				0x48, 0x8a, 0x48, 0x98, 0x48, 0xba, 0xbd, 0x04, 0x01,
+				0x29, 0x10, 0xf0, 0x03, 0x6c, 0x16, 0x03, 0x6c, 0x14, 0x03
+			});
+			store(0xea31, {0x68, 0xa8, 0x68, 0xaa, 0x68, 0x40});
+			store(0xfe66, {0x68, 0xa8, 0x68, 0xaa, 0x68, 0x40});
+
+			// Trap character output and keyboard input, and the two exits that indicate failure; all return.
+			for(const uint16_t address: {0xffd2, 0xffe4, 0x8000, 0xa474}) {
+				processor_->add_trap_address(address);
+				store(address, {0x60});
+			}
+
+			// A test ends by loading the next, via the KERNAL routine at $e16f; make that loop in place.
+			store(0xe16f, {0x4c, 0x6f, 0xe1});
+
+			processor_->set_value_of_register(CPU::MOS6502::Register::ProgramCounter, 0x0801);
+			processor_->set_value_of_register(CPU::MOS6502::Register::StackPointer, 0xfd);
+			processor_->set_value_of_register(CPU::MOS6502::Register::Flags, 0x04);
+
+			constexpr int slice = 1000;
+			uint16_t address;
+			do {
+				processor_->run_for(Cycles(slice));
+				cycles += slice;
+				address = processor_->get_value_of_register(CPU::MOS6502::Register::LastOperationAddress);
+			} while(address != 0xe16f && !failure_address_ && !processor_->is_jammed());
+
+			return outcome(failure_address_ ? failure_address_ : address, 0xe16f);
+		}
+
+		void store(uint16_t address, std::initializer_list<uint8_t> values) {
+			processor_->set_data_at_address(address, values.size(), values.begin());
+		}
+
+		void processor_did_trap(CPU::AllRAMProcessor &, uint16_t address) final {
+			switch(address) {
+				case 0xffd2:	store(0x030c, {0x00});	break;
+				case 0xffe4:	processor_->set_value_of_register(CPU::MOS6502::Register::A, 0x03);	break;
+				default:		failure_address_ = address;	break;
+			}
+		}
+};
+
+/// Provides 64kb of RAM, mirrored across the 68000's address space; works with either implementation.
+struct RAM68000 {
+	std::vector<uint8_t> ram = std::vector<uint8_t>(65536);
+
+	template <typename Microcycle> HalfCycles perform_bus_operation(const Microcycle &cycle, int) {
+		const uint32_t address = cycle.address ? (*cycle.address & 0xffff) : 0;
+		switch(cycle.operation & (Microcycle::SelectWord | Microcycle::SelectByte | Microcycle::Read)) {
+			default: break;
+
+			case Microcycle::SelectWord | Microcycle::Read:
+				cycle.set_value16(uint16_t((ram[address] << 8) | ram[address | 1]));
+			break;
+			case Microcycle::SelectByte | Microcycle::Read:
+				if(address & 1) {
+					cycle.set_value8_low(ram[address]);
+				} else {
+					cycle.set_value8_high(ram[address]);
+				}
+			break;
+			case Microcycle::SelectWord:
+				ram[address] = cycle.value8_high();
+				ram[address | 1] = cycle.value8_low();
+			break;
+			case Microcycle::SelectByte:
+				ram[address] = (address & 1) ? cycle.value8_low() : cycle.value8_high();
+			break;
+		}
+		return HalfCycles(0);
+	}
+
+	void will_perform(uint32_t, uint16_t) {}
+
+	RAM68000() {
+		const uint16_t program[] = {
+			0x0000, 0x8000,			// Initial stack pointer: 0x8000.
+			0x0000, 0x1000,			// Initial program counter: 0x1000.
+		};
+		const uint16_t loop[] = {
+			0x41f9, 0x0000, 0x2000,	// LEA $2000, A0
+			0x303c, 0x00ff,			// MOVE.W #$ff, D0
+			0xd290,					// loop: ADD.L (A0), D1
+			0x20c1,					// MOVE.L D1, (A0)+
+			0x51c8, 0xfffa,			// DBF D0, loop
+			0x4ef8, 0x1000,			// JMP $1000.W
+		};
+		store(0, program, sizeof(program) / sizeof(*program));
+		store(0x1000, loop, sizeof(loop) / sizeof(*loop));
+	}
+
+	private:
+		void store(uint32_t address, const uint16_t *words, size_t count) {
+			for(size_t c = 0; c < count; ++c) {
+				ram[address + c*2] = uint8_t(words[c] >> 8);
+				ram[address + c*2 + 1] = uint8_t(words[c]);
+			}
+		}
+};
+
+template <typename ProcessorT> void benchmark_68000(const Arguments &arguments, const char *name) {
+	if(!matches(arguments, name)) return;
+
+	RAM68000 bus_handler;
+	auto processor = std::make_unique<ProcessorT>(bus_handler);
+
+	time_processor(name, arguments.cycles, [&] {
+		processor->run_for(HalfCycles(arguments.cycles * 2));
+	});
+}
+
+/// @returns The current resident set size of this process, in bytes, or 0 if unknown.
+size_t resident_bytes() {
+#ifdef __linux__
+	FILE *const statm = fopen("/proc/self/statm", "r");
+	if(!statm) return 0;
+
+	unsigned long size = 0, resident = 0;
+	const bool did_read = fscanf(statm, "%lu %lu", &size, &resident) == 2;
+	fclose(statm);
+	return did_read ? size_t(resident) * size_t(sysconf(_SC_PAGESIZE)) : 0;
+#else
+	return 0;
+#endif
+}
+
+/// Measures the cost of constructing the first processor of a type, and of each one after that.
+template <typename ProcessorT> void benchmark_construction(const Arguments &arguments, const char *name) {
+	if(!matches(arguments, name)) return;
+
+	RAM68000 bus_handler;
+	std::vector<std::unique_ptr<ProcessorT>> processors;
+	constexpr int further_processors = 16;
+
+	const auto start_time = Time::nanos_now();
+	const auto start_resident = resident_bytes();
+	processors.push_back(std::make_unique<ProcessorT>(bus_handler));
+	const auto first_time = Time::nanos_now();
+	const auto first_resident = resident_bytes();
+	for(int c = 0; c < further_processors; ++c) {
+		processors.push_back(std::make_unique<ProcessorT>(bus_handler));
+	}
+	const auto end_time = Time::nanos_now();
+	const auto end_resident = resident_bytes();
+
+	std::cout << std::left << std::setw(28) << name << std::right << std::fixed << std::setprecision(2);
+	std::cout << "first: " << std::setw(8) << double(first_time - start_time) / 1e6 << "ms " << std::setw(8) << (double(first_resident) - double(start_resident)) / 1024.0 << "kb;  ";
+	std::cout << "each thereafter: " << std::setw(8) << double(end_time - first_time) / (1e6 * further_processors) << "ms " << std::setw(8) << (double(end_resident) - double(first_resident)) / (1024.0 * further_processors) << "kb";
+	std::cout << std::endl;
+}
+
+void benchmark_start_up(const Arguments &arguments) {
+	std::cout << "Start-up time and resident memory:" << std::endl;
+
+	benchmark_construction<CPU::MC68000::Processor<RAM68000, true>>(arguments, "68000");
+	benchmark_construction<CPU::MC68000Mk2::Processor<RAM68000, true, true>>(arguments, "68000Mk2");
+
+	std::cout << std::endl;
+}
+
+void benchmark_processors(const Arguments &arguments) {
+	std::cout << "Processors, " << arguments.cycles << " cycles each:" << std::endl;
+
+	benchmark_z80(arguments);
+	benchmark_6502(arguments, CPU::MOS6502Esque::Type::T6502, "6502");
+	benchmark_6502(arguments, CPU::MOS6502Esque::Type::TWDC65816, "65816");
+	benchmark_dormann(arguments, CPU::MOS6502Esque::Type::T6502, "6502 (Dormann)", "6502_functional_test.bin", 0x3399);
+	benchmark_dormann(arguments, CPU::MOS6502Esque::Type::TWDC65C02, "65C02 (Dormann)", "65C02_extended_opcodes_test.bin", 0x24f1);
+	LorenzSuite(arguments).run("6502 (Lorenz)");
+	benchmark_68000<CPU::MC68000::Processor<RAM68000, true>>(arguments, "68000");
+	benchmark_68000<CPU::MC68000Mk2::Processor<RAM68000, true, true>>(arguments, "68000Mk2");
+
+	std::cout << std::endl;
+}
+
+}
+
+int main(int argc, char *argv[]) {
+	Arguments arguments;
+	if(!parse_arguments(argc, argv, arguments)) {
+		std::cerr << "Usage: " << argv[0] << " [--seconds={emulated seconds per machine, default 10}] [--cycles={cycles per processor, default 50000000}] [--rompath={path to ROMs}] [--testpath={path to processor test suites, default ../Mac/Clock SignalTests}] [--only={name filter}] [--machines-only] [--processors-only]" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	// Start-up is measured first, so that it is the first construction of each processor.
+	if(arguments.run_processors) benchmark_start_up(arguments);
+	if(arguments.run_machines) benchmark_machines(arguments);
+	if(arguments.run_processors) benchmark_processors(arguments);
+
+	return EXIT_SUCCESS;
+}
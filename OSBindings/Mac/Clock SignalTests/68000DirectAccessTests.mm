@@ -0,0 +1,126 @@
+//
+//  68000DirectAccessTests.mm
+//  Clock SignalTests
+//
+//  Created by Thomas Harte on 16/10/2026.
+//  Copyright 2026 Thomas Harte. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#include "../../../Processors/68000Mk2/68000Mk2.hpp"
+
+#include <array>
+#include <iterator>
+
+namespace {
+
+using Microcycle = CPU::MC68000Mk2::Microcycle;
+
+/// Provides 64kb of RAM, stored as host-endian words, and a periodic level 4 interrupt;
+/// runs a loop that is interrupted regularly.
+template <typename Self> struct InterruptingRAM: public CPU::MC68000Mk2::BusHandler {
+	std::array<uint8_t, 65536> ram{};
+	CPU::MC68000Mk2::Processor<Self, true, true> processor;
+
+	int bus_operations = 0;
+	int total_length = 0;
+
+	InterruptingRAM() : processor(static_cast<Self &>(*this)) {
+		const uint16_t vectors[] = {
+			0x0000, 0x8000,			// Initial stack pointer: 0x8000.
+			0x0000, 0x1000,			// Initial program counter: 0x1000.
+		};
+		const uint16_t loop[] = {
+			0x46fc, 0x2000,			// MOVE #$2000, SR
+			0x41f9, 0x0000, 0x2000,	// LEA $2000, A0
+			0x303c, 0x00ff,			// MOVE.W #$ff, D0
+			0xd290,					// loop: ADD.L (A0), D1
+			0x20c1,					// MOVE.L D1, (A0)+
+			0x51c8, 0xfffa,			// DBF D0, loop
+			0x4ef8, 0x1004,			// JMP $1004.W
+		};
+		const uint16_t handler[] = {
+			0x5282,					// ADDQ.L #1, D2
+			0x4e73,					// RTE
+		};
+		const uint16_t handler_address[] = {0x0000, 0x1100};
+
+		store(0, vectors, std::size(vectors));
+		store(0x70, handler_address, std::size(handler_address));
+		store(0x1000, loop, std::size(loop));
+		store(0x1100, handler, std::size(handler));
+	}
+
+	HalfCycles perform_bus_operation(const Microcycle &cycle, int) {
+		++bus_operations;
+
+		// Signal an interrupt for 200 half-cycles out of every 5000.
+		total_length += cycle.length.as<int>();
+		processor.set_interrupt_level((total_length % 5000) < 200 ? 4 : 0);
+
+		if(cycle.operation & Microcycle::InterruptAcknowledge) {
+			processor.set_is_peripheral_address(true);
+			return HalfCycles(0);
+		}
+		processor.set_is_peripheral_address(false);
+
+		if(cycle.operation & (Microcycle::SelectWord | Microcycle::SelectByte)) {
+			cycle.apply(&ram[cycle.host_endian_byte_address() & 0xffff]);
+		}
+		return HalfCycles(0);
+	}
+
+	private:
+		void store(uint32_t address, const uint16_t *words, size_t count) {
+			for(size_t c = 0; c < count; ++c) {
+				*reinterpret_cast<uint16_t *>(&ram[address + c*2]) = words[c];
+			}
+		}
+};
+
+struct IndirectRAM: public InterruptingRAM<IndirectRAM> {};
+
+struct DirectRAM: public InterruptingRAM<DirectRAM> {
+	uint8_t *direct_access(const Microcycle &cycle, int) {
+		return &ram[cycle.host_endian_byte_address() & 0xffff];
+	}
+};
+
+}
+
+@interface M68000DirectAccessTests : XCTestCase
+@end
+
+@implementation M68000DirectAccessTests
+
+/// Tests that direct accesses produce exactly the same results, with exactly the same
+/// total time posted to the bus handler, while reducing the number of bus operations.
+- (void)testEquivalence {
+	IndirectRAM indirect;
+	DirectRAM direct;
+	for(int c = 0; c < 100; c++) {
+		indirect.processor.run_for(HalfCycles(10'001));
+		direct.processor.run_for(HalfCycles(10'001));
+
+		XCTAssertEqual(indirect.total_length, direct.total_length);
+	}
+
+	const auto indirect_state = indirect.processor.get_state().registers;
+	const auto direct_state = direct.processor.get_state().registers;
+	XCTAssertEqual(indirect_state.program_counter, direct_state.program_counter);
+	XCTAssertEqual(indirect_state.status, direct_state.status);
+	for(int c = 0; c < 8; c++) {
+		XCTAssertEqual(indirect_state.data[c], direct_state.data[c]);
+	}
+	for(int c = 0; c < 7; c++) {
+		XCTAssertEqual(indirect_state.address[c], direct_state.address[c]);
+	}
+	XCTAssert(indirect.ram == direct.ram);
+
+	// Some interrupts should have occurred.
+	XCTAssertGreaterThan(direct_state.data[2], 0);
+	XCTAssertLessThan(direct.bus_operations, indirect.bus_operations / 2);
+}
+
+@end
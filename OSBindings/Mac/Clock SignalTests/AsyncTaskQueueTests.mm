@@ -0,0 +1,158 @@
+//
+//  AsyncTaskQueueTests.mm
+//  Clock SignalTests
+//
+//  Created by Thomas Harte on 16/10/2026.
+//  Copyright 2026 Thomas Harte. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#include "../../../Concurrency/AsyncTaskQueue.hpp"
+#include "../../../Concurrency/LockFreeTaskQueue.hpp"
+#include "../../../ClockReceiver/TimeTypes.hpp"
+
+#include <array>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr int ActionCount = 1'000'000;
+constexpr int LatencySamples = 10'000;
+
+/// Enqueues ActionCount trivial actions and waits for them all to be performed;
+/// returns the number of actions per second and sets @c total to the number actually performed.
+template <typename QueueT> double throughput(QueueT &queue, int &total) {
+	total = 0;
+	const auto start = Time::nanos_now();
+	for(int c = 0; c < ActionCount; ++c) {
+		queue.enqueue([&total] { ++total; });
+	}
+	queue.flush();
+	const auto end = Time::nanos_now();
+	return double(ActionCount) / Time::seconds(end - start);
+}
+
+/// Measures the mean time between an action being enqueued and it being performed,
+/// in nanoseconds, posting one action at a time.
+template <typename QueueT> double latency(QueueT &queue) {
+	std::atomic<Time::Nanos> performed_at = 0;
+	Time::Nanos total = 0;
+	for(int c = 0; c < LatencySamples; ++c) {
+		performed_at = 0;
+		const auto start = Time::nanos_now();
+		queue.enqueue([&performed_at] { performed_at = Time::nanos_now(); });
+		while(!performed_at) {}
+		total += performed_at - start;
+	}
+	return double(total) / double(LatencySamples);
+}
+
+}
+
+@interface AsyncTaskQueueTests : XCTestCase
+@end
+
+@implementation AsyncTaskQueueTests
+
+// MARK: - Correctness
+
+- (void)testOrderFromMultipleProducers {
+	Concurrency::LockFreeTaskQueue<true, true, void, 64> queue;
+	constexpr int Producers = 4;
+	constexpr int PerProducer = 100'000;
+
+	// Each producer's actions should be performed in the order that producer posted them,
+	// without loss even though the ring is much smaller than the total number of actions.
+	std::array<int, Producers> next{};
+	std::atomic<int> failures = 0;
+
+	std::vector<std::thread> producers;
+	for(int p = 0; p < Producers; ++p) {
+		producers.emplace_back([&queue, &next, &failures, p] {
+			for(int c = 0; c < PerProducer; ++c) {
+				queue.enqueue([&next, &failures, p, c] {
+					if(next[p] != c) ++failures;
+					next[p] = c + 1;
+				});
+			}
+		});
+	}
+	for(auto &producer: producers) producer.join();
+	queue.flush();
+
+	XCTAssertEqual(failures, 0);
+	for(int p = 0; p < Producers; ++p) {
+		XCTAssertEqual(next[p], PerProducer);
+	}
+}
+
+- (void)testManualPerform {
+	Concurrency::LockFreeTaskQueue<false> queue;
+	std::atomic<int> total = 0;
+
+	for(int c = 0; c < 100; ++c) {
+		queue.enqueue([&total] { ++total; });
+	}
+
+	// Nothing should happen until perform() is called; allow ample opportunity.
+	std::this_thread::sleep_for(std::chrono::milliseconds(50));
+	XCTAssertEqual(total, 0);
+
+	queue.flush();
+	XCTAssertEqual(total, 100);
+}
+
+- (void)testPerformSchedulesOnlyPriorActions {
+	Concurrency::LockFreeTaskQueue<false> queue;
+	std::atomic<int> total = 0;
+
+	queue.enqueue([&total] { ++total; });
+	queue.perform();
+	queue.enqueue([&total] { total += 10; });
+
+	// Only the action enqueued before perform() should be performed; allow ample opportunity.
+	std::this_thread::sleep_for(std::chrono::milliseconds(50));
+	XCTAssertEqual(total, 1);
+
+	queue.flush();
+	XCTAssertEqual(total, 11);
+}
+
+- (void)testStopPerformsPending {
+	std::atomic<int> total = 0;
+	{
+		Concurrency::LockFreeTaskQueue<false> queue;
+		for(int c = 0; c < 100; ++c) {
+			queue.enqueue([&total] { ++total; });
+		}
+	}
+	XCTAssertEqual(total, 100);
+}
+
+// MARK: - Comparative benchmarks
+
+- (void)testThroughput {
+	Concurrency::AsyncTaskQueue<true> locking;
+	Concurrency::LockFreeTaskQueue<true> lock_free;
+
+	int locking_total, lock_free_total;
+	const double locking_rate = throughput(locking, locking_total);
+	const double lock_free_rate = throughput(lock_free, lock_free_total);
+	XCTAssertEqual(locking_total, ActionCount);
+	XCTAssertEqual(lock_free_total, ActionCount);
+	NSLog(@"Throughput: AsyncTaskQueue %0.0f actions/s; LockFreeTaskQueue %0.0f actions/s", locking_rate, lock_free_rate);
+}
+
+- (void)testLatency {
+	Concurrency::AsyncTaskQueue<true> locking;
+	Concurrency::LockFreeTaskQueue<true> lock_free;
+
+	const double locking_latency = latency(locking);
+	const double lock_free_latency = latency(lock_free);
+	NSLog(@"Mean enqueue-to-perform latency: AsyncTaskQueue %0.0fns; LockFreeTaskQueue %0.0fns", locking_latency, lock_free_latency);
+}
+
+@end
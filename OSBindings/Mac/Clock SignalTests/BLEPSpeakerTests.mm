@@ -0,0 +1,356 @@
+//
+//  BLEPSpeakerTests.mm
+//  Clock SignalTests
+//
+//  Created by Thomas Harte on 16/10/2026.
+//  Copyright 2026 Thomas Harte. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#include "../../../Outputs/Speaker/Implementation/BLEPSpeaker.hpp"
+#include "../../../Outputs/Speaker/Implementation/LowpassSpeaker.hpp"
+#include "../../../Outputs/Speaker/Implementation/ReplayingSource.hpp"
+#include "../../../Outputs/Speaker/Implementation/SampleSource.hpp"
+
+#include "../../../Components/AY38910/AY38910.hpp"
+#include "../../../Machines/Atari/2600/TIASound.hpp"
+#include "../../../Machines/Enterprise/Dave.hpp"
+
+#include <cmath>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace {
+
+constexpr float InputRate = 1000000.0f;
+constexpr float OutputRate = 44100.0f;
+
+/// A square wave with a given half period, usable both as a sample source and as a step source;
+/// a half period of 0 indicates a single step up at @c first_change.
+struct SquareWave: public Outputs::Speaker::SampleSource {
+	SquareWave(size_t half_period, size_t first_change) : half_period(half_period), counter(first_change) {}
+
+	void set_sample_volume_range(int16_t range) {
+		volume = range;
+	}
+
+	void get_samples(size_t number_of_samples, int16_t *target) {
+		while(number_of_samples--) {
+			*target++ = level;
+			if(!--counter) change();
+		}
+	}
+
+	template <typename TargetT> void get_steps(size_t number_of_cycles, TargetT &target) {
+		size_t offset = 0;
+		target.step(0, level);
+		while(counter && offset + counter <= number_of_cycles) {
+			offset += counter;
+			change();
+			if(offset < number_of_cycles) target.step(offset, level);
+		}
+		if(counter) counter -= number_of_cycles - offset;
+	}
+
+	size_t half_period, counter;
+	int16_t volume = 0, level = 0;
+
+	private:
+		void change() {
+			level = level ? 0 : volume;
+			counter = half_period;
+		}
+};
+
+/// Captures all output.
+struct Capture: public Outputs::Speaker::Speaker::Delegate {
+	std::vector<int16_t> samples;
+	void speaker_did_complete_samples(Outputs::Speaker::Speaker *, const std::vector<int16_t> &buffer) final {
+		samples.insert(samples.end(), buffer.begin(), buffer.end());
+	}
+};
+
+/// Performs all work immediately.
+struct ImmediateQueue {
+	template <typename FuncT> void enqueue(FuncT &&func) {
+		func();
+	}
+};
+
+/// Runs @c speaker for one second of input, in chunks of 100 cycles, returning everything output.
+template <typename SpeakerT> std::vector<int16_t> run(SpeakerT &speaker) {
+	Capture capture;
+	ImmediateQueue queue;
+	speaker.set_input_rate(InputRate);
+	speaker.set_output_rate(OutputRate, 512, false);
+	speaker.set_delegate(&capture);
+	for(int c = 0; c < int(InputRate) / 100; c++) {
+		speaker.run_for(queue, Cycles(100));
+	}
+	return capture.samples;
+}
+
+/// Reconstructs the sample stream described by the steps announced to it.
+template <bool is_stereo> struct StepCapture {
+	static constexpr size_t Channels = is_stereo ? 2 : 1;
+
+	void step(size_t offset, int16_t level) {
+		fill(offset);
+		levels[0] = level;
+	}
+
+	void step(size_t offset, int16_t left, int16_t right) {
+		fill(offset);
+		levels[0] = left;
+		levels[1] = right;
+	}
+
+	/// Extends the captured samples with the current levels, up to @c offset cycles into the current call.
+	void fill(size_t offset) {
+		while(samples.size() < (base + offset) * Channels) {
+			samples.insert(samples.end(), levels, levels + Channels);
+		}
+	}
+
+	std::vector<int16_t> samples;
+	int16_t levels[2]{};
+	size_t base = 0;
+};
+
+/// An AY with register writes posted to its task queue.
+template <bool is_stereo> struct AYFixture {
+	Concurrency::AsyncTaskQueue<false> queue;
+	GI::AY38910::AY38910<is_stereo> ay{GI::AY38910::Personality::AY38910, queue};
+	GI::AY38910::AY38910<is_stereo> &source = ay;
+
+	AYFixture() {
+		ay.set_sample_volume_range(16384);
+		ay.set_output_mixing(0.0, 0.5, 1.0, 1.0, 0.5, 0.0);
+	}
+
+	void write(uint32_t value) {
+		GI::AY38910::Utility::write(ay, false, uint8_t(value % 14));
+		GI::AY38910::Utility::write(ay, true, uint8_t(value >> 8));
+		queue.flush();
+	}
+};
+
+/// A stereo AY with register writes logged, at irregular intervals, for replay by a ReplayingSource.
+struct LoggedAYFixture {
+	using AY = GI::AY38910::AY38910<true>;
+	using Log = Concurrency::RegisterWriteLog<>;
+
+	Concurrency::AsyncTaskQueue<false> queue;
+	Log log;
+	AY ay{GI::AY38910::Personality::YM2149F, queue};
+	Outputs::Speaker::ReplayingSource<AY, Log> source{ay, log};
+
+	LoggedAYFixture() {
+		source.set_sample_volume_range(16384);
+		ay.set_register_write_log(&log);
+	}
+
+	void write(uint32_t value) {
+		GI::AY38910::Utility::write(ay, false, uint8_t(value % 14));
+		GI::AY38910::Utility::write(ay, true, uint8_t(value >> 8));
+		log.advance((value >> 16) & 63);
+	}
+};
+
+struct TIAFixture {
+	Concurrency::AsyncTaskQueue<false> queue;
+	Atari2600::TIASound source{queue};
+
+	TIAFixture() {
+		source.set_sample_volume_range(16384);
+	}
+
+	void write(uint32_t value) {
+		const int channel = value & 1;
+		switch((value >> 1) % 3) {
+			case 0:	source.set_volume(channel, uint8_t(value >> 8));	break;
+			case 1:	source.set_divider(channel, uint8_t(value >> 8));	break;
+			case 2:	source.set_control(channel, uint8_t(value >> 8));	break;
+		}
+		queue.flush();
+	}
+};
+
+struct DaveFixture {
+	Concurrency::AsyncTaskQueue<false> queue;
+	Enterprise::Dave::Audio source{queue};
+
+	DaveFixture() {
+		source.set_sample_volume_range(16384);
+		queue.flush();
+	}
+
+	void write(uint32_t value) {
+		const auto address = uint16_t(value % 16);
+		source.write(address == 7 ? 31 : address, uint8_t(value >> 8));
+		queue.flush();
+	}
+};
+
+/// Runs two identical instances of @c FixtureT's source, one via get_samples and one via get_steps,
+/// in irregularly-sized chunks with random register writes in between; @returns the number of samples that differ.
+template <typename FixtureT> size_t compare_steps_and_samples() {
+	using SourceT = std::remove_reference_t<decltype(FixtureT::source)>;
+	constexpr size_t Channels = SourceT::get_is_stereo() ? 2 : 1;
+
+	// Some chips seed their polynomials via rand().
+	srand(0);
+	const auto sampled = std::make_unique<FixtureT>();
+	srand(0);
+	const auto stepped = std::make_unique<FixtureT>();
+
+	std::mt19937 random(0);
+	std::vector<int16_t> samples;
+	StepCapture<SourceT::get_is_stereo()> capture;
+	for(int c = 0; c < 5000; c++) {
+		const auto value = uint32_t(random());
+		sampled->write(value);
+		stepped->write(value);
+
+		const size_t length = 1 + random() % 300;
+		samples.resize(samples.size() + length * Channels);
+		sampled->source.get_samples(length, &samples[samples.size() - length * Channels]);
+
+		stepped->source.get_steps(length, capture);
+		capture.fill(length);
+		capture.base += length;
+	}
+
+	size_t mismatches = 0;
+	for(size_t c = 0; c < samples.size(); c++) {
+		mismatches += samples[c] != capture.samples[c];
+	}
+	return mismatches;
+}
+
+/// @returns The number of times that @c samples rise through @c threshold.
+size_t rising_edges(const std::vector<int16_t> &samples, int16_t threshold) {
+	size_t edges = 0;
+	for(size_t c = 1; c < samples.size(); c++) {
+		edges += samples[c-1] < threshold && samples[c] >= threshold;
+	}
+	return edges;
+}
+
+}
+
+@interface BLEPSpeakerTests : XCTestCase
+@end
+
+@implementation BLEPSpeakerTests
+
+/// Tests that a single step settles exactly at its new level, with only a small overshoot.
+- (void)testStep {
+	SquareWave source(0, 500000);
+	Outputs::Speaker::PullBLEP<SquareWave> speaker(source);
+	speaker.set_output_volume(0.5f);
+	const auto samples = run(speaker);
+
+	XCTAssertEqual(samples.size(), 44032);
+	const size_t step = size_t(OutputRate / 2.0f);
+	for(size_t c = 0; c < step; c++) {
+		XCTAssertEqual(samples[c], 0);
+	}
+
+	int16_t peak = 0;
+	for(size_t c = step; c < step + 64; c++) {
+		peak = std::max(peak, samples[c]);
+	}
+	XCTAssertGreaterThan(peak, 16383);
+	XCTAssertLessThan(peak, 16383 * 1.1);
+
+	for(size_t c = step + 64; c < samples.size(); c++) {
+		XCTAssertEqual(samples[c], 16383);
+	}
+}
+
+/// Tests that a 1kHz square wave is output similarly to the low-pass speaker.
+- (void)testMatchesLowpass {
+	SquareWave blep_source(500, 500), lowpass_source(500, 500);
+	Outputs::Speaker::PullBLEP<SquareWave> blep(blep_source);
+	Outputs::Speaker::PullLowpass<SquareWave> lowpass(lowpass_source);
+
+	// Allow headroom for overshoot.
+	blep.set_output_volume(0.5f);
+	lowpass.set_output_volume(0.5f);
+
+	const auto blep_samples = run(blep);
+	const auto lowpass_samples = run(lowpass);
+	XCTAssertEqual(blep_samples.size(), lowpass_samples.size());
+
+	XCTAssertEqual(rising_edges(blep_samples, 8192), 998);
+	XCTAssertEqual(rising_edges(lowpass_samples, 8192), 998);
+
+	double blep_mean = 0.0, lowpass_mean = 0.0;
+	for(size_t c = 0; c < blep_samples.size(); c++) {
+		blep_mean += blep_samples[c];
+		lowpass_mean += lowpass_samples[c];
+	}
+	XCTAssertEqualWithAccuracy(blep_mean / double(blep_samples.size()), 8192.0, 100.0);
+	XCTAssertEqualWithAccuracy(lowpass_mean / double(lowpass_samples.size()), 8192.0, 100.0);
+}
+
+/// Tests that each chip announces exactly the steps necessary to reproduce its sampled output.
+- (void)testChipSteps {
+	XCTAssertEqual(compare_steps_and_samples<AYFixture<false>>(), 0);
+	XCTAssertEqual(compare_steps_and_samples<AYFixture<true>>(), 0);
+	XCTAssertEqual(compare_steps_and_samples<LoggedAYFixture>(), 0);
+	XCTAssertEqual(compare_steps_and_samples<TIAFixture>(), 0);
+	XCTAssertEqual(compare_steps_and_samples<DaveFixture>(), 0);
+}
+
+/// Tests that stereo steps are output as interleaved channels.
+- (void)testStereo {
+	Concurrency::AsyncTaskQueue<false> queue;
+	GI::AY38910::AY38910<true> ay(GI::AY38910::Personality::AY38910, queue);
+	Outputs::Speaker::PullBLEP<GI::AY38910::AY38910<true>> speaker(ay);
+
+	// Enable only channel A, at fixed full volume and without tone or noise, and mix it entirely to the right.
+	ay.set_output_mixing(0.0, 0.0, 0.0, 1.0, 0.0, 0.0);
+	GI::AY38910::Utility::write(ay, false, 7);
+	GI::AY38910::Utility::write(ay, true, 0x3f);
+	GI::AY38910::Utility::write(ay, false, 8);
+	GI::AY38910::Utility::write(ay, true, 0x0f);
+	queue.flush();
+
+	Capture capture;
+	ImmediateQueue immediate;
+	speaker.set_input_rate(InputRate);
+	speaker.set_output_rate(OutputRate, 512, true);
+	speaker.set_delegate(&capture);
+	speaker.run_for(immediate, Cycles(int(InputRate) / 10));
+
+	XCTAssertEqual(capture.samples.size(), 4096 * 2);
+	const auto level = capture.samples.back();
+	XCTAssertGreaterThan(level, 0);
+	for(size_t c = 128; c < capture.samples.size(); c += 2) {
+		XCTAssertEqual(capture.samples[c], 0);
+		XCTAssertEqual(capture.samples[c + 1], level);
+	}
+}
+
+- (void)testBLEPPerformance {
+	[self measureBlock:^{
+		SquareWave source(500, 500);
+		Outputs::Speaker::PullBLEP<SquareWave> speaker(source);
+		run(speaker);
+	}];
+}
+
+- (void)testLowpassPerformance {
+	[self measureBlock:^{
+		SquareWave source(500, 500);
+		Outputs::Speaker::PullLowpass<SquareWave> speaker(source);
+		run(speaker);
+	}];
+}
+
+@end
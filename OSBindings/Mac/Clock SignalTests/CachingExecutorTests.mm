@@ -0,0 +1,141 @@
+//
+//  CachingExecutorTests.mm
+//  Clock SignalTests
+//
+//  Created by Thomas Harte on 16/10/2026.
+//  Copyright 2026 Thomas Harte. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#include "../../../InstructionSets/CachingExecutor.hpp"
+
+#include <type_traits>
+
+namespace {
+
+class TestExecutor;
+using TestCachingExecutor = InstructionSet::CachingExecutor<TestExecutor, 0xffff, 1, uint8_t, false, 3>;
+
+/// An executor for a one-byte instruction set with no effects, which counts the translations
+/// performed by the CachingExecutor.
+class TestExecutor: public TestCachingExecutor {
+	public:
+		TestExecutor() {
+			performers_[0] = &TestExecutor::perform;
+		}
+
+		void enter(uint16_t address) {
+			set_program_counter(address);
+		}
+
+		using TestCachingExecutor::invalidate;
+		using TestCachingExecutor::invalidate_all;
+
+		int translations = 0;
+
+	private:
+		friend TestCachingExecutor;
+
+		PerformerIndex action_for(uint8_t) {
+			return 0;
+		}
+
+		void parse(uint16_t start, uint16_t closing_bound) {
+			++translations;
+			for(uint32_t address = start; address <= closing_bound; address++) {
+				announce_instruction(uint16_t(address), 0);
+			}
+		}
+
+		void perform() {}
+};
+
+static_assert(!std::is_copy_constructible_v<TestExecutor>);
+static_assert(!std::is_copy_assignable_v<TestExecutor>);
+
+}
+
+@interface CachingExecutorTests : XCTestCase
+@end
+
+@implementation CachingExecutorTests
+
+/// Tests that each entry point is translated only once while its page remains cached.
+- (void)testCacheHits {
+	TestExecutor executor;
+
+	executor.enter(0x1000);
+	XCTAssertEqual(executor.translations, 1);
+	executor.enter(0x1000);
+	XCTAssertEqual(executor.translations, 1);
+
+	// A new entry point within the same page requires its own translation.
+	executor.enter(0x1080);
+	XCTAssertEqual(executor.translations, 2);
+	executor.enter(0x1000);
+	executor.enter(0x1080);
+	XCTAssertEqual(executor.translations, 2);
+}
+
+/// Tests that invalidation discards only the affected pages.
+- (void)testInvalidation {
+	TestExecutor executor;
+	executor.enter(0x1000);
+	executor.enter(0x1100);
+	executor.enter(0x1200);
+	XCTAssertEqual(executor.translations, 3);
+
+	// A write within a page discards only that page.
+	executor.invalidate(0x1280);
+	executor.enter(0x1000);
+	executor.enter(0x1100);
+	XCTAssertEqual(executor.translations, 3);
+	executor.enter(0x1200);
+	XCTAssertEqual(executor.translations, 4);
+
+	// A write close enough to the start of a page to be part of an instruction that
+	// begins on the previous page also discards the previous page.
+	executor.invalidate(0x1101);
+	executor.enter(0x1200);
+	XCTAssertEqual(executor.translations, 4);
+	executor.enter(0x1000);
+	executor.enter(0x1100);
+	XCTAssertEqual(executor.translations, 6);
+
+	// Discarding everything should require everything to be retranslated.
+	executor.invalidate_all();
+	executor.enter(0x1000);
+	executor.enter(0x1100);
+	executor.enter(0x1200);
+	XCTAssertEqual(executor.translations, 9);
+}
+
+/// Tests that once the cache is full, the least-recently entered page is the one discarded.
+- (void)testLRUEviction {
+	// The number of pages that a CachingExecutor retains.
+	constexpr int CachedPages = 64;
+	TestExecutor executor;
+
+	for(int page = 0; page < CachedPages; page++) {
+		executor.enter(uint16_t(page << 8));
+	}
+	XCTAssertEqual(executor.translations, CachedPages);
+
+	// Reenter the first page, leaving the second as least recently used; adding another
+	// page should then discard only the second.
+	executor.enter(0);
+	executor.enter(uint16_t(CachedPages << 8));
+	XCTAssertEqual(executor.translations, CachedPages + 1);
+
+	executor.enter(0);
+	for(int page = 2; page <= CachedPages; page++) {
+		executor.enter(uint16_t(page << 8));
+	}
+	XCTAssertEqual(executor.translations, CachedPages + 1);
+
+	executor.enter(0x100);
+	XCTAssertEqual(executor.translations, CachedPages + 2);
+}
+
+@end
@@ -0,0 +1,157 @@
+//
+//  CopyOnWriteDeviceTests.mm
+//  Clock SignalTests
+//
+//  Created by Thomas Harte on 16/10/2026.
+//  Copyright 2026 Thomas Harte. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#include "../../../Storage/MassStorage/CopyOnWriteDevice.hpp"
+
+#include <cstdio>
+#include <string>
+
+namespace {
+
+using namespace Storage::MassStorage;
+
+/// A 16-block device held in memory, in which every byte of block n is initially n.
+class MemoryDevice: public MassStorageDevice {
+	public:
+		MemoryDevice() {
+			for(uint8_t c = 0; c < 16; c++) {
+				blocks_.emplace_back(256, c);
+			}
+		}
+
+		size_t get_block_size() final									{	return 256;				}
+		size_t get_number_of_blocks() final								{	return blocks_.size();	}
+		std::vector<uint8_t> get_block(size_t address) final			{	return blocks_[address];	}
+		void set_block(size_t address, const std::vector<uint8_t> &contents) final {
+			blocks_[address] = contents;
+			++writes;
+		}
+
+		int writes = 0;
+
+	private:
+		std::vector<std::vector<uint8_t>> blocks_;
+};
+
+}
+
+@interface CopyOnWriteDeviceTests : XCTestCase
+@end
+
+@implementation CopyOnWriteDeviceTests {
+	std::string _deltaFileName;
+}
+
+- (void)setUp {
+	_deltaFileName = [[NSTemporaryDirectory() stringByAppendingPathComponent:[[NSUUID UUID] UUIDString]] UTF8String];
+}
+
+- (void)tearDown {
+	std::remove(_deltaFileName.c_str());
+}
+
+- (void)exerciseOverlay:(CopyOnWriteDevice &)overlay base:(MemoryDevice &)base {
+	XCTAssertEqual(overlay.get_block_size(), 256);
+	XCTAssertEqual(overlay.get_number_of_blocks(), 16);
+
+	// Writes should be visible through the overlay only.
+	overlay.set_block(3, std::vector<uint8_t>(256, 0xaa));
+	overlay.set_block(3, std::vector<uint8_t>(256, 0xbb));
+	overlay.set_block(7, std::vector<uint8_t>(256, 0xcc));
+	XCTAssertEqual(overlay.get_number_of_modified_blocks(), 2);
+	XCTAssert(overlay.get_block(3) == std::vector<uint8_t>(256, 0xbb));
+	XCTAssert(overlay.get_block(7) == std::vector<uint8_t>(256, 0xcc));
+	XCTAssert(overlay.get_block(4) == std::vector<uint8_t>(256, 4));
+	XCTAssert(base.get_block(3) == std::vector<uint8_t>(256, 3));
+	XCTAssertEqual(base.writes, 0);
+
+	// Discarding should restore the original contents.
+	overlay.discard();
+	XCTAssertEqual(overlay.get_number_of_modified_blocks(), 0);
+	XCTAssert(overlay.get_block(3) == std::vector<uint8_t>(256, 3));
+
+	// Committing should write each modified block to the base once.
+	overlay.set_block(5, std::vector<uint8_t>(256, 0xdd));
+	overlay.commit();
+	XCTAssertEqual(overlay.get_number_of_modified_blocks(), 0);
+	XCTAssertEqual(base.writes, 1);
+	XCTAssert(base.get_block(5) == std::vector<uint8_t>(256, 0xdd));
+	XCTAssert(overlay.get_block(5) == std::vector<uint8_t>(256, 0xdd));
+}
+
+- (void)testInMemory {
+	const auto base = std::make_shared<MemoryDevice>();
+	CopyOnWriteDevice overlay(base);
+	[self exerciseOverlay:overlay base:*base];
+}
+
+- (void)testSidecar {
+	const auto base = std::make_shared<MemoryDevice>();
+	{
+		CopyOnWriteDevice overlay(base, _deltaFileName);
+		[self exerciseOverlay:overlay base:*base];
+	}
+
+	// A delta should persist between overlays, and occupy one record per modified block.
+	{
+		CopyOnWriteDevice overlay(base, _deltaFileName);
+		overlay.set_block(9, std::vector<uint8_t>(256, 0x11));
+		overlay.set_block(9, std::vector<uint8_t>(256, 0x22));
+	}
+	{
+		CopyOnWriteDevice overlay(base, _deltaFileName);
+		XCTAssertEqual(overlay.get_number_of_modified_blocks(), 1);
+		XCTAssert(overlay.get_block(9) == std::vector<uint8_t>(256, 0x22));
+		XCTAssert(base->get_block(9) == std::vector<uint8_t>(256, 9));
+	}
+}
+
+- (void)testInvalidSidecar {
+	const auto base = std::make_shared<MemoryDevice>();
+
+	// A file that isn't a delta should be rejected rather than overwritten.
+	FILE *const file = std::fopen(_deltaFileName.c_str(), "wb");
+	std::fputs("Not a delta file.", file);
+	std::fclose(file);
+
+	bool did_throw = false;
+	try {
+		CopyOnWriteDevice overlay(base, _deltaFileName);
+	} catch(CopyOnWriteDevice::Error error) {
+		did_throw = error == CopyOnWriteDevice::Error::InvalidFormat;
+	}
+	XCTAssert(did_throw);
+}
+
+- (void)testMismatchedSidecar {
+	const auto base = std::make_shared<MemoryDevice>();
+	{
+		CopyOnWriteDevice overlay(base, _deltaFileName);
+		overlay.set_block(2, std::vector<uint8_t>(256, 0x33));
+	}
+
+	// A delta made against one base should be refused by a base with different contents.
+	const auto other_base = std::make_shared<MemoryDevice>();
+	other_base->set_block(0, std::vector<uint8_t>(256, 0xee));
+
+	bool did_throw = false;
+	try {
+		CopyOnWriteDevice overlay(other_base, _deltaFileName);
+	} catch(CopyOnWriteDevice::Error error) {
+		did_throw = error == CopyOnWriteDevice::Error::InvalidFormat;
+	}
+	XCTAssert(did_throw);
+
+	// ... but still be accepted by the original.
+	CopyOnWriteDevice overlay(base, _deltaFileName);
+	XCTAssert(overlay.get_block(2) == std::vector<uint8_t>(256, 0x33));
+}
+
+@end
@@ -0,0 +1,155 @@
+//
+//  DiskImageHolderTests.mm
+//  Clock SignalTests
+//
+//  Created by Thomas Harte on 16/10/2026.
+//  Copyright 2026 Thomas Harte. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#include "../../../Storage/Disk/DiskImage/DiskImage.hpp"
+#include "../../../Storage/Disk/Track/UnformattedTrack.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using namespace Storage::Disk;
+
+/// Records the address of every track decoded, and the thread that decoded it.
+struct DecodeLog {
+	std::mutex mutex;
+	std::vector<std::pair<Track::Address, std::thread::id>> decodes;
+
+	size_t size() {
+		std::lock_guard lock(mutex);
+		return decodes.size();
+	}
+
+	size_t count_on(std::thread::id thread) {
+		std::lock_guard lock(mutex);
+		return size_t(std::count_if(decodes.begin(), decodes.end(), [thread](const auto &decode) {
+			return decode.second == thread;
+		}));
+	}
+
+	size_t count_of(Track::Address address) {
+		std::lock_guard lock(mutex);
+		return size_t(std::count_if(decodes.begin(), decodes.end(), [address](const auto &decode) {
+			return decode.first == address;
+		}));
+	}
+};
+
+/// A double-sided, 80-track disk image that logs all decodes, each of which takes at least @c delay.
+class LoggingImage: public DiskImage {
+	public:
+		LoggingImage(DecodeLog &log, std::chrono::milliseconds delay = std::chrono::milliseconds(0)) : log_(log), delay_(delay) {}
+
+		HeadPosition get_maximum_head_position() final	{	return HeadPosition(80);	}
+		int get_head_count() final						{	return 2;					}
+
+		std::shared_ptr<Track> get_track_at_position(Track::Address address) final {
+			std::this_thread::sleep_for(delay_);
+			std::lock_guard lock(log_.mutex);
+			log_.decodes.emplace_back(address, std::this_thread::get_id());
+			return std::make_shared<UnformattedTrack>();
+		}
+
+	private:
+		DecodeLog &log_;
+		const std::chrono::milliseconds delay_;
+};
+
+/// Waits for up to a second for @c log to reach @c size entries.
+bool wait_for(DecodeLog &log, size_t size) {
+	for(int c = 0; c < 1000; c++) {
+		if(log.size() >= size) return true;
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+	return false;
+}
+
+}
+
+@interface DiskImageHolderTests : XCTestCase
+@end
+
+@implementation DiskImageHolderTests
+
+/// Tests that tracks within two positions of the head, on both sides, are decoded in the background
+/// and are subsequently supplied from the cache.
+- (void)testPrefetch {
+	DecodeLog log;
+	DiskImageHolder<LoggingImage> disk(log);
+	const auto this_thread = std::this_thread::get_id();
+
+	const auto track = disk.get_track_at_position(Track::Address(0, HeadPosition(10)));
+	XCTAssert(track != nullptr);
+	XCTAssertEqual(log.count_on(this_thread), 1);
+
+	// Positions 8–12 should be decoded on both heads.
+	XCTAssert(wait_for(log, 10));
+	std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	XCTAssertEqual(log.size(), 10);
+	for(int position = 8; position <= 12; position++) {
+		for(int head = 0; head < 2; head++) {
+			XCTAssertEqual(log.count_of(Track::Address(head, HeadPosition(position))), 1);
+		}
+	}
+
+	// The same track should be returned upon a repeated request.
+	XCTAssert(disk.get_track_at_position(Track::Address(0, HeadPosition(10))) == track);
+
+	// Stepping to a nearby position should be served entirely from the cache, and prompt
+	// decoding of positions 13 and 14 only.
+	XCTAssert(disk.get_track_at_position(Track::Address(1, HeadPosition(12))) != nullptr);
+	XCTAssertEqual(log.count_on(this_thread), 1);
+	XCTAssert(wait_for(log, 14));
+	std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	XCTAssertEqual(log.size(), 14);
+	XCTAssertEqual(log.count_of(Track::Address(1, HeadPosition(14))), 1);
+}
+
+/// Tests that no prefetching occurs beyond the bounds of the disk.
+- (void)testPrefetchBounds {
+	DecodeLog log;
+	DiskImageHolder<LoggingImage> disk(log);
+
+	disk.get_track_at_position(Track::Address(0, HeadPosition(79)));
+	XCTAssert(wait_for(log, 6));
+	std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	XCTAssertEqual(log.size(), 6);
+}
+
+/// Tests that a track that isn't cached is obtained without waiting for an ongoing prefetch to complete.
+- (void)testMissAbandonsPrefetch {
+	DecodeLog log;
+	DiskImageHolder<LoggingImage> disk(log, std::chrono::milliseconds(20));
+
+	// Begin a prefetch of ten tracks, then seek well away while it is ongoing.
+	disk.get_track_at_position(Track::Address(0, HeadPosition(10)));
+	std::this_thread::sleep_for(std::chrono::milliseconds(30));
+
+	const auto start = std::chrono::steady_clock::now();
+	XCTAssert(disk.get_track_at_position(Track::Address(0, HeadPosition(50))) != nullptr);
+	const auto wait = std::chrono::steady_clock::now() - start;
+
+	// At most the prefetch's current track should have been awaited.
+	XCTAssertLessThan(std::chrono::duration_cast<std::chrono::milliseconds>(wait).count(), 100);
+
+	size_t prefetched = 0;
+	for(int position = 8; position <= 12; position++) {
+		for(int head = 0; head < 2; head++) {
+			prefetched += log.count_of(Track::Address(head, HeadPosition(position)));
+		}
+	}
+	XCTAssertLessThan(prefetched, 10);
+}
+
+@end
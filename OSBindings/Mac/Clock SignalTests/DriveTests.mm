@@ -0,0 +1,139 @@
+//
+//  DriveTests.mm
+//  Clock SignalTests
+//
+//  Created by Thomas Harte on 16/10/2026.
+//  Copyright 2026 Thomas Harte. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#include "../../../Storage/Disk/Disk.hpp"
+#include "../../../Storage/Disk/Drive.hpp"
+#include "../../../Storage/Disk/Track/PCMTrack.hpp"
+
+#include <memory>
+#include <vector>
+
+namespace {
+
+using namespace Storage::Disk;
+
+/// A single-headed disk with the same track at every position; that track has a flux transition in each of its 20,000 bit cells.
+struct FluxDisk: public Disk {
+	std::shared_ptr<Track> track;
+
+	FluxDisk() {
+		PCMSegment segment;
+		segment.data.resize(20'000, true);
+		track = std::make_shared<PCMTrack>(segment);
+	}
+
+	HeadPosition get_maximum_head_position() final	{	return HeadPosition(1);	}
+	int get_head_count() final						{	return 1;				}
+	bool get_is_read_only() final					{	return true;			}
+	void flush_tracks() final						{}
+
+	std::shared_ptr<Track> get_track_at_position(Track::Address) final				{	return track;	}
+	void set_track_at_position(Track::Address, const std::shared_ptr<Track> &) final	{}
+	bool tracks_differ(Track::Address, Track::Address) final							{	return false;	}
+};
+
+/// Counts flux transitions and records the time at which each index hole is announced.
+struct EventRecorder: public Drive::EventDelegate {
+	Cycles::IntType time = 0;
+	int flux_transitions = 0;
+	std::vector<Cycles::IntType> index_holes;
+
+	void process_event(const Drive::Event &event) final {
+		if(event.type == Track::Event::IndexHole) {
+			index_holes.push_back(time);
+		} else {
+			++flux_transitions;
+		}
+	}
+
+	void advance(Cycles cycles) final {
+		time += cycles.as_integral();
+	}
+};
+
+// At 1Mhz and 300RPM, a revolution takes 200,000 cycles; so a bit cell is 10 cycles, which is short
+// enough that the drive won't generate any noise between transitions.
+constexpr int ClockRate = 1'000'000;
+constexpr Cycles::IntType CyclesPerRevolution = 200'000;
+
+void run_for(Drive &drive, Cycles::IntType cycles) {
+	while(cycles > 0) {
+		const auto slice = std::min(cycles, Cycles::IntType(1'001));
+		drive.run_for(Cycles(slice));
+		cycles -= slice;
+	}
+}
+
+}
+
+@interface DriveTests : XCTestCase
+@end
+
+@implementation DriveTests
+
+/// Tests that a drive whose delegate isn't listening announces index holes only, at the same points
+/// in rotation as otherwise, and that flux transitions resume when the delegate is listening again.
+- (void)testEventSkipping {
+	Drive drive(ClockRate, 1);
+	EventRecorder recorder;
+	drive.set_event_delegate(&recorder);
+	drive.set_disk(std::make_shared<FluxDisk>());
+	drive.set_motor_on(true);
+
+	// Listen for a revolution and a half; a flux transition should be received for every bit cell,
+	// and index holes should be announced at the start of rotation and after a full revolution.
+	run_for(drive, CyclesPerRevolution * 3 / 2);
+	XCTAssertEqual(recorder.index_holes.size(), 2);
+	XCTAssertGreaterThan(recorder.flux_transitions, 29'900);
+	XCTAssertLessThan(recorder.flux_transitions, 30'100);
+	const int listened_transitions = recorder.flux_transitions;
+
+	// Stop listening for five revolutions; only index holes should be received.
+	drive.set_event_delegate_is_listening(false);
+	run_for(drive, CyclesPerRevolution * 5);
+	XCTAssertEqual(recorder.flux_transitions, listened_transitions);
+	XCTAssertEqual(recorder.index_holes.size(), 7);
+
+	// Resume listening, from part way through a revolution.
+	drive.set_event_delegate_is_listening(true);
+	run_for(drive, CyclesPerRevolution * 2);
+	XCTAssertEqual(recorder.index_holes.size(), 9);
+	XCTAssertGreaterThan(recorder.flux_transitions - listened_transitions, 39'900);
+	XCTAssertLessThan(recorder.flux_transitions - listened_transitions, 40'100);
+
+	// All time should have been accounted for, and all index holes should be a revolution apart.
+	XCTAssertEqual(recorder.time, CyclesPerRevolution * 17 / 2);
+	for(size_t c = 1; c < recorder.index_holes.size(); c++) {
+		const auto interval = recorder.index_holes[c] - recorder.index_holes[c - 1];
+		XCTAssertGreaterThanOrEqual(interval, CyclesPerRevolution - 20);
+		XCTAssertLessThanOrEqual(interval, CyclesPerRevolution + 20);
+	}
+}
+
+/// Tests that a drive without a delegate continues to track the index hole.
+- (void)testNoDelegate {
+	Drive drive(ClockRate, 1);
+	drive.set_disk(std::make_shared<FluxDisk>());
+	drive.set_motor_on(true);
+
+	// The index pulse lasts for 2ms after each index hole.
+	bool saw_index_pulse = false;
+	for(int c = 0; c < 3; c++) {
+		run_for(drive, CyclesPerRevolution - 3'000);
+		XCTAssertFalse(drive.get_index_pulse());
+
+		run_for(drive, 3'000);
+		saw_index_pulse |= drive.get_index_pulse();
+	}
+	XCTAssert(saw_index_pulse);
+	XCTAssert(drive.get_is_ready());
+}
+
+@end
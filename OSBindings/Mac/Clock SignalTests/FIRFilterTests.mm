@@ -0,0 +1,173 @@
+//
+//  FIRFilterTests.mm
+//  Clock SignalTests
+//
+//  Created by Thomas Harte on 16/10/2026.
+//  Copyright 2026 Thomas Harte. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#include "../../../SignalProcessing/FIRFilter.hpp"
+
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+namespace {
+
+// A typical configuration: an AY clocked at 1.7734Mhz, output at 44.1kHz.
+constexpr float InputRate = 1773400.0f;
+constexpr float OutputRate = 44100.0f;
+constexpr size_t Taps = 163;
+
+/// @returns The fixed-point coefficients in use by @c filter.
+std::vector<short> fixed_coefficients(const SignalProcessing::FIRFilter &filter) {
+	std::vector<short> result;
+	for(const auto coefficient: filter.get_coefficients()) {
+		result.push_back(short(lrintf(coefficient * 32767.0f)));
+	}
+	return result;
+}
+
+/// @returns The result of applying @c coefficients as the original, scalar implementation did.
+short reference_apply(const std::vector<short> &coefficients, const short *src, size_t stride) {
+	int output = 0;
+	for(size_t c = 0; c < coefficients.size(); ++c) {
+		output += coefficients[c] * src[c * stride];
+	}
+	return short(output >> 15);
+}
+
+std::vector<short> noise(size_t length) {
+	std::vector<short> result(length);
+	srand(65816);
+	for(auto &sample: result) {
+		sample = short(rand());
+	}
+	return result;
+}
+
+}
+
+@interface FIRFilterTests : XCTestCase
+@end
+
+@implementation FIRFilterTests
+
+/// Tests that whichever vectorised implementation is in use matches the scalar original.
+- (void)testVectorisedMatchesScalar {
+#ifdef USE_ACCELERATE
+	// Accelerate rounds rather than truncates.
+	constexpr int tolerance = 1;
+#else
+	constexpr int tolerance = 0;
+#endif
+
+	const auto source = noise(4096);
+
+	// Test a variety of lengths, to cover all tail cases.
+	for(size_t taps = 3; taps < 64; taps += 2) {
+		const SignalProcessing::FIRFilter filter(taps, InputRate, 0.0f, OutputRate / 2.0f);
+		const auto coefficients = fixed_coefficients(filter);
+
+		for(size_t offset = 0; offset < 64; ++offset) {
+			XCTAssertLessThanOrEqual(
+				abs(filter.apply(&source[offset]) - reference_apply(coefficients, &source[offset], 1)),
+				tolerance);
+
+			short stereo[2];
+			filter.apply_stereo(&source[offset], stereo);
+			XCTAssertLessThanOrEqual(abs(stereo[0] - reference_apply(coefficients, &source[offset], 2)), tolerance);
+			XCTAssertLessThanOrEqual(abs(stereo[1] - reference_apply(coefficients, &source[offset + 1], 2)), tolerance);
+		}
+	}
+}
+
+/// Tests that each phase of a polyphase bank matches the ordinary filter applied to a
+/// correspondingly-advanced signal.
+- (void)testPolyphaseBank {
+	constexpr size_t phases = 16;
+	const auto bank = SignalProcessing::FIRFilter::polyphase_bank(phases, Taps, InputRate, 0.0f, OutputRate / 2.0f);
+	XCTAssertEqual(bank.size(), phases);
+
+	const SignalProcessing::FIRFilter filter(Taps, InputRate, 0.0f, OutputRate / 2.0f);
+
+	// Use a 5kHz tone, i.e. comfortably within the pass band.
+	const float step = 2.0f * float(M_PI) * 5000.0f / InputRate;
+	auto tone = [step] (float offset) {
+		std::vector<short> source(Taps + 64);
+		for(size_t c = 0; c < source.size(); ++c) {
+			source[c] = short(16384.0f * sinf((float(c) + offset) * step));
+		}
+		return source;
+	};
+	const auto source = tone(0.0f);
+
+	for(size_t phase = 0; phase < phases; ++phase) {
+		XCTAssertEqual(bank[phase].get_number_of_taps(), Taps);
+
+		const auto advanced_source = tone(float(phase) / float(phases));
+		for(size_t offset = 0; offset < 64; ++offset) {
+			XCTAssertLessThanOrEqual(abs(bank[phase].apply(&source[offset]) - filter.apply(&advanced_source[offset])), 32);
+		}
+	}
+
+	// Phase 0 should be close to the standard filter for any input.
+	const auto noisy_source = noise(Taps + 1024);
+	for(size_t offset = 0; offset < 1024; ++offset) {
+		XCTAssertLessThanOrEqual(abs(bank[0].apply(&noisy_source[offset]) - filter.apply(&noisy_source[offset])), 256);
+	}
+}
+
+// MARK: - Performance.
+
+- (void)testMonoPerformance {
+	const SignalProcessing::FIRFilter filter(Taps, InputRate, 0.0f, OutputRate / 2.0f);
+	const auto source = noise(Taps + 1024);
+
+	[self measureBlock:^{
+		int total = 0;
+		for(int repeat = 0; repeat < 1000; ++repeat) {
+			for(size_t offset = 0; offset < 1024; ++offset) {
+				total += filter.apply(&source[offset]);
+			}
+		}
+		XCTAssertNotEqual(total, 1);
+	}];
+}
+
+- (void)testStereoPerformance {
+	const SignalProcessing::FIRFilter filter(Taps, InputRate, 0.0f, OutputRate / 2.0f);
+	const auto source = noise(Taps * 2 + 2048);
+
+	[self measureBlock:^{
+		int total = 0;
+		short output[2];
+		for(int repeat = 0; repeat < 1000; ++repeat) {
+			for(size_t offset = 0; offset < 2048; offset += 2) {
+				filter.apply_stereo(&source[offset], output);
+				total += output[0] + output[1];
+			}
+		}
+		XCTAssertNotEqual(total, 1);
+	}];
+}
+
+- (void)testScalarPerformance {
+	const SignalProcessing::FIRFilter filter(Taps, InputRate, 0.0f, OutputRate / 2.0f);
+	const auto coefficients = fixed_coefficients(filter);
+	const auto source = noise(Taps + 1024);
+
+	[self measureBlock:^{
+		int total = 0;
+		for(int repeat = 0; repeat < 1000; ++repeat) {
+			for(size_t offset = 0; offset < 1024; ++offset) {
+				total += reference_apply(coefficients, &source[offset], 1);
+			}
+		}
+		XCTAssertNotEqual(total, 1);
+	}];
+}
+
+@end
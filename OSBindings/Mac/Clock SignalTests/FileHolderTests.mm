@@ -0,0 +1,85 @@
+//
+//  FileHolderTests.mm
+//  Clock SignalTests
+//
+//  Created by Thomas Harte on 16/10/2026.
+//  Copyright 2026 Thomas Harte. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#include "../../../Storage/FileHolder.hpp"
+
+#include <cstdio>
+#include <string>
+
+@interface FileHolderTests : XCTestCase
+@end
+
+@implementation FileHolderTests {
+	std::string _fileName;
+}
+
+- (void)setUp {
+	_fileName = [[NSTemporaryDirectory() stringByAppendingPathComponent:[[NSUUID UUID] UUIDString]] UTF8String];
+
+	FILE *const file = std::fopen(_fileName.c_str(), "wb");
+	for(int c = 0; c < 1024; c++) {
+		std::fputc(c & 0xff, file);
+	}
+	std::fclose(file);
+}
+
+- (void)tearDown {
+	std::remove(_fileName.c_str());
+}
+
+/// Tests that views supply file contents without affecting the reading cursor, and decline
+/// ranges beyond the end of the file.
+- (void)testView {
+	Storage::FileHolder file(_fileName);
+	file.seek(100, SEEK_SET);
+
+	const auto view = file.view(10, 20);
+	XCTAssertEqual(view.size(), 20);
+	for(size_t c = 0; c < view.size(); c++) {
+		XCTAssertEqual(view[c], c + 10);
+	}
+	XCTAssertEqual(file.tell(), 100);
+
+	XCTAssert(file.view(1000, 25).empty());
+}
+
+/// Tests that views reflect prior writes, including those that extend the file, and that
+/// earlier views remain valid.
+- (void)testViewAfterWrite {
+	Storage::FileHolder file(_fileName);
+	XCTAssertEqual(file.view(0, 16).size(), 16);
+
+	file.seek(12, SEEK_SET);
+	file.put8(0xaa);
+	XCTAssertEqual(file.view(12, 1)[0], 0xaa);
+
+	file.seek(0, SEEK_END);
+	file.putn(100, 0x55);
+	const auto extension = file.view(1000, 124);
+	XCTAssertEqual(extension.size(), 124);
+	XCTAssertEqual(extension[0], 1000 & 0xff);
+	XCTAssertEqual(extension[123], 0x55);
+
+	// Earlier regions should remain visible through the replacement mapping.
+	const auto start = file.view(0, 16);
+	XCTAssertEqual(start[0], 0);
+	XCTAssertEqual(start[15], 15);
+
+	// Repeated growth should be observed by each subsequent view.
+	for(int c = 0; c < 8; c++) {
+		file.seek(0, SEEK_END);
+		file.put8(uint8_t(c));
+		const auto tail = file.view(1124 + c, 1);
+		XCTAssertEqual(tail.size(), 1);
+		XCTAssertEqual(tail[0], c);
+	}
+}
+
+@end
@@ -0,0 +1,160 @@
+//
+//  IIgsSoundTests.mm
+//  Clock SignalTests
+//
+//  Created by Thomas Harte on 16/10/2026.
+//  Copyright 2026 Thomas Harte. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#include "../../../Machines/Apple/AppleIIgs/Sound.hpp"
+#include "../../../ClockReceiver/TimeTypes.hpp"
+#include "../../../Numeric/CPUFeatures.hpp"
+
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace {
+
+/// A single register write, to be performed before the sample at @c time is generated.
+struct RegisterWrite {
+	size_t time;
+	uint8_t address;
+	uint8_t value;
+};
+
+/// Builds a register log that plays @c length samples of randomly-programmed oscillators, using a mix
+/// of free-run, one-shot and swap modes, and sync/AM mode if @c include_sync is @c true.
+std::vector<RegisterWrite> register_log(size_t length, bool include_sync) {
+	std::mt19937 random(include_sync);
+	std::vector<RegisterWrite> log;
+
+	// Enable all 32 oscillators.
+	log.push_back({0, 0xe1, 31 << 1});
+
+	for(size_t time = 0; time < length; time += 1 + random() % 400) {
+		const uint8_t oscillator = random() & 31;
+
+		log.push_back({time, uint8_t(0x00 | oscillator), uint8_t(random())});
+		log.push_back({time, uint8_t(0x20 | oscillator), uint8_t(random())});
+		log.push_back({time, uint8_t(0x40 | oscillator), uint8_t(random())});
+		log.push_back({time, uint8_t(0x80 | oscillator), uint8_t(random() & 15)});
+
+		// Use tables of 256, 512 or 1024 bytes, at any resolution.
+		log.push_back({time, uint8_t(0xc0 | oscillator), uint8_t(((random() % 3) << 3) | (random() & 7))});
+
+		uint8_t mode;
+		const auto selection = random() % 20;
+		if(selection < 8)					mode = 0;
+		else if(selection < 16)				mode = 2;
+		else if(selection < 19 || !include_sync)	mode = 6;
+		else								mode = 4;
+		log.push_back({time, uint8_t(0xa0 | oscillator), uint8_t(mode | (random() & 1))});
+
+		if(!(random() & 31)) {
+			log.push_back({time, 0xe1, uint8_t((7 + random() % 25) << 1)});
+		}
+	}
+
+	return log;
+}
+
+/// Owns a GLU and the audio queue it posts to.
+struct Ensoniq {
+	Ensoniq(bool use_oscillator_bank, bool use_avx2) : glu(queue) {
+		glu.set_oscillator_bank_enabled(use_oscillator_bank);
+		glu.set_avx2_enabled(use_avx2);
+		glu.set_sample_volume_range(1024);
+
+		// Fill the first sixteen pages of sound RAM with waveforms; include the occasional
+		// zero so that oscillators sometimes halt.
+		std::mt19937 random(0);
+		glu.set_control(0x60);
+		glu.set_address_low(0);
+		glu.set_address_high(0);
+		for(int c = 0; c < 16 * 256; c++) {
+			const auto value = uint8_t(random());
+			glu.set_data((value || !(random() & 3)) ? value : 1);
+		}
+		glu.set_control(0x00);
+
+		// Apply the RAM writes.
+		queue.flush();
+		glu.skip_samples(1);
+	}
+
+	/// Plays @c log, returning the audio generated and accumulating time spent generating it into @c seconds.
+	std::vector<int16_t> play(const std::vector<RegisterWrite> &log, size_t length, double &seconds) {
+		std::vector<int16_t> output(length);
+		size_t time = 0;
+
+		const auto generate = [&] (size_t end) {
+			if(end == time) return;
+			queue.flush();
+
+			const auto start = Time::nanos_now();
+			glu.get_samples(end - time, &output[time]);
+			seconds += Time::seconds(Time::nanos_now() - start);
+			time = end;
+		};
+
+		for(const auto &write: log) {
+			generate(write.time);
+			glu.set_address_low(write.address);
+			glu.set_data(write.value);
+		}
+		generate(length);
+
+		return output;
+	}
+
+	Concurrency::AsyncTaskQueue<false> queue;
+	Apple::IIgs::Sound::GLU glu;
+};
+
+}
+
+@interface IIgsSoundTests : XCTestCase
+@end
+
+@implementation IIgsSoundTests
+
+/// Plays a register log via the oscillator bank, both with and without AVX2, and via the scalar path,
+/// asserting identical output and returning the time spent in each.
+- (void)compareLog:(const std::vector<RegisterWrite> &)log length:(size_t)length avx2Seconds:(double &)avx2Seconds bankSeconds:(double &)bankSeconds scalarSeconds:(double &)scalarSeconds {
+	avx2Seconds = bankSeconds = scalarSeconds = 0.0;
+	const auto avx2 = std::make_unique<Ensoniq>(true, true)->play(log, length, avx2Seconds);
+	const auto bank = std::make_unique<Ensoniq>(true, false)->play(log, length, bankSeconds);
+	const auto scalar = std::make_unique<Ensoniq>(false, false)->play(log, length, scalarSeconds);
+
+	size_t avx2_mismatches = 0, bank_mismatches = 0, nonzero = 0;
+	for(size_t c = 0; c < length; c++) {
+		avx2_mismatches += avx2[c] != scalar[c];
+		bank_mismatches += bank[c] != scalar[c];
+		nonzero += scalar[c] != 0;
+	}
+	XCTAssertEqual(avx2_mismatches, 0);
+	XCTAssertEqual(bank_mismatches, 0);
+	XCTAssertGreaterThan(nonzero, length / 2);
+}
+
+- (void)testSyncAndAmplitudeModulation {
+	constexpr size_t length = 500'000;
+	double avx2Seconds, bankSeconds, scalarSeconds;
+	[self compareLog:register_log(length, true) length:length avx2Seconds:avx2Seconds bankSeconds:bankSeconds scalarSeconds:scalarSeconds];
+}
+
+- (void)testOscillatorBank {
+	constexpr size_t length = 2'000'000;
+	double avx2Seconds, bankSeconds, scalarSeconds;
+	[self compareLog:register_log(length, false) length:length avx2Seconds:avx2Seconds bankSeconds:bankSeconds scalarSeconds:scalarSeconds];
+	if(Numeric::has_avx2()) {
+		NSLog(@"Ensoniq: oscillator bank %0.3fs with AVX2, %0.3fs without; scalar %0.3fs", avx2Seconds, bankSeconds, scalarSeconds);
+	} else {
+		NSLog(@"Ensoniq: AVX2 unavailable; oscillator bank %0.3fs; scalar %0.3fs", bankSeconds, scalarSeconds);
+	}
+}
+
+@end
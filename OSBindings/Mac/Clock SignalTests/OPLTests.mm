@@ -9,8 +9,11 @@
 #import <XCTest/XCTest.h>
 
 #include "Tables.hpp"
+#include "MelodicBank.hpp"
+#include "WaveformGenerator.hpp"
 
 #include <cmath>
+#include <random>
 
 @interface OPLTests: XCTestCase
 @end
@@ -31,6 +34,98 @@
 	}
 }
 
+// MARK: - Melodic bank tests
+
+/// Runs a MelodicBank, via @c update, alongside a channel-at-a-time evaluation using WaveformGenerator
+/// and LogSign, and confirms that they produce identical output and feedback.
+- (void)compareMelodicBankForChannels:(int)channels update:(void (*)(Yamaha::OPL::MelodicBank<9, 9> &, int, const int *, int *))update {
+	constexpr int precision = 9;
+	using Waveform = Yamaha::OPL::Waveform;
+	using WaveformGenerator = Yamaha::OPL::WaveformGenerator<precision>;
+
+	std::mt19937 random(channels);
+	Yamaha::OPL::MelodicBank<precision, 9> bank;
+	Waveform carrier_waveforms[9], modulator_waveforms[9];
+	int feedback[9];
+	Yamaha::OPL::LogSign modulator_outputs[9];
+	int carrier_phases[9], modulator_phases[9], expected_modulator_phases[9];
+
+	for(int c = 0; c < 9; ++c) {
+		carrier_waveforms[c] = Waveform(random() & 3);
+		modulator_waveforms[c] = Waveform(random() & 3);
+		feedback[c] = random() & 7;
+		bank.set_waveforms(c, carrier_waveforms[c], modulator_waveforms[c]);
+		bank.set_feedback(c, feedback[c]);
+
+		modulator_outputs[c] = Yamaha::OPL::LogSign{1 << 13, 1};
+		carrier_phases[c] = modulator_phases[c] = expected_modulator_phases[c] = 0;
+	}
+
+	for(int step = 0; step < 10000; ++step) {
+		for(int c = 0; c < 9; ++c) {
+			bank.carrier_attenuation[c] = random() % 6000;
+			bank.modulator_attenuation[c] = random() % 6000;
+
+			const int carrier_step = random() % 20000;
+			const int modulator_step = random() % 20000;
+			carrier_phases[c] += carrier_step;
+			modulator_phases[c] += modulator_step;
+			expected_modulator_phases[c] += modulator_step;
+		}
+		update(bank, channels, carrier_phases, modulator_phases);
+
+		for(int c = 0; c < channels; ++c) {
+			auto carrier = WaveformGenerator::wave(carrier_waveforms[c], carrier_phases[c] >> 1, modulator_outputs[c]);
+			carrier += bank.carrier_attenuation[c];
+
+			auto modulation = WaveformGenerator::wave(modulator_waveforms[c], expected_modulator_phases[c] >> (precision + 1));
+			modulation += bank.modulator_attenuation[c];
+
+			constexpr int masks[] = {0, ~0, ~0, ~0, ~0, ~0, ~0, ~0};
+			expected_modulator_phases[c] +=
+				((modulation.level(precision) + modulator_outputs[c].level(precision)) >> (8 - feedback[c])) & masks[feedback[c]];
+			modulator_outputs[c] = modulation;
+
+			XCTAssertEqual(bank.output[c], carrier.level(), @"Channel %d differs at step %d", c, step);
+			XCTAssertEqual(modulator_phases[c], expected_modulator_phases[c], @"Channel %d feedback differs at step %d", c, step);
+		}
+		for(int c = channels; c < 9; ++c) {
+			XCTAssertEqual(modulator_phases[c], expected_modulator_phases[c], @"Channel %d was modified at step %d", c, step);
+		}
+	}
+}
+
+- (void)testMelodicBank {
+	const auto update = [] (Yamaha::OPL::MelodicBank<9, 9> &bank, int channels, const int *carrier_phases, int *modulator_phases) {
+		bank.update(channels, carrier_phases, modulator_phases);
+	};
+	[self compareMelodicBankForChannels:9 update:update];
+	[self compareMelodicBankForChannels:6 update:update];
+}
+
+- (void)testMelodicBankAVX2 {
+#ifdef AVX2_TARGET
+	if(!Numeric::has_avx2()) {
+		NSLog(@"AVX2 is unavailable; its MelodicBank path is untested");
+		return;
+	}
+
+	const auto update = [] (Yamaha::OPL::MelodicBank<9, 9> &bank, int channels, const int *carrier_phases, int *modulator_phases) {
+		bank.update_avx2(channels, carrier_phases, modulator_phases);
+	};
+	[self compareMelodicBankForChannels:9 update:update];
+	[self compareMelodicBankForChannels:6 update:update];
+#endif
+}
+
+- (void)testMelodicBankScalar {
+	const auto update = [] (Yamaha::OPL::MelodicBank<9, 9> &bank, int channels, const int *carrier_phases, int *modulator_phases) {
+		bank.update_scalar(channels, carrier_phases, modulator_phases);
+	};
+	[self compareMelodicBankForChannels:9 update:update];
+	[self compareMelodicBankForChannels:6 update:update];
+}
+
 // MARK: - Two-operator FM tests
 
 /*- (void)compareFMTo:(NSArray *)knownGood atAttenuation:(int)attenuation {
@@ -93,4 +93,41 @@
 	XCTAssertTrue(next_event.type == Storage::Disk::Track::Event::IndexHole, @"End should have been reached");
 }
 
+- (void)testGapsSpanningWords {
+	Storage::Disk::PCMSegment segment;
+	segment.length_of_a_bit = Storage::Time(1, 1000);
+	segment.data.resize(1000);
+	segment.data[5] = segment.data[200] = segment.data[700] = true;
+	Storage::Disk::PCMSegmentEventSource segmentSource(segment);
+
+	const unsigned int expected_lengths[] = {11, 390, 1000, 599};
+	for(const auto expected_length: expected_lengths) {
+		Storage::Disk::Track::Event next_event = segmentSource.get_next_event();
+		XCTAssertTrue(next_event.length == Storage::Time(expected_length, 2000u), @"Event should have occurred %d half-bits later", expected_length);
+	}
+	XCTAssertTrue(segmentSource.get_next_event().type == Storage::Disk::Track::Event::IndexHole, @"End should have been reached");
+}
+
+- (void)testFuzzyBits {
+	Storage::Disk::PCMSegment segment;
+	segment.length_of_a_bit = Storage::Time(1, 1000);
+	segment.data.resize(1000);
+	segment.fuzzy_mask.resize(600);
+	std::fill(segment.fuzzy_mask.begin() + 100, segment.fuzzy_mask.end(), true);
+	Storage::Disk::PCMSegmentEventSource segmentSource(segment);
+
+	// Bits 100–599 should each produce a flux transition with a probability of 1/2; nothing else should.
+	Storage::Time time;
+	int transitions = 0;
+	while(true) {
+		Storage::Disk::Track::Event next_event = segmentSource.get_next_event();
+		time += next_event.length;
+		if(next_event.type == Storage::Disk::Track::Event::IndexHole) break;
+
+		++transitions;
+		XCTAssertTrue(time > Storage::Time(100, 1000) && time < Storage::Time(600, 1000), @"Transitions should occur only within the fuzzy region");
+	}
+	XCTAssertTrue(transitions > 150 && transitions < 350, @"Roughly half of the fuzzy bits should have been transitions; got %d", transitions);
+}
+
 @end
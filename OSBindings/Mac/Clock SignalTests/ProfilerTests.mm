@@ -0,0 +1,77 @@
+//
+//  ProfilerTests.mm
+//  Clock SignalTests
+//
+//  Created by Thomas Harte on 16/10/2026.
+//  Copyright 2026 Thomas Harte. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+// Instrumentation is otherwise compiled out.
+#define PROFILE_COMPONENTS
+#include "../../../Activity/Profiler.hpp"
+
+#include <chrono>
+#include <thread>
+
+namespace {
+
+struct ProfiledType {};
+
+void inner() {
+	PROFILE_TYPE_SCOPE("ProfilerTests inner", ProfiledType, 10);
+	std::this_thread::sleep_for(std::chrono::milliseconds(20));
+}
+
+void outer() {
+	PROFILE_SCOPE("ProfilerTests outer", 5);
+	std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	inner();
+	inner();
+}
+
+const Activity::Profiler::Entry *find(const std::vector<Activity::Profiler::Entry> &entries, const char *prefix) {
+	for(const auto &entry: entries) {
+		if(entry.name.rfind(prefix, 0) == 0) return &entry;
+	}
+	return nullptr;
+}
+
+}
+
+@interface ProfilerTests : XCTestCase
+@end
+
+@implementation ProfilerTests
+
+/// Tests that calls and cycles are totalled, and that time is attributed only to the innermost scope.
+- (void)testExclusiveTotals {
+	Activity::Profiler::reset();
+	outer();
+
+	const auto report = Activity::Profiler::report();
+	const auto inner_entry = find(report, "ProfilerTests inner");
+	const auto outer_entry = find(report, "ProfilerTests outer");
+	XCTAssert(inner_entry != nullptr);
+	XCTAssert(outer_entry != nullptr);
+	if(!inner_entry || !outer_entry) return;
+
+	XCTAssertEqual(inner_entry->calls, 2);
+	XCTAssertEqual(inner_entry->cycles, 20);
+	XCTAssertEqual(outer_entry->calls, 1);
+	XCTAssertEqual(outer_entry->cycles, 5);
+
+	// Sleeps may overrun, but not underrun.
+	XCTAssertGreaterThanOrEqual(inner_entry->nanos, 40'000'000);
+	XCTAssertGreaterThanOrEqual(outer_entry->nanos, 10'000'000);
+	XCTAssertLessThan(outer_entry->nanos, inner_entry->nanos);
+
+	// Entries are ordered most expensive first.
+	XCTAssertLessThan(inner_entry, outer_entry);
+
+	Activity::Profiler::reset();
+	XCTAssert(find(Activity::Profiler::report(), "ProfilerTests") == nullptr);
+}
+
+@end
@@ -0,0 +1,178 @@
+//
+//  RecorderTests.mm
+//  Clock SignalTests
+//
+//  Created by Thomas Harte on 16/10/2026.
+//  Copyright 2026 Thomas Harte. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#include "../../../Outputs/Capture/Recorder.hpp"
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+#include <zlib.h>
+
+namespace {
+
+constexpr int Width = 64;
+constexpr int Height = 48;
+constexpr int FrameCount = 60;
+constexpr int PacketCount = 100;
+constexpr int PacketSize = 1024;
+
+/// Counts the audio packets forwarded to it.
+struct CountingDelegate: public Outputs::Speaker::Speaker::Delegate {
+	void speaker_did_complete_samples(Outputs::Speaker::Speaker *, const std::vector<int16_t> &buffer) final {
+		++packets;
+		samples += buffer.size();
+	}
+	int packets = 0;
+	size_t samples = 0;
+};
+
+std::vector<uint8_t> contents(const std::string &path) {
+	std::ifstream file(path, std::ios::binary);
+	return std::vector<uint8_t>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+uint32_t get32(const uint8_t *source) {
+	return uint32_t(source[0] | (source[1] << 8) | (source[2] << 16) | (source[3] << 24));
+}
+
+uint32_t get32_big_endian(const uint8_t *source) {
+	return uint32_t((source[0] << 24) | (source[1] << 16) | (source[2] << 8) | source[3]);
+}
+
+/// @returns Component @c component of pixel (@c x, @c y) in frame @c frame.
+uint8_t channel(int frame, int x, int y, int component) {
+	return uint8_t(frame * 3 + x * 5 + y * 7 + component * 64);
+}
+
+}
+
+@interface RecorderTests : XCTestCase
+@end
+
+@implementation RecorderTests {
+	std::string _base;
+}
+
+- (void)setUp {
+	_base = std::string([NSTemporaryDirectory() UTF8String]) + "/RecorderTests";
+}
+
+/// Records a known sequence of frames and audio packets in all formats, with only two buffers of
+/// each type so that the producers will regularly wait for the encoder. Audio is supplied from a
+/// separate thread, as it would be by a machine's audio queue.
+- (void)record {
+	CountingDelegate delegate;
+	{
+		Outputs::Capture::Recorder recorder(_base, Outputs::Capture::Recorder::Format::All, 50.0, 2, 2);
+		recorder.set_audio_format(48000, false);
+		recorder.set_delegate(&delegate);
+
+		std::thread audio_thread([&recorder] {
+			std::vector<int16_t> packet(PacketSize);
+			for(int c = 0; c < PacketCount; c++) {
+				for(int s = 0; s < PacketSize; s++) {
+					packet[s] = int16_t(c * PacketSize + s);
+				}
+				recorder.speaker_did_complete_samples(nullptr, packet);
+			}
+		});
+
+		for(int c = 0; c < FrameCount; c++) {
+			uint8_t *pixels = recorder.begin_frame(Width, Height);
+			for(int y = 0; y < Height; y++) {
+				for(int x = 0; x < Width; x++) {
+					for(int ch = 0; ch < 4; ch++) {
+						*pixels++ = channel(c, x, y, ch);
+					}
+				}
+			}
+			recorder.end_frame();
+		}
+		audio_thread.join();
+
+		XCTAssertEqual(recorder.frame_count(), FrameCount);
+		XCTAssert(recorder.stop());
+		XCTAssertFalse(recorder.has_failed());
+	}
+
+	XCTAssertEqual(delegate.packets, PacketCount);
+	XCTAssertEqual(delegate.samples, PacketCount * PacketSize);
+}
+
+- (void)testWAV {
+	[self record];
+	const auto wav = contents(_base + ".wav");
+
+	XCTAssertEqual(wav.size(), 44 + PacketCount * PacketSize * 2);
+	XCTAssert(!memcmp(wav.data(), "RIFF", 4));
+	XCTAssertEqual(get32(&wav[4]), wav.size() - 8);
+	XCTAssertEqual(get32(&wav[24]), 48000);
+	XCTAssertEqual(get32(&wav[40]), PacketCount * PacketSize * 2);
+
+	// Samples should be in order, with no packet lost or repeated.
+	for(int c = 0; c < PacketCount * PacketSize; c++) {
+		XCTAssertEqual(int16_t(wav[44 + c*2] | (wav[45 + c*2] << 8)), int16_t(c));
+	}
+}
+
+- (void)testRawAndY4M {
+	[self record];
+
+	const auto raw = contents(_base + ".rgba");
+	XCTAssertEqual(raw.size(), FrameCount * Width * Height * 4);
+	XCTAssertEqual(raw[(FrameCount - 1) * Width * Height * 4 + 1], channel(FrameCount - 1, 0, 0, 1));
+
+	const auto y4m = contents(_base + ".y4m");
+	const std::string header = "YUV4MPEG2 W64 H48 F50:1 Ip A1:1 C444\n";
+	XCTAssert(!memcmp(y4m.data(), header.data(), header.size()));
+	XCTAssertEqual(y4m.size(), header.size() + FrameCount * (6 + Width * Height * 3));
+}
+
+- (void)testPNG {
+	[self record];
+
+	// Decode the final frame's image data, which is expected to be a single IDAT chunk.
+	char suffix[16];
+	snprintf(suffix, sizeof(suffix), "-%06d.png", FrameCount - 1);
+	const auto png = contents(_base + suffix);
+	XCTAssertEqual(png[0], 0x89);
+	XCTAssert(!memcmp(&png[12], "IHDR", 4));
+	XCTAssertEqual(get32_big_endian(&png[16]), Width);
+	XCTAssertEqual(get32_big_endian(&png[20]), Height);
+
+	const size_t idat = 8 + 12 + 13;
+	XCTAssert(!memcmp(&png[idat + 4], "IDAT", 4));
+	const uint32_t length = get32_big_endian(&png[idat]);
+	XCTAssertEqual(get32_big_endian(&png[idat + 8 + length]), crc32(0, &png[idat + 4], length + 4));
+
+	const size_t iend = idat + 12 + length;
+	XCTAssert(!memcmp(&png[iend + 4], "IEND", 4));
+	XCTAssertEqual(get32_big_endian(&png[iend + 8]), crc32(0, &png[iend + 4], 4));
+
+	std::vector<uint8_t> image(Height * (1 + Width * 3));
+	uLongf image_size = uLongf(image.size());
+	XCTAssertEqual(uncompress(image.data(), &image_size, &png[idat + 8], length), Z_OK);
+	XCTAssertEqual(image_size, image.size());
+
+	for(int y = 0; y < Height; y++) {
+		const uint8_t *row = &image[y * (1 + Width * 3)];
+		XCTAssertEqual(row[0], 0);
+		for(int x = 0; x < Width; x++) {
+			for(int ch = 0; ch < 3; ch++) {
+				XCTAssertEqual(row[1 + x*3 + ch], channel(FrameCount - 1, x, y, ch));
+			}
+		}
+	}
+}
+
+@end
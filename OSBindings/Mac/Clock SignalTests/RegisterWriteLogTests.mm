@@ -0,0 +1,186 @@
+//
+//  RegisterWriteLogTests.mm
+//  Clock SignalTests
+//
+//  Created by Thomas Harte on 16/10/2026.
+//  Copyright 2026 Thomas Harte. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#include "../../../Concurrency/AsyncTaskQueue.hpp"
+#include "../../../Concurrency/RegisterWriteLog.hpp"
+#include "../../../ClockReceiver/TimeTypes.hpp"
+#include "../../../Outputs/Speaker/Implementation/ReplayingSource.hpp"
+
+#include <vector>
+
+namespace {
+
+/// Outputs the most recent value written to it, which is applied either
+/// immediately or via a register write log.
+struct LatchSource: public Outputs::Speaker::SampleSource {
+	void get_samples(std::size_t number_of_samples, std::int16_t *target) {
+		while(number_of_samples--) {
+			*target++ = level;
+		}
+	}
+
+	void set_register(uint16_t address, uint8_t value) {
+		level = int16_t(value + (address << 8));
+	}
+
+	void apply_register_write(const Concurrency::RegisterWrite &write) {
+		set_register(write.address, write.value);
+	}
+
+	int16_t level = 0;
+};
+
+using Log = Concurrency::RegisterWriteLog<>;
+using Replayer = Outputs::Speaker::ReplayingSource<LatchSource, Log>;
+
+constexpr int WriteCount = 1'000'000;
+constexpr int CyclesPerWrite = 16;
+constexpr int WritesPerFlush = 1'000;
+
+/// Posts WriteCount writes, each preceded by an advance of CyclesPerWrite, as per the
+/// usual pattern of closure-per-write posting; returns writes per second.
+double closure_throughput(LatchSource &source) {
+	Concurrency::AsyncTaskQueue<false> queue;
+	std::vector<int16_t> samples(CyclesPerWrite);
+
+	const auto start = Time::nanos_now();
+	for(int c = 0; c < WriteCount; ++c) {
+		queue.enqueue([&source, &samples] {
+			source.get_samples(samples.size(), samples.data());
+		});
+		queue.enqueue([&source, c] {
+			source.set_register(0, uint8_t(c));
+		});
+		if(!(c % WritesPerFlush)) queue.perform();
+	}
+	queue.flush();
+	const auto end = Time::nanos_now();
+	return double(WriteCount) / Time::seconds(end - start);
+}
+
+/// Posts the same writes as closure_throughput via a RegisterWriteLog, with only a
+/// single closure per flush; returns writes per second.
+double log_throughput(LatchSource &source) {
+	Concurrency::AsyncTaskQueue<false> queue;
+	Log log;
+	Replayer replayer(source, log);
+	std::vector<int16_t> samples(CyclesPerWrite * WritesPerFlush);
+
+	const auto start = Time::nanos_now();
+	uint64_t posted = 0;
+	for(int c = 0; c < WriteCount; ++c) {
+		log.advance(CyclesPerWrite);
+		log.push(0, 0, uint8_t(c));
+		if(!(c % WritesPerFlush)) {
+			const auto length = size_t(log.time() - posted);
+			posted = log.time();
+			queue.enqueue([&replayer, &samples, length] {
+				replayer.get_samples(length, samples.data());
+			});
+			queue.perform();
+		}
+	}
+	queue.enqueue([&replayer, &log] {
+		replayer.catch_up(log.time());
+	});
+	queue.flush();
+	const auto end = Time::nanos_now();
+	return double(WriteCount) / Time::seconds(end - start);
+}
+
+}
+
+@interface RegisterWriteLogTests : XCTestCase
+@end
+
+@implementation RegisterWriteLogTests
+
+// MARK: - Correctness
+
+/// Tests that writes are applied at exactly their timestamps, regardless of how
+/// samples are requested.
+- (void)testReplayTiming {
+	LatchSource source;
+	Log log;
+	Replayer replayer(source, log);
+
+	log.advance(3);
+	log.push(0, 0, 1);
+	log.advance(7);
+	log.push(0, 0, 2);
+	log.push(0, 1, 3);
+	log.advance(1);
+	log.push(0, 0, 4);
+
+	std::vector<int16_t> samples(20);
+	replayer.get_samples(2, &samples[0]);
+	replayer.get_samples(9, &samples[2]);
+	replayer.skip_samples(1);
+	replayer.get_samples(8, &samples[12]);
+
+	const std::vector<int16_t> expected = {
+		0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 259, 0, 4, 4, 4, 4, 4, 4, 4, 4
+	};
+	XCTAssert(samples == expected);
+	XCTAssertEqual(log.size(), 0);
+}
+
+/// Tests that catch_up applies writes even if no samples are requested.
+- (void)testCatchUp {
+	LatchSource source;
+	Log log;
+	Replayer replayer(source, log);
+
+	log.advance(100);
+	log.push(0, 0, 7);
+	log.advance(100);
+	log.push(0, 0, 9);
+
+	replayer.catch_up(150);
+	XCTAssertEqual(source.level, 7);
+	XCTAssertEqual(log.size(), 1);
+
+	replayer.catch_up(200);
+	XCTAssertEqual(source.level, 9);
+	XCTAssertEqual(log.size(), 0);
+}
+
+/// Tests that a producer outpacing the ring waits for the consumer rather than losing writes.
+- (void)testFullRing {
+	LatchSource source;
+	Concurrency::RegisterWriteLog<16> log;
+	Outputs::Speaker::ReplayingSource<LatchSource, Concurrency::RegisterWriteLog<16>> replayer(source, log);
+	Concurrency::AsyncTaskQueue<true> queue;
+
+	for(int c = 0; c < 1000; ++c) {
+		log.advance(1);
+		log.push(0, 0, uint8_t(c));
+		if((c & 7) == 7) {
+			queue.enqueue([&replayer, time = log.time()] {
+				replayer.catch_up(time);
+			});
+		}
+	}
+	queue.flush();
+	replayer.catch_up(log.time());
+	XCTAssertEqual(source.level, int16_t(999 & 0xff));
+}
+
+// MARK: - Comparative benchmark
+
+- (void)testThroughput {
+	LatchSource closure_source, log_source;
+	const double closure_rate = closure_throughput(closure_source);
+	const double log_rate = log_throughput(log_source);
+	XCTAssertEqual(closure_source.level, log_source.level);
+	NSLog(@"Register writes: closure per write %0.0f writes/s; RegisterWriteLog %0.0f writes/s", closure_rate, log_rate);
+}
+
+@end
@@ -0,0 +1,161 @@
+//
+//  RewindBufferTests.mm
+//  Clock SignalTests
+//
+//  Created by Thomas Harte on 16/10/2026.
+//  Copyright 2026 Thomas Harte. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#include "../../../Machines/Utility/RewindBuffer.hpp"
+
+#include <memory>
+#include <vector>
+
+namespace {
+
+struct TestState: public Reflection::StructImpl<TestState> {
+	int counter = 0;
+	uint8_t registers[4]{};
+	std::vector<uint8_t> ram;
+
+	TestState() {
+		if(needs_declare()) {
+			DeclareField(counter);
+			DeclareField(registers);
+			DeclareField(ram);
+		}
+	}
+};
+
+/// A 'machine' that is nothing but a state; each step touches a little of its RAM.
+class TestMachine: public Machine::DynamicMachine, public MachineTypes::StateProducer {
+	public:
+		TestState state;
+
+		TestMachine() {
+			state.ram.resize(48*1024);
+		}
+
+		void step() {
+			++state.counter;
+			state.registers[state.counter & 3] = uint8_t(state.counter);
+			for(int c = 0; c < 16; c++) {
+				state.ram[size_t(state.counter * 37 + c * 1021) % state.ram.size()] ^= uint8_t(state.counter + c);
+			}
+		}
+
+		// StateProducer.
+		std::unique_ptr<Reflection::Struct> get_state() final {
+			return std::make_unique<TestState>(state);
+		}
+		void get_state(Reflection::Struct &target) final {
+			static_cast<TestState &>(target) = state;
+		}
+		void set_state(const Reflection::Struct &source) final {
+			state = static_cast<const TestState &>(source);
+		}
+
+		// DynamicMachine.
+		Activity::Source *activity_source() final { return nullptr; }
+		Configurable::Device *configurable_device() final { return nullptr; }
+		MachineTypes::TimedMachine *timed_machine() final { return nullptr; }
+		MachineTypes::ScanProducer *scan_producer() final { return nullptr; }
+		MachineTypes::AudioProducer *audio_producer() final { return nullptr; }
+		MachineTypes::JoystickMachine *joystick_machine() final { return nullptr; }
+		MachineTypes::KeyboardMachine *keyboard_machine() final { return nullptr; }
+		MachineTypes::MouseMachine *mouse_machine() final { return nullptr; }
+		MachineTypes::MediaTarget *media_target() final { return nullptr; }
+		MachineTypes::StateProducer *state_producer() final { return state_producer_enabled ? this : nullptr; }
+		void *raw_pointer() final { return this; }
+
+		bool state_producer_enabled = true;
+};
+
+}
+
+@interface RewindBufferTests : XCTestCase
+@end
+
+@implementation RewindBufferTests
+
+- (void)testRewind {
+	TestMachine machine;
+	Machine::RewindBuffer buffer(machine, 500, 64*1024*1024, 60);
+	XCTAssert(buffer.is_supported());
+
+	// Keep a full copy of every state for comparison.
+	std::vector<TestState> history;
+	for(int c = 0; c < 300; c++) {
+		machine.step();
+		buffer.capture();
+		history.push_back(machine.state);
+	}
+	XCTAssertEqual(buffer.size(), 300);
+
+	// Deltas should be much smaller than full states.
+	XCTAssertLessThan(buffer.memory_usage(), 300 * machine.state.ram.size() / 10);
+
+	// Rewind by amounts that variously walk backwards from the most recent state
+	// and forwards from a keyframe.
+	size_t current = history.size() - 1;
+	for(size_t step: {0, 1, 5, 59, 61, 100}) {
+		XCTAssert(buffer.rewind(step));
+		current -= step;
+		XCTAssertEqual(machine.state.counter, history[current].counter);
+		XCTAssert(machine.state.ram == history[current].ram);
+		XCTAssertEqual(buffer.size(), current + 1);
+	}
+
+	// Continue from the rewound state and then rewind into the new timeline.
+	for(int c = 0; c < 10; c++) {
+		machine.step();
+		buffer.capture();
+	}
+	const auto expected = machine.state.counter - 4;
+	XCTAssert(buffer.rewind(4));
+	XCTAssertEqual(machine.state.counter, expected);
+
+	XCTAssertFalse(buffer.rewind(buffer.size()));
+}
+
+- (void)testLimits {
+	TestMachine machine;
+	Machine::RewindBuffer buffer(machine, 100, 64*1024*1024, 60);
+
+	std::vector<TestState> history;
+	for(int c = 0; c < 250; c++) {
+		machine.step();
+		buffer.capture();
+		history.push_back(machine.state);
+	}
+
+	// Only the most recent 100 captures should remain, and the oldest should
+	// still be intact despite its keyframe having been discarded.
+	XCTAssertEqual(buffer.size(), 100);
+	XCTAssert(buffer.rewind(99));
+	XCTAssert(machine.state.ram == history[150].ram);
+
+	// A tight memory limit should be honoured with whatever fits.
+	Machine::RewindBuffer small_buffer(machine, 1000, 128*1024, 60);
+	for(int c = 0; c < 250; c++) {
+		machine.step();
+		small_buffer.capture();
+	}
+	XCTAssertLessThanOrEqual(small_buffer.memory_usage(), 128*1024);
+	XCTAssertGreaterThan(small_buffer.size(), 1);
+}
+
+- (void)testUnsupported {
+	TestMachine machine;
+	machine.state_producer_enabled = false;
+
+	Machine::RewindBuffer buffer(machine);
+	XCTAssertFalse(buffer.is_supported());
+	buffer.capture();
+	XCTAssertEqual(buffer.size(), 0);
+	XCTAssertFalse(buffer.rewind(0));
+}
+
+@end
@@ -0,0 +1,214 @@
+//
+//  StateTests.mm
+//  Clock SignalTests
+//
+//  Created by Thomas Harte on 16/10/2026.
+//  Copyright 2026 Thomas Harte. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#include "../../../Machines/AmstradCPC/State.hpp"
+#include "../../../Machines/Apple/Macintosh/State.hpp"
+#include "../../../Machines/Commodore/Vic-20/State.hpp"
+#include "../../../Machines/Sinclair/ZXSpectrum/State.hpp"
+
+#include <array>
+
+namespace {
+
+/// Provides 64kb of RAM with an odd initial program counter, so that the 68000's
+/// first prefetch raises an address error during reset, halting it.
+struct DoubleFaultingRAM: public CPU::MC68000Mk2::BusHandler {
+	std::array<uint8_t, 65536> ram{};
+	CPU::MC68000Mk2::Processor<DoubleFaultingRAM, true, true> processor;
+	int accesses = 0;
+
+	DoubleFaultingRAM() : processor(*this) {
+		// RAM is stored as host-endian words.
+		*reinterpret_cast<uint16_t *>(&ram[2]) = 0x8000;	// Initial stack pointer: 0x8000.
+		*reinterpret_cast<uint16_t *>(&ram[6]) = 0x0001;	// Initial program counter: 0x0001.
+	}
+
+	HalfCycles perform_bus_operation(const CPU::MC68000Mk2::Microcycle &cycle, int) {
+		if(cycle.operation & (CPU::MC68000Mk2::Microcycle::SelectWord | CPU::MC68000Mk2::Microcycle::SelectByte)) {
+			++accesses;
+			cycle.apply(&ram[cycle.host_endian_byte_address() & 0xffff]);
+		}
+		return HalfCycles(0);
+	}
+};
+
+}
+
+@interface StateTests : XCTestCase
+@end
+
+@implementation StateTests
+
+- (void)testSpectrumStateRoundTrip {
+	Sinclair::ZXSpectrum::State source;
+
+	// Pick values that exercise enums, negative and multi-byte integers,
+	// nested structs, arrays and binary data.
+	source.z80.registers.program_counter = 0x8123;
+	source.z80.registers.interrupt_mode = 2;
+	source.z80.execution_state.phase = CPU::Z80::State::ExecutionState::Phase::Operation;
+	source.z80.execution_state.half_cycles_into_step = -3;
+	source.video.half_cycles_since_interrupt = 33156;
+	source.video.is_alternate_line = true;
+	source.ay.registers[13] = 0x0e;
+	source.ram.resize(128*1024);
+	for(size_t c = 0; c < source.ram.size(); c++) {
+		source.ram[c] = uint8_t(c * 7);
+	}
+	source.last_7ffd = 0x17;
+
+	const auto bson = source.serialise();
+
+	Sinclair::ZXSpectrum::State destination;
+	XCTAssert(destination.deserialise(bson));
+
+	XCTAssertEqual(destination.z80.registers.program_counter, 0x8123);
+	XCTAssertEqual(destination.z80.registers.interrupt_mode, 2);
+	XCTAssert(destination.z80.execution_state.phase == CPU::Z80::State::ExecutionState::Phase::Operation);
+	XCTAssertEqual(destination.z80.execution_state.half_cycles_into_step, -3);
+	XCTAssertEqual(destination.video.half_cycles_since_interrupt, 33156);
+	XCTAssert(destination.video.is_alternate_line);
+	XCTAssertEqual(destination.ay.registers[13], 0x0e);
+	XCTAssert(destination.ram == source.ram);
+	XCTAssertEqual(destination.last_7ffd, 0x17);
+
+	// Reserialising should give exactly the same BSON.
+	XCTAssert(destination.serialise() == bson);
+}
+
+- (void)testCPCStateRoundTrip {
+	AmstradCPC::State source;
+
+	source.z80.registers.program_counter = 0x4000;
+	source.crtc.registers[9] = 7;
+	source.crtc.line_address = 0x3fff;
+	source.i8255.outputs[2] = 0xf4;
+	source.gate_array.palette[3] = 0x2a;
+	source.gate_array.mode = 1;
+	source.gate_array.was_vsync = true;
+	source.gate_array.ram_configuration = 6;
+	source.clock_offset = 3;
+	source.ram.resize(128*1024);
+	for(size_t c = 0; c < source.ram.size(); c++) {
+		source.ram[c] = uint8_t(c * 5);
+	}
+
+	const auto bson = source.serialise();
+
+	AmstradCPC::State destination;
+	XCTAssert(destination.deserialise(bson));
+
+	XCTAssertEqual(destination.z80.registers.program_counter, 0x4000);
+	XCTAssertEqual(destination.crtc.registers[9], 7);
+	XCTAssertEqual(destination.crtc.line_address, 0x3fff);
+	XCTAssertEqual(destination.i8255.outputs[2], 0xf4);
+	XCTAssertEqual(destination.gate_array.palette[3], 0x2a);
+	XCTAssertEqual(destination.gate_array.mode, 1);
+	XCTAssert(destination.gate_array.was_vsync);
+	XCTAssertEqual(destination.gate_array.ram_configuration, 6);
+	XCTAssertEqual(destination.clock_offset, 3);
+	XCTAssert(destination.ram == source.ram);
+
+	XCTAssert(destination.serialise() == bson);
+}
+
+- (void)testVic20StateRoundTrip {
+	Commodore::Vic20::State source;
+
+	source.m6502.registers.program_counter = 0xfd22;
+	source.m6502.execution_state.interrupt_requests = 4;
+	source.mos6560.registers[15] = 0x1b;
+	source.user_port_via.timer[0] = 0xfffe;
+	source.keyboard_via.next_timer[1] = -1;
+	source.keyboard_via.control_inputs[2] = true;
+	source.ram.resize(64*1024);
+	for(size_t c = 0; c < source.ram.size(); c++) {
+		source.ram[c] = uint8_t(c * 3);
+	}
+	source.colour_ram.resize(1024, 0x06);
+
+	const auto bson = source.serialise();
+
+	Commodore::Vic20::State destination;
+	XCTAssert(destination.deserialise(bson));
+
+	XCTAssertEqual(destination.m6502.registers.program_counter, 0xfd22);
+	XCTAssertEqual(destination.m6502.execution_state.interrupt_requests, 4);
+	XCTAssertEqual(destination.mos6560.registers[15], 0x1b);
+	XCTAssertEqual(destination.user_port_via.timer[0], 0xfffe);
+	XCTAssertEqual(destination.keyboard_via.next_timer[1], -1);
+	XCTAssert(destination.keyboard_via.control_inputs[2]);
+	XCTAssertFalse(destination.keyboard_via.control_inputs[1]);
+	XCTAssert(destination.ram == source.ram);
+	XCTAssert(destination.colour_ram == source.colour_ram);
+
+	XCTAssert(destination.serialise() == bson);
+}
+
+- (void)testMacintoshStateRoundTrip {
+	Apple::Macintosh::State source;
+
+	source.mc68000.address[6] = 0x12345678;
+	source.mc68000.time_remaining = -6;
+	source.mc68000.phase = CPU::MC68000Mk2::Snapshot::Phase::Stopped;
+	source.via.interrupt_enable = 0x82;
+	source.scc.channel_b.dcd = true;
+	source.clock.data.assign(256, 0xa8);
+	source.clock.address = 0x201;
+	source.video.frame_position = 12345;
+	source.keyboard.key_queue = {0x01, 0x83};
+	source.ram.resize(128*1024);
+	for(size_t c = 0; c < source.ram.size(); c++) {
+		source.ram[c] = uint8_t(c * 11);
+	}
+	source.rom_is_overlay = false;
+
+	const auto bson = source.serialise();
+
+	Apple::Macintosh::State destination;
+	XCTAssert(destination.deserialise(bson));
+
+	XCTAssertEqual(destination.mc68000.address[6], 0x12345678);
+	XCTAssertEqual(destination.mc68000.time_remaining, -6);
+	XCTAssert(destination.mc68000.phase == CPU::MC68000Mk2::Snapshot::Phase::Stopped);
+	XCTAssertEqual(destination.via.interrupt_enable, 0x82);
+	XCTAssert(destination.scc.channel_b.dcd);
+	XCTAssertFalse(destination.scc.channel_a.dcd);
+	XCTAssert(destination.clock.data == source.clock.data);
+	XCTAssertEqual(destination.clock.address, 0x201);
+	XCTAssertEqual(destination.video.frame_position, 12345);
+	XCTAssert(destination.keyboard.key_queue == source.keyboard.key_queue);
+	XCTAssert(destination.ram == source.ram);
+	XCTAssertFalse(destination.rom_is_overlay);
+
+	XCTAssert(destination.serialise() == bson);
+}
+
+- (void)testMC68000HaltedSnapshot {
+	DoubleFaultingRAM source;
+	source.processor.run_for(HalfCycles(400));
+
+	// The address error should have halted the processor rather than being processed.
+	const int accesses = source.accesses;
+	source.processor.run_for(HalfCycles(400));
+	XCTAssertEqual(source.accesses, accesses);
+
+	const CPU::MC68000Mk2::Snapshot snapshot(source.processor);
+	XCTAssert(snapshot.phase == CPU::MC68000Mk2::Snapshot::Phase::Halted);
+
+	// A processor restored from the snapshot should also remain halted.
+	DoubleFaultingRAM destination;
+	snapshot.apply(destination.processor);
+	destination.processor.run_for(HalfCycles(400));
+	XCTAssertEqual(destination.accesses, 0);
+	XCTAssert(CPU::MC68000Mk2::Snapshot(destination.processor).phase == CPU::MC68000Mk2::Snapshot::Phase::Halted);
+}
+
+@end
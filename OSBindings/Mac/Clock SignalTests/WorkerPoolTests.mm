@@ -0,0 +1,95 @@
+//
+//  WorkerPoolTests.mm
+//  Clock SignalTests
+//
+//  Created by Thomas Harte on 16/10/2026.
+//  Copyright 2026 Thomas Harte. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#include "../../../Concurrency/WorkerPool.hpp"
+#include "../../../ClockReceiver/TimeTypes.hpp"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+@interface WorkerPoolTests : XCTestCase
+@end
+
+@implementation WorkerPoolTests
+
+/// Tests that every task is performed exactly once, for a range of pool and batch sizes.
+- (void)testAllTasksPerformedOnce {
+	for(size_t workers = 0; workers < 5; ++workers) {
+		Concurrency::WorkerPool pool(workers);
+		XCTAssertEqual(pool.participants(), workers + 1);
+
+		for(size_t count = 0; count < 20; ++count) {
+			for(int repeat = 0; repeat < 50; ++repeat) {
+				std::vector<std::atomic<int>> performed(count);
+				pool.parallel_for(count, [&performed] (size_t index) {
+					++performed[index];
+				});
+
+				for(size_t index = 0; index < count; ++index) {
+					XCTAssertEqual(performed[index], 1);
+				}
+			}
+		}
+	}
+}
+
+/// Tests that the calling thread always performs task 0.
+- (void)testCallerPerformsFirstTask {
+	Concurrency::WorkerPool pool(3);
+	const auto caller = std::this_thread::get_id();
+
+	for(int repeat = 0; repeat < 100; ++repeat) {
+		std::thread::id first;
+		pool.parallel_for(4, [&first] (size_t index) {
+			if(!index) first = std::this_thread::get_id();
+		});
+		XCTAssert(first == caller);
+	}
+}
+
+/// Tests that idle participants steal work: if one task is slow then the others should
+/// all be completed elsewhere while it runs.
+- (void)testStealing {
+	Concurrency::WorkerPool pool(2);
+
+	std::atomic<int> completed_while_blocked = 0;
+	std::atomic<bool> release = false;
+	pool.parallel_for(30, [&] (size_t index) {
+		if(!index) {
+			// Wait until every other task has been performed, or for at most a second.
+			const auto start = Time::nanos_now();
+			while(completed_while_blocked != 29 && Time::nanos_now() - start < 1'000'000'000) {
+				std::this_thread::yield();
+			}
+			release = true;
+			return;
+		}
+		if(!release) ++completed_while_blocked;
+	});
+	XCTAssertEqual(completed_while_blocked, 29);
+}
+
+/// Measures the cost of synchronisation alone.
+- (void)testBarrierPerformance {
+	Concurrency::WorkerPool pool(3);
+	Concurrency::WorkerPool *const pool_pointer = &pool;	// Blocks would otherwise attempt to copy the pool.
+
+	[self measureBlock:^{
+		std::vector<int> values(4);
+		for(int repeat = 0; repeat < 10'000; ++repeat) {
+			pool_pointer->parallel_for(values.size(), [&values] (size_t index) {
+				++values[index];
+			});
+		}
+	}];
+}
+
+@end
@@ -104,10 +104,12 @@ SOURCES += \
 	$$SRC/Machines/Sinclair/ZXSpectrum/*.cpp \
 \
 	$$SRC/Outputs/*.cpp \
+	$$SRC/Outputs/Capture/*.cpp \
 	$$SRC/Outputs/CRT/*.cpp \
 	$$SRC/Outputs/ScanTargets/*.cpp \
 	$$SRC/Outputs/OpenGL/*.cpp \
 	$$SRC/Outputs/OpenGL/Primitives/*.cpp \
+	$$SRC/Outputs/Software/*.cpp \
 \
 	$$SRC/Processors/6502/Implementation/*.cpp \
 	$$SRC/Processors/6502/State/*.cpp \
@@ -240,11 +242,13 @@ HEADERS += \
 	$$SRC/Numeric/*.hpp \
 \
 	$$SRC/Outputs/*.hpp \
+	$$SRC/Outputs/Capture/*.hpp \
 	$$SRC/Outputs/CRT/*.hpp \
 	$$SRC/Outputs/CRT/Internals/*.hpp \
 	$$SRC/Outputs/ScanTargets/*.hpp \
 	$$SRC/Outputs/OpenGL/*.hpp \
 	$$SRC/Outputs/OpenGL/Primitives/*.hpp \
+	$$SRC/Outputs/Software/*.hpp \
 	$$SRC/Outputs/Speaker/*.hpp \
 	$$SRC/Outputs/Speaker/Implementation/*.hpp \
 \
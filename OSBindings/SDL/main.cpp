@@ -9,20 +9,24 @@
 #include <algorithm>
 #include <array>
 #include <atomic>
+#include <cmath>
 #include <cstddef>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
 #include <iomanip>
 #include <iostream>
+#include <limits>
 #include <map>
 #include <memory>
+#include <sstream>
 #include <sys/stat.h>
 
 #include <SDL2/SDL.h>
 
 #include "../../Analyser/Static/StaticAnalyser.hpp"
 #include "../../Machines/Utility/MachineForTarget.hpp"
+#include "../../Storage/MassStorage/CopyOnWriteDevice.hpp"
 
 #include "../../ClockReceiver/TimeTypes.hpp"
 #include "../../ClockReceiver/ScanSynchroniser.hpp"
@@ -30,9 +34,11 @@
 #include "../../Machines/MachineTypes.hpp"
 
 #include "../../Activity/Observer.hpp"
+#include "../../Outputs/Capture/Recorder.hpp"
 #include "../../Outputs/OpenGL/Primitives/Rectangle.hpp"
 #include "../../Outputs/OpenGL/ScanTarget.hpp"
 #include "../../Outputs/OpenGL/Screenshot.hpp"
+#include "../../Outputs/Software/ScanTarget.hpp"
 
 #include "../../Reflection/Enum.hpp"
 #include "../../Reflection/Struct.hpp"
@@ -213,6 +219,151 @@ struct SpeakerDelegate: public Outputs::Speaker::Speaker::Delegate {
 	std::vector<int16_t> audio_buffer_;
 };
 
+/// Prints the component profile of @c machine to standard output.
+void print_profile(const MachineTypes::TimedMachine &machine) {
+#ifdef PROFILE_COMPONENTS
+	const auto profile = machine.get_profile();
+	Time::Nanos total = 0;
+	for(const auto &entry: profile) {
+		total += entry.nanos;
+	}
+
+	std::cout << "Component profile:" << std::endl;
+	std::cout << std::fixed << std::setprecision(3);
+	for(const auto &entry: profile) {
+		std::cout << '\t' << std::setw(7) << 100.0 * double(entry.nanos) / double(std::max(total, Time::Nanos(1))) << "%  ";
+		std::cout << std::setw(10) << Time::seconds(entry.nanos) << "s  ";
+		std::cout << entry.calls << " calls, " << entry.cycles << " cycles  " << entry.name << std::endl;
+	}
+#else
+	(void)machine;
+	std::cout << "Component profiling is unavailable; rebuild with PROFILE_COMPONENTS defined, e.g. via scons profile=1." << std::endl;
+#endif
+}
+
+/*!
+	Runs a machine without any video or audio output device, as quickly as possible,
+	for either a fixed amount of emulated time or a fixed number of frames; reports
+	throughput upon completion. Audio and video can optionally be captured to files.
+*/
+struct HeadlessRunner {
+	/// Describes the files to which output should be captured.
+	struct Capture {
+		std::string base_path;
+		int formats = Outputs::Capture::Recorder::Format::WAV | Outputs::Capture::Recorder::Format::Y4M;
+		double frame_rate = 50.0;
+	};
+
+	// Frames are captured at a fixed size, covering the whole visible area.
+	static constexpr int CaptureWidth = 640;
+	static constexpr int CaptureHeight = 480;
+
+	/// Counts frames, as delimited by the start of vertical retrace, while discarding all video.
+	struct FrameCounter: public Outputs::Display::NullScanTarget {
+		void announce(Event event, bool, const Scan::EndPoint &, uint8_t) final {
+			if(event == Event::BeginVerticalRetrace) ++frames;
+		}
+		int frames = 0;
+	};
+
+	/// Receives and discards all audio; audio is still generated so that its cost is measured.
+	struct NullSpeakerDelegate: public Outputs::Speaker::Speaker::Delegate {
+		void speaker_did_complete_samples(Outputs::Speaker::Speaker *, const std::vector<int16_t> &) final {}
+	};
+
+	/// Runs @c machine for up to @c seconds of emulated time or until @c frames frames have been
+	/// produced, whichever comes first. A zero limit is ignored. If @c capture is non-null then
+	/// audio and video are recorded as it describes.
+	///
+	/// @throws Outputs::Capture::Recorder::Error::CantOpen if capture files cannot be opened.
+	static void run(Machine::DynamicMachine &machine, Time::Seconds seconds, int frames, const Capture *capture = nullptr) {
+		FrameCounter frame_counter;
+		NullSpeakerDelegate speaker_delegate;
+
+		// If capturing, render video in software and pass everything to a recorder; otherwise
+		// just count frames.
+		std::unique_ptr<Outputs::Display::Software::ScanTarget> software_scan_target;
+		std::unique_ptr<Outputs::Capture::Recorder> recorder;
+		if(capture) {
+			recorder = std::make_unique<Outputs::Capture::Recorder>(capture->base_path, capture->formats, capture->frame_rate);
+			software_scan_target = std::make_unique<Outputs::Display::Software::ScanTarget>();
+			machine.scan_producer()->set_scan_target(software_scan_target.get());
+		} else {
+			machine.scan_producer()->set_scan_target(&frame_counter);
+		}
+		const auto frame_count = [&] {
+			return software_scan_target ? int(software_scan_target->frame_count()) : frame_counter.frames;
+		};
+
+		const auto audio_producer = machine.audio_producer();
+		if(audio_producer) {
+			auto speaker = audio_producer->get_speaker();
+			if(speaker) {
+				speaker->set_output_rate(48000, 1024, speaker->get_is_stereo());
+				if(recorder) {
+					recorder->set_audio_format(48000, speaker->get_is_stereo());
+					speaker->set_delegate(recorder.get());
+				} else {
+					speaker->set_delegate(&speaker_delegate);
+				}
+			}
+		}
+
+		// Run in slices of a hundredth of a second; that's short enough to stop close to any frame count
+		// while costing nothing noticeable in overhead. If capturing, use one slice per captured frame.
+		// The machine scales each slice by its speed multiplier, so emulated time does likewise.
+		const Time::Seconds slice = capture ? 1.0 / capture->frame_rate : 0.01;
+		const auto timed_machine = machine.timed_machine();
+		const Time::Seconds emulated_slice = slice * timed_machine->get_speed_multiplier();
+		Time::Seconds emulated = 0.0;
+
+		const auto start_time = Time::nanos_now();
+		while(
+			(seconds <= 0.0 || emulated < seconds) &&
+			(frames <= 0 || frame_count() < frames)
+		) {
+			timed_machine->run_for(slice);
+			timed_machine->flush_output(MachineTypes::TimedMachine::Output::All);
+			emulated += emulated_slice;
+
+			if(recorder) {
+				software_scan_target->update(CaptureWidth, CaptureHeight);
+				recorder->capture_frame(*software_scan_target);
+			}
+		}
+
+		// Wait for all audio so far generated to be delivered, so that none is lost and no callback
+		// remains in flight, then detach before local delegates are destroyed.
+		machine.scan_producer()->set_scan_target(nullptr);
+		if(audio_producer && audio_producer->get_speaker()) {
+			audio_producer->wait_for_audio();
+			audio_producer->get_speaker()->set_delegate(nullptr);
+		}
+
+		// Include the time taken to finish writing any capture.
+		size_t captured_frames = 0;
+		bool capture_failed = false;
+		if(recorder) {
+			captured_frames = recorder->frame_count();
+			capture_failed = !recorder->stop();
+			recorder.reset();
+		}
+		const auto wall = Time::seconds(Time::nanos_now() - start_time);
+
+		std::cout << std::fixed << std::setprecision(3);
+		std::cout << "Emulated " << emulated << "s (" << frame_count() << " frames) in " << wall << "s wall time" << std::endl;
+		std::cout << "Speed: " << emulated / wall << "x real time; ";
+		std::cout << double(frame_count()) / wall << " frames/s; ";
+		std::cout << timed_machine->get_clock_rate() * emulated / (wall * 1e6) << " emulated MHz" << std::endl;
+		if(capture) {
+			std::cout << "Captured " << captured_frames << " frames to " << capture->base_path << std::endl;
+			if(capture_failed) {
+				std::cerr << "Some capture output could not be written" << std::endl;
+			}
+		}
+	}
+};
+
 class ActivityObserver: public Activity::Observer {
 	public:
 		ActivityObserver(Activity::Source *source, float aspect_ratio) {
@@ -534,7 +685,7 @@ int main(int argc, char *argv[]) {
 	const ParsedArguments arguments = parse_arguments(argc, argv);
 
 	// This may be printed either as
-	const std::string usage_suffix = " [file or --new={machine}] [OPTIONS] [--rompath={path to ROMs}] [--speed={speed multiplier, e.g. 1.5}]  [--logical-keyboard] [--volume={0.0 to 1.0}]";
+	const std::string usage_suffix = " [file or --new={machine}] [OPTIONS] [--rompath={path to ROMs}] [--speed={speed multiplier, e.g. 1.5}]  [--logical-keyboard] [--volume={0.0 to 1.0}] [--overlay[={delta file}]] [--headless [--run-seconds={seconds}] [--run-frames={frames}] [--capture={base path} [--capture-formats={wav,raw,png,y4m}] [--capture-rate={frames per second}]]] [--profile]";
 
 	// Print a help message if requested.
 	if(arguments.selections.find("help") != arguments.selections.end() || arguments.selections.find("h") != arguments.selections.end()) {
@@ -542,6 +693,10 @@ int main(int argc, char *argv[]) {
 
 		std::cout << "Usage: " << final_path_component(argv[0]) << usage_suffix << std::endl;
 		std::cout << "Use alt+enter to toggle full screen display. Use control+shift+V to paste text." << std::endl;
+		std::cout << "Use --headless to run without video or audio output as quickly as possible, for --run-seconds of emulated time (default: 10) or --run-frames, then report speed." << std::endl;
+		std::cout << "Use --capture with --headless to record audio and " << HeadlessRunner::CaptureWidth << "x" << HeadlessRunner::CaptureHeight << " video to files named from the given base path; --capture-formats selects any of WAV audio, raw RGBA frames, one PNG per frame and Y4M video (default: wav,y4m), and --capture-rate sets the frame rate (default: 50)." << std::endl;
+		std::cout << "Use --overlay to leave hard disk images unmodified, keeping any changes in memory or, if a file name is given, in that file; if there are several hard disks then their files are named with suffixes .0, .1, etc." << std::endl;
+		std::cout << "Use --profile to report the time spent in each emulated component upon exit; this requires a build with PROFILE_COMPONENTS defined." << std::endl;
 		std::cout << "Required machine type **and all options** are determined from the file if specified; otherwise use:" << std::endl << std::endl;
 		std::cout << "\t--new={";
 		bool is_first = true;
@@ -761,6 +916,46 @@ int main(int argc, char *argv[]) {
 			return results;
 		};
 
+	// Overlay mass storage devices if requested. Alternative targets may share devices, so create only
+	// one overlay per device; if there's more than one device, suffix each delta file's name with an index.
+	const auto overlay_argument = arguments.selections.find("overlay");
+	if(overlay_argument != arguments.selections.end()) {
+		std::vector<std::shared_ptr<Storage::MassStorage::MassStorageDevice>> devices;
+		for(const auto &target: targets) {
+			for(const auto &device: target->media.mass_storage_devices) {
+				if(std::find(devices.begin(), devices.end(), device) == devices.end()) {
+					devices.push_back(device);
+				}
+			}
+		}
+
+		std::map<Storage::MassStorage::MassStorageDevice *, std::shared_ptr<Storage::MassStorage::MassStorageDevice>> overlays;
+		for(size_t index = 0; index < devices.size(); ++index) {
+			std::string delta_file_name = overlay_argument->second;
+			if(!delta_file_name.empty() && devices.size() > 1) {
+				delta_file_name += "." + std::to_string(index);
+			}
+
+			auto &overlay = overlays[devices[index].get()];
+			try {
+				if(delta_file_name.empty()) {
+					overlay = std::make_shared<Storage::MassStorage::CopyOnWriteDevice>(devices[index]);
+				} else {
+					overlay = std::make_shared<Storage::MassStorage::CopyOnWriteDevice>(devices[index], delta_file_name);
+				}
+			} catch(...) {
+				std::cerr << "Could not use " << delta_file_name << " as an overlay." << std::endl;
+				return EXIT_FAILURE;
+			}
+		}
+
+		for(auto &target: targets) {
+			for(auto &device: target->media.mass_storage_devices) {
+				device = overlays[device.get()];
+			}
+		}
+	}
+
 	// Apply all command-line options to the targets.
 	for(auto &target: targets) {
 		auto reflectable_target = dynamic_cast<Reflection::Struct *>(target.get());
@@ -804,6 +999,10 @@ int main(int argc, char *argv[]) {
 		configurable->set_options(options);
 	}
 
+	// Check whether headless running has been requested; if so there's no need for any further
+	// setup beyond media insertion.
+	const bool is_headless = arguments.selections.find("headless") != arguments.selections.end();
+
 	// Apply the speed multiplier, if one was requested.
 	{
 		const auto speed_argument = arguments.selections.find("speed");
@@ -816,6 +1015,9 @@ int main(int argc, char *argv[]) {
 				std::cerr << "Unable to parse speed: " << speed_string << std::endl;
 			} else if(speed <= 0.0) {
 				std::cerr << "Cannot run at speed " << speed_string << "; speeds must be positive." << std::endl;
+			} else if(is_headless) {
+				// Headless runs aren't paced by the display, so apply the multiplier directly.
+				machine->timed_machine()->set_speed_multiplier(speed);
 			} else {
 				machine_runner.set_speed_multiplier(speed);
 			}
@@ -844,11 +1046,13 @@ int main(int argc, char *argv[]) {
 		}
 	}
 
+	const bool should_profile = arguments.selections.find("profile") != arguments.selections.end();
+
 	// Check whether a 'logical' keyboard has been requested, or the machine would prefer one anyway.
 	const bool logical_keyboard =
 		(arguments.selections.find("logical-keyboard") != arguments.selections.end()) ||
 		(machine->keyboard_machine() && machine->keyboard_machine()->prefers_logical_input());
-	if(logical_keyboard) {
+	if(logical_keyboard && !is_headless) {
 		SDL_StartTextInput();
 	}
 
@@ -864,6 +1068,103 @@ int main(int argc, char *argv[]) {
 		}
 	}
 
+	if(is_headless) {
+		Time::Seconds seconds = 0.0;
+		int frames = 0;
+
+		const auto seconds_argument = arguments.selections.find("run-seconds");
+		if(seconds_argument != arguments.selections.end()) {
+			const char *seconds_string = seconds_argument->second.c_str();
+			char *end;
+			seconds = strtod(seconds_string, &end);
+
+			if(!*seconds_string || size_t(end - seconds_string) != strlen(seconds_string)) {
+				std::cerr << "Unable to parse run time: " << seconds_string << std::endl;
+				return EXIT_FAILURE;
+			}
+			if(seconds <= 0.0) {
+				std::cerr << "Cannot run for " << seconds_string << " seconds; run times must be positive." << std::endl;
+				return EXIT_FAILURE;
+			}
+		}
+		const auto frames_argument = arguments.selections.find("run-frames");
+		if(frames_argument != arguments.selections.end()) {
+			const char *frames_string = frames_argument->second.c_str();
+			char *end;
+			const long parsed_frames = strtol(frames_string, &end, 10);
+
+			if(!*frames_string || size_t(end - frames_string) != strlen(frames_string)) {
+				std::cerr << "Unable to parse frame count: " << frames_string << std::endl;
+				return EXIT_FAILURE;
+			}
+			if(parsed_frames <= 0 || parsed_frames > std::numeric_limits<int>::max()) {
+				std::cerr << "Cannot run for " << frames_string << " frames; frame counts must be positive." << std::endl;
+				return EXIT_FAILURE;
+			}
+			frames = int(parsed_frames);
+		}
+		if(seconds <= 0.0 && frames <= 0) {
+			seconds = 10.0;
+		}
+
+		std::unique_ptr<HeadlessRunner::Capture> capture;
+		const auto capture_argument = arguments.selections.find("capture");
+		if(capture_argument != arguments.selections.end()) {
+			capture = std::make_unique<HeadlessRunner::Capture>();
+			capture->base_path = capture_argument->second;
+
+			const auto formats_argument = arguments.selections.find("capture-formats");
+			if(formats_argument != arguments.selections.end()) {
+				using Format = Outputs::Capture::Recorder::Format;
+				const std::map<std::string, int> formats = {
+					{"wav", Format::WAV},
+					{"raw", Format::Raw},
+					{"png", Format::PNG},
+					{"y4m", Format::Y4M},
+				};
+
+				capture->formats = 0;
+				std::istringstream stream(formats_argument->second);
+				std::string name;
+				while(std::getline(stream, name, ',')) {
+					const auto format = formats.find(name);
+					if(format == formats.end()) {
+						std::cerr << "Unrecognised capture format " << name << std::endl;
+						return EXIT_FAILURE;
+					}
+					capture->formats |= format->second;
+				}
+			}
+
+			const auto rate_argument = arguments.selections.find("capture-rate");
+			if(rate_argument != arguments.selections.end()) {
+				const char *rate_string = rate_argument->second.c_str();
+				char *end;
+				capture->frame_rate = strtod(rate_string, &end);
+
+				if(!*rate_string || size_t(end - rate_string) != strlen(rate_string)) {
+					std::cerr << "Unable to parse capture rate: " << rate_string << std::endl;
+					return EXIT_FAILURE;
+				}
+				if(!std::isfinite(capture->frame_rate) || capture->frame_rate <= 0.0) {
+					std::cerr << "Cannot capture at " << rate_string << " frames per second; capture rates must be positive." << std::endl;
+					return EXIT_FAILURE;
+				}
+			}
+		}
+
+		try {
+			HeadlessRunner::run(*machine, seconds, frames, capture.get());
+		} catch(Outputs::Capture::Recorder::Error) {
+			std::cerr << "Could not open capture files at " << capture->base_path << std::endl;
+			return EXIT_FAILURE;
+		}
+		if(should_profile) {
+			print_profile(*machine->timed_machine());
+		}
+		return EXIT_SUCCESS;
+	}
+
 	// Attempt to set up video and audio.
 	if(SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO) < 0) {
 		std::cerr << "SDL could not initialize! SDL_Error: " << SDL_GetError() << std::endl;
@@ -1304,6 +1605,9 @@ int main(int argc, char *argv[]) {
 
 	// Clean up.
 	machine_runner.stop();	// Ensure no further updates will occur.
+	if(should_profile) {
+		print_profile(*machine->timed_machine());
+	}
 	joysticks.clear();
 	SDL_DestroyWindow( window );
 	SDL_Quit();
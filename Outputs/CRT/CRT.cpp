@@ -8,6 +8,8 @@
 
 #include "CRT.hpp"
 
+#include "../../Activity/Profiler.hpp"
+
 #include <cstdarg>
 #include <cmath>
 #include <algorithm>
@@ -206,6 +208,7 @@ Outputs::Display::ScanTarget::Scan::EndPoint CRT::end_point(uint16_t data_offset
 }
 
 void CRT::advance_cycles(int number_of_cycles, bool hsync_requested, bool vsync_requested, const Scan::Type type, int number_of_samples) {
+	PROFILE_SCOPE("CRT", uint64_t(number_of_cycles));
 	number_of_cycles *= time_multiplier_;
 
 	const bool is_output_run = ((type == Scan::Type::Level) || (type == Scan::Type::Data));
@@ -0,0 +1,345 @@
+//
+//  Recorder.cpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 16/10/2026.
+//  Copyright 2026 Thomas Harte. All rights reserved.
+//
+
+#include "Recorder.hpp"
+
+#include "../Software/ScanTarget.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <thread>
+#include <zlib.h>
+
+using namespace Outputs::Capture;
+
+namespace {
+
+/// The largest data chunk that a WAV file can contain, given that the RIFF size excludes only the first 8 bytes of its 44-byte header.
+constexpr size_t MaxWAVDataSize = std::numeric_limits<uint32_t>::max() - 36;
+
+void put16(uint8_t *target, uint16_t value) {
+	target[0] = uint8_t(value);
+	target[1] = uint8_t(value >> 8);
+}
+
+void put32(uint8_t *target, uint32_t value) {
+	put16(target, uint16_t(value));
+	put16(target + 2, uint16_t(value >> 16));
+}
+
+void put32_big_endian(uint8_t *target, uint32_t value) {
+	target[0] = uint8_t(value >> 24);
+	target[1] = uint8_t(value >> 16);
+	target[2] = uint8_t(value >> 8);
+	target[3] = uint8_t(value);
+}
+
+}
+
+// MARK: - Buffer pools.
+
+template <typename BufferT> BufferT &Recorder::Pool<BufferT>::acquire() {
+	// Wait for the encoder to release the oldest buffer if all are in use.
+	while(acquired - released.load(std::memory_order_acquire) == buffers.size()) {
+		std::this_thread::yield();
+	}
+	return buffers[acquired++ % buffers.size()];
+}
+
+template <typename BufferT> void Recorder::Pool<BufferT>::release() {
+	released.fetch_add(1, std::memory_order_release);
+}
+
+// MARK: - Lifecycle.
+
+Recorder::Recorder(const std::string &base_path, int formats, double frame_rate, size_t frame_buffers, size_t audio_buffers) :
+	frames_(frame_buffers), audio_(audio_buffers), base_path_(base_path), formats_(formats), frame_rate_(frame_rate) {
+	const auto open = [&base_path] (const char *extension) {
+		return std::fopen((base_path + extension).c_str(), "wb");
+	};
+
+	if(formats & Format::WAV)	wav_ = open(".wav");
+	if(formats & Format::Raw)	raw_ = open(".rgba");
+	if(formats & Format::Y4M)	y4m_ = open(".y4m");
+
+	if(
+		(formats & Format::WAV && !wav_) ||
+		(formats & Format::Raw && !raw_) ||
+		(formats & Format::Y4M && !y4m_)
+	) {
+		for(auto file: {wav_, raw_, y4m_}) {
+			if(file) std::fclose(file);
+		}
+		throw Error::CantOpen;
+	}
+
+	// Reserve space for the WAV header, which can't be completed until the total length is known.
+	if(wav_) {
+		write_wav_header();
+	}
+}
+
+Recorder::~Recorder() {
+	stop();
+}
+
+bool Recorder::stop() {
+	if(is_stopped_) return !has_failed_;
+	is_stopped_ = true;
+
+	// Complete all pending encoding; after this the encoder-thread state can safely be accessed here.
+	encoder_.stop();
+
+	if(wav_) {
+		std::fseek(wav_, 0, SEEK_SET);
+		write_wav_header();
+	}
+
+	// Closing a file may write out buffered data, so may also fail.
+	for(auto file: {wav_, raw_, y4m_}) {
+		if(file && std::fclose(file)) {
+			has_failed_ = true;
+		}
+	}
+	wav_ = raw_ = y4m_ = nullptr;
+
+	return !has_failed_;
+}
+
+// MARK: - Audio input.
+
+void Recorder::set_audio_format(int sample_rate, bool is_stereo) {
+	sample_rate_ = sample_rate;
+	is_stereo_ = is_stereo;
+}
+
+void Recorder::set_delegate(Outputs::Speaker::Speaker::Delegate *delegate) {
+	delegate_ = delegate;
+}
+
+// Audio input may arrive on another thread, so touches only the audio pool,
+// the encoder queue and the delegate.
+void Recorder::speaker_did_complete_samples(Outputs::Speaker::Speaker *speaker, const std::vector<int16_t> &buffer) {
+	if(formats_ & Format::WAV) {
+		auto &samples = audio_.acquire();
+		samples = buffer;
+		encoder_.enqueue([this, &samples] {
+			encode_audio(samples);
+			audio_.release();
+		});
+	}
+
+	const auto delegate = delegate_.load();
+	if(delegate) {
+		delegate->speaker_did_complete_samples(speaker, buffer);
+	}
+}
+
+void Recorder::speaker_did_change_input_clock(Outputs::Speaker::Speaker *speaker) {
+	const auto delegate = delegate_.load();
+	if(delegate) {
+		delegate->speaker_did_change_input_clock(speaker);
+	}
+}
+
+// MARK: - Video input.
+
+uint8_t *Recorder::begin_frame(int width, int height) {
+	current_frame_ = &frames_.acquire();
+	current_frame_->width = width;
+	current_frame_->height = height;
+	current_frame_->pixels.resize(size_t(width) * size_t(height) * 4);
+	return current_frame_->pixels.data();
+}
+
+void Recorder::end_frame() {
+	const Frame *const frame = current_frame_;
+	current_frame_ = nullptr;
+	encoder_.enqueue([this, frame] {
+		encode_frame(*frame);
+		frames_.release();
+	});
+}
+
+void Recorder::capture_frame(Outputs::Display::Software::ScanTarget &scan_target) {
+	const int width = scan_target.output_width();
+	const int height = scan_target.output_height();
+	if(!width || !height) return;
+
+	scan_target.draw(begin_frame(width, height), size_t(width) * 4);
+	end_frame();
+}
+
+size_t Recorder::frame_count() const {
+	return frames_.acquired;
+}
+
+bool Recorder::has_failed() const {
+	return has_failed_;
+}
+
+// MARK: - Encoding.
+
+void Recorder::write(FILE *file, const void *data, size_t size) {
+	if(std::fwrite(data, 1, size, file) != size) {
+		has_failed_ = true;
+	}
+}
+
+void Recorder::write_wav_header() {
+	const uint16_t channels = is_stereo_ ? 2 : 1;
+	uint8_t header[44];
+
+	std::copy_n("RIFF", 4, &header[0]);
+	put32(&header[4], uint32_t(36 + audio_bytes_));
+	std::copy_n("WAVEfmt ", 8, &header[8]);
+	put32(&header[16], 16);									// Length of format chunk.
+	put16(&header[20], 1);									// PCM.
+	put16(&header[22], channels);
+	put32(&header[24], uint32_t(sample_rate_));
+	put32(&header[28], uint32_t(sample_rate_ * channels * 2));	// Bytes per second.
+	put16(&header[32], uint16_t(channels * 2));				// Bytes per sample frame.
+	put16(&header[34], 16);									// Bits per sample.
+	std::copy_n("data", 4, &header[36]);
+	put32(&header[40], uint32_t(audio_bytes_));
+
+	write(wav_, header, sizeof(header));
+}
+
+void Recorder::encode_audio(const std::vector<int16_t> &samples) {
+	// A WAV file can't describe more than 4GB, less its header; audio beyond that is discarded.
+	if(audio_bytes_ + samples.size() * 2 > MaxWAVDataSize) {
+		has_failed_ = true;
+		return;
+	}
+
+	scratch_.resize(samples.size() * 2);
+	for(size_t c = 0; c < samples.size(); c++) {
+		put16(&scratch_[c * 2], uint16_t(samples[c]));
+	}
+	write(wav_, scratch_.data(), scratch_.size());
+	audio_bytes_ += scratch_.size();
+}
+
+void Recorder::encode_frame(const Frame &frame) {
+	if(raw_) {
+		write(raw_, frame.pixels.data(), frame.pixels.size());
+	}
+	if(y4m_) {
+		write_y4m(frame);
+	}
+	if(formats_ & Format::PNG) {
+		write_png(frame);
+	}
+	++frames_encoded_;
+}
+
+void Recorder::write_y4m(const Frame &frame) {
+	if(!frames_encoded_) {
+		// Express the frame rate as a fraction, preserving up to three decimal places.
+		int numerator = int(std::round(frame_rate_));
+		int denominator = 1;
+		if(std::fabs(frame_rate_ - double(numerator)) > 0.0005) {
+			numerator = int(std::round(frame_rate_ * 1000.0));
+			denominator = 1000;
+		}
+
+		char header[128];
+		const int length = std::snprintf(header, sizeof(header), "YUV4MPEG2 W%d H%d F%d:%d Ip A1:1 C444\n",
+			frame.width, frame.height, numerator, denominator);
+		write(y4m_, header, size_t(length));
+	}
+
+	// Convert to limited-range BT.601, with each plane stored separately.
+	const size_t pixels = size_t(frame.width) * size_t(frame.height);
+	scratch_.resize(pixels * 3);
+	uint8_t *const y = scratch_.data();
+	uint8_t *const u = y + pixels;
+	uint8_t *const v = u + pixels;
+	for(size_t c = 0; c < pixels; c++) {
+		const int red = frame.pixels[c*4 + 0];
+		const int green = frame.pixels[c*4 + 1];
+		const int blue = frame.pixels[c*4 + 2];
+
+		y[c] = uint8_t(((66*red + 129*green + 25*blue + 128) >> 8) + 16);
+		u[c] = uint8_t(((-38*red - 74*green + 112*blue + 128) >> 8) + 128);
+		v[c] = uint8_t(((112*red - 94*green - 18*blue + 128) >> 8) + 128);
+	}
+
+	write(y4m_, "FRAME\n", 6);
+	write(y4m_, scratch_.data(), scratch_.size());
+}
+
+void Recorder::write_png(const Frame &frame) {
+	// Each row is a filter type, which is always 0 (i.e. no filter) here, followed by RGB data.
+	const size_t row_length = 1 + size_t(frame.width) * 3;
+	scratch_.resize(row_length * size_t(frame.height));
+	for(int row = 0; row < frame.height; row++) {
+		uint8_t *target = &scratch_[size_t(row) * row_length];
+		const uint8_t *source = &frame.pixels[size_t(row) * size_t(frame.width) * 4];
+
+		*target++ = 0;
+		for(int column = 0; column < frame.width; column++) {
+			target[0] = source[0];
+			target[1] = source[1];
+			target[2] = source[2];
+			target += 3;
+			source += 4;
+		}
+	}
+
+	// Compress for speed over size; it's assumed that PNGs will generally be used for regression
+	// comparisons, or be reprocessed later.
+	uLongf compressed_size = compressBound(uLong(scratch_.size()));
+	compressed_.resize(compressed_size);
+	if(compress2(compressed_.data(), &compressed_size, scratch_.data(), uLong(scratch_.size()), 1) != Z_OK) {
+		has_failed_ = true;
+		return;
+	}
+
+	char name_suffix[16];
+	std::snprintf(name_suffix, sizeof(name_suffix), "-%06zu.png", frames_encoded_);
+	FILE *const file = std::fopen((base_path_ + name_suffix).c_str(), "wb");
+	if(!file) {
+		has_failed_ = true;
+		return;
+	}
+
+	const auto chunk = [this, file] (const char *type, const uint8_t *data, size_t size) {
+		uint8_t length[4];
+		put32_big_endian(length, uint32_t(size));
+		write(file, length, 4);
+		write(file, type, 4);
+		if(size) write(file, data, size);
+
+		// zlib's crc32 returns its initial value if given a null pointer, so don't supply one.
+		uLong crc = crc32(0, reinterpret_cast<const Bytef *>(type), 4);
+		if(size) crc = crc32(crc, data, uInt(size));
+		uint8_t crc_bytes[4];
+		put32_big_endian(crc_bytes, uint32_t(crc));
+		write(file, crc_bytes, 4);
+	};
+
+	constexpr uint8_t signature[] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n'};
+	write(file, signature, sizeof(signature));
+
+	uint8_t header[13];
+	put32_big_endian(&header[0], uint32_t(frame.width));
+	put32_big_endian(&header[4], uint32_t(frame.height));
+	header[8] = 8;		// Bit depth.
+	header[9] = 2;		// Colour type: RGB.
+	header[10] = 0;		// Compression method: deflate.
+	header[11] = 0;		// Filter method: adaptive.
+	header[12] = 0;		// Interlace method: none.
+	chunk("IHDR", header, sizeof(header));
+	chunk("IDAT", compressed_.data(), compressed_size);
+	chunk("IEND", nullptr, 0);
+
+	std::fclose(file);
+}
@@ -0,0 +1,170 @@
+//
+//  Recorder.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 16/10/2026.
+//  Copyright 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef Outputs_Capture_Recorder_hpp
+#define Outputs_Capture_Recorder_hpp
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "../Speaker/Speaker.hpp"
+#include "../../Concurrency/LockFreeTaskQueue.hpp"
+
+namespace Outputs {
+namespace Display {
+namespace Software {
+class ScanTarget;
+}
+}
+
+namespace Capture {
+
+/*!
+	Records audio and video to files, performing all encoding and file output on a background thread.
+
+	Audio is received as a Speaker::Delegate, and can be forwarded to another delegate so that recording
+	doesn't displace live output. Frames are RGBA images, supplied either via @c begin_frame and @c end_frame
+	or directly from a Software::ScanTarget.
+
+	Audio and frames are copied into fixed pools of buffers and handed to the encoder via a lock-free queue,
+	so memory use is bounded. If the encoder falls behind and all buffers of the relevant type are in use,
+	the producer waits for one to be released. Faster-than-real-time runs are therefore slowed to the pace
+	of encoding rather than losing data.
+
+	Audio may be supplied from a thread other than the owner's, such as a machine's audio queue, provided that
+	only one thread supplies audio at a time and that the Recorder is detached from any speaker before @c stop
+	is called. All other calls must be made from the thread that owns the Recorder, which is also the thread
+	that will wait for frame buffers.
+*/
+class Recorder: public Outputs::Speaker::Speaker::Delegate {
+	public:
+		/// Flags for the supported output formats; each names the file that will be written, given a base path.
+		struct Format {
+			/// <base>.wav: 16-bit PCM audio.
+			static constexpr int WAV = 1 << 0;
+			/// <base>.rgba: frames as RGBA data in raster order, concatenated without headers.
+			static constexpr int Raw = 1 << 1;
+			/// <base>-000000.png, <base>-000001.png, etc: one RGB PNG per frame.
+			static constexpr int PNG = 1 << 2;
+			/// <base>.y4m: frames as a YUV 4:4:4 stream, suitable as input to most video encoders.
+			static constexpr int Y4M = 1 << 3;
+
+			static constexpr int All = WAV | Raw | PNG | Y4M;
+		};
+
+		enum class Error {
+			CantOpen = -1
+		};
+
+		/*!
+			Constructs a Recorder that will write the formats indicated by @c formats, with file names derived from
+			@c base_path. @c frame_rate is recorded in the Y4M header.
+
+			At most @c frame_buffers frames and @c audio_buffers audio packets will be awaiting encoding at any time.
+
+			@throws Error::CantOpen if any of the output files cannot be opened.
+		*/
+		Recorder(const std::string &base_path, int formats, double frame_rate, size_t frame_buffers = 4, size_t audio_buffers = 16);
+
+		/// Calls @c stop if it has not already been called.
+		~Recorder();
+
+		/// Waits for all pending audio and frames to be written, then completes and closes all files. No further
+		/// audio or frames should be supplied.
+		///
+		/// @returns @c true if all output was written successfully; @c false otherwise.
+		bool stop();
+
+		/// Sets the format of audio that will be supplied; this may be called at any time before destruction.
+		void set_audio_format(int sample_rate, bool is_stereo);
+
+		/// Sets a delegate to which all audio will be forwarded after it has been captured.
+		void set_delegate(Outputs::Speaker::Speaker::Delegate *delegate);
+
+		// Speaker::Delegate.
+		void speaker_did_complete_samples(Outputs::Speaker::Speaker *speaker, const std::vector<int16_t> &buffer) final;
+		void speaker_did_change_input_clock(Outputs::Speaker::Speaker *speaker) final;
+
+		/*!
+			Obtains storage for the next frame, which will be @c width by @c height pixels; the caller should fill it
+			with RGBA data in raster order, then call @c end_frame. All frames should have the same dimensions.
+
+			Blocks if all frame buffers are currently awaiting encoding.
+		*/
+		uint8_t *begin_frame(int width, int height);
+
+		/// Submits the frame most recently returned by @c begin_frame for encoding.
+		void end_frame();
+
+		/// Captures the current contents of @c scan_target as the next frame, at its current output size.
+		void capture_frame(Outputs::Display::Software::ScanTarget &scan_target);
+
+		/// @returns The number of frames submitted so far.
+		size_t frame_count() const;
+
+		/// @returns @c true if any write has failed, or if audio has exceeded the maximum size of a WAV file,
+		/// in which case output will be incomplete. Failures in completing files are reported only after @c stop.
+		bool has_failed() const;
+
+	private:
+		struct Frame {
+			std::vector<uint8_t> pixels;
+			int width = 0, height = 0;
+		};
+
+		/// A fixed pool of buffers. Buffers are acquired in rotation by the producer and released by
+		/// the encoder in the same order, so a count of each is sufficient to track which are free.
+		template <typename BufferT> struct Pool {
+			Pool(size_t size) : buffers(size) {}
+
+			BufferT &acquire();
+			void release();
+
+			std::vector<BufferT> buffers;
+			size_t acquired = 0;
+			std::atomic<size_t> released = 0;
+		};
+		Pool<Frame> frames_;
+		Pool<std::vector<int16_t>> audio_;
+		Frame *current_frame_ = nullptr;
+
+		std::atomic<Outputs::Speaker::Speaker::Delegate *> delegate_ = nullptr;
+		int sample_rate_ = 0;
+		bool is_stereo_ = false;
+
+		// Encoder-thread state.
+		const std::string base_path_;
+		const int formats_;
+		const double frame_rate_;
+		FILE *wav_ = nullptr, *raw_ = nullptr, *y4m_ = nullptr;
+		size_t audio_bytes_ = 0;
+		size_t frames_encoded_ = 0;
+		std::vector<uint8_t> scratch_;
+		std::vector<uint8_t> compressed_;
+		std::atomic<bool> has_failed_ = false;
+		bool is_stopped_ = false;
+
+		void write(FILE *file, const void *data, size_t size);
+		void encode_audio(const std::vector<int16_t> &samples);
+		void encode_frame(const Frame &frame);
+		void write_png(const Frame &frame);
+		void write_y4m(const Frame &frame);
+		void write_wav_header();
+
+		// Declared last, so that it is destroyed first.
+		Concurrency::LockFreeTaskQueue<true, true, void, 64> encoder_;
+};
+
+}
+}
+
+#endif /* Outputs_Capture_Recorder_hpp */
@@ -0,0 +1,808 @@
+//
+//  ScanTarget.cpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 16/10/2026.
+//  Copyright 2026 Thomas Harte. All rights reserved.
+//
+
+#include "ScanTarget.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#define USE_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#define USE_NEON
+#include <arm_neon.h>
+#endif
+
+using namespace Outputs::Display::Software;
+
+namespace {
+
+/// Opaque black, as stored in the framebuffer.
+constexpr uint32_t OpaqueBlack = 0xff00'0000;
+
+/// Provides four lanes of float arithmetic using whichever vector unit is available.
+struct Float4 {
+#if defined(USE_SSE2)
+	__m128 v;
+
+	static Float4 load(const float *source)				{	return {_mm_loadu_ps(source)};				}
+	static Float4 all(float value)						{	return {_mm_set1_ps(value)};				}
+	void store(float *target) const						{	_mm_storeu_ps(target, v);					}
+
+	Float4 operator +(Float4 rhs) const					{	return {_mm_add_ps(v, rhs.v)};				}
+	Float4 operator -(Float4 rhs) const					{	return {_mm_sub_ps(v, rhs.v)};				}
+	Float4 operator *(Float4 rhs) const					{	return {_mm_mul_ps(v, rhs.v)};				}
+	Float4 clamp(Float4 low, Float4 high) const			{	return {_mm_min_ps(_mm_max_ps(v, low.v), high.v)};	}
+
+	/// Stores the nearest integers to these lanes, which must be non-negative, to @c target.
+	void store_rounded(int32_t *target) const {
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(target), _mm_cvttps_epi32(_mm_add_ps(v, _mm_set1_ps(0.5f))));
+	}
+
+	/// Stores four opaque pixels built from @c red, @c green and @c blue, which must be in the range [0, 255].
+	static void store_pixels(uint32_t *target, Float4 red, Float4 green, Float4 blue) {
+		const __m128 half = _mm_set1_ps(0.5f);
+		const __m128i r = _mm_cvttps_epi32(_mm_add_ps(red.v, half));
+		const __m128i g = _mm_slli_epi32(_mm_cvttps_epi32(_mm_add_ps(green.v, half)), 8);
+		const __m128i b = _mm_slli_epi32(_mm_cvttps_epi32(_mm_add_ps(blue.v, half)), 16);
+		const __m128i rgba = _mm_or_si128(_mm_or_si128(r, g), _mm_or_si128(b, _mm_set1_epi32(int(OpaqueBlack))));
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(target), rgba);
+	}
+#elif defined(USE_NEON)
+	float32x4_t v;
+
+	static Float4 load(const float *source)				{	return {vld1q_f32(source)};					}
+	static Float4 all(float value)						{	return {vdupq_n_f32(value)};				}
+	void store(float *target) const						{	vst1q_f32(target, v);						}
+
+	Float4 operator +(Float4 rhs) const					{	return {vaddq_f32(v, rhs.v)};				}
+	Float4 operator -(Float4 rhs) const					{	return {vsubq_f32(v, rhs.v)};				}
+	Float4 operator *(Float4 rhs) const					{	return {vmulq_f32(v, rhs.v)};				}
+	Float4 clamp(Float4 low, Float4 high) const			{	return {vminq_f32(vmaxq_f32(v, low.v), high.v)};	}
+
+	void store_rounded(int32_t *target) const {
+		vst1q_s32(target, vcvtq_s32_f32(vaddq_f32(v, vdupq_n_f32(0.5f))));
+	}
+
+	static void store_pixels(uint32_t *target, Float4 red, Float4 green, Float4 blue) {
+		const float32x4_t half = vdupq_n_f32(0.5f);
+		const uint32x4_t r = vcvtq_u32_f32(vaddq_f32(red.v, half));
+		const uint32x4_t g = vshlq_n_u32(vcvtq_u32_f32(vaddq_f32(green.v, half)), 8);
+		const uint32x4_t b = vshlq_n_u32(vcvtq_u32_f32(vaddq_f32(blue.v, half)), 16);
+		vst1q_u32(target, vorrq_u32(vorrq_u32(r, g), vorrq_u32(b, vdupq_n_u32(OpaqueBlack))));
+	}
+#else
+	float v[4];
+
+	static Float4 load(const float *source)				{	return {{source[0], source[1], source[2], source[3]}};	}
+	static Float4 all(float value)						{	return {{value, value, value, value}};					}
+	void store(float *target) const						{	std::copy(v, v + 4, target);							}
+
+	Float4 operator +(Float4 rhs) const	{	return {{v[0] + rhs.v[0], v[1] + rhs.v[1], v[2] + rhs.v[2], v[3] + rhs.v[3]}};	}
+	Float4 operator -(Float4 rhs) const	{	return {{v[0] - rhs.v[0], v[1] - rhs.v[1], v[2] - rhs.v[2], v[3] - rhs.v[3]}};	}
+	Float4 operator *(Float4 rhs) const	{	return {{v[0] * rhs.v[0], v[1] * rhs.v[1], v[2] * rhs.v[2], v[3] * rhs.v[3]}};	}
+	Float4 clamp(Float4 low, Float4 high) const {
+		Float4 result;
+		for(int c = 0; c < 4; ++c) result.v[c] = std::min(std::max(v[c], low.v[c]), high.v[c]);
+		return result;
+	}
+
+	void store_rounded(int32_t *target) const {
+		for(int c = 0; c < 4; ++c) target[c] = int32_t(v[c] + 0.5f);
+	}
+
+	static void store_pixels(uint32_t *target, Float4 red, Float4 green, Float4 blue) {
+		for(int c = 0; c < 4; ++c) {
+			target[c] =
+				uint32_t(red.v[c] + 0.5f) |
+				(uint32_t(green.v[c] + 0.5f) << 8) |
+				(uint32_t(blue.v[c] + 0.5f) << 16) |
+				OpaqueBlack;
+		}
+	}
+#endif
+};
+
+/// Applies a centred box filter exactly one colour cycle wide — i.e. with weights [1/8, 1/4, 1/4, 1/4, 1/8]
+/// at four samples per cycle — to @c count samples from @c source, writing to @c target. Up to three samples
+/// beyond @c count may also be written, and @c source must have five samples of padding on either side.
+void box_filter(const float *source, float *target, int count) {
+	const auto eighth = Float4::all(0.125f);
+	const auto quarter = Float4::all(0.25f);
+	for(int c = 0; c < count; c += 4) {
+		const auto outer = Float4::load(&source[c - 2]) + Float4::load(&source[c + 2]);
+		const auto inner = Float4::load(&source[c - 1]) + Float4::load(&source[c]) + Float4::load(&source[c + 1]);
+		(outer * eighth + inner * quarter).store(&target[c]);
+	}
+}
+
+}
+
+/// Working space for decoding a single line.
+struct ScanTarget::Scratch {
+	/// Input data for the line, composed into RGBA by clock.
+	std::array<uint32_t, LineBufferWidth> composed;
+
+	/// Samples are stored with this much padding on either side so that filters can run
+	/// off the ends, and so that vector loops can overrun.
+	static constexpr int Padding = 8;
+	using Samples = std::array<float, LineBufferWidth + Padding * 2>;
+
+	/// The composite signal, or the luminance and chrominance of an S-Video signal.
+	Samples signal, chroma;
+	/// The colour subcarrier at each sample.
+	Samples cos, sin;
+	/// Demodulated but unfiltered chrominance.
+	Samples raw_u, raw_v;
+	/// Three channels of decoded colour, either RGB or luminance plus chrominance.
+	Samples planes[3];
+
+	/// The same three channels after resampling to the output.
+	std::vector<float> output[3];
+	std::vector<int32_t> rounded[3];
+};
+
+ScanTarget::ScanTarget(float output_gamma, size_t thread_count) :
+	output_gamma_(output_gamma) {
+
+	set_scan_buffer(scan_buffer_.data(), scan_buffer_.size());
+	set_line_buffer(line_buffer_.data(), line_metadata_buffer_.data(), line_buffer_.size());
+
+	// Establish initial state for is_drawing_to_framebuffer_.
+	is_drawing_to_framebuffer_.clear();
+
+	if(!thread_count) {
+		thread_count = std::max(std::thread::hardware_concurrency(), 1u);
+	}
+	scratch_.resize(thread_count);
+	decoded_lines_.resize(LineBufferHeight);
+
+	// Scratch space zero is used by the thread that calls update; spawn workers for the rest.
+	for(size_t c = 1; c < thread_count; ++c) {
+		workers_.emplace_back([this, c] {
+			size_t generation = 0;
+			while(true) {
+				{
+					std::unique_lock lock(work_mutex_);
+					work_condition_.wait(lock, [this, &generation] {
+						return workers_should_quit_ || work_generation_ != generation;
+					});
+					if(workers_should_quit_) return;
+					generation = work_generation_;
+				}
+
+				perform_work(scratch_[c]);
+
+				std::lock_guard lock(work_mutex_);
+				if(!--workers_outstanding_) {
+					completion_condition_.notify_one();
+				}
+			}
+		});
+	}
+}
+
+ScanTarget::~ScanTarget() {
+	{
+		std::lock_guard lock(work_mutex_);
+		workers_should_quit_ = true;
+	}
+	work_condition_.notify_all();
+	for(auto &worker: workers_) {
+		worker.join();
+	}
+}
+
+void ScanTarget::setup_pipeline() {
+	const auto modals = BufferingScanTarget::modals();
+	const auto data_type_size = Outputs::Display::size_for_data_type(modals.input_data_type);
+
+	// Resize the write area only if required.
+	const size_t required_size = WriteAreaWidth*WriteAreaHeight*data_type_size;
+	if(required_size != write_area_data_size() || write_area_texture_.size() != required_size) {
+		write_area_texture_.resize(required_size);
+		set_write_area(write_area_texture_.data());
+	}
+
+	pipeline_.display_type = modals.display_type;
+	pipeline_.input_data_type = modals.input_data_type;
+	pipeline_.data_type_size = data_type_size;
+	pipeline_.phase_offset = modals.input_data_tweaks.phase_linked_luminance_offset;
+
+	// Build a table for composition of one- and two-byte formats; this is the equivalent
+	// of the OpenGL composition shader.
+	auto &table = pipeline_.composition_table;
+	const auto grey = [](uint32_t level) { return level | (level << 8) | (level << 16); };
+	const auto rgb = [](uint32_t red, uint32_t green, uint32_t blue) { return red | (green << 8) | (blue << 16); };
+	table.clear();
+	pipeline_.composed_black = 0;
+	switch(modals.input_data_type) {
+		case InputDataType::Luminance1:
+			table.resize(256);
+			for(uint32_t c = 0; c < 256; c++) table[c] = c ? grey(255) : 0;
+		break;
+
+		case InputDataType::Luminance8:
+			table.resize(256);
+			for(uint32_t c = 0; c < 256; c++) table[c] = grey(c);
+		break;
+
+		case InputDataType::Red1Green1Blue1:
+			table.resize(256);
+			for(uint32_t c = 0; c < 256; c++) table[c] = rgb((c & 4) ? 255 : 0, (c & 2) ? 255 : 0, (c & 1) ? 255 : 0);
+		break;
+
+		case InputDataType::Red2Green2Blue2:
+			table.resize(256);
+			for(uint32_t c = 0; c < 256; c++) table[c] = rgb(((c >> 4) & 3) * 85, ((c >> 2) & 3) * 85, (c & 3) * 85);
+		break;
+
+		case InputDataType::Red4Green4Blue4:
+			// Indexed by the low nibble of the first byte, then the entire second byte.
+			table.resize(4096);
+			for(uint32_t c = 0; c < 4096; c++) table[c] = rgb(((c >> 8) & 0xf) * 17, ((c >> 4) & 0xf) * 17, (c & 0xf) * 17);
+		break;
+
+		case InputDataType::Luminance8Phase8:
+			// Black is zero luminance, with the colour subcarrier disengaged.
+			pipeline_.composed_black = 0xff00;
+		break;
+
+		default: break;
+	}
+
+	// Tabulate the phase offsets of Luminance8Phase8 data: 256 units cover two full cycles
+	// and anything above 0.75 disengages the subcarrier.
+	for(int c = 0; c < 256; c++) {
+		const bool is_enabled = c <= 191;
+		const float angle = 2.0f * 3.141592654f * 2.0f * float(c) / 255.0f;
+		pipeline_.phase_cos[size_t(c)] = is_enabled ? std::cos(angle) : 0.0f;
+		pipeline_.phase_sin[size_t(c)] = is_enabled ? std::sin(angle) : 0.0f;
+	}
+
+	// Establish colour conversions, folding in brightness.
+	pipeline_.from_rgb = from_rgb_matrix(modals.composite_colour_space);
+	if(modals.display_type == DisplayType::RGB) {
+		pipeline_.to_rgb = {1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f};
+	} else {
+		pipeline_.to_rgb = to_rgb_matrix(modals.composite_colour_space);
+	}
+	for(auto &entry: pipeline_.to_rgb) {
+		entry *= modals.brightness;
+	}
+
+	// Apply a gamma correction if required, via a ten-bit table.
+	pipeline_.gamma_table.clear();
+	if(std::fabs(output_gamma_ - modals.intended_gamma) > 0.05f) {
+		const float gamma_ratio = output_gamma_ / modals.intended_gamma;
+		pipeline_.gamma_table.resize(1024);
+		for(size_t c = 0; c < 1024; c++) {
+			pipeline_.gamma_table[c] = uint8_t(std::round(255.0f * std::pow(float(c) / 1023.0f, gamma_ratio)));
+		}
+	}
+
+	// Establish the mapping from Line coordinates to the unit square; this follows the OpenGL
+	// conversion shader.
+	pipeline_.x_scale = 1.0f / (float(modals.output_scale.x) * modals.visible_area.size.width);
+	pipeline_.y_scale = 1.0f / (float(modals.output_scale.y) * modals.aspect_ratio * (3.0f / 4.0f) * modals.visible_area.size.height);
+	pipeline_.origin_x = modals.visible_area.origin.x / modals.visible_area.size.width;
+	pipeline_.origin_y = modals.visible_area.origin.y / modals.visible_area.size.height;
+	pipeline_.row_height = 1.0f / (float(modals.expected_vertical_lines) * modals.visible_area.size.height);
+}
+
+void ScanTarget::update(int output_width, int output_height) {
+	perform([=] {
+		const OutputArea area = get_output_area();
+		const auto begin_time = std::chrono::high_resolution_clock::now();
+
+		// Establish the pipeline if necessary.
+		if(new_modals()) {
+			setup_pipeline();
+		}
+
+		// Resize the framebuffer if necessary, starting again from black.
+		if(output_width != output_width_ || output_height != output_height_) {
+			while(is_drawing_to_framebuffer_.test_and_set(std::memory_order_acquire));
+			output_width_ = std::max(output_width, 0);
+			output_height_ = std::max(output_height, 0);
+			framebuffer_.assign(size_t(output_width_) * size_t(output_height_), OpaqueBlack);
+			row_was_painted_.assign(size_t(output_height_), false);
+			painted_rows_are_valid_ = false;
+			is_drawing_to_framebuffer_.clear(std::memory_order_release);
+
+			display_metrics_.announce_did_resize();
+		}
+
+		// Decode and paint all new lines.
+		const size_t new_lines = (area.end.line - area.start.line + LineBufferHeight) % LineBufferHeight;
+		if(new_lines && output_width_ && output_height_ && !write_area_texture_.empty()) {
+			const size_t required_size = new_lines * size_t(output_width_ + 4);
+			if(decoded_pixels_.size() < required_size) {
+				decoded_pixels_.resize(required_size);
+			}
+
+			decode_lines(area, new_lines);
+
+			while(is_drawing_to_framebuffer_.test_and_set(std::memory_order_acquire));
+			paint_lines(new_lines);
+			is_drawing_to_framebuffer_.clear(std::memory_order_release);
+		}
+
+		display_metrics_.announce_draw_status(
+			new_lines,
+			std::chrono::high_resolution_clock::now() - begin_time,
+			true);
+		complete_output_area(area);
+	});
+}
+
+void ScanTarget::draw(uint8_t *target, size_t bytes_per_row) {
+	while(is_drawing_to_framebuffer_.test_and_set(std::memory_order_acquire));
+
+	const size_t row_size = size_t(output_width_) * sizeof(uint32_t);
+	for(size_t y = 0; y < size_t(output_height_); y++) {
+		memcpy(&target[y * bytes_per_row], &framebuffer_[y * size_t(output_width_)], row_size);
+	}
+
+	is_drawing_to_framebuffer_.clear(std::memory_order_release);
+}
+
+int ScanTarget::output_width() const {
+	return output_width_;
+}
+
+int ScanTarget::output_height() const {
+	return output_height_;
+}
+
+size_t ScanTarget::frame_count() const {
+	return frame_count_.load(std::memory_order_relaxed);
+}
+
+// MARK: - Line distribution.
+
+void ScanTarget::decode_lines(const OutputArea &area, size_t count) {
+	work_area_ = &area;
+	work_count_ = count;
+	next_line_.store(0, std::memory_order_relaxed);
+
+	// Don't bother waking the workers for fewer lines than would give each of two threads a batch.
+	if(workers_.empty() || count < LinesPerBatch * 2) {
+		perform_work(scratch_[0]);
+		return;
+	}
+
+	{
+		std::lock_guard lock(work_mutex_);
+		++work_generation_;
+		workers_outstanding_ = workers_.size();
+	}
+	work_condition_.notify_all();
+
+	perform_work(scratch_[0]);
+
+	std::unique_lock lock(work_mutex_);
+	completion_condition_.wait(lock, [this] { return !workers_outstanding_; });
+}
+
+void ScanTarget::perform_work(Scratch &scratch) {
+	while(true) {
+		const size_t start = next_line_.fetch_add(LinesPerBatch, std::memory_order_relaxed);
+		if(start >= work_count_) return;
+
+		const size_t end = std::min(start + LinesPerBatch, work_count_);
+		for(size_t index = start; index < end; index++) {
+			decode_line(index, *work_area_, scratch);
+		}
+	}
+}
+
+void ScanTarget::paint_lines(size_t count) {
+	const size_t width = size_t(output_width_);
+	const size_t stride = width + 4;
+
+	for(size_t index = 0; index < count; index++) {
+		const DecodedLine &line = decoded_lines_[index];
+
+		// At the start of each frame, clear any rows that were untouched by the previous one,
+		// provided that the previous frame was output in full.
+		if(line.is_first_in_frame) {
+			if(painted_rows_are_valid_ && line.previous_frame_was_complete) {
+				for(size_t row = 0; row < row_was_painted_.size(); row++) {
+					if(!row_was_painted_[row]) {
+						std::fill_n(&framebuffer_[row * width], width, OpaqueBlack);
+					}
+				}
+			}
+			painted_rows_are_valid_ = true;
+			std::fill(row_was_painted_.begin(), row_was_painted_.end(), false);
+			frame_count_.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		if(line.left >= line.right) continue;
+
+		const uint32_t *const source = &decoded_pixels_[index * stride];
+		const size_t length = size_t(line.right - line.left) * sizeof(uint32_t);
+		for(int row = line.top; row < line.bottom; row++) {
+			memcpy(&framebuffer_[size_t(row) * width + size_t(line.left)], source, length);
+			row_was_painted_[size_t(row)] = true;
+		}
+	}
+}
+
+// MARK: - Line decoding.
+
+void ScanTarget::decode_line(size_t index, const OutputArea &area, Scratch &scratch) {
+	const size_t line_index = (area.start.line + index) % LineBufferHeight;
+	const Line &line = line_buffer_[line_index];
+	const LineMetadata &metadata = line_metadata_buffer_[line_index];
+
+	DecodedLine &decoded = decoded_lines_[index];
+	decoded.is_first_in_frame = metadata.is_first_in_frame;
+	decoded.previous_frame_was_complete = metadata.previous_frame_was_complete;
+	decoded.left = decoded.right = 0;
+
+	// Determine the output area covered by this line; lines are painted as horizontal
+	// strips one row-height high, centred on the line's average y.
+	const float width = float(output_width_);
+	const float height = float(output_height_);
+	const float x0 = float(line.end_points[0].x) * pipeline_.x_scale - pipeline_.origin_x;
+	const float x1 = float(line.end_points[1].x) * pipeline_.x_scale - pipeline_.origin_x;
+	const float y = (float(line.end_points[0].y) + float(line.end_points[1].y)) * 0.5f * pipeline_.y_scale - pipeline_.origin_y;
+	if(x1 <= x0) return;
+
+	const int left = std::max(int(std::ceil(x0 * width - 0.5f)), 0);
+	const int right = std::min(int(std::ceil(x1 * width - 0.5f)), output_width_);
+	int top = int(std::ceil((y - pipeline_.row_height * 0.5f) * height - 0.5f));
+	int bottom = int(std::ceil((y + pipeline_.row_height * 0.5f) * height - 0.5f));
+	if(bottom <= top) {
+		top = int(std::floor(y * height));
+		bottom = top + 1;
+	}
+	top = std::max(top, 0);
+	bottom = std::min(bottom, output_height_);
+	if(left >= right || top >= bottom) return;
+
+	const int start_clock = line.end_points[0].cycles_since_end_of_horizontal_retrace;
+	const int end_clock = std::min(int(line.end_points[1].cycles_since_end_of_horizontal_retrace), LineBufferWidth);
+	if(end_clock <= start_clock) return;
+
+	//
+	// Compose: paste the scans that fall on this line into a single run of RGBA, by clock.
+	//
+	auto &composed = scratch.composed;
+	std::fill(&composed[size_t(start_clock)], &composed[size_t(end_clock)], pipeline_.composed_black);
+
+	const size_t data_type_size = pipeline_.data_type_size;
+	const size_t end_scan =
+		(index + 1 < work_count_) ? line_metadata_buffer_[(line_index + 1) % LineBufferHeight].first_scan : area.end.scan;
+	for(size_t scan_index = metadata.first_scan; scan_index != end_scan; scan_index = (scan_index + 1) % scan_buffer_.size()) {
+		const Scan &scan = scan_buffer_[scan_index];
+		const int scan_start = scan.scan.end_points[0].cycles_since_end_of_horizontal_retrace;
+		const int scan_end = scan.scan.end_points[1].cycles_since_end_of_horizontal_retrace;
+		if(scan_end <= scan_start) continue;
+
+		const int first = std::max(scan_start, start_clock);
+		const int last = std::min(scan_end, end_clock);
+		if(last <= first) continue;
+
+		// Step through source data in 16.16 fixed point, sampling at the centre of each clock.
+		const int data_start = scan.scan.end_points[0].data_offset;
+		const int data_end = scan.scan.end_points[1].data_offset;
+		const int64_t step = (int64_t(data_end - data_start) << 16) / (scan_end - scan_start);
+		int64_t position = (int64_t(data_start) << 16) + step / 2 + step * (first - scan_start);
+
+		const uint8_t *const row = &write_area_texture_[size_t(scan.data_y) * WriteAreaWidth * data_type_size];
+		uint32_t *const target = &composed[size_t(first)];
+		const int length = last - first;
+
+		switch(data_type_size) {
+			case 1: {
+				const uint32_t *const table = pipeline_.composition_table.data();
+				for(int c = 0; c < length; c++) {
+					target[c] = table[row[position >> 16]];
+					position += step;
+				}
+			} break;
+
+			case 2:
+				if(pipeline_.composition_table.empty()) {
+					for(int c = 0; c < length; c++) {
+						const uint8_t *const source = &row[(position >> 16) * 2];
+						target[c] = uint32_t(source[0] | (source[1] << 8));
+						position += step;
+					}
+				} else {
+					const uint32_t *const table = pipeline_.composition_table.data();
+					for(int c = 0; c < length; c++) {
+						const uint8_t *const source = &row[(position >> 16) * 2];
+						target[c] = table[((source[0] & 0xf) << 8) | source[1]];
+						position += step;
+					}
+				}
+			break;
+
+			case 4:
+				for(int c = 0; c < length; c++) {
+					const uint8_t *const source = &row[(position >> 16) * 4];
+					target[c] = uint32_t(source[0] | (source[1] << 8) | (source[2] << 16) | (source[3] << 24));
+					position += step;
+				}
+			break;
+		}
+	}
+
+	//
+	// Sample: produce three planes of decoded colour.
+	//
+	constexpr int Padding = Scratch::Padding;
+	float *const planes[3] = {
+		&scratch.planes[0][Padding],
+		&scratch.planes[1][Padding],
+		&scratch.planes[2][Padding],
+	};
+	int samples;
+
+	if(pipeline_.display_type == DisplayType::RGB) {
+		// RGB output needs no decoding; just sample once per clock.
+		samples = end_clock - start_clock;
+		constexpr float Scale = 1.0f / 255.0f;
+		for(int c = 0; c < samples; c++) {
+			const uint32_t colour = composed[size_t(start_clock + c)];
+			planes[0][c] = float(colour & 0xff) * Scale;
+			planes[1][c] = float((colour >> 8) & 0xff) * Scale;
+			planes[2][c] = float((colour >> 16) & 0xff) * Scale;
+		}
+	} else {
+		// Sample four times per colour cycle, so that the subcarrier is in exact quadrature
+		// across consecutive samples. Angles are measured in cycles.
+		const float start_angle = float(line.end_points[0].composite_angle) / 64.0f;
+		const float end_angle = float(line.end_points[1].composite_angle) / 64.0f;
+		const int quarter_cycles = int(std::round(std::fabs(end_angle - start_angle) * 4.0f));
+		samples = (quarter_cycles > 0) ? std::min(quarter_cycles, LineBufferWidth) : (end_clock - start_clock);
+
+		// Establish subcarrier values by recurrence.
+		float *const cos = &scratch.cos[Padding];
+		float *const sin = &scratch.sin[Padding];
+		{
+			const double step = 2.0 * 3.141592653589793 * double(end_angle - start_angle) / double(samples);
+			const double step_cos = std::cos(step), step_sin = std::sin(step);
+			double angle_cos = std::cos(2.0 * 3.141592653589793 * double(start_angle) + step * 0.5);
+			double angle_sin = std::sin(2.0 * 3.141592653589793 * double(start_angle) + step * 0.5);
+			for(int c = 0; c < samples; c++) {
+				cos[c] = float(angle_cos);
+				sin[c] = float(angle_sin);
+
+				const double next_cos = angle_cos * step_cos - angle_sin * step_sin;
+				angle_sin = angle_sin * step_cos + angle_cos * step_sin;
+				angle_cos = next_cos;
+			}
+		}
+
+		// Sample the input, producing either a composite signal or separate luminance and chrominance.
+		const bool is_svideo = pipeline_.display_type == DisplayType::SVideo;
+		const float amplitude = float(line.composite_amplitude) / 255.0f;
+		float *const signal = &scratch.signal[Padding];
+		float *const chroma = &scratch.chroma[Padding];
+		const float clocks_per_sample = float(end_clock - start_clock) / float(samples);
+		const float angle_per_sample = (end_angle - start_angle) / float(samples);
+		constexpr float Scale = 1.0f / 255.0f;
+
+		// Luminance goes to signal and chrominance to chroma in the first instance.
+		const auto input = [&](int c) {
+			return composed[size_t(start_clock + int((float(c) + 0.5f) * clocks_per_sample))];
+		};
+		switch(pipeline_.input_data_type) {
+			case InputDataType::Luminance1:
+			case InputDataType::Luminance8:
+				for(int c = 0; c < samples; c++) {
+					signal[c] = float(input(c) & 0xff) * Scale;
+				}
+				std::fill_n(chroma, samples, 0.0f);
+			break;
+
+			case InputDataType::PhaseLinkedLuminance8:
+				// Select the byte that corresponds to the current quarter of the colour cycle.
+				for(int c = 0; c < samples; c++) {
+					const float angle = start_angle + (float(c) + 0.5f) * angle_per_sample;
+					int quarter = int(std::floor((std::fabs(angle) + pipeline_.phase_offset) * 4.0f)) & 3;
+					if(angle < 0.0f) quarter ^= 3;
+
+					signal[c] = float((input(c) >> (quarter * 8)) & 0xff) * Scale;
+				}
+				std::fill_n(chroma, samples, 0.0f);
+			break;
+
+			case InputDataType::Luminance8Phase8:
+				for(int c = 0; c < samples; c++) {
+					const uint32_t value = input(c);
+					const size_t phase = (value >> 8) & 0xff;
+					signal[c] = float(value & 0xff) * Scale;
+					chroma[c] = cos[c] * pipeline_.phase_cos[phase] - sin[c] * pipeline_.phase_sin[phase];
+				}
+			break;
+
+			default: {
+				const auto &matrix = pipeline_.from_rgb;
+				for(int c = 0; c < samples; c++) {
+					const uint32_t value = input(c);
+					const float red = float(value & 0xff) * Scale;
+					const float green = float((value >> 8) & 0xff) * Scale;
+					const float blue = float((value >> 16) & 0xff) * Scale;
+					signal[c] = matrix[0] * red + matrix[3] * green + matrix[6] * blue;
+					chroma[c] =
+						cos[c] * (matrix[1] * red + matrix[4] * green + matrix[7] * blue) +
+						sin[c] * (matrix[2] * red + matrix[5] * green + matrix[8] * blue);
+				}
+			} break;
+		}
+
+		// For composite output, mix luminance and chrominance according to the colour burst amplitude.
+		if(!is_svideo) {
+			const auto mix = Float4::all(amplitude);
+			for(int c = 0; c < samples; c += 4) {
+				const auto luminance = Float4::load(&signal[c]);
+				(luminance + (Float4::load(&chroma[c]) - luminance) * mix).store(&signal[c]);
+			}
+		}
+
+		// Zero the padding, so that filters see black beyond the ends of the line.
+		std::fill_n(&scratch.signal[0], Padding, 0.0f);
+		std::fill_n(&signal[samples], Padding, 0.0f);
+		std::fill_n(&scratch.chroma[0], Padding, 0.0f);
+		std::fill_n(&chroma[samples], Padding, 0.0f);
+
+		// Separate luminance and chrominance if necessary, then demodulate chrominance
+		// by multiplying by the subcarrier and lowpass filtering.
+		const bool has_colour =
+			is_svideo ||
+			(pipeline_.display_type == DisplayType::CompositeColour && line.composite_amplitude > 2);
+		if(has_colour) {
+			float *const raw_u = &scratch.raw_u[Padding];
+			float *const raw_v = &scratch.raw_v[Padding];
+
+			if(is_svideo) {
+				std::copy(signal, signal + samples, planes[0]);
+
+				const auto two = Float4::all(2.0f);
+				for(int c = 0; c < samples; c += 4) {
+					const auto modulated = Float4::load(&chroma[c]) * two;
+					(modulated * Float4::load(&cos[c])).store(&raw_u[c]);
+					(modulated * Float4::load(&sin[c])).store(&raw_v[c]);
+				}
+			} else {
+				// A one-cycle box filter removes the subcarrier entirely, leaving luminance.
+				box_filter(signal, planes[0], samples);
+
+				const auto chroma_scale = Float4::all(2.0f / amplitude);
+				const auto luma_scale = Float4::all(1.0f / std::max(1.0f - amplitude, 0.05f));
+				for(int c = 0; c < samples; c += 4) {
+					const auto luminance = Float4::load(&planes[0][c]);
+					const auto modulated = (Float4::load(&signal[c]) - luminance) * chroma_scale;
+					(modulated * Float4::load(&cos[c])).store(&raw_u[c]);
+					(modulated * Float4::load(&sin[c])).store(&raw_v[c]);
+					(luminance * luma_scale).store(&planes[0][c]);
+				}
+			}
+
+			std::fill_n(&scratch.raw_u[0], Padding, 0.0f);
+			std::fill_n(&raw_u[samples], Padding, 0.0f);
+			std::fill_n(&scratch.raw_v[0], Padding, 0.0f);
+			std::fill_n(&raw_v[samples], Padding, 0.0f);
+
+			box_filter(raw_u, planes[1], samples);
+			box_filter(raw_v, planes[2], samples);
+		} else {
+			if(pipeline_.display_type == DisplayType::CompositeColour) {
+				box_filter(signal, planes[0], samples);
+			} else {
+				std::copy(signal, signal + samples, planes[0]);
+			}
+			std::fill_n(planes[1], samples, 0.0f);
+			std::fill_n(planes[2], samples, 0.0f);
+		}
+	}
+
+	//
+	// Resample: average the samples that fall within each output pixel.
+	//
+	const int pixels = right - left;
+	const size_t rounded_pixels = size_t((pixels + 3) & ~3);
+	for(int c = 0; c < 3; c++) {
+		if(scratch.output[c].size() < rounded_pixels) {
+			scratch.output[c].resize(rounded_pixels);
+			scratch.rounded[c].resize(rounded_pixels);
+		}
+	}
+
+	const float samples_per_unit = float(samples) / (x1 - x0);
+	const float samples_per_pixel = samples_per_unit / width;
+	const float final_sample = float(samples);
+	float sample_start = (float(left) / width - x0) * samples_per_unit;
+	for(int pixel = 0; pixel < pixels; pixel++) {
+		const float sample_end = sample_start + samples_per_pixel;
+		const float low = std::clamp(sample_start, 0.0f, final_sample);
+		const float high = std::clamp(sample_end, 0.0f, final_sample);
+		sample_start = sample_end;
+
+		const int first = std::min(int(low), samples - 1);
+		const int last = std::min(int(std::ceil(high)) - 1, samples - 1);
+		if(last <= first) {
+			// Entirely within one sample: this is the usual case when upscaling.
+			for(int p = 0; p < 3; p++) {
+				scratch.output[p][size_t(pixel)] = planes[p][first];
+			}
+			continue;
+		}
+
+		// Otherwise, integrate: partial first sample, whole middle samples, partial last sample.
+		const float first_weight = float(first + 1) - low;
+		const float last_weight = high - float(last);
+		const float scale = 1.0f / (high - low);
+		for(int p = 0; p < 3; p++) {
+			float total = planes[p][first] * first_weight + planes[p][last] * last_weight;
+			for(int s = first + 1; s < last; s++) {
+				total += planes[p][s];
+			}
+			scratch.output[p][size_t(pixel)] = total * scale;
+		}
+	}
+
+	//
+	// Convert: apply the colour matrix, clamp and pack.
+	//
+	const auto &matrix = pipeline_.to_rgb;
+	const Float4 m[9] = {
+		Float4::all(matrix[0]), Float4::all(matrix[1]), Float4::all(matrix[2]),
+		Float4::all(matrix[3]), Float4::all(matrix[4]), Float4::all(matrix[5]),
+		Float4::all(matrix[6]), Float4::all(matrix[7]), Float4::all(matrix[8]),
+	};
+	const auto zero = Float4::all(0.0f);
+	uint32_t *const target = &decoded_pixels_[index * size_t(output_width_ + 4)];
+
+	if(pipeline_.gamma_table.empty()) {
+		const auto maximum = Float4::all(255.0f);
+		for(size_t c = 0; c < rounded_pixels; c += 4) {
+			const auto a = Float4::load(&scratch.output[0][c]) * maximum;
+			const auto b = Float4::load(&scratch.output[1][c]) * maximum;
+			const auto d = Float4::load(&scratch.output[2][c]) * maximum;
+			Float4::store_pixels(
+				&target[c],
+				(m[0] * a + m[3] * b + m[6] * d).clamp(zero, maximum),
+				(m[1] * a + m[4] * b + m[7] * d).clamp(zero, maximum),
+				(m[2] * a + m[5] * b + m[8] * d).clamp(zero, maximum));
+		}
+	} else {
+		const auto maximum = Float4::all(1023.0f);
+		for(size_t c = 0; c < rounded_pixels; c += 4) {
+			const auto a = Float4::load(&scratch.output[0][c]) * maximum;
+			const auto b = Float4::load(&scratch.output[1][c]) * maximum;
+			const auto d = Float4::load(&scratch.output[2][c]) * maximum;
+			(m[0] * a + m[3] * b + m[6] * d).clamp(zero, maximum).store_rounded(&scratch.rounded[0][c]);
+			(m[1] * a + m[4] * b + m[7] * d).clamp(zero, maximum).store_rounded(&scratch.rounded[1][c]);
+			(m[2] * a + m[5] * b + m[8] * d).clamp(zero, maximum).store_rounded(&scratch.rounded[2][c]);
+		}
+
+		const uint8_t *const gamma = pipeline_.gamma_table.data();
+		for(size_t c = 0; c < size_t(pixels); c++) {
+			target[c] =
+				uint32_t(gamma[scratch.rounded[0][c]]) |
+				(uint32_t(gamma[scratch.rounded[1][c]]) << 8) |
+				(uint32_t(gamma[scratch.rounded[2][c]]) << 16) |
+				OpaqueBlack;
+		}
+	}
+
+	decoded.left = left;
+	decoded.right = right;
+	decoded.top = top;
+	decoded.bottom = bottom;
+}
@@ -0,0 +1,160 @@
+//
+//  ScanTarget.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 16/10/2026.
+//  Copyright 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef Software_ScanTarget_hpp
+#define Software_ScanTarget_hpp
+
+#include "../ScanTargets/BufferingScanTarget.hpp"
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Outputs {
+namespace Display {
+namespace Software {
+
+/*!
+	Provides a ScanTarget that renders entirely on the CPU, into an RGBA framebuffer in memory.
+
+	It consumes the same Scan and Line buffers as the OpenGL scan target and produces broadly the same
+	output: RGB input is resampled directly; composite and S-Video input is sampled four times per colour
+	cycle, then separated and demodulated with a one-cycle box filter. Lines are decoded in parallel across
+	a pool of worker threads and then copied to the framebuffer in order.
+
+	No GPU context is required, so this is suitable for headless use, screenshots and feeding video encoders.
+*/
+class ScanTarget: public Outputs::Display::BufferingScanTarget {
+	public:
+		/// Constructs a ScanTarget that will use @c thread_count threads, including the
+		/// caller's, for line decoding; @c 0 means one per available core.
+		ScanTarget(float output_gamma = 2.2f, size_t thread_count = 0);
+		~ScanTarget();
+
+		/*! Processes all the latest input into a framebuffer of the specified size. */
+		void update(int output_width, int output_height);
+
+		/*!
+			Copies the current framebuffer to @c target as RGBA data in raster order, with @c bytes_per_row
+			bytes between the start of each row. @c target must have room for output_height() rows.
+
+			This may be called from any thread.
+		*/
+		void draw(uint8_t *target, size_t bytes_per_row);
+
+		/// @returns The width of the framebuffer, as of the most recent call to @c update.
+		int output_width() const;
+		/// @returns The height of the framebuffer, as of the most recent call to @c update.
+		int output_height() const;
+
+		/// @returns The number of frames that have started since construction; a frame starts upon
+		/// the first visible line after vertical retrace.
+		size_t frame_count() const;
+
+	private:
+		static constexpr int LineBufferWidth = 2048;
+		static constexpr int LineBufferHeight = 2048;
+
+		const float output_gamma_;
+
+		// Storage for the various buffers.
+		std::vector<uint8_t> write_area_texture_;
+		std::array<Scan, LineBufferHeight*5> scan_buffer_;
+		std::array<Line, LineBufferHeight> line_buffer_;
+		std::array<LineMetadata, LineBufferHeight> line_metadata_buffer_;
+
+		// The framebuffer, plus a record of which of its rows have been painted in the current
+		// frame so that rows that go unpainted can be cleared at the start of the next.
+		std::vector<uint32_t> framebuffer_;
+		std::vector<bool> row_was_painted_;
+		int output_width_ = 0, output_height_ = 0;
+		bool painted_rows_are_valid_ = false;
+		std::atomic<size_t> frame_count_ = 0;
+		std::atomic_flag is_drawing_to_framebuffer_;
+
+		/// Receives scan target modals.
+		void setup_pipeline();
+
+		// Decoding state derived from the modals.
+		struct Pipeline {
+			DisplayType display_type = DisplayType::RGB;
+			InputDataType input_data_type = InputDataType::Red8Green8Blue8;
+			size_t data_type_size = 4;
+
+			/// Maps one- or two-byte input to composed RGBA; empty for other input types.
+			std::vector<uint32_t> composition_table;
+			/// The composed value that describes black for the current input type.
+			uint32_t composed_black = 0;
+
+			/// Cosine and sine of the phase offsets described by Luminance8Phase8 data; both
+			/// are zero for those phases that disable the colour subcarrier.
+			std::array<float, 256> phase_cos, phase_sin;
+
+			/// Converts from the decoded triple to RGB, column-major, with brightness applied.
+			std::array<float, 9> to_rgb;
+			/// Converts from RGB to luminance plus two chrominance channels, column-major.
+			std::array<float, 9> from_rgb;
+
+			/// Maps from ten-bit linear output to eight-bit gamma-corrected output; empty if no
+			/// gamma correction is required.
+			std::vector<uint8_t> gamma_table;
+
+			float phase_offset = 0.0f;
+			float row_height = 0.0f;
+
+			// Mapping from Line coordinates to [0, 1).
+			float x_scale = 0.0f, y_scale = 0.0f;
+			float origin_x = 0.0f, origin_y = 0.0f;
+		} pipeline_;
+
+		// Lines are decoded in parallel into rows of output_width_ pixels, then
+		// copied to the framebuffer serially.
+		struct DecodedLine {
+			int left = 0, right = 0;
+			int top = 0, bottom = 0;
+			bool is_first_in_frame = false;
+			bool previous_frame_was_complete = false;
+		};
+		std::vector<DecodedLine> decoded_lines_;
+		std::vector<uint32_t> decoded_pixels_;
+
+		/// Per-thread working space for line decoding.
+		struct Scratch;
+		std::vector<Scratch> scratch_;
+
+		void decode_line(size_t index, const OutputArea &area, Scratch &scratch);
+		void decode_lines(const OutputArea &area, size_t count);
+		void paint_lines(size_t count);
+
+		// The worker pool; workers each claim batches of lines from next_line_ until
+		// all are exhausted, then report completion.
+		std::vector<std::thread> workers_;
+		std::mutex work_mutex_;
+		std::condition_variable work_condition_, completion_condition_;
+		size_t work_generation_ = 0;
+		size_t workers_outstanding_ = 0;
+		bool workers_should_quit_ = false;
+
+		const OutputArea *work_area_ = nullptr;
+		size_t work_count_ = 0;
+		std::atomic<size_t> next_line_ = 0;
+
+		void perform_work(Scratch &scratch);
+		static constexpr size_t LinesPerBatch = 16;
+};
+
+}
+}
+}
+
+#endif /* Software_ScanTarget_hpp */
@@ -0,0 +1,317 @@
+//
+//  BLEPSpeaker.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 16/10/2026.
+//  Copyright 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef BLEPSpeaker_hpp
+#define BLEPSpeaker_hpp
+
+#include "../Speaker.hpp"
+#include "../../../ClockReceiver/ClockReceiver.hpp"
+#include "../../../Activity/Profiler.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+namespace Outputs {
+namespace Speaker {
+
+/*!
+	The BLEP speaker expects an Outputs::Speaker::StepSource-derived template class, and
+	uses the instance supplied to its constructor as a source of level changes.
+
+	Each change is rendered directly at the output rate as a band-limited step, i.e. a
+	windowed-sinc impulse that is subsequently integrated, so the cost of audio is proportional
+	to the number of level changes plus the number of output samples, rather than to the
+	input clock rate as per PullLowpass.
+
+	Stereo sources announce a pair of levels with each step; each channel is then integrated separately.
+*/
+template <typename StepSource> class PullBLEP: public Speaker {
+	static constexpr bool is_stereo = StepSource::get_is_stereo();
+	static constexpr size_t Channels = is_stereo ? 2 : 1;
+
+	public:
+		PullBLEP(StepSource &step_source) : step_source_(step_source) {
+			// Propagate an initial volume level.
+			step_source.set_sample_volume_range(32767);
+		}
+
+		/*!
+			Sets the clock rate of the input audio.
+		*/
+		void set_input_rate(float cycles_per_second) {
+			std::lock_guard lock_guard(parameters_mutex_);
+			if(parameters_.input_cycles_per_second == cycles_per_second) {
+				return;
+			}
+			parameters_.input_cycles_per_second = cycles_per_second;
+			parameters_.parameters_are_dirty = true;
+			parameters_.input_rate_changed = true;
+		}
+
+		/*!
+			As per LowpassBase::set_high_frequency_cutoff; steps will be band-limited to
+			the lower of this and a little under half the output rate.
+		*/
+		void set_high_frequency_cutoff(float high_frequency) {
+			std::lock_guard lock_guard(parameters_mutex_);
+			if(parameters_.high_frequency_cutoff == high_frequency) {
+				return;
+			}
+			parameters_.high_frequency_cutoff = high_frequency;
+			parameters_.parameters_are_dirty = true;
+		}
+
+		void set_output_volume(float volume) final {
+			// Clamp to the acceptable range, and set.
+			volume = std::clamp(volume, 0.0f, 1.0f);
+			step_source_.set_sample_volume_range(int16_t(32767.0f * volume));
+		}
+
+		bool get_is_stereo() final {
+			return is_stereo;
+		}
+
+		/*!
+			Schedules an advancement by the number of cycles specified on the provided queue,
+			which may be any of the AsyncTaskQueue-compatible queues in Concurrency.
+		*/
+		template <typename QueueT> void run_for(QueueT &queue, const Cycles cycles) {
+			if(cycles == Cycles(0)) {
+				return;
+			}
+
+			queue.enqueue([this, cycles] {
+				run_for(cycles);
+			});
+		}
+
+		/*!
+			Announces that the source's output level is @c level from @c offset cycles into
+			the current call to its @c get_steps. For use by a mono step source only.
+		*/
+		void step(std::size_t offset, int16_t level) {
+			static_assert(!is_stereo, "Stereo sources must announce both levels");
+			if(level == levels_[0]) return;
+			add_step(step_position_ + double(offset) * samples_per_cycle_, 0, level);
+		}
+
+		/*!
+			Announces that the source's output levels are @c left and @c right from @c offset cycles
+			into the current call to its @c get_steps. For use by a stereo step source only.
+		*/
+		void step(std::size_t offset, int16_t left, int16_t right) {
+			static_assert(is_stereo, "Mono sources must announce a single level");
+			if(left == levels_[0] && right == levels_[1]) return;
+
+			const double position = step_position_ + double(offset) * samples_per_cycle_;
+			if(left != levels_[0]) add_step(position, 0, left);
+			if(right != levels_[1]) add_step(position, 1, right);
+		}
+
+	private:
+		StepSource &step_source_;
+
+		float get_ideal_clock_rate_in_range(float, float maximum) final {
+			// Cost is largely independent of the output rate, so prefer the highest available.
+			return maximum;
+		}
+
+		void set_computed_output_rate(float cycles_per_second, int buffer_size, bool) final {
+			std::lock_guard lock_guard(parameters_mutex_);
+			if(parameters_.output_cycles_per_second == cycles_per_second && size_t(buffer_size) == parameters_.buffer_size) {
+				return;
+			}
+			parameters_.output_cycles_per_second = cycles_per_second;
+			parameters_.buffer_size = size_t(buffer_size);
+			parameters_.parameters_are_dirty = true;
+		}
+
+		std::mutex parameters_mutex_;
+		struct Parameters {
+			float input_cycles_per_second = 0.0f;
+			float output_cycles_per_second = 0.0f;
+			float high_frequency_cutoff = -1.0f;
+			size_t buffer_size = 0;
+
+			bool parameters_are_dirty = true;
+			bool input_rate_changed = false;
+		} parameters_;
+
+		// MARK: - Synthesis.
+
+		/// Kernels are stored for this many fractional output sample positions.
+		static constexpr size_t NumberOfPhases = 32;
+
+		/// Each kernel sums to exactly 1 << KernelShift, so that every step settles at exactly its new level.
+		static constexpr int KernelShift = 15;
+
+		/// The number of output samples that may be accumulated before being posted.
+		static constexpr size_t MaximumChunk = 256;
+
+		std::vector<int32_t> kernel_;
+		size_t kernel_width_ = 0;
+
+		double samples_per_cycle_ = 0.0;
+		double position_ = 0.0;			// Current position within the accumulator, in output samples.
+		double step_position_ = 0.0;	// Position at which the current call to get_steps began.
+
+		/// Pending kernel output, interleaved by channel.
+		std::vector<int64_t> accumulator_;
+		int64_t integrators_[Channels]{};
+		int16_t levels_[Channels]{};
+
+		std::vector<int16_t> output_buffer_;
+		size_t output_buffer_pointer_ = 0;
+
+		void update_kernels(const Parameters &parameters) {
+			samples_per_cycle_ = double(parameters.output_cycles_per_second) / double(parameters.input_cycles_per_second);
+			if(output_buffer_.size() != parameters.buffer_size * Channels) {
+				output_buffer_.resize(parameters.buffer_size * Channels);
+				output_buffer_pointer_ = 0;
+			}
+
+			// Pick a cut-off, as a proportion of the output rate, and a kernel width sufficient
+			// to include a couple of lobes either side of the centre.
+			double cutoff = 0.45;
+			if(parameters.high_frequency_cutoff > 0.0f) {
+				cutoff = std::min(cutoff, double(parameters.high_frequency_cutoff) / double(parameters.output_cycles_per_second));
+			}
+			kernel_width_ = std::max(size_t(16), 2 * size_t(std::ceil(2.0 / cutoff)));
+
+			// Build a Blackman-windowed sinc for each phase, delayed by half the kernel width so as to
+			// be causal, and normalise each so that it sums exactly to 1 << KernelShift.
+			kernel_.resize(NumberOfPhases * kernel_width_);
+			std::vector<double> taps(kernel_width_);
+			const double half_width = double(kernel_width_) / 2.0;
+			for(size_t phase = 0; phase < NumberOfPhases; phase++) {
+				double sum = 0.0;
+				for(size_t c = 0; c < kernel_width_; c++) {
+					const double x = double(c) - half_width - double(phase) / double(NumberOfPhases);
+					const double u = x / half_width;
+					if(std::abs(u) >= 1.0) {
+						taps[c] = 0.0;
+						continue;
+					}
+
+					const double window = 0.42 + 0.5 * std::cos(M_PI * u) + 0.08 * std::cos(2.0 * M_PI * u);
+					const double sinc = x == 0.0 ? 1.0 : std::sin(2.0 * M_PI * cutoff * x) / (2.0 * M_PI * cutoff * x);
+					taps[c] = sinc * window;
+					sum += taps[c];
+				}
+
+				int32_t *const kernel = &kernel_[phase * kernel_width_];
+				int32_t total = 0;
+				size_t largest = 0;
+				for(size_t c = 0; c < kernel_width_; c++) {
+					kernel[c] = int32_t(std::round(taps[c] * double(1 << KernelShift) / sum));
+					total += kernel[c];
+					if(kernel[c] > kernel[largest]) largest = c;
+				}
+				kernel[largest] += (1 << KernelShift) - total;
+			}
+
+			// Retain anything already accumulated.
+			accumulator_.resize((MaximumChunk + kernel_width_ + size_t(std::ceil(samples_per_cycle_)) + 1) * Channels);
+		}
+
+		bool recalculate_kernels_if_dirty() {
+			Parameters parameters;
+			{
+				std::lock_guard lock_guard(parameters_mutex_);
+				parameters = parameters_;
+				parameters_.parameters_are_dirty = false;
+				parameters_.input_rate_changed = false;
+			}
+			if(parameters.parameters_are_dirty) update_kernels(parameters);
+			return parameters.input_rate_changed;
+		}
+
+		/// Adds a band-limited step to @c level on @c channel at @c position, in output samples.
+		void add_step(double position, size_t channel, int16_t level) {
+			const int delta = level - levels_[channel];
+			levels_[channel] = level;
+
+			const auto index = size_t(position);
+			const auto phase = size_t((position - double(index)) * double(NumberOfPhases));
+			assert((index + kernel_width_) * Channels <= accumulator_.size());
+
+			const int32_t *const kernel = &kernel_[phase * kernel_width_];
+			int64_t *const target = &accumulator_[index * Channels + channel];
+			for(size_t c = 0; c < kernel_width_; c++) {
+				target[c * Channels] += int64_t(delta) * kernel[c];
+			}
+		}
+
+		/// Integrates and posts the first @c count samples of the accumulator, then shifts the remainder down.
+		void output(size_t count, int scale) {
+			for(size_t c = 0; c < count; c++) {
+				for(size_t channel = 0; channel < Channels; channel++) {
+					integrators_[channel] += accumulator_[c * Channels + channel];
+
+					int sample = int(integrators_[channel] >> KernelShift);
+					if(scale != 65536) sample = (sample * scale) >> 16;
+					output_buffer_[output_buffer_pointer_ + channel] = int16_t(std::clamp(sample, -32768, 32767));
+				}
+
+				// Announce to delegate if full.
+				output_buffer_pointer_ += Channels;
+				if(output_buffer_pointer_ == output_buffer_.size()) {
+					output_buffer_pointer_ = 0;
+					did_complete_samples(this, output_buffer_, is_stereo);
+				}
+			}
+
+			const size_t consumed = count * Channels;
+			std::memmove(accumulator_.data(), &accumulator_[consumed], sizeof(int64_t) * (accumulator_.size() - consumed));
+			std::fill(accumulator_.end() - ptrdiff_t(consumed), accumulator_.end(), 0);
+			position_ -= double(count);
+		}
+
+		/*!
+			Advances by the number of cycles specified, obtaining level changes from the step source
+			supplied at construction and passing output on to the speaker's delegate if there is one.
+		*/
+		void run_for(const Cycles cycles) {
+			const auto delegate = delegate_.load(std::memory_order::memory_order_relaxed);
+			if(!delegate) return;
+
+			auto length = size_t(cycles.as_integral());
+			PROFILE_SCOPE("Speaker", uint64_t(length));
+
+			if(recalculate_kernels_if_dirty()) {
+				delegate->speaker_did_change_input_clock(this);
+			}
+			if(output_buffer_.empty()) return;
+
+			const int scale = int(65536.0 / step_source_.get_average_output_peak());
+			while(length) {
+				// Limit each call to the source so that all steps fall within the accumulator.
+				const auto cycles_to_read = std::clamp(size_t((double(MaximumChunk) - position_) / samples_per_cycle_), size_t(1), length);
+
+				step_position_ = position_;
+				{
+					PROFILE_TYPE_SCOPE("Audio source", StepSource, uint64_t(cycles_to_read));
+					step_source_.get_steps(cycles_to_read, *this);
+				}
+				position_ += double(cycles_to_read) * samples_per_cycle_;
+
+				// Samples before the current position can no longer be affected by future steps.
+				output(size_t(position_), scale);
+				length -= cycles_to_read;
+			}
+		}
+};
+
+}
+}
+
+#endif /* BLEPSpeaker_hpp */
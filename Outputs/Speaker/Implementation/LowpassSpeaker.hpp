@@ -13,6 +13,7 @@
 #include "../../../SignalProcessing/FIRFilter.hpp"
 #include "../../../ClockReceiver/ClockReceiver.hpp"
 #include "../../../Concurrency/AsyncTaskQueue.hpp"
+#include "../../../Activity/Profiler.hpp"
 
 #include <algorithm>
 #include <cassert>
@@ -97,7 +98,11 @@ template <typename ConcreteT, bool is_stereo> class LowpassBase: public Speaker
 
 		float step_rate_ = 0.0f;
 		float position_error_ = 0.0f;
-		std::unique_ptr<SignalProcessing::FIRFilter> filter_;
+
+		/// The filters in use; if resampling by a non-integral ratio then this is a polyphase bank,
+		/// indexed by the fractional part of the current input position. Otherwise it contains a single filter.
+		std::vector<SignalProcessing::FIRFilter> filters_;
+		static constexpr std::size_t NumberOfPhases = 16;
 
 		std::mutex filter_parameters_mutex_;
 		struct FilterParameters {
@@ -124,12 +129,23 @@ template <typename ConcreteT, bool is_stereo> class LowpassBase: public Speaker
 			step_rate_ = filter_parameters.input_cycles_per_second / filter_parameters.output_cycles_per_second;
 			position_error_ = 0.0f;
 
-			filter_ = std::make_unique<SignalProcessing::FIRFilter>(
-				unsigned(number_of_taps),
-				filter_parameters.input_cycles_per_second,
-				0.0,
-				high_pass_frequency,
-				SignalProcessing::FIRFilter::DefaultAttenuation);
+			filters_.clear();
+			if(step_rate_ == floorf(step_rate_)) {
+				filters_.emplace_back(
+					unsigned(number_of_taps),
+					filter_parameters.input_cycles_per_second,
+					0.0,
+					high_pass_frequency,
+					SignalProcessing::FIRFilter::DefaultAttenuation);
+			} else {
+				filters_ = SignalProcessing::FIRFilter::polyphase_bank(
+					NumberOfPhases,
+					unsigned(number_of_taps),
+					filter_parameters.input_cycles_per_second,
+					0.0,
+					high_pass_frequency,
+					SignalProcessing::FIRFilter::DefaultAttenuation);
+			}
 
 			// Pick the new conversion function.
 			if(	filter_parameters.input_cycles_per_second == filter_parameters.output_cycles_per_second &&
@@ -174,12 +190,14 @@ template <typename ConcreteT, bool is_stereo> class LowpassBase: public Speaker
 				return;
 			}
 
+			// Pick the phase closest to, but not after, the ideal position of this output sample
+			// within the input; evaluate only that one.
+			const auto &filter = filters_[std::min(size_t(position_error_ * float(filters_.size())), filters_.size() - 1)];
 			if constexpr (is_stereo) {
-				output_buffer_[output_buffer_pointer_ + 0] = filter_->apply(input_buffer_.data(), 2);
-				output_buffer_[output_buffer_pointer_ + 1] = filter_->apply(input_buffer_.data() + 1, 2);
+				filter.apply_stereo(input_buffer_.data(), &output_buffer_[output_buffer_pointer_]);
 				output_buffer_pointer_+= 2;
 			} else {
-				output_buffer_[output_buffer_pointer_] = filter_->apply(input_buffer_.data());
+				output_buffer_[output_buffer_pointer_] = filter.apply(input_buffer_.data());
 				output_buffer_pointer_++;
 			}
 
@@ -238,11 +256,19 @@ template <typename ConcreteT, bool is_stereo> class LowpassBase: public Speaker
 			return filter_parameters.input_rate_changed;
 		}
 
+		/// Obtains samples from the concrete speaker's source; time spent there is profiled separately from filtering.
+		inline void fetch_samples(size_t length, int16_t *target) {
+			PROFILE_TYPE_SCOPE("Audio source", ConcreteT, uint64_t(length));
+			static_cast<ConcreteT *>(this)->get_samples(length, target);
+		}
+
 	protected:
 		bool process(size_t length) {
 			const auto delegate = delegate_.load(std::memory_order::memory_order_relaxed);
 			if(!delegate) return false;
 
+			PROFILE_SCOPE("Speaker", uint64_t(length));
+
 			const int scale = static_cast<ConcreteT *>(this)->get_scale();
 
 			if(recalculate_filter_if_dirty()) {
@@ -253,7 +279,7 @@ template <typename ConcreteT, bool is_stereo> class LowpassBase: public Speaker
 				case Conversion::Copy:
 					while(length) {
 						const auto samples_to_read = std::min((output_buffer_.size() - output_buffer_pointer_) / (1 + is_stereo), length);
-						static_cast<ConcreteT *>(this)->get_samples(samples_to_read, &output_buffer_[output_buffer_pointer_ ]);
+						fetch_samples(samples_to_read, &output_buffer_[output_buffer_pointer_ ]);
 						output_buffer_pointer_ += samples_to_read * (1 + is_stereo);
 
 						// TODO: apply scale.
@@ -271,7 +297,7 @@ template <typename ConcreteT, bool is_stereo> class LowpassBase: public Speaker
 				case Conversion::ResampleSmaller:
 					while(length) {
 						const auto cycles_to_read = std::min((input_buffer_.size() - input_buffer_depth_) / (1 + is_stereo), length);
-						static_cast<ConcreteT *>(this)->get_samples(cycles_to_read, &input_buffer_[input_buffer_depth_]);
+						fetch_samples(cycles_to_read, &input_buffer_[input_buffer_depth_]);
 						input_buffer_depth_ += cycles_to_read * (1 + is_stereo);
 
 						if(input_buffer_depth_ == input_buffer_.size()) {
@@ -368,11 +394,12 @@ template <typename SampleSource> class PullLowpass: public LowpassBase<PullLowpa
 		}
 
 		/*!
-			Schedules an advancement by the number of cycles specified on the provided queue.
+			Schedules an advancement by the number of cycles specified on the provided queue,
+			which may be any of the AsyncTaskQueue-compatible queues in Concurrency.
 			The speaker will advance by obtaining data from the sample source supplied
 			at construction, filtering it and passing it on to the speaker's delegate if there is one.
 		*/
-		void run_for(Concurrency::AsyncTaskQueue<false> &queue, const Cycles cycles) {
+		template <typename QueueT> void run_for(QueueT &queue, const Cycles cycles) {
 			if(cycles == Cycles(0)) {
 				return;
 			}
@@ -0,0 +1,131 @@
+//
+//  ReplayingSource.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 16/10/2026.
+//  Copyright 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef ReplayingSource_hpp
+#define ReplayingSource_hpp
+
+#include "SampleSource.hpp"
+#include "../../../Concurrency/RegisterWriteLog.hpp"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace Outputs {
+namespace Speaker {
+
+/*!
+	A ReplayingSource wraps another SampleSource, applying the writes recorded in a
+	Concurrency::RegisterWriteLog at the proper sample offsets as it generates audio.
+
+	The log's times are taken to be in samples of the underlying source, counted from
+	construction. Writes are applied by calling @c source.apply_register_write(write),
+	on whichever thread is requesting samples.
+
+	If the underlying source is also a StepSource then so is this, allowing use with PullBLEP.
+*/
+template <typename SourceT, typename LogT> class ReplayingSource: public Outputs::Speaker::SampleSource {
+	public:
+		ReplayingSource(SourceT &source, LogT &log) : source_(source), log_(log) {}
+
+		void get_samples(std::size_t number_of_samples, std::int16_t *target) {
+			while(number_of_samples) {
+				const auto length = next_length(number_of_samples);
+				source_.get_samples(length, target);
+				target += length * (1 + get_is_stereo());
+				number_of_samples -= length;
+				time_ += length;
+			}
+		}
+
+		template <typename TargetT> void get_steps(std::size_t number_of_cycles, TargetT &target) {
+			OffsetTarget<TargetT> offset_target{target, 0};
+			while(number_of_cycles) {
+				const auto length = next_length(number_of_cycles);
+				source_.get_steps(length, offset_target);
+				offset_target.offset += length;
+				number_of_cycles -= length;
+				time_ += length;
+			}
+		}
+
+		void skip_samples(const std::size_t number_of_samples) {
+			auto remaining = number_of_samples;
+			while(remaining) {
+				const auto length = next_length(remaining);
+				source_.skip_samples(length);
+				remaining -= length;
+				time_ += length;
+			}
+		}
+
+		/*!
+			Applies all writes up to @c time, without generating any audio, if the owning speaker
+			hasn't already advanced that far; e.g. because it has no delegate. An owner should
+			schedule this after each speaker update, to ensure that the log is always drained.
+		*/
+		void catch_up(uint64_t time) {
+			if(time_ < time) {
+				time_ = time;
+			}
+			apply_writes();
+		}
+
+		bool is_zero_level() const {
+			return !log_.front() && source_.is_zero_level();
+		}
+
+		void set_sample_volume_range(std::int16_t range) {
+			source_.set_sample_volume_range(range);
+		}
+
+		static constexpr bool get_is_stereo() {
+			return SourceT::get_is_stereo();
+		}
+
+		double get_average_output_peak() const {
+			return source_.get_average_output_peak();
+		}
+
+	private:
+		SourceT &source_;
+		LogT &log_;
+		uint64_t time_ = 0;
+
+		/// Forwards steps to @c target, with offsets adjusted to be relative to the start of the current call to @c get_steps.
+		template <typename TargetT> struct OffsetTarget {
+			TargetT &target;
+			std::size_t offset;
+
+			template <typename... LevelsT> void step(std::size_t step_offset, LevelsT... levels) {
+				target.step(offset + step_offset, levels...);
+			}
+		};
+
+		/// Applies all writes that are now due and returns the number of samples,
+		/// up to @c limit, that may be generated before the next.
+		std::size_t next_length(std::size_t limit) {
+			const auto next = apply_writes();
+			if(!next) return limit;
+			return std::size_t(std::min(uint64_t(limit), next->time - time_));
+		}
+
+		/// Applies all writes that are now due; returns the next pending write, if any.
+		const Concurrency::RegisterWrite *apply_writes() {
+			while(true) {
+				const auto next = log_.front();
+				if(!next || next->time > time_) return next;
+				source_.apply_register_write(*next);
+				log_.pop();
+			}
+		}
+};
+
+}
+}
+
+#endif /* ReplayingSource_hpp */
@@ -0,0 +1,59 @@
+//
+//  StepSource.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 16/10/2026.
+//  Copyright 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef StepSource_hpp
+#define StepSource_hpp
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Outputs {
+namespace Speaker {
+
+/*!
+	A step source is something that can provide a stream of audio that holds a constant
+	level between discrete changes, such as the square waves of many sound chips.
+	Rather than supplying a sample per input cycle, it reports only the changes.
+
+	This optional base class provides the interface expected to be exposed
+	by the template parameter to PullBLEP.
+*/
+class StepSource {
+	public:
+		/*!
+			Should advance by @c number_of_cycles, calling @c target.step(offset, level) to announce
+			the output level at each point where it may have changed, or @c target.step(offset, left, right)
+			if this is a stereo source. @c offset is the number of cycles since the start of this call,
+			and must not decrease from one step to the next.
+
+			Announcing a level that is unchanged is harmless; it is therefore acceptable merely to
+			announce the current level at offset 0 even if it hasn't changed since the previous call.
+		*/
+		template <typename TargetT> void get_steps([[maybe_unused]] std::size_t number_of_cycles, [[maybe_unused]] TargetT &target) {}
+
+		/*!
+			Sets the proper output range for this step source; it should announce levels
+			between 0 and volume.
+		*/
+		void set_sample_volume_range([[maybe_unused]] std::int16_t volume) {}
+
+		/*!
+			Indicates whether this component will announce stereo levels.
+		*/
+		static constexpr bool get_is_stereo() { return false; }
+
+		/*!
+			As per SampleSource::get_average_output_peak.
+		*/
+		double get_average_output_peak() const { return 1.0; }
+};
+
+}
+}
+
+#endif /* StepSource_hpp */
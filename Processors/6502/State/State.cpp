@@ -30,6 +30,8 @@ State::State(const ProcessorBase &src): State() {
 	execution_state.operand = src.operand_;
 	execution_state.address = src.address_.full;
 	execution_state.next_address = src.next_address_.full;
+	execution_state.interrupt_requests = src.interrupt_requests_;
+	execution_state.irq_request_history = src.irq_request_history_;
 	if(src.ready_is_active_) {
 		execution_state.phase = State::ExecutionState::Phase::Ready;
 	} else if(src.is_jammed_) {
@@ -50,7 +52,7 @@ State::State(const ProcessorBase &src): State() {
 	assert(&src.operations_[execution_state.micro_program][execution_state.micro_program_offset] == src.scheduled_program_counter_);
 }
 
-void State::apply(ProcessorBase &target) {
+void State::apply(ProcessorBase &target) const {
 	// Registers.
 	target.pc_.full = registers.program_counter;
 	target.s_ = registers.stack_pointer;
@@ -62,9 +64,14 @@ void State::apply(ProcessorBase &target) {
 	// Inputs.
 	target.ready_line_is_enabled_ = inputs.ready;
 	target.set_irq_line(inputs.irq);
-	target.set_nmi_line(inputs.nmi);
 	target.set_reset_line(inputs.reset);
 
+	// NMI is edge triggered, so is set directly; any pending NMI is
+	// restored along with other interrupt requests below.
+	target.nmi_line_is_enabled_ = inputs.nmi;
+	target.interrupt_requests_ = execution_state.interrupt_requests;
+	target.irq_request_history_ = execution_state.irq_request_history;
+
 	// Execution state.
 	target.ready_is_active_ = target.is_jammed_ = target.wait_is_active_ = target.stop_is_active_ = false;
 	switch(execution_state.phase) {
@@ -112,6 +119,8 @@ State::ExecutionState::ExecutionState() {
 		DeclareField(operand);
 		DeclareField(address);
 		DeclareField(next_address);
+		DeclareField(interrupt_requests);
+		DeclareField(irq_request_history);
 	}
 }
 
@@ -28,10 +28,10 @@ struct State: public Reflection::StructImpl<State> {
 		Provides the current state of the well-known, published internal registers.
 	*/
 	struct Registers: public Reflection::StructImpl<Registers> {
-		uint16_t program_counter;
-		uint8_t stack_pointer;
-		uint8_t flags;
-		uint8_t a, x, y;
+		uint16_t program_counter = 0;
+		uint8_t stack_pointer = 0;
+		uint8_t flags = 0;
+		uint8_t a = 0, x = 0, y = 0;
 
 		Registers();
 	} registers;
@@ -41,10 +41,10 @@ struct State: public Reflection::StructImpl<State> {
 		related to an access cycle.
 	*/
 	struct Inputs: public Reflection::StructImpl<Inputs> {
-		bool ready;
-		bool irq;
-		bool nmi;
-		bool reset;
+		bool ready = false;
+		bool irq = false;
+		bool nmi = false;
+		bool reset = false;
 
 		Inputs();
 	} inputs;
@@ -60,9 +60,9 @@ struct State: public Reflection::StructImpl<State> {
 		);
 
 		/// Current executon phase, e.g. standard instruction flow or responding to an IRQ.
-		Phase phase;
-		int micro_program;
-		int micro_program_offset;
+		Phase phase = Phase::Instruction;
+		int micro_program = 0;
+		int micro_program_offset = 0;
 
 		// The following are very internal things. At the minute I
 		// consider these 'reliable' for inter-launch state
@@ -73,8 +73,13 @@ struct State: public Reflection::StructImpl<State> {
 		// retained, they're entirely ephemeral. If providing a state
 		// for persistance, machines that can should advance until
 		// cycles_into_phase is 0.
-		uint8_t operation, operand;
-		uint16_t address, next_address;
+		uint8_t operation = 0, operand = 0;
+		uint16_t address = 0, next_address = 0;
+
+		// Pending interrupts, including any NMI that has been latched
+		// but not yet serviced, and the IRQ input as sampled so far.
+		uint8_t interrupt_requests = 0;
+		uint8_t irq_request_history = 0;
 
 		ExecutionState();
 	} execution_state;
@@ -86,7 +91,7 @@ struct State: public Reflection::StructImpl<State> {
 	State(const ProcessorBase &src);
 
 	/// Applies this state to @c target.
-	void apply(ProcessorBase &target);
+	void apply(ProcessorBase &target) const;
 };
 
 
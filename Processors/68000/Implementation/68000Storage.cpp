@@ -10,8 +10,9 @@
 
 #include <algorithm>
 #include <cassert>
-#include <ctime>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <vector>
 #include <sstream>
 
@@ -32,7 +33,7 @@ namespace MC68000 {
 #define Imm		0x14
 
 struct ProcessorStorageConstructor {
-	ProcessorStorageConstructor(ProcessorStorage &storage) : storage_(storage) {}
+	ProcessorStorageConstructor(ProcessorStorage &storage, ProcessorStorage::Programs &programs) : storage_(storage), programs_(programs) {}
 
 	using BusStep = ProcessorStorage::BusStep;
 
@@ -829,7 +830,7 @@ struct ProcessorStorageConstructor {
 		// storage_.all_bus_steps_ at the end.
 //		BusStep arbitrary_base;
 
-#define op(...) 	storage_.all_micro_ops_.emplace_back(__VA_ARGS__)
+#define op(...) 	programs_.micro_ops.emplace_back(__VA_ARGS__)
 #define seq(...)	assemble_program(__VA_ARGS__)
 #define ea(n)		&storage_.effective_address_[n].full
 #define a(n)		&storage_.address_[n].full
@@ -845,7 +846,7 @@ struct ProcessorStorageConstructor {
 			for(const auto &mapping: mappings) {
 				if((instruction & mapping.mask) == mapping.value) {
 					auto operation = mapping.operation;
-					const auto micro_op_start = storage_.all_micro_ops_.size();
+					const auto micro_op_start = programs_.micro_ops.size();
 
 					// The following fields are used commonly enough to be worth pulling out here.
 					const int ea_register = instruction & 7;
@@ -3045,17 +3046,17 @@ struct ProcessorStorageConstructor {
 					}
 
 					// Add a terminating micro operation if necessary.
-					if(!storage_.all_micro_ops_.back().is_terminal()) {
-						storage_.all_micro_ops_.emplace_back();
+					if(!programs_.micro_ops.back().is_terminal()) {
+						programs_.micro_ops.emplace_back();
 					}
 
 					// Ensure that steps that weren't meant to look terminal aren't terminal; also check
 					// for improperly encoded address calculation-type actions.
-					for(auto index = micro_op_start; index < storage_.all_micro_ops_.size() - 1; ++index) {
+					for(auto index = micro_op_start; index < programs_.micro_ops.size() - 1; ++index) {
 
 #ifdef DEBUG
 						// All of the actions below must also nominate a source and/or destination.
-						switch(storage_.all_micro_ops_[index].action) {
+						switch(programs_.micro_ops[index].action) {
 							default: break;
 							case int(Action::CalcD16PC):
 							case int(Action::CalcD8PCXn):
@@ -3074,14 +3075,14 @@ struct ProcessorStorageConstructor {
 						}
 #endif
 
-						if(storage_.all_micro_ops_[index].is_terminal()) {
-							storage_.all_micro_ops_[index].bus_program = uint16_t(seq(""));
+						if(programs_.micro_ops[index].is_terminal()) {
+							programs_.micro_ops[index].bus_program = uint16_t(seq(""));
 						}
 					}
 
 					// Install the operation and make a note of where micro-ops begin.
 					program.operation = operation;
-					storage_.instructions[instruction] = program;
+					programs_.instructions[instruction] = program;
 					micro_op_pointers[size_t(instruction)] = size_t(micro_op_start);
 
 					// Don't search further through the list of possibilities, unless this is a debugging build,
@@ -3100,7 +3101,7 @@ struct ProcessorStorageConstructor {
 		}
 
 		// Throw in the interrupt program.
-		const auto interrupt_pointer = storage_.all_micro_ops_.size();
+		const auto interrupt_pointer = programs_.micro_ops.size();
 
 		// WORKAROUND FOR THE 68000 MAIN LOOP. Hopefully temporary.
 		op(Action::None, seq(""));
@@ -3151,27 +3152,21 @@ struct ProcessorStorageConstructor {
 //		};
 
 		// Finalise micro-op and program pointers.
-		int total_instructions = 0;
 		for(size_t instruction = 0; instruction < 65536; ++instruction) {
 			if(micro_op_pointers[instruction] != std::numeric_limits<size_t>::max()) {
-				storage_.instructions[instruction].micro_operations = uint32_t(micro_op_pointers[instruction]);
-				++total_instructions;
-//				link_operations(&storage_.all_micro_ops_[micro_op_pointers[instruction]], &arbitrary_base);
+				programs_.instructions[instruction].micro_operations = uint32_t(micro_op_pointers[instruction]);
+//				link_operations(&programs_.micro_ops[micro_op_pointers[instruction]], &arbitrary_base);
 			}
 		}
 
 		// Link up the interrupt micro ops.
-		storage_.interrupt_micro_ops_ = &storage_.all_micro_ops_[interrupt_pointer];
+		programs_.interrupt_offset = interrupt_pointer;
 //		link_operations(storage_.interrupt_micro_ops_, &arbitrary_base);
-
-		std::cout << total_instructions << " total opcodes" << std::endl;
-		std::cout << storage_.all_bus_steps_.size() << " total bus steps; at " << sizeof(BusStep) << " bytes per bus step implies " << storage_.all_bus_steps_.size() * sizeof(BusStep) << " bytes" << std::endl;
-		std::cout << storage_.all_micro_ops_.size() << " total micro ops; at " << sizeof(MicroOp) << " bytes per micro-op implies " << storage_.all_micro_ops_.size() * sizeof(MicroOp) << " bytes" << std::endl;
-		std::cout << "(Microcycles being " << sizeof(Microcycle) << " bytes; ProcessorStorage being " << sizeof(ProcessorStorage) << " bytes, or " << sizeof(ProcessorStorage) - sizeof(ProcessorStorage::instructions) << " bytes without the instructions table)" << std::endl;
 	}
 
 	private:
 		ProcessorStorage &storage_;
+		ProcessorStorage::Programs &programs_;
 
 		std::initializer_list<RegisterPair16 *>::const_iterator replace_write_values(BusStep *start, std::initializer_list<RegisterPair16 *>::const_iterator value) {
 			while(!start->is_terminal()) {
@@ -3208,20 +3203,20 @@ struct ProcessorStorageConstructor {
 }
 }
 
-CPU::MC68000::ProcessorStorage::ProcessorStorage() {
-	ProcessorStorageConstructor constructor(*this);
+void CPU::MC68000::ProcessorStorage::assemble_programs(Programs &programs) {
+	ProcessorStorageConstructor constructor(*this, programs);
 
 	// Create the special programs.
-	const size_t reset_offset = constructor.assemble_program("n n n n n nn nF nf nV nv np np");
+	programs.reset_offset = constructor.assemble_program("n n n n n nn nF nf nV nv np np");
 
-	const size_t branch_taken_offset = constructor.assemble_program("n np np");
-	const size_t branch_byte_not_taken_offset = constructor.assemble_program("nn np");
-	const size_t branch_word_not_taken_offset = constructor.assemble_program("nn np np");
-	const size_t bsr_offset = constructor.assemble_program("np np");
+	programs.branch_taken_offset = constructor.assemble_program("n np np");
+	programs.branch_byte_not_taken_offset = constructor.assemble_program("nn np");
+	programs.branch_word_not_taken_offset = constructor.assemble_program("nn np np");
+	programs.bsr_offset = constructor.assemble_program("np np");
 
-	const size_t dbcc_condition_true_offset = constructor.assemble_program("nn np np");
-	const size_t dbcc_condition_false_no_branch_offset = constructor.assemble_program("n nr np np", { &dbcc_false_address_ });
-	const size_t dbcc_condition_false_branch_offset = constructor.assemble_program("n np np");
+	programs.dbcc_condition_true_offset = constructor.assemble_program("nn np np");
+	programs.dbcc_condition_false_no_branch_offset = constructor.assemble_program("n nr np np", { &dbcc_false_address_ });
+	programs.dbcc_condition_false_branch_offset = constructor.assemble_program("n np np");
 	// That nr in dbcc_condition_false_no_branch_offset is to look like an np from the wrong address.
 
 	// The reads steps needs to be 32 long-word reads plus an overflow word; the writes just the long words.
@@ -3235,12 +3230,12 @@ CPU::MC68000::ProcessorStorage::ProcessorStorage() {
 	}
 	movem_reads_pattern += "nr";
 	addresses.push_back(nullptr);
-	const size_t movem_read_offset = constructor.assemble_program(movem_reads_pattern.c_str(), addresses);
-	const size_t movem_write_offset = constructor.assemble_program(movem_writes_pattern.c_str(), addresses);
+	programs.movem_read_offset = constructor.assemble_program(movem_reads_pattern.c_str(), addresses);
+	programs.movem_write_offset = constructor.assemble_program(movem_writes_pattern.c_str(), addresses);
 
 	// Target addresses and values will be filled in by TRAP/illegal too.
-	const size_t trap_offset = constructor.assemble_program("r nw nw nW nV nv np np", { &precomputed_addresses_[0], &precomputed_addresses_[1], &precomputed_addresses_[2] });
-	const size_t bus_error_offset =
+	programs.trap_offset = constructor.assemble_program("r nw nw nW nV nv np np", { &precomputed_addresses_[0], &precomputed_addresses_[1], &precomputed_addresses_[2] });
+	programs.bus_error_offset =
 		constructor.assemble_program(
 			"nn nw nw nW nw nw nw nW nV nv np np",
 			{
@@ -3255,53 +3250,32 @@ CPU::MC68000::ProcessorStorage::ProcessorStorage() {
 	);
 
 	// Chuck in the proper micro-ops for handling an exception.
-	const auto short_exception_offset = all_micro_ops_.size();
-	all_micro_ops_.emplace_back(ProcessorBase::MicroOp::Action::None);
-	all_micro_ops_.emplace_back();
+	programs.short_exception_offset = programs.micro_ops.size();
+	programs.micro_ops.emplace_back(ProcessorBase::MicroOp::Action::None);
+	programs.micro_ops.emplace_back();
 
-	const auto long_exception_offset = all_micro_ops_.size();
-	all_micro_ops_.emplace_back(ProcessorBase::MicroOp::Action::None);
-	all_micro_ops_.emplace_back();
+	programs.long_exception_offset = programs.micro_ops.size();
+	programs.micro_ops.emplace_back(ProcessorBase::MicroOp::Action::None);
+	programs.micro_ops.emplace_back();
 
 	// Install operations.
-//#ifndef NDEBUG
-	const std::clock_t start = std::clock();
-//#endif
 	constructor.install_instructions();
-//#ifndef NDEBUG
-	std::cout << "Construction took " << double(std::clock() - start) / double(CLOCKS_PER_SEC / 1000) << "ms" << std::endl;
-//#endif
-
-	// Realise the special programs as direct pointers.
-	reset_bus_steps_ = &all_bus_steps_[reset_offset];
-
-	branch_taken_bus_steps_ = &all_bus_steps_[branch_taken_offset];
-	branch_byte_not_taken_bus_steps_ = &all_bus_steps_[branch_byte_not_taken_offset];
-	branch_word_not_taken_bus_steps_ = &all_bus_steps_[branch_word_not_taken_offset];
-	bsr_bus_steps_ = &all_bus_steps_[bsr_offset];
-
-	dbcc_condition_true_steps_ = &all_bus_steps_[dbcc_condition_true_offset];
-	dbcc_condition_false_no_branch_steps_ = &all_bus_steps_[dbcc_condition_false_no_branch_offset];
-	dbcc_condition_false_no_branch_steps_[1].microcycle.operation |= Microcycle::IsProgram;
-	dbcc_condition_false_no_branch_steps_[2].microcycle.operation |= Microcycle::IsProgram;
-	dbcc_condition_false_branch_steps_ = &all_bus_steps_[dbcc_condition_false_branch_offset];
 
-	movem_read_steps_ = &all_bus_steps_[movem_read_offset];
-	movem_write_steps_ = &all_bus_steps_[movem_write_offset];
+	// Mark the dbcc false-without-branch reads as program fetches.
+	all_bus_steps_[programs.dbcc_condition_false_no_branch_offset + 1].microcycle.operation |= Microcycle::IsProgram;
+	all_bus_steps_[programs.dbcc_condition_false_no_branch_offset + 2].microcycle.operation |= Microcycle::IsProgram;
 
-	// Link the trap steps but also fill in the program counter as the source
-	// for its parts, and use the computed addresses.
+	// Fill in the program counter as the source for the parts of the trap steps,
+	// and use the computed addresses.
 	//
 	// Order of output is: PC.l, SR, PC.h.
-	trap_steps_ = &all_bus_steps_[trap_offset];
-	constructor.replace_write_values(trap_steps_, { &program_counter_.halves.low, &destination_bus_data_.halves.low, &program_counter_.halves.high });
+	constructor.replace_write_values(&all_bus_steps_[programs.trap_offset], { &program_counter_.halves.low, &destination_bus_data_.halves.low, &program_counter_.halves.high });
 
 	// Fill in the same order of writes for the interrupt micro-ops, though it divides the work differently.
-	constructor.replace_write_values(interrupt_micro_ops_, { &program_counter_.halves.low, &destination_bus_data_.halves.low, &program_counter_.halves.high });
+	constructor.replace_write_values(&programs.micro_ops[programs.interrupt_offset], { &program_counter_.halves.low, &destination_bus_data_.halves.low, &program_counter_.halves.high });
 
-	// Link the bus error exception steps and fill in the proper sources.
-	bus_error_steps_ = &all_bus_steps_[bus_error_offset];
-	constructor.replace_write_values(bus_error_steps_, {
+	// Fill in the proper sources for the bus error exception steps.
+	constructor.replace_write_values(&all_bus_steps_[programs.bus_error_offset], {
 		&program_counter_.halves.low,
 		&destination_bus_data_.halves.low,
 		&program_counter_.halves.high,
@@ -3315,20 +3289,87 @@ CPU::MC68000::ProcessorStorage::ProcessorStorage() {
 	//
 	// Assumed order of input: PC.h, SR, PC.l (i.e. the opposite of TRAP's output).
 	for(const int instruction: { 0x4e73, 0x4e77 }) {
-		auto steps = &all_bus_steps_[all_micro_ops_[instructions[instruction].micro_operations].bus_program];
+		auto steps = &all_bus_steps_[programs.micro_ops[programs.instructions[instruction].micro_operations].bus_program];
 		steps[0].microcycle.value = steps[1].microcycle.value = &program_counter_.halves.high;
 		steps[4].microcycle.value = steps[5].microcycle.value = &program_counter_.halves.low;
 	}
 
-	// Setup the stop cycle.
-	stop_cycle_.length = HalfCycles(2);
+	// Complete linkage of the exception micro programs.
+	programs.micro_ops[programs.short_exception_offset].bus_program = uint16_t(programs.trap_offset);
+	programs.micro_ops[programs.long_exception_offset].bus_program = uint16_t(programs.bus_error_offset);
+
+	// Convert all pointers into this ProcessorStorage to offsets, so that the bus steps can
+	// serve as a template for every other instance.
+	const auto base = reinterpret_cast<uintptr_t>(this);
+	const auto offset = [base] (const void *pointer) -> uint32_t {
+		if(!pointer) return Programs::Relocation::None;
+
+		const auto address = reinterpret_cast<uintptr_t>(pointer);
+		assert(address >= base && address < base + sizeof(ProcessorStorage));
+		return uint32_t(address - base);
+	};
+
+	programs.bus_steps = std::move(all_bus_steps_);
+	programs.relocations.reserve(programs.bus_steps.size());
+	for(auto &step: programs.bus_steps) {
+		programs.relocations.push_back({offset(step.microcycle.address), offset(step.microcycle.value)});
+		step.microcycle.address = nullptr;
+		step.microcycle.value = nullptr;
+	}
+}
 
-	// Complete linkage of the exception micro program.
-	short_exception_micro_ops_ = &all_micro_ops_[short_exception_offset];
-	short_exception_micro_ops_->bus_program = uint16_t(trap_offset);
+CPU::MC68000::ProcessorStorage::ProcessorStorage() {
+	// Build the programs if this is the first 68000 to be constructed.
+	{
+		static std::mutex mutex;
+		static std::unique_ptr<Programs> programs;
+
+		std::lock_guard lock(mutex);
+		if(!programs) {
+			auto new_programs = std::make_unique<Programs>();
+			assemble_programs(*new_programs);
+			programs = std::move(new_programs);
+		}
+		programs_ = programs.get();
+	}
+	all_micro_ops_ = programs_->micro_ops.data();
+	instructions = programs_->instructions;
+
+	// Point this processor's copies of all bus steps at its own registers.
+	all_bus_steps_ = programs_->bus_steps;
+	const auto resolve = [this] (uint32_t offset) -> void * {
+		if(offset == Programs::Relocation::None) return nullptr;
+		return reinterpret_cast<uint8_t *>(this) + offset;
+	};
+	for(size_t index = 0; index < all_bus_steps_.size(); ++index) {
+		all_bus_steps_[index].microcycle.address = static_cast<const uint32_t *>(resolve(programs_->relocations[index].address));
+		all_bus_steps_[index].microcycle.value = static_cast<RegisterPair16 *>(resolve(programs_->relocations[index].value));
+	}
+
+	// Realise the special programs as direct pointers.
+	reset_bus_steps_ = &all_bus_steps_[programs_->reset_offset];
+
+	branch_taken_bus_steps_ = &all_bus_steps_[programs_->branch_taken_offset];
+	branch_byte_not_taken_bus_steps_ = &all_bus_steps_[programs_->branch_byte_not_taken_offset];
+	branch_word_not_taken_bus_steps_ = &all_bus_steps_[programs_->branch_word_not_taken_offset];
+	bsr_bus_steps_ = &all_bus_steps_[programs_->bsr_offset];
+
+	dbcc_condition_true_steps_ = &all_bus_steps_[programs_->dbcc_condition_true_offset];
+	dbcc_condition_false_no_branch_steps_ = &all_bus_steps_[programs_->dbcc_condition_false_no_branch_offset];
+	dbcc_condition_false_branch_steps_ = &all_bus_steps_[programs_->dbcc_condition_false_branch_offset];
 
-	long_exception_micro_ops_ = &all_micro_ops_[long_exception_offset];
-	long_exception_micro_ops_->bus_program = uint16_t(bus_error_offset);
+	movem_read_steps_ = &all_bus_steps_[programs_->movem_read_offset];
+	movem_write_steps_ = &all_bus_steps_[programs_->movem_write_offset];
+
+	trap_steps_ = &all_bus_steps_[programs_->trap_offset];
+	bus_error_steps_ = &all_bus_steps_[programs_->bus_error_offset];
+
+	short_exception_micro_ops_ = &all_micro_ops_[programs_->short_exception_offset];
+	long_exception_micro_ops_ = &all_micro_ops_[programs_->long_exception_offset];
+	interrupt_micro_ops_ = &all_micro_ops_[programs_->interrupt_offset];
+
+	// Setup the stop cycle.
+	stop_cycle_.length = HalfCycles(2);
 
 	// Set initial state.
 	active_step_ = reset_bus_steps_;
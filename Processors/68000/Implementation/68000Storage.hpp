@@ -436,19 +436,57 @@ class ProcessorStorage {
 			}
 		};
 
+		/*!
+			All micro-ops and programs, plus the bus steps they use; these are built once, by whichever
+			processor is constructed first, and then shared between all processors.
+
+			The bus steps are only a template: each processor takes its own copy, with addresses and
+			values pointing into itself, since some of them are modified at runtime.
+		*/
+		struct Programs {
+			std::vector<MicroOp> micro_ops;
+
+			// A lookup table from instructions to implementations.
+			Program instructions[65536];
+
+			/// Every bus step, with addresses and values cleared.
+			std::vector<BusStep> bus_steps;
+
+			/// For each of bus_steps, the offsets within ProcessorStorage of its address and value.
+			struct Relocation {
+				static constexpr uint32_t None = std::numeric_limits<uint32_t>::max();
+				uint32_t address = None;
+				uint32_t value = None;
+			};
+			std::vector<Relocation> relocations;
+
+			// Offsets of the special steps and programs for exception handlers and conditionals.
+			size_t reset_offset;
+			size_t branch_taken_offset, branch_byte_not_taken_offset, branch_word_not_taken_offset, bsr_offset;
+			size_t dbcc_condition_true_offset, dbcc_condition_false_no_branch_offset, dbcc_condition_false_branch_offset;
+			size_t movem_read_offset, movem_write_offset;
+			size_t trap_offset, bus_error_offset;
+
+			size_t long_exception_offset, short_exception_offset, interrupt_offset;
+		};
+		const Programs *programs_ = nullptr;
+
+		/// Builds all programs, using this instance as the target for all addresses and values.
+		void assemble_programs(Programs &programs);
+
 		// Storage for all the sequences of bus steps and micro-ops used throughout
-		// the 68000.
+		// the 68000; the bus steps are this processor's own copy.
 		std::vector<BusStep> all_bus_steps_;
-		std::vector<MicroOp> all_micro_ops_;
+		const MicroOp *all_micro_ops_ = nullptr;
 
 		// A lookup table from instructions to implementations.
-		Program instructions[65536];
+		const Program *instructions = nullptr;
 
 		// Special steps and programs for exception handlers.
 		BusStep *reset_bus_steps_;
-		MicroOp *long_exception_micro_ops_;		// i.e. those that leave 14 bytes on the stack — bus error and address error.
-		MicroOp *short_exception_micro_ops_;	// i.e. those that leave 6 bytes on the stack — everything else (other than interrupts).
-		MicroOp *interrupt_micro_ops_;
+		const MicroOp *long_exception_micro_ops_;	// i.e. those that leave 14 bytes on the stack — bus error and address error.
+		const MicroOp *short_exception_micro_ops_;	// i.e. those that leave 6 bytes on the stack — everything else (other than interrupts).
+		const MicroOp *interrupt_micro_ops_;
 
 		// Special micro-op sequences and storage for conditionals.
 		BusStep *branch_taken_bus_steps_;
@@ -13,6 +13,10 @@
 #include "../../Numeric/RegisterSizes.hpp"
 #include "../../InstructionSets/M68k/RegisterSet.hpp"
 
+#include <cassert>
+#include <type_traits>
+#include <utility>
+
 namespace CPU {
 namespace MC68000Mk2 {
 
@@ -351,6 +355,22 @@ class BusHandler {
 			Provides information about the path of execution if enabled via the template.
 		*/
 		void will_perform([[maybe_unused]] uint32_t address, [[maybe_unused]] uint16_t opcode) {}
+
+		// Bus handlers may optionally also implement:
+		//
+		//	uint8_t *direct_access(const Microcycle &cycle, int is_supervisor);
+		//
+		// It is offered the data-select microcycle of each read or write before that access begins,
+		// and may return a pointer suitable for Microcycle::apply if the access would have no side
+		// effects, incur no delay, and assert neither VPA nor BERR. The memory must also be neither
+		// observed nor modified by anything other than the processor. Otherwise return nullptr.
+		//
+		// The processor will then perform the access itself rather than posting its two microcycles.
+		// Their time will instead be posted later as part of a single idle microcycle, before the next
+		// microcycle of any other sort, before the interrupt input is next sampled, and before the
+		// processor returns from run_for.
+		//
+		// It is used only if DTACK is implicit and overrun is permitted.
 };
 
 struct State {
@@ -444,6 +464,16 @@ class Processor: private ProcessorBase {
 
 	private:
 		BusHandler &bus_handler_;
+
+		template <typename S, typename = void> struct has_direct_access : std::false_type {};
+		template <typename S> struct has_direct_access<S, decltype(void(std::declval<S &>().direct_access(std::declval<const Microcycle &>(), 0)))> : std::true_type {};
+		static constexpr bool use_direct_access = dtack_is_implicit && permit_overrun && has_direct_access<BusHandler>::value;
+
+		/// Performs the access described by @c announce and @c perform directly, if the bus handler permits,
+		/// deferring the time it would have taken; @returns @c true if so.
+		forceinline bool perform_direct(const Microcycle &announce, const Microcycle &perform);
+
+		friend struct Snapshot;
 };
 
 }
@@ -28,6 +28,7 @@ enum ExecutionState: int {
 	Decode,
 	WaitForDTACK,
 	WaitForInterrupt,
+	Halted,
 
 	StoreOperand,
 	StoreOperand_bw,
@@ -216,7 +217,17 @@ void Processor<BusHandler, dtack_is_implicit, permit_overrun, signal_will_perfor
 
 	// Check whether all remaining time has been expended; if so then exit, having set this line up as
 	// the next resumption point.
-#define ConsiderExit()	if(time_remaining_ < HalfCycles(0)) { state_ = ExecutionState::Max + ((__COUNTER__+1) >> 1); return; } [[fallthrough]]; case ExecutionState::Max + (__COUNTER__ >> 1):
+#define ConsiderExit()	if(time_remaining_ < HalfCycles(0)) { FlushDirectTime(); state_ = ExecutionState::Max + ((__COUNTER__+1) >> 1); return; } [[fallthrough]]; case ExecutionState::Max + (__COUNTER__ >> 1):
+
+	// Posts any time spent on direct accesses to the bus handler, as a single idle microcycle.
+#define FlushDirectTime()																			\
+	if constexpr (use_direct_access) {																\
+		if(direct_time_ > HalfCycles(0)) {															\
+			direct_idle.length = direct_time_;														\
+			direct_time_ = HalfCycles(0);															\
+			time_remaining_ -= bus_handler_.perform_bus_operation(direct_idle, is_supervisor_);		\
+		}																							\
+	}
 
 	// Subtracts `n` half-cycles from `time_remaining_`; if permit_overrun is false, also ConsiderExit()
 #define Spend(n)		time_remaining_ -= (n); if constexpr (!permit_overrun) ConsiderExit()
@@ -274,9 +285,13 @@ void Processor<BusHandler, dtack_is_implicit, permit_overrun, signal_will_perfor
 	exception_vector_ = x;					\
 	MoveToStateSpecific(StandardException);
 
-	// Raises a bus/address error with integer vector x for access v.
-	// x is the vector identifier, not its address.
+	// Raises a bus/address error with integer vector x for access v,
+	// or halts if one occurs while a reset or another bus/address error
+	// is being processed. x is the vector identifier, not its address.
 #define RaiseBusOrAddressError(x, v)				\
+	if(is_processing_group0_) {						\
+		MoveToStateSpecific(Halted);				\
+	}												\
 	exception_vector_ = InstructionSet::M68k::x;	\
 	bus_error_ = v;									\
 	MoveToStateSpecific(BusOrAddressErrorException);
@@ -284,6 +299,7 @@ void Processor<BusHandler, dtack_is_implicit, permit_overrun, signal_will_perfor
 	// Performs the bus operation and then applies a `Spend` of its length
 	// plus any additional length returned by the bus handler.
 #define PerformBusOperation(x)										\
+	FlushDirectTime();												\
 	delay = bus_handler_.perform_bus_operation(x, is_supervisor_);	\
 	Spend(x.length + delay)
 
@@ -325,7 +341,8 @@ void Processor<BusHandler, dtack_is_implicit, permit_overrun, signal_will_perfor
 	PerformBusOperation(x)
 
 	// Performs the memory access implied by the announce, perform pair,
-	// honouring DTACK, BERR and VPA as necessary.
+	// honouring DTACK, BERR and VPA as necessary, or directly if the bus
+	// handler permits.
 #define AccessPair(val, announce, perform)					\
 	perform.value = &val;									\
 	if constexpr (!dtack_is_implicit) {						\
@@ -334,9 +351,11 @@ void Processor<BusHandler, dtack_is_implicit, permit_overrun, signal_will_perfor
 	if(*perform.address & (perform.operation >> 1) & 1) {	\
 		RaiseBusOrAddressError(AddressError, perform);		\
 	}														\
-	PerformBusOperation(announce);							\
-	WaitForDTACK(announce);									\
-	CompleteAccess(perform);
+	if(!perform_direct(announce, perform)) {				\
+		PerformBusOperation(announce);						\
+		WaitForDTACK(announce);								\
+		CompleteAccess(perform);							\
+	}
 
 	// Sets up the next data access size and read flags.
 #define SetupDataAccess(read_flag, select_flag)												\
@@ -361,6 +380,7 @@ void Processor<BusHandler, dtack_is_implicit, permit_overrun, signal_will_perfor
 #define Prefetch()										\
 	prefetch_.high = prefetch_.low;						\
 	ReadProgramWord(prefetch_.low)						\
+	FlushDirectTime();									\
 	captured_interrupt_level_ = bus_interrupt_level_;
 
 	// Copies the current program counter, adjusted to allow for the prefetch queue,
@@ -400,6 +420,7 @@ void Processor<BusHandler, dtack_is_implicit, permit_overrun, signal_will_perfor
 
 		BeginState(WaitForInterrupt):
 			// Spin in place until an interrupt arrives.
+			FlushDirectTime();
 			captured_interrupt_level_ = bus_interrupt_level_;
 			if(status_.would_accept_interrupt(captured_interrupt_level_)) {
 				MoveToStateSpecific(DoInterrupt);
@@ -408,9 +429,23 @@ void Processor<BusHandler, dtack_is_implicit, permit_overrun, signal_will_perfor
 			CheckOverrun();
 		MoveToStateSpecific(WaitForInterrupt);
 
+		// Spin in place following a double bus fault; only a reset will exit this state.
+		BeginState(Halted):
+			FlushDirectTime();
+			IdleBus(1);
+
+			// As per CheckOverrun(), but leaving Halted as the resumption point so that
+			// a Snapshot can recognise the processor as halted.
+			if(time_remaining_ < HalfCycles(0)) {
+				state_ = Halted;
+				return;
+			}
+		MoveToStateSpecific(Halted);
+
 		// Perform the RESET exception, which seeds the stack pointer and program
 		// counter, populates the prefetch queue, and then moves to instruction dispatch.
 		BeginState(Reset):
+			is_processing_group0_ = true;
 			IdleBus(7);			// (n-)*5   nn
 
 			// Establish general reset state.
@@ -436,6 +471,7 @@ void Processor<BusHandler, dtack_is_implicit, permit_overrun, signal_will_perfor
 			Prefetch();			// np
 			IdleBus(1);			// n
 			Prefetch();			// np
+			is_processing_group0_ = false;
 		MoveToStateSpecific(Decode);
 
 		// Perform a 'standard' exception, i.e. a Group 1 or 2.
@@ -510,6 +546,7 @@ void Processor<BusHandler, dtack_is_implicit, permit_overrun, signal_will_perfor
 			// the same interleaved order as program counter and captured status register,
 			// which is the order that I know to be correct for a standard exception.
 
+			is_processing_group0_ = true;
 			IdleBus(2);
 
 			// Switch to supervisor mode, disable interrupts.
@@ -578,6 +615,7 @@ void Processor<BusHandler, dtack_is_implicit, permit_overrun, signal_will_perfor
 			Prefetch();			// np
 			IdleBus(1);			// n
 			Prefetch();			// np
+			is_processing_group0_ = false;
 		MoveToStateSpecific(Decode);
 
 		// Acknowledge an interrupt, thereby obtaining an exception vector,
@@ -647,7 +685,15 @@ void Processor<BusHandler, dtack_is_implicit, permit_overrun, signal_will_perfor
 		// Inspect the prefetch queue in order to decode the next instruction,
 		// and segue into the fetching of operands.
 		BeginState(Decode):
-			CheckOverrun();
+			// As per CheckOverrun(), but leaving Decode as the resumption point so that
+			// a Snapshot can recognise the processor as being between instructions.
+			if constexpr (permit_overrun) {
+				if(time_remaining_ < HalfCycles(0)) {
+					FlushDirectTime();
+					state_ = Decode;
+					return;
+				}
+			}
 
 			// Capture the address of the next instruction.
 			ReloadInstructionAddress();
@@ -2798,6 +2844,7 @@ void Processor<BusHandler, dtack_is_implicit, permit_overrun, signal_will_perfor
 #undef CheckOverrun
 #undef Spend
 #undef ConsiderExit
+#undef FlushDirectTime
 #undef ReloadInstructionAddress
 #undef MoveToAddressingMode
 #undef BeginStateMode
@@ -3059,6 +3106,7 @@ void Processor<BusHandler, dtack_is_implicit, permit_overrun, signal_will_perfor
 
 	// Ensure the state machine will resume at decode.
 	state_ = Decode;
+	is_processing_group0_ = false;
 
 	// Fill the prefetch queue.
 	captured_interrupt_level_ = bus_interrupt_level_;
@@ -3074,6 +3122,23 @@ void Processor<BusHandler, dtack_is_implicit, permit_overrun, signal_will_perfor
 	program_counter_.l += 2;
 }
 
+template <class BusHandler, bool dtack_is_implicit, bool permit_overrun, bool signal_will_perform>
+bool Processor<BusHandler, dtack_is_implicit, permit_overrun, signal_will_perform>::perform_direct(const Microcycle &announce, const Microcycle &perform) {
+	if constexpr (use_direct_access) {
+		uint8_t *const target = bus_handler_.direct_access(perform, is_supervisor_);
+		if(target) {
+			perform.apply(target);
+
+			// This is the time that CompleteAccess would apply in the absence of VPA.
+			const HalfCycles length = announce.length + HalfCycles(4);
+			direct_time_ += length;
+			time_remaining_ -= length;
+			return true;
+		}
+	}
+	return false;
+}
+
 template <class BusHandler, bool dtack_is_implicit, bool permit_overrun, bool signal_will_perform>
 void Processor<BusHandler, dtack_is_implicit, permit_overrun, signal_will_perform>::reset() {
 	state_ = Reset;
@@ -31,6 +31,10 @@ struct ProcessorBase: public InstructionSet::M68k::NullFlowController {
 	/// is complete; may be less than zero.
 	HalfCycles time_remaining_;
 
+	/// Time spent on direct accesses that has not yet been posted to the bus handler;
+	/// it'll be posted via direct_idle.
+	HalfCycles direct_time_;
+
 	/// E clock phase.
 	HalfCycles e_clock_phase_;
 
@@ -107,6 +111,10 @@ struct ProcessorBase: public InstructionSet::M68k::NullFlowController {
 	/// A record of the exception to trigger.
 	int exception_vector_ = 0;
 
+	/// Set while a reset or a bus or address error is being processed, during which
+	/// a further bus or address error halts the processor.
+	bool is_processing_group0_ = false;
+
 	/// Transient storage for exception processing.
 	SlicedInt16 captured_status_;
 
@@ -183,6 +191,7 @@ struct ProcessorBase: public InstructionSet::M68k::NullFlowController {
 	// the semantics of a switch statement make in-place declarations awkward and
 	// some of these may persist across multiple calls to run_for.
 	Microcycle idle{0};
+	Microcycle direct_idle{0};
 
 	// Read a program word. All accesses via the program counter are word sized.
 	Microcycle read_program_announce {
@@ -0,0 +1,148 @@
+//
+//  State.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 16/10/2026.
+//  Copyright 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef MC68000Mk2_State_hpp
+#define MC68000Mk2_State_hpp
+
+#include "../../../Reflection/Enum.hpp"
+#include "../../../Reflection/Struct.hpp"
+#include "../68000Mk2.hpp"
+
+#include <cstring>
+
+namespace CPU {
+namespace MC68000Mk2 {
+
+/*!
+	Provides a means for capturing or restoring complete 68000 state, as a reflective
+	counterpart to @c State, which holds registers only.
+
+	This is intended for processors that permit overrun, captured between calls to
+	@c run_for; such processors will then be either at an instruction boundary, STOPped,
+	halted by a double bus fault or yet to perform their reset, and the internal state of
+	an in-progress instruction need not be captured.
+*/
+struct Snapshot: public Reflection::StructImpl<Snapshot> {
+	uint32_t data[8]{};
+	uint32_t address[7]{};
+	uint32_t user_stack_pointer = 0;
+	uint32_t supervisor_stack_pointer = 0;
+	uint16_t status = 0;
+	uint32_t program_counter = 0;
+
+	/// The two words of the prefetch queue; the next to be decoded is in the upper half.
+	uint32_t prefetch = 0;
+	uint32_t instruction_address = 0;
+
+	/// Time owed to or by the processor, in half cycles.
+	int time_remaining = 0;
+	/// The phase of the E clock, in half cycles relative to the current time.
+	int e_clock_phase = 0;
+
+	bool should_trace = false;
+	int captured_interrupt_level = 0;
+	int bus_interrupt_level = 0;
+	bool dtack = false, vpa = false, berr = false;
+
+	ReflectableEnum(Phase,
+		Instruction, Stopped, Reset, Halted
+	);
+	Phase phase = Phase::Reset;
+
+	Snapshot() {
+		if(needs_declare()) {
+			DeclareField(data);
+			DeclareField(address);
+			DeclareField(user_stack_pointer);
+			DeclareField(supervisor_stack_pointer);
+			DeclareField(status);
+			DeclareField(program_counter);
+			DeclareField(prefetch);
+			DeclareField(instruction_address);
+			DeclareField(time_remaining);
+			DeclareField(e_clock_phase);
+			DeclareField(should_trace);
+			DeclareField(captured_interrupt_level);
+			DeclareField(bus_interrupt_level);
+			DeclareField(dtack);
+			DeclareField(vpa);
+			DeclareField(berr);
+
+			AnnounceEnum(Phase);
+			DeclareField(phase);
+		}
+	}
+
+	template <typename ProcessorT> Snapshot(ProcessorT &source) : Snapshot() {
+		const auto registers = source.get_state().registers;
+		memcpy(data, registers.data, sizeof(data));
+		memcpy(address, registers.address, sizeof(address));
+		user_stack_pointer = registers.user_stack_pointer;
+		supervisor_stack_pointer = registers.supervisor_stack_pointer;
+		status = registers.status;
+		program_counter = registers.program_counter;
+
+		prefetch = source.prefetch_.l;
+		instruction_address = source.instruction_address_.l;
+
+		time_remaining = source.time_remaining_.template as<int>();
+		e_clock_phase = ((source.e_clock_phase_ - source.time_remaining_) % HalfCycles(20)).template as<int>();
+		if(e_clock_phase < 0) e_clock_phase += 20;
+
+		should_trace = source.should_trace_;
+		captured_interrupt_level = source.captured_interrupt_level_;
+		bus_interrupt_level = source.bus_interrupt_level_;
+		dtack = source.dtack_;
+		vpa = source.vpa_;
+		berr = source.berr_;
+
+		switch(source.state_) {
+			case ExecutionState::Decode:	phase = Phase::Instruction;	break;
+			case ExecutionState::Reset:		phase = Phase::Reset;		break;
+			case ExecutionState::Halted:	phase = Phase::Halted;		break;
+			default:						phase = Phase::Stopped;		break;
+		}
+	}
+
+	template <typename ProcessorT> void apply(ProcessorT &target) const {
+		State state;
+		memcpy(state.registers.data, data, sizeof(data));
+		memcpy(state.registers.address, address, sizeof(address));
+		state.registers.user_stack_pointer = user_stack_pointer;
+		state.registers.supervisor_stack_pointer = supervisor_stack_pointer;
+		state.registers.status = status;
+		state.registers.program_counter = program_counter;
+		target.set_state(state);
+
+		target.prefetch_.l = prefetch;
+		target.instruction_address_.l = instruction_address;
+
+		target.time_remaining_ = HalfCycles(time_remaining);
+		target.e_clock_phase_ = HalfCycles(time_remaining + e_clock_phase);
+
+		target.should_trace_ = should_trace;
+		target.captured_interrupt_level_ = captured_interrupt_level;
+		target.bus_interrupt_level_ = bus_interrupt_level;
+		target.dtack_ = dtack;
+		target.vpa_ = vpa;
+		target.berr_ = berr;
+
+		switch(phase) {
+			case Phase::Instruction:	target.state_ = ExecutionState::Decode;				break;
+			case Phase::Stopped:		target.state_ = ExecutionState::WaitForInterrupt;	break;
+			case Phase::Reset:			target.state_ = ExecutionState::Reset;				break;
+			case Phase::Halted:			target.state_ = ExecutionState::Halted;				break;
+		}
+		target.is_processing_group0_ = false;
+	}
+};
+
+}
+}
+
+#endif /* MC68000Mk2_State_hpp */
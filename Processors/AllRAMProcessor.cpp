@@ -8,6 +8,9 @@
 
 #include "AllRAMProcessor.hpp"
 
+#include <algorithm>
+#include <cstring>
+
 using namespace CPU;
 
 AllRAMProcessor::AllRAMProcessor(std::size_t memory_size) :
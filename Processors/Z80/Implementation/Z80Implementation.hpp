@@ -11,7 +11,7 @@ template <	class T,
 			bool uses_wait_line> Processor <T, uses_bus_request, uses_wait_line>
 				::Processor(T &bus_handler) :
 					bus_handler_(bus_handler) {
-	install_default_instruction_set();
+	install_default_instruction_set(uses_wait_line);
 }
 
 template <	class T,
@@ -24,16 +24,16 @@ template <	class T,
 		halt_mask_ = 0xff;	\
 		if(last_request_status_ & (Interrupt::PowerOn | Interrupt::Reset)) {	\
 			request_status_ &= ~Interrupt::PowerOn;	\
-			scheduled_program_counter_ = reset_program_.data();	\
+			scheduled_program_counter_ = programs_->reset.data();	\
 		} else if(last_request_status_ & Interrupt::NMI) {	\
 			request_status_ &= ~Interrupt::NMI;	\
-			scheduled_program_counter_ = nmi_program_.data();	\
+			scheduled_program_counter_ = programs_->nmi.data();	\
 		} else if(last_request_status_ & Interrupt::IRQ) {	\
-			scheduled_program_counter_ = irq_program_[interrupt_mode_].data();	\
+			scheduled_program_counter_ = programs_->irq[interrupt_mode_].data();	\
 		}	\
 	} else {	\
-		current_instruction_page_ = &base_page_;	\
-		scheduled_program_counter_ = base_page_.fetch_decode_execute_data;	\
+		current_instruction_page_ = &programs_->base_page;	\
+		scheduled_program_counter_ = programs_->base_page.fetch_decode_execute_data;	\
 	}
 
 	number_of_cycles_ += cycles;
@@ -66,27 +66,28 @@ template <	class T,
 	parity_overflow_result_ ^= parity_overflow_result_ >> 1;
 
 			switch(operation->type) {
-				case MicroOp::BusOperation:
-					if(number_of_cycles_ < operation->machine_cycle.length) {
+				case MicroOp::BusOperation: {
+					const PartialMachineCycle &cycle = bus_cycles_[operation->machine_cycle_index];
+					if(number_of_cycles_ < cycle.length) {
 						scheduled_program_counter_--;
 						return;
 					}
-					if(uses_wait_line && operation->machine_cycle.was_requested) {
+					if(uses_wait_line && cycle.was_requested) {
 						if(wait_line_) {
 							scheduled_program_counter_--;
 						} else {
 							continue;
 						}
 					}
-					number_of_cycles_ -= operation->machine_cycle.length;
+					number_of_cycles_ -= cycle.length;
 					last_request_status_ = request_status_;
 
 					// TODO: eliminate this conditional if all bus cycles have an address filled in.
-					last_address_bus_ = operation->machine_cycle.address ? *operation->machine_cycle.address : 0xdead;
+					last_address_bus_ = cycle.address ? *cycle.address : 0xdead;
 
-					number_of_cycles_ -= bus_handler_.perform_machine_cycle(operation->machine_cycle);
+					number_of_cycles_ -= bus_handler_.perform_machine_cycle(cycle);
 					if(uses_bus_request && bus_request_line_) goto do_bus_acknowledge;
-				break;
+				} break;
 				case MicroOp::MoveToNextProgram:
 					advance_operation();
 				break;
@@ -100,12 +101,12 @@ template <	class T,
 					flag_adjustment_history_ <<= 1;
 				break;
 
-				case MicroOp::Increment8NoFlags:	++ *static_cast<uint8_t *>(operation->source);			break;
-				case MicroOp::Increment16:			++ *static_cast<uint16_t *>(operation->source);			break;
+				case MicroOp::Increment8NoFlags:	++ *resolve<uint8_t>(operation->source);			break;
+				case MicroOp::Increment16:			++ *resolve<uint16_t>(operation->source);			break;
 				case MicroOp::IncrementPC:			pc_.full += pc_increment_;								break;
-				case MicroOp::Decrement16:			-- *static_cast<uint16_t *>(operation->source);			break;
-				case MicroOp::Move8:				*static_cast<uint8_t *>(operation->destination) = *static_cast<uint8_t *>(operation->source);		break;
-				case MicroOp::Move16:				*static_cast<uint16_t *>(operation->destination) = *static_cast<uint16_t *>(operation->source);		break;
+				case MicroOp::Decrement16:			-- *resolve<uint16_t>(operation->source);			break;
+				case MicroOp::Move8:				*resolve<uint8_t>(operation->destination) = *resolve<uint8_t>(operation->source);		break;
+				case MicroOp::Move16:				*resolve<uint16_t>(operation->destination) = *resolve<uint16_t>(operation->source);		break;
 
 				case MicroOp::AssembleAF:
 					temp16_.halves.high = a_;
@@ -127,17 +128,17 @@ template <	class T,
 	set_did_compute_flags();
 
 				case MicroOp::And:
-					a_ &= *static_cast<uint8_t *>(operation->source);
+					a_ &= *resolve<uint8_t>(operation->source);
 					set_logical_flags(Flag::HalfCarry);
 				break;
 
 				case MicroOp::Or:
-					a_ |= *static_cast<uint8_t *>(operation->source);
+					a_ |= *resolve<uint8_t>(operation->source);
 					set_logical_flags(0);
 				break;
 
 				case MicroOp::Xor:
-					a_ ^= *static_cast<uint8_t *>(operation->source);
+					a_ ^= *resolve<uint8_t>(operation->source);
 					set_logical_flags(0);
 				break;
 
@@ -200,7 +201,7 @@ template <	class T,
 	set_did_compute_flags();
 
 				case MicroOp::CP8: {
-					const uint8_t value = *static_cast<uint8_t *>(operation->source);
+					const uint8_t value = *resolve<uint8_t>(operation->source);
 					const int result = a_ - value;
 					const int half_result = (a_&0xf) - (value&0xf);
 
@@ -213,7 +214,7 @@ template <	class T,
 				} break;
 
 				case MicroOp::SUB8: {
-					const uint8_t value = *static_cast<uint8_t *>(operation->source);
+					const uint8_t value = *resolve<uint8_t>(operation->source);
 					const int result = a_ - value;
 					const int half_result = (a_&0xf) - (value&0xf);
 
@@ -226,7 +227,7 @@ template <	class T,
 				} break;
 
 				case MicroOp::SBC8: {
-					const uint8_t value = *static_cast<uint8_t *>(operation->source);
+					const uint8_t value = *resolve<uint8_t>(operation->source);
 					const int result = a_ - value - (carry_result_ & Flag::Carry);
 					const int half_result = (a_&0xf) - (value&0xf) - (carry_result_ & Flag::Carry);
 
@@ -239,7 +240,7 @@ template <	class T,
 				} break;
 
 				case MicroOp::ADD8: {
-					const uint8_t value = *static_cast<uint8_t *>(operation->source);
+					const uint8_t value = *resolve<uint8_t>(operation->source);
 					const int result = a_ + value;
 					const int half_result = (a_&0xf) + (value&0xf);
 
@@ -252,7 +253,7 @@ template <	class T,
 				} break;
 
 				case MicroOp::ADC8: {
-					const uint8_t value = *static_cast<uint8_t *>(operation->source);
+					const uint8_t value = *resolve<uint8_t>(operation->source);
 					const int result = a_ + value + (carry_result_ & Flag::Carry);
 					const int half_result = (a_&0xf) + (value&0xf) + (carry_result_ & Flag::Carry);
 
@@ -281,7 +282,7 @@ template <	class T,
 				} break;
 
 				case MicroOp::Increment8: {
-					const uint8_t value = *static_cast<uint8_t *>(operation->source);
+					const uint8_t value = *resolve<uint8_t>(operation->source);
 					const int result = value + 1;
 
 					// with an increment, overflow occurs if the sign changes from
@@ -289,7 +290,7 @@ template <	class T,
 					const int overflow = (value ^ result) & ~value;
 					const int half_result = (value&0xf) + 1;
 
-					*static_cast<uint8_t *>(operation->source) = uint8_t(result);
+					*resolve<uint8_t>(operation->source) = uint8_t(result);
 
 					// sign, zero and 5 & 3 are set directly from the result
 					bit53_result_ = sign_result_ = zero_result_ = uint8_t(result);
@@ -300,7 +301,7 @@ template <	class T,
 				} break;
 
 				case MicroOp::Decrement8: {
-					const uint8_t value = *static_cast<uint8_t *>(operation->source);
+					const uint8_t value = *resolve<uint8_t>(operation->source);
 					const int result = value - 1;
 
 					// with a decrement, overflow occurs if the sign changes from
@@ -308,7 +309,7 @@ template <	class T,
 					const int overflow = (value ^ result) & value;
 					const int half_result = (value&0xf) - 1;
 
-					*static_cast<uint8_t *>(operation->source) = uint8_t(result);
+					*resolve<uint8_t>(operation->source) = uint8_t(result);
 
 					// sign, zero and 5 & 3 are set directly from the result
 					bit53_result_ = sign_result_ = zero_result_ = uint8_t(result);
@@ -364,8 +365,8 @@ template <	class T,
 // MARK: - 16-bit arithmetic
 
 				case MicroOp::ADD16: {
-					memptr_.full = *static_cast<uint16_t *>(operation->destination);
-					const uint16_t sourceValue = *static_cast<uint16_t *>(operation->source);
+					memptr_.full = *resolve<uint16_t>(operation->destination);
+					const uint16_t sourceValue = *resolve<uint16_t>(operation->source);
 					const uint16_t destinationValue = memptr_.full;
 					const int result = sourceValue + destinationValue;
 					const int halfResult = (sourceValue&0xfff) + (destinationValue&0xfff);
@@ -376,13 +377,13 @@ template <	class T,
 					subtract_flag_ = 0;
 					set_did_compute_flags();
 
-					*static_cast<uint16_t *>(operation->destination) = uint16_t(result);
+					*resolve<uint16_t>(operation->destination) = uint16_t(result);
 					memptr_.full++;
 				} break;
 
 				case MicroOp::ADC16: {
-					memptr_.full = *static_cast<uint16_t *>(operation->destination);
-					const uint16_t sourceValue = *static_cast<uint16_t *>(operation->source);
+					memptr_.full = *resolve<uint16_t>(operation->destination);
+					const uint16_t sourceValue = *resolve<uint16_t>(operation->source);
 					const uint16_t destinationValue = memptr_.full;
 					const int result = sourceValue + destinationValue + (carry_result_ & Flag::Carry);
 					const int halfResult = (sourceValue&0xfff) + (destinationValue&0xfff) + (carry_result_ & Flag::Carry);
@@ -398,13 +399,13 @@ template <	class T,
 					parity_overflow_result_ = uint8_t(overflow >> 13);
 					set_did_compute_flags();
 
-					*static_cast<uint16_t *>(operation->destination) = uint16_t(result);
+					*resolve<uint16_t>(operation->destination) = uint16_t(result);
 					memptr_.full++;
 				} break;
 
 				case MicroOp::SBC16: {
-					memptr_.full = *static_cast<uint16_t *>(operation->destination);
-					const uint16_t sourceValue = *static_cast<uint16_t *>(operation->source);
+					memptr_.full = *resolve<uint16_t>(operation->destination);
+					const uint16_t sourceValue = *resolve<uint16_t>(operation->source);
 					const uint16_t destinationValue = memptr_.full;
 					const int result = destinationValue - sourceValue - (carry_result_ & Flag::Carry);
 					const int halfResult = (destinationValue&0xfff) - (sourceValue&0xfff) - (carry_result_ & Flag::Carry);
@@ -423,7 +424,7 @@ template <	class T,
 					parity_overflow_result_ = uint8_t(overflow >> 13);
 					set_did_compute_flags();
 
-					*static_cast<uint16_t *>(operation->destination) = uint16_t(result);
+					*resolve<uint16_t>(operation->destination) = uint16_t(result);
 					memptr_.full++;
 				} break;
 
@@ -640,13 +641,13 @@ template <	class T,
 // MARK: - Bit Manipulation
 
 				case MicroOp::BIT: {
-					const uint8_t result = *static_cast<uint8_t *>(operation->source) & (1 << ((operation_ >> 3)&7));
+					const uint8_t result = *resolve<uint8_t>(operation->source) & (1 << ((operation_ >> 3)&7));
 
 					// Leak MEMPTR into bits 5 and 3 if this is either BIT n,(HL) or BIT n,(IX/IY+d).
 					if(current_instruction_page_->is_indexed || ((operation_&0x07) == 6)) {
 						bit53_result_ = memptr_.halves.high;
 					} else {
-						bit53_result_ = *static_cast<uint8_t *>(operation->source);
+						bit53_result_ = *resolve<uint8_t>(operation->source);
 					}
 
 					sign_result_ = zero_result_ = result;
@@ -657,11 +658,11 @@ template <	class T,
 				} break;
 
 				case MicroOp::RES:
-					*static_cast<uint8_t *>(operation->source) &= ~(1 << ((operation_ >> 3)&7));
+					*resolve<uint8_t>(operation->source) &= ~(1 << ((operation_ >> 3)&7));
 				break;
 
 				case MicroOp::SET:
-					*static_cast<uint8_t *>(operation->source) |= (1 << ((operation_ >> 3)&7));
+					*resolve<uint8_t>(operation->source) |= (1 << ((operation_ >> 3)&7));
 				break;
 
 // MARK: - Rotation and shifting
@@ -699,59 +700,59 @@ template <	class T,
 #undef set_rotate_flags
 
 #define set_shift_flags()	\
-	sign_result_ = zero_result_ = bit53_result_ = *static_cast<uint8_t *>(operation->source);	\
+	sign_result_ = zero_result_ = bit53_result_ = *resolve<uint8_t>(operation->source);	\
 	set_parity(sign_result_);	\
 	half_carry_result_ = 0;	\
 	subtract_flag_ = 0;	\
 	set_did_compute_flags();
 
 				case MicroOp::RLC:
-					carry_result_ = *static_cast<uint8_t *>(operation->source) >> 7;
-					*static_cast<uint8_t *>(operation->source) = uint8_t((*static_cast<uint8_t *>(operation->source) << 1) | carry_result_);
+					carry_result_ = *resolve<uint8_t>(operation->source) >> 7;
+					*resolve<uint8_t>(operation->source) = uint8_t((*resolve<uint8_t>(operation->source) << 1) | carry_result_);
 					set_shift_flags();
 				break;
 
 				case MicroOp::RRC:
-					carry_result_ = *static_cast<uint8_t *>(operation->source);
-					*static_cast<uint8_t *>(operation->source) = uint8_t((*static_cast<uint8_t *>(operation->source) >> 1) | (carry_result_ << 7));
+					carry_result_ = *resolve<uint8_t>(operation->source);
+					*resolve<uint8_t>(operation->source) = uint8_t((*resolve<uint8_t>(operation->source) >> 1) | (carry_result_ << 7));
 					set_shift_flags();
 				break;
 
 				case MicroOp::RL: {
-					const uint8_t next_carry = *static_cast<uint8_t *>(operation->source) >> 7;
-					*static_cast<uint8_t *>(operation->source) = uint8_t((*static_cast<uint8_t *>(operation->source) << 1) | (carry_result_ & Flag::Carry));
+					const uint8_t next_carry = *resolve<uint8_t>(operation->source) >> 7;
+					*resolve<uint8_t>(operation->source) = uint8_t((*resolve<uint8_t>(operation->source) << 1) | (carry_result_ & Flag::Carry));
 					carry_result_ = next_carry;
 					set_shift_flags();
 				} break;
 
 				case MicroOp::RR: {
-					const uint8_t next_carry = *static_cast<uint8_t *>(operation->source);
-					*static_cast<uint8_t *>(operation->source) = uint8_t((*static_cast<uint8_t *>(operation->source) >> 1) | (carry_result_ << 7));
+					const uint8_t next_carry = *resolve<uint8_t>(operation->source);
+					*resolve<uint8_t>(operation->source) = uint8_t((*resolve<uint8_t>(operation->source) >> 1) | (carry_result_ << 7));
 					carry_result_ = next_carry;
 					set_shift_flags();
 				} break;
 
 				case MicroOp::SLA:
-					carry_result_ = *static_cast<uint8_t *>(operation->source) >> 7;
-					*static_cast<uint8_t *>(operation->source) = uint8_t(*static_cast<uint8_t *>(operation->source) << 1);
+					carry_result_ = *resolve<uint8_t>(operation->source) >> 7;
+					*resolve<uint8_t>(operation->source) = uint8_t(*resolve<uint8_t>(operation->source) << 1);
 					set_shift_flags();
 				break;
 
 				case MicroOp::SRA:
-					carry_result_ = *static_cast<uint8_t *>(operation->source);
-					*static_cast<uint8_t *>(operation->source) = uint8_t((*static_cast<uint8_t *>(operation->source) >> 1) | (*static_cast<uint8_t *>(operation->source) & 0x80));
+					carry_result_ = *resolve<uint8_t>(operation->source);
+					*resolve<uint8_t>(operation->source) = uint8_t((*resolve<uint8_t>(operation->source) >> 1) | (*resolve<uint8_t>(operation->source) & 0x80));
 					set_shift_flags();
 				break;
 
 				case MicroOp::SLL:
-					carry_result_ = *static_cast<uint8_t *>(operation->source) >> 7;
-					*static_cast<uint8_t *>(operation->source) = uint8_t(*static_cast<uint8_t *>(operation->source) << 1) | 1;
+					carry_result_ = *resolve<uint8_t>(operation->source) >> 7;
+					*resolve<uint8_t>(operation->source) = uint8_t(*resolve<uint8_t>(operation->source) << 1) | 1;
 					set_shift_flags();
 				break;
 
 				case MicroOp::SRL:
-					carry_result_ = *static_cast<uint8_t *>(operation->source);
-					*static_cast<uint8_t *>(operation->source) = uint8_t((*static_cast<uint8_t *>(operation->source) >> 1));
+					carry_result_ = *resolve<uint8_t>(operation->source);
+					*resolve<uint8_t>(operation->source) = uint8_t((*resolve<uint8_t>(operation->source) >> 1));
 					set_shift_flags();
 				break;
 
@@ -808,7 +809,7 @@ template <	class T,
 
 				case MicroOp::SetInFlags:
 					subtract_flag_ = half_carry_result_ = 0;
-					sign_result_ = zero_result_ = bit53_result_ = *static_cast<uint8_t *>(operation->source);
+					sign_result_ = zero_result_ = bit53_result_ = *resolve<uint8_t>(operation->source);
 					set_parity(sign_result_);
 					set_did_compute_flags();
 					++memptr_.full;
@@ -875,16 +876,16 @@ template <	class T,
 // MARK: - Internal bookkeeping
 
 				case MicroOp::SetInstructionPage:
-					current_instruction_page_ = (InstructionPage *)operation->source;
+					current_instruction_page_ = static_cast<const InstructionPage *>(operation->source);
 					scheduled_program_counter_ = current_instruction_page_->fetch_decode_execute_data;
 				break;
 
 				case MicroOp::CalculateIndexAddress:
-					memptr_.full = uint16_t(*static_cast<uint16_t *>(operation->source) + int8_t(temp8_));
+					memptr_.full = uint16_t(*resolve<uint16_t>(operation->source) + int8_t(temp8_));
 				break;
 
 				case MicroOp::SetAddrAMemptr:
-					memptr_.full = uint16_t(((*static_cast<uint16_t *>(operation->source) + 1)&0xff) + (a_ << 8));
+					memptr_.full = uint16_t(((*resolve<uint16_t>(operation->source) + 1)&0xff) + (a_ << 8));
 				break;
 
 				case MicroOp::IndexedPlaceHolder:
@@ -7,7 +7,11 @@
 //
 
 #include "../Z80.hpp"
+
+#include <cassert>
 #include <cstring>
+#include <memory>
+#include <mutex>
 
 using namespace CPU::Z80;
 
@@ -84,7 +88,7 @@ ProcessorStorage::ProcessorStorage() {
 #define NOP						{ {MicroOp::MoveToNextProgram} }
 
 #define JP(cc)					Sequence(Read16Inc(pc_, memptr_), {MicroOp::cc}, {MicroOp::Move16, &memptr_.full, &pc_.full})
-#define CALL(cc)				Sequence(ReadInc(pc_, memptr_.halves.low), {MicroOp::cc, conditional_call_untaken_program_.data()}, ReadInc(pc_, memptr_.halves.high), InternalOperation(2), Push(pc_), {MicroOp::Move16, &memptr_.full, &pc_.full})
+#define CALL(cc)				Sequence(ReadInc(pc_, memptr_.halves.low), {MicroOp::cc, programs.conditional_call_untaken.data()}, ReadInc(pc_, memptr_.halves.high), InternalOperation(2), Push(pc_), {MicroOp::Move16, &memptr_.full, &pc_.full})
 #define RET(cc)					Sequence(InternalOperation(2), {MicroOp::cc}, Pop(memptr_), {MicroOp::Move16, &memptr_.full, &pc_.full})
 #define JR(cc)					Sequence(ReadInc(pc_, temp8_), {MicroOp::cc}, InternalOperation(10), {MicroOp::CalculateIndexAddress, &pc_.full}, {MicroOp::Move16, &memptr_.full, &pc_.full})
 #define RST()					Sequence(InternalOperation(2), {MicroOp::CalculateRSTDestination}, Push(pc_), {MicroOp::Move16, &memptr_.full, &pc_.full})
@@ -144,28 +148,108 @@ ProcessorStorage::ProcessorStorage() {
 #define ADC16(d, s) Sequence(InternalOperation(8), InternalOperation(6), {MicroOp::ADC16, &s.full, &d.full})
 #define SBC16(d, s) Sequence(InternalOperation(8), InternalOperation(6), {MicroOp::SBC16, &s.full, &d.full})
 
-void ProcessorStorage::install_default_instruction_set() {
+void ProcessorStorage::install_default_instruction_set(bool uses_wait_line) {
+	// Programs are assembled by the first processor to need them, then shared.
+	static std::mutex mutex;
+	static std::unique_ptr<Programs> shared_programs[2];
+	{
+		std::lock_guard lock(mutex);
+		auto &programs = shared_programs[uses_wait_line];
+		if(!programs) {
+			auto new_programs = std::make_unique<Programs>();
+			assemble_programs(*new_programs);
+			share_programs(*new_programs);
+			programs = std::move(new_programs);
+		}
+		programs_ = programs.get();
+	}
+
+	// Point this processor's copies of all bus cycles at its own registers.
+	bus_cycles_.reserve(programs_->bus_cycles.size());
+	for(const auto &cycle: programs_->bus_cycles) {
+		bus_cycles_.emplace_back(
+			cycle.operation,
+			cycle.length,
+			cycle.address ? resolve<uint16_t>(cycle.address) : nullptr,
+			cycle.value ? resolve<uint8_t>(cycle.value) : nullptr,
+			cycle.was_requested
+		);
+	}
+}
+
+void ProcessorStorage::share_programs(Programs &programs) {
+	// Convert all pointers into this ProcessorStorage to offsets; leave all others, i.e. those
+	// to other programs and pages, as they are.
+	const auto base = reinterpret_cast<uintptr_t>(this);
+	const auto offset = [base] (const void *pointer) -> void * {
+		const auto address = reinterpret_cast<uintptr_t>(pointer);
+		if(address < base || address >= base + sizeof(ProcessorStorage)) return const_cast<void *>(pointer);
+		return reinterpret_cast<void *>(address - base);
+	};
+
+	const auto share = [&] (std::vector<MicroOp> &program) {
+		for(auto &operation: program) {
+			operation.source = offset(operation.source);
+			operation.destination = offset(operation.destination);
+			if(operation.type != MicroOp::BusOperation) continue;
+
+			const auto &cycle = operation.machine_cycle;
+			const PartialMachineCycle shared_cycle(
+				cycle.operation,
+				cycle.length,
+				static_cast<uint16_t *>(offset(cycle.address)),
+				static_cast<uint8_t *>(offset(cycle.value)),
+				cycle.was_requested);
+
+			const auto existing = std::find_if(programs.bus_cycles.begin(), programs.bus_cycles.end(), [&] (const PartialMachineCycle &rhs) {
+				return
+					shared_cycle.operation == rhs.operation &&
+					shared_cycle.length == rhs.length &&
+					shared_cycle.address == rhs.address &&
+					shared_cycle.value == rhs.value &&
+					shared_cycle.was_requested == rhs.was_requested;
+			});
+			operation.machine_cycle_index = size_t(existing - programs.bus_cycles.begin());
+			if(existing == programs.bus_cycles.end()) {
+				programs.bus_cycles.push_back(shared_cycle);
+			}
+		}
+	};
+
+	share(programs.conditional_call_untaken);
+	share(programs.reset);
+	share(programs.irq[0]);
+	share(programs.irq[1]);
+	share(programs.irq[2]);
+	share(programs.nmi);
+	for(auto page: {&programs.base_page, &programs.ed_page, &programs.fd_page, &programs.dd_page, &programs.cb_page, &programs.fdcb_page, &programs.ddcb_page}) {
+		share(page->all_operations);
+		share(page->fetch_decode_execute);
+	}
+}
+
+void ProcessorStorage::assemble_programs(Programs &programs) {
 	MicroOp conditional_call_untaken_program[] = Sequence(ReadInc(pc_, memptr_.halves.high));
-	copy_program(conditional_call_untaken_program, conditional_call_untaken_program_);
+	copy_program(conditional_call_untaken_program, programs.conditional_call_untaken);
 
-	assemble_base_page(base_page_, hl_, false, cb_page_);
-	assemble_base_page(dd_page_, ix_, true, ddcb_page_);
-	assemble_base_page(fd_page_, iy_, true, fdcb_page_);
-	assemble_ed_page(ed_page_);
+	assemble_base_page(programs, programs.base_page, hl_, false, programs.cb_page);
+	assemble_base_page(programs, programs.dd_page, ix_, true, programs.ddcb_page);
+	assemble_base_page(programs, programs.fd_page, iy_, true, programs.fdcb_page);
+	assemble_ed_page(programs.ed_page);
 
-	fd_page_.is_indexed = true;
-	fdcb_page_.is_indexed = true;
-	dd_page_.is_indexed = true;
-	ddcb_page_.is_indexed = true;
+	programs.fd_page.is_indexed = true;
+	programs.fdcb_page.is_indexed = true;
+	programs.dd_page.is_indexed = true;
+	programs.ddcb_page.is_indexed = true;
 
-	assemble_fetch_decode_execute(base_page_, 4);
-	assemble_fetch_decode_execute(dd_page_, 4);
-	assemble_fetch_decode_execute(fd_page_, 4);
-	assemble_fetch_decode_execute(ed_page_, 4);
-	assemble_fetch_decode_execute(cb_page_, 4);
+	assemble_fetch_decode_execute(programs.base_page, 4);
+	assemble_fetch_decode_execute(programs.dd_page, 4);
+	assemble_fetch_decode_execute(programs.fd_page, 4);
+	assemble_fetch_decode_execute(programs.ed_page, 4);
+	assemble_fetch_decode_execute(programs.cb_page, 4);
 
-	assemble_fetch_decode_execute(fdcb_page_, 3);
-	assemble_fetch_decode_execute(ddcb_page_, 3);
+	assemble_fetch_decode_execute(programs.fdcb_page, 3);
+	assemble_fetch_decode_execute(programs.ddcb_page, 3);
 
 	MicroOp reset_program[] = Sequence(InternalOperation(6), {MicroOp::Reset});
 
@@ -212,11 +296,11 @@ void ProcessorStorage::install_default_instruction_set() {
 		{ MicroOp::MoveToNextProgram }
 	};
 
-	copy_program(reset_program, reset_program_);
-	copy_program(nmi_program, nmi_program_);
-	copy_program(irq_mode0_program, irq_program_[0]);
-	copy_program(irq_mode1_program, irq_program_[1]);
-	copy_program(irq_mode2_program, irq_program_[2]);
+	copy_program(reset_program, programs.reset);
+	copy_program(nmi_program, programs.nmi);
+	copy_program(irq_mode0_program, programs.irq[0]);
+	copy_program(irq_mode1_program, programs.irq[1]);
+	copy_program(irq_mode2_program, programs.irq[2]);
 }
 
 void ProcessorStorage::assemble_ed_page(InstructionPage &target) {
@@ -320,7 +404,7 @@ void ProcessorStorage::assemble_cb_page(InstructionPage &target, RegisterPair16
 #undef CB_PAGE
 }
 
-void ProcessorStorage::assemble_base_page(InstructionPage &target, RegisterPair16 &index, bool add_offsets, InstructionPage &cb_page) {
+void ProcessorStorage::assemble_base_page(Programs &programs, InstructionPage &target, RegisterPair16 &index, bool add_offsets, InstructionPage &cb_page) {
 #define INC_DEC_LD(r)	\
 				Sequence({MicroOp::Increment8, &r}),	\
 				Sequence({MicroOp::Decrement8, &r}),	\
@@ -465,7 +549,7 @@ void ProcessorStorage::assemble_base_page(InstructionPage &target, RegisterPair1
 		/* 0xd7 RST 10h */	RST(),
 		/* 0xd8 RET C */	RET(TestC),								/* 0xd9 EXX */		Sequence({MicroOp::EXX}),
 		/* 0xda JP C */		JP(TestC),								/* 0xdb IN A, (n) */Sequence(ReadInc(pc_, memptr_.halves.low), {MicroOp::Move8, &a_, &memptr_.halves.high}, Input(memptr_, a_), Inc16(memptr_)),
-		/* 0xdc CALL C */	CALL(TestC),							/* 0xdd [DD page] */Sequence({MicroOp::SetInstructionPage, &dd_page_}),
+		/* 0xdc CALL C */	CALL(TestC),							/* 0xdd [DD page] */Sequence({MicroOp::SetInstructionPage, &programs.dd_page}),
 		/* 0xde SBC A, n */	Sequence(ReadInc(pc_, temp8_), {MicroOp::SBC8, &temp8_}),
 		/* 0xdf RST 18h */	RST(),
 		/* 0xe0 RET PO */	RET(TestPO),							/* 0xe1 POP HL */	Sequence(Pop(index)),
@@ -475,7 +559,7 @@ void ProcessorStorage::assemble_base_page(InstructionPage &target, RegisterPair1
 		/* 0xe7 RST 20h */	RST(),
 		/* 0xe8 RET PE */	RET(TestPE),							/* 0xe9 JP (HL) */	Sequence({MicroOp::Move16, &index.full, &pc_.full}),
 		/* 0xea JP PE */	JP(TestPE),								/* 0xeb EX DE, HL */Sequence({MicroOp::ExDEHL}),
-		/* 0xec CALL PE */	CALL(TestPE),							/* 0xed [ED page] */Sequence({MicroOp::SetInstructionPage, &ed_page_}),
+		/* 0xec CALL PE */	CALL(TestPE),							/* 0xed [ED page] */Sequence({MicroOp::SetInstructionPage, &programs.ed_page}),
 		/* 0xee XOR n */	Sequence(ReadInc(pc_, temp8_), {MicroOp::Xor, &temp8_}),
 		/* 0xef RST 28h */	RST(),
 		/* 0xf0 RET p */	RET(TestP),								/* 0xf1 POP AF */	Sequence(Pop(temp16_), {MicroOp::DisassembleAF}),
@@ -485,7 +569,7 @@ void ProcessorStorage::assemble_base_page(InstructionPage &target, RegisterPair1
 		/* 0xf7 RST 30h */	RST(),
 		/* 0xf8 RET M */	RET(TestM),								/* 0xf9 LD SP, HL */Sequence(InternalOperation(4), {MicroOp::Move16, &index.full, &sp_.full}),
 		/* 0xfa JP M */		JP(TestM),								/* 0xfb EI */		Sequence({MicroOp::EI}),
-		/* 0xfc CALL M */	CALL(TestM),							/* 0xfd [FD page] */Sequence({MicroOp::SetInstructionPage, &fd_page_}),
+		/* 0xfc CALL M */	CALL(TestM),							/* 0xfd [FD page] */Sequence({MicroOp::SetInstructionPage, &programs.fd_page}),
 		/* 0xfe CP n */		Sequence(ReadInc(pc_, temp8_), {MicroOp::CP8, &temp8_}),
 		/* 0xff RST 38h */	RST(),
 	};
@@ -531,8 +615,8 @@ void ProcessorStorage::assemble_fetch_decode_execute(InstructionPage &target, in
 
 bool ProcessorBase::is_starting_new_instruction() const {
 	return
-		current_instruction_page_ == &base_page_ &&
-		scheduled_program_counter_ == &base_page_.fetch_decode_execute[0];
+		current_instruction_page_ == &programs_->base_page &&
+		scheduled_program_counter_ == &programs_->base_page.fetch_decode_execute[0];
 }
 
 bool ProcessorBase::get_is_resetting() const {
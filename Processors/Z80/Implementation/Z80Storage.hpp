@@ -111,9 +111,18 @@ class ProcessorStorage {
 				Reset
 			};
 			Type type = Type::Reset;
+
+			/// Operands are registers, which are stored as offsets from the ProcessorStorage
+			/// and should be obtained via @c resolve; the exceptions are SetInstructionPage,
+			/// which stores an InstructionPage *, and the conditionals, which store the
+			/// MicroOp * to continue with if the condition fails.
 			void *source = nullptr;
 			void *destination = nullptr;
+
+			/// Bus operations are performed from @c bus_cycles_[machine_cycle_index]; @c machine_cycle
+			/// is retained as a template only.
 			PartialMachineCycle machine_cycle{};
+			size_t machine_cycle_index = 0;
 		};
 
 		struct InstructionPage {
@@ -124,8 +133,36 @@ class ProcessorStorage {
 			bool is_indexed = false;
 		};
 
+		/*!
+			All micro-op programs; these are built once and then shared between all processors
+			that make the same use of the wait line.
+		*/
+		struct Programs {
+			std::vector<MicroOp> conditional_call_untaken;
+			std::vector<MicroOp> reset;
+			std::vector<MicroOp> irq[3];
+			std::vector<MicroOp> nmi;
+
+			InstructionPage base_page;
+			InstructionPage ed_page;
+			InstructionPage fd_page;
+			InstructionPage dd_page;
+
+			InstructionPage cb_page;
+			InstructionPage fdcb_page;
+			InstructionPage ddcb_page;
+
+			/// Every distinct bus cycle used by the programs above, with address and value stored as offsets.
+			std::vector<PartialMachineCycle> bus_cycles;
+		};
+
 		ProcessorStorage();
-		void install_default_instruction_set();
+		void install_default_instruction_set(bool uses_wait_line);
+
+		/// @returns The register at @c offset, as stored in a MicroOp.
+		template <typename RegisterT> RegisterT *resolve(const void *offset) {
+			return reinterpret_cast<RegisterT *>(reinterpret_cast<uint8_t *>(this) + reinterpret_cast<uintptr_t>(offset));
+		}
 
 		uint8_t a_;
 		RegisterPair16 bc_, de_, hl_;
@@ -170,20 +207,11 @@ class ProcessorStorage {
 
 		const MicroOp *scheduled_program_counter_ = nullptr;
 
-		std::vector<MicroOp> conditional_call_untaken_program_;
-		std::vector<MicroOp> reset_program_;
-		std::vector<MicroOp> irq_program_[3];
-		std::vector<MicroOp> nmi_program_;
-		InstructionPage *current_instruction_page_;
-
-		InstructionPage base_page_;
-		InstructionPage ed_page_;
-		InstructionPage fd_page_;
-		InstructionPage dd_page_;
+		const Programs *programs_ = nullptr;
+		const InstructionPage *current_instruction_page_ = nullptr;
 
-		InstructionPage cb_page_;
-		InstructionPage fdcb_page_;
-		InstructionPage ddcb_page_;
+		/// The bus cycles of @c programs_ with address and value pointing into this instance.
+		std::vector<PartialMachineCycle> bus_cycles_;
 
 		/*!
 			Gets the flags register.
@@ -224,10 +252,12 @@ class ProcessorStorage {
 		virtual void assemble_page(InstructionPage &target, InstructionTable &table, bool add_offsets) = 0;
 		virtual void copy_program(const MicroOp *source, std::vector<MicroOp> &destination) = 0;
 
+		void assemble_programs(Programs &programs);
 		void assemble_fetch_decode_execute(InstructionPage &target, int length);
 		void assemble_ed_page(InstructionPage &target);
 		void assemble_cb_page(InstructionPage &target, RegisterPair16 &index, bool add_offsets);
-		void assemble_base_page(InstructionPage &target, RegisterPair16 &index, bool add_offsets, InstructionPage &cb_page);
+		void assemble_base_page(Programs &programs, InstructionPage &target, RegisterPair16 &index, bool add_offsets, InstructionPage &cb_page);
+		void share_programs(Programs &programs);
 
 		// Allow state objects to capture and apply state.
 		friend struct State;
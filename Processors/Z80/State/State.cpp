@@ -52,46 +52,52 @@ State::State(const ProcessorBase &src): State() {
 	execution_state.half_cycles_into_step = src.number_of_cycles_.as<int>();
 
 	// Search for the current holder of the scheduled_program_counter_.
-#define ContainedBy(x)	(src.scheduled_program_counter_ >= &src.x[0]) && (src.scheduled_program_counter_ < &src.x[src.x.size()])
+	const auto &programs = *src.programs_;
+#define ContainedBy(x)	(src.scheduled_program_counter_ >= x.data()) && (src.scheduled_program_counter_ < x.data() + x.size())
 #define Populate(x, y)	\
 	execution_state.phase = ExecutionState::Phase::x;	\
-	execution_state.steps_into_phase = int(src.scheduled_program_counter_ - &src.y[0]);
-
-	if(ContainedBy(conditional_call_untaken_program_)) {
-		Populate(UntakenConditionalCall, conditional_call_untaken_program_);
-	} else if(ContainedBy(reset_program_)) {
-		Populate(Reset, reset_program_);
-	} else if(ContainedBy(irq_program_[0])) {
-		Populate(IRQMode0, irq_program_[0]);
-	} else if(ContainedBy(irq_program_[1])) {
-		Populate(IRQMode1, irq_program_[1]);
-	} else if(ContainedBy(irq_program_[2])) {
-		Populate(IRQMode2, irq_program_[2]);
-	} else if(ContainedBy(nmi_program_)) {
-		Populate(NMI, nmi_program_);
+	execution_state.steps_into_phase = int(src.scheduled_program_counter_ - y);
+
+	if(!src.scheduled_program_counter_) {
+		// The processor hasn't yet run, so it will start with its power-on reset.
+		execution_state.phase = ExecutionState::Phase::Reset;
+		execution_state.steps_into_phase = 0;
+		execution_state.requests &= ~ProcessorBase::Interrupt::PowerOn;
+	} else if(ContainedBy(programs.conditional_call_untaken)) {
+		Populate(UntakenConditionalCall, programs.conditional_call_untaken.data());
+	} else if(ContainedBy(programs.reset)) {
+		Populate(Reset, programs.reset.data());
+	} else if(ContainedBy(programs.irq[0])) {
+		Populate(IRQMode0, programs.irq[0].data());
+	} else if(ContainedBy(programs.irq[1])) {
+		Populate(IRQMode1, programs.irq[1].data());
+	} else if(ContainedBy(programs.irq[2])) {
+		Populate(IRQMode2, programs.irq[2].data());
+	} else if(ContainedBy(programs.nmi)) {
+		Populate(NMI, programs.nmi.data());
 	} else {
-		if(src.current_instruction_page_ == &src.base_page_) {
+		if(src.current_instruction_page_ == &programs.base_page) {
 			execution_state.instruction_page = 0;
-		} else if(src.current_instruction_page_ == &src.ed_page_) {
+		} else if(src.current_instruction_page_ == &programs.ed_page) {
 			execution_state.instruction_page = 0xed;
-		} else if(src.current_instruction_page_ == &src.fd_page_) {
+		} else if(src.current_instruction_page_ == &programs.fd_page) {
 			execution_state.instruction_page = 0xfd;
-		} else if(src.current_instruction_page_ == &src.dd_page_) {
+		} else if(src.current_instruction_page_ == &programs.dd_page) {
 			execution_state.instruction_page = 0xdd;
-		} else if(src.current_instruction_page_ == &src.cb_page_) {
+		} else if(src.current_instruction_page_ == &programs.cb_page) {
 			execution_state.instruction_page = 0xcb;
-		} else if(src.current_instruction_page_ == &src.fdcb_page_) {
+		} else if(src.current_instruction_page_ == &programs.fdcb_page) {
 			execution_state.instruction_page = 0xfdcb;
-		} else if(src.current_instruction_page_ == &src.ddcb_page_) {
+		} else if(src.current_instruction_page_ == &programs.ddcb_page) {
 			execution_state.instruction_page = 0xddcb;
 		}
 
-		if(ContainedBy(current_instruction_page_->fetch_decode_execute)) {
-			Populate(FetchDecode, current_instruction_page_->fetch_decode_execute);
+		if(ContainedBy(src.current_instruction_page_->fetch_decode_execute)) {
+			Populate(FetchDecode, src.current_instruction_page_->fetch_decode_execute.data());
 		} else {
 			// There's no need to determine which opcode because that knowledge is already
 			// contained in the dedicated opcode field.
-			Populate(Operation, current_instruction_page_->instructions[src.operation_ & src.halt_mask_]);
+			Populate(Operation, src.current_instruction_page_->instructions[src.operation_ & src.halt_mask_]);
 		}
 	}
 
@@ -101,7 +107,7 @@ State::State(const ProcessorBase &src): State() {
 #undef ContainedBy
 }
 
-void State::apply(ProcessorBase &target) {
+void State::apply(ProcessorBase &target) const {
 	// Registers.
 	target.a_ = registers.a;
 	target.set_flags(registers.flags);
@@ -140,24 +146,25 @@ void State::apply(ProcessorBase &target) {
 	target.refresh_addr_.full = execution_state.refresh_address;
 	target.number_of_cycles_ = HalfCycles(execution_state.half_cycles_into_step);
 
+	const auto &programs = *target.programs_;
 	switch(execution_state.instruction_page) {
-		default:		target.current_instruction_page_ = &target.base_page_;	break;
-		case 0xed:		target.current_instruction_page_ = &target.ed_page_;	break;
-		case 0xdd:		target.current_instruction_page_ = &target.dd_page_;	break;
-		case 0xcb:		target.current_instruction_page_ = &target.cb_page_;	break;
-		case 0xfd:		target.current_instruction_page_ = &target.fd_page_;	break;
-		case 0xfdcb:	target.current_instruction_page_ = &target.fdcb_page_;	break;
-		case 0xddcb:	target.current_instruction_page_ = &target.ddcb_page_;	break;
+		default:		target.current_instruction_page_ = &programs.base_page;	break;
+		case 0xed:		target.current_instruction_page_ = &programs.ed_page;	break;
+		case 0xdd:		target.current_instruction_page_ = &programs.dd_page;	break;
+		case 0xcb:		target.current_instruction_page_ = &programs.cb_page;	break;
+		case 0xfd:		target.current_instruction_page_ = &programs.fd_page;	break;
+		case 0xfdcb:	target.current_instruction_page_ = &programs.fdcb_page;	break;
+		case 0xddcb:	target.current_instruction_page_ = &programs.ddcb_page;	break;
 	}
 
 	switch(execution_state.phase) {
-		case ExecutionState::Phase::UntakenConditionalCall:		target.scheduled_program_counter_ = &target.conditional_call_untaken_program_[0];						break;
-		case ExecutionState::Phase::Reset:						target.scheduled_program_counter_ = &target.reset_program_[0];											break;
-		case ExecutionState::Phase::IRQMode0:					target.scheduled_program_counter_ = &target.irq_program_[0][0];											break;
-		case ExecutionState::Phase::IRQMode1:					target.scheduled_program_counter_ = &target.irq_program_[1][0];											break;
-		case ExecutionState::Phase::IRQMode2:					target.scheduled_program_counter_ = &target.irq_program_[2][0];											break;
-		case ExecutionState::Phase::NMI:						target.scheduled_program_counter_ = &target.nmi_program_[0];											break;
-		case ExecutionState::Phase::FetchDecode:				target.scheduled_program_counter_ = &target.current_instruction_page_->fetch_decode_execute[0];			break;
+		case ExecutionState::Phase::UntakenConditionalCall:		target.scheduled_program_counter_ = programs.conditional_call_untaken.data();							break;
+		case ExecutionState::Phase::Reset:						target.scheduled_program_counter_ = programs.reset.data();												break;
+		case ExecutionState::Phase::IRQMode0:					target.scheduled_program_counter_ = programs.irq[0].data();												break;
+		case ExecutionState::Phase::IRQMode1:					target.scheduled_program_counter_ = programs.irq[1].data();												break;
+		case ExecutionState::Phase::IRQMode2:					target.scheduled_program_counter_ = programs.irq[2].data();												break;
+		case ExecutionState::Phase::NMI:						target.scheduled_program_counter_ = programs.nmi.data();												break;
+		case ExecutionState::Phase::FetchDecode:				target.scheduled_program_counter_ = target.current_instruction_page_->fetch_decode_execute.data();		break;
 		case ExecutionState::Phase::Operation:					target.scheduled_program_counter_ = target.current_instruction_page_->instructions[target.operation_];	break;
 	}
 	target.scheduled_program_counter_ += execution_state.steps_into_phase;
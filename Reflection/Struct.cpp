@@ -110,7 +110,8 @@ template <> bool Reflection::set(Struct &target, const std::string &name, bool v
 	if(!target_type) return false;
 
 	if(*target_type == typeid(bool)) {
-		target.set(name, &value, offset);;
+		target.set(name, &value, offset);
+		return true;
 	}
 
 	return false;
@@ -278,7 +279,7 @@ std::vector<uint8_t> Reflection::Struct::serialise() const {
 		if(!Reflection::Enum::name(*type).empty()) {
 			int value;
 			Reflection::get(*this, key, value, offset);
-			const auto text = Reflection::Enum::to_string(*type, 0);
+			const auto text = Reflection::Enum::to_string(*type, value);
 			push_string(text);
 			return;
 		}
@@ -448,13 +449,14 @@ bool Reflection::Struct::deserialise(const uint8_t *bson, size_t size) {
 	// Validate the object's declared size.
 	const auto end = bson + size;
 	auto read_int = [&bson] (auto &target) {
-		constexpr auto shift = 8 * (sizeof(target) - 1);
-		target = 0;
+		// Assemble as unsigned, to avoid sign extension as bytes are shifted in.
+		using IntT = std::remove_reference_t<decltype(target)>;
+		std::make_unsigned_t<IntT> value = 0;
 		for(size_t c = 0; c < sizeof(target); ++c) {
-			target >>= 8;
-			target |= decltype(target)(*bson) << shift;
+			value |= decltype(value)(*bson) << (8 * c);
 			++bson;
 		}
+		target = IntT(value);
 	};
 
 	uint32_t object_size;
@@ -487,15 +489,21 @@ bool Reflection::Struct::deserialise(const uint8_t *bson, size_t size) {
 				uint32_t subobject_size;
 				read_int(subobject_size);
 
-				if(next_type == 0x03 && *type == typeid(Reflection::Struct)) {
-					auto child = reinterpret_cast<Reflection::Struct *>(get(key));
-					child->deserialise(bson - 4, size_t(end - bson + 4));
+				// Anything with an unrecognised key is skipped.
+				if(next_type == 0x03) {
+					if(type && *type == typeid(Reflection::Struct)) {
+						auto child = reinterpret_cast<Reflection::Struct *>(get(key));
+						child->deserialise(bson - 4, size_t(end - bson + 4));
+					}
 					bson += subobject_size - 4;
-				}
-
-				if(next_type == 0x05 && *type == typeid(std::vector<uint8_t>)) {
-					auto child = reinterpret_cast<std::vector<uint8_t> *>(get(key));
-					*child = std::vector<uint8_t>(bson, bson + subobject_size);
+				} else {
+					// Binary data is followed by a subtype byte; serialise always writes 0x00,
+					// generic binary, and the subtype has no bearing on what follows.
+					++bson;
+					if(type && *type == typeid(std::vector<uint8_t>)) {
+						auto child = reinterpret_cast<std::vector<uint8_t> *>(get(key));
+						child->assign(bson, bson + subobject_size);
+					}
 					bson += subobject_size;
 				}
 			} break;
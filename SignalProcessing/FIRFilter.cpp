@@ -8,6 +8,7 @@
 
 #include "FIRFilter.hpp"
 
+#include <algorithm>
 #include <cmath>
 
 #ifndef M_PI
@@ -51,18 +52,19 @@ float FIRFilter::ino(float a) {
 	return s;
 }
 
-void FIRFilter::coefficients_for_idealised_filter_response(short *filter_coefficients, float *A, float attenuation, std::size_t number_of_taps) {
-	/* calculate alpha, which is the Kaiser-Bessel window shape factor */
-	float a;	// to take the place of alpha in the normal derivation
-
+/*! Calculates alpha, the Kaiser-Bessel window shape factor, for the given attenuation. */
+float FIRFilter::kaiser_alpha(float attenuation) {
 	if(attenuation < 21.0f) {
-		a = 0.0f;
-	} else {
-		if(attenuation > 50.0f)
-			a = 0.1102f * (attenuation - 8.7f);
-		else
-			a = 0.5842f * powf(attenuation - 21.0f, 0.4f) + 0.7886f * (attenuation - 21.0f);
+		return 0.0f;
 	}
+	if(attenuation > 50.0f) {
+		return 0.1102f * (attenuation - 8.7f);
+	}
+	return 0.5842f * powf(attenuation - 21.0f, 0.4f) + 0.7886f * (attenuation - 21.0f);
+}
+
+void FIRFilter::coefficients_for_idealised_filter_response(short *filter_coefficients, float *A, float attenuation, std::size_t number_of_taps) {
+	const float a = kaiser_alpha(attenuation);	// to take the place of alpha in the normal derivation
 
 	std::vector<float> filter_coefficients_float(number_of_taps);
 
@@ -175,3 +177,54 @@ FIRFilter FIRFilter::operator*(const FIRFilter &rhs) const {
 
 	return FIRFilter(sum);
 }
+
+std::vector<FIRFilter> FIRFilter::polyphase_bank(std::size_t number_of_phases, std::size_t number_of_taps, float input_sample_rate, float low_frequency, float high_frequency, float attenuation) {
+	// Apply the same sanity constraints as the constructor.
+	if(number_of_phases < 1) number_of_phases = 1;
+	if(number_of_taps < 3) number_of_taps = 3;
+	if(attenuation < 21.0f) attenuation = 21.0f;
+	number_of_taps |= 1;
+	high_frequency = std::min(high_frequency, input_sample_rate * 0.5f);
+
+	// Evaluate the windowed ideal response directly at each fractional offset. The window extends
+	// a sample beyond the outermost taps so that it remains defined for every phase.
+	const float a = kaiser_alpha(attenuation);
+	const float I0 = ino(a);
+	const float Np = float((number_of_taps - 1) / 2);
+	const float window_radius = Np + 1.0f;
+
+	std::vector<FIRFilter> bank;
+	bank.reserve(number_of_phases);
+	std::vector<float> coefficients(number_of_taps);
+	for(std::size_t phase = 0; phase < number_of_phases; ++phase) {
+		const float offset = float(phase) / float(number_of_phases);
+
+		float total = 0.0f;
+		for(std::size_t i = 0; i < number_of_taps; ++i) {
+			const float x = float(i) - Np - offset;
+
+			float ideal;
+			if(fabsf(x) < 1e-6f) {
+				ideal = 2.0f * (high_frequency - low_frequency) / input_sample_rate;
+			} else {
+				const float x_pi = x * float(M_PI);
+				ideal = (
+					sinf(2.0f * x_pi * high_frequency / input_sample_rate) -
+					sinf(2.0f * x_pi * low_frequency / input_sample_rate)
+				) / x_pi;
+			}
+
+			const float window = ino(a * sqrtf(1.0f - (x * x) / (window_radius * window_radius))) / I0;
+			coefficients[i] = ideal * window;
+			total += coefficients[i];
+		}
+
+		// Normalise each phase individually so that all retain 100% of input volume.
+		for(auto &coefficient: coefficients) {
+			coefficient /= total;
+		}
+		bank.emplace_back(coefficients);
+	}
+
+	return bank;
+}
@@ -15,9 +15,17 @@
 #if defined(__APPLE__) && !defined(TARGET_QT)
 #include <Accelerate/Accelerate.h>
 #define USE_ACCELERATE
+#elif defined(__SSE2__) || defined(_M_X64)
+#define USE_SSE2_FIR
+#include <emmintrin.h>
+#include "../Numeric/CPUFeatures.hpp"
+#elif defined(__ARM_NEON)
+#define USE_NEON_FIR
+#include <arm_neon.h>
 #endif
 
 #include <cstddef>
+#include <cstdint>
 #include <vector>
 
 namespace SignalProcessing {
@@ -48,6 +56,17 @@ class FIRFilter {
 		FIRFilter(std::size_t number_of_taps, float input_sample_rate, float low_frequency, float high_frequency, float attenuation = DefaultAttenuation);
 		FIRFilter(const std::vector<float> &coefficients);
 
+		/*!
+			Creates a bank of @c number_of_phases filters for polyphase resampling. Each has the same
+			low-pass response as a filter created with the same parameters by the constructor above, but
+			phase @c p is centred @c p/number_of_phases of an input sample later than the midpoint of its
+			window. So a resampler can pick the phase that best matches the fractional position of each
+			output sample, evaluating only that phase.
+
+			Each phase has @c number_of_taps taps, rounded as by the constructor.
+		*/
+		static std::vector<FIRFilter> polyphase_bank(std::size_t number_of_phases, std::size_t number_of_taps, float input_sample_rate, float low_frequency, float high_frequency, float attenuation = DefaultAttenuation);
+
 		/*!
 			Applies the filter to one batch of input samples, returning the net result.
 
@@ -60,11 +79,90 @@ class FIRFilter {
 				vDSP_dotpr_s1_15(filter_coefficients_.data(), 1, src, vDSP_Stride(stride), &result, filter_coefficients_.size());
 				return result;
 			#else
-				int outputValue = 0;
-				for(std::size_t c = 0; c < filter_coefficients_.size(); ++c) {
-					outputValue += filter_coefficients_[c] * src[c * stride];
+				const std::size_t taps = filter_coefficients_.size();
+				const short *const coefficients = filter_coefficients_.data();
+				std::size_t c = 0;
+				int32_t output_value = 0;
+
+				// Vectorise only the common, contiguous case. Sums are formed in 32-bit lanes, which
+				// wrap identically to the scalar sum, so the result is the same in any order.
+				if(stride == 1) {
+					#if defined(USE_SSE2_FIR)
+						#ifdef AVX2_TARGET
+						if(use_avx2_) {
+							output_value = apply_avx2(coefficients, src, taps, c);
+						} else
+						#endif
+						{
+							output_value = apply_sse2(coefficients, src, taps, c);
+						}
+					#elif defined(USE_NEON_FIR)
+						int32x4_t sum = vdupq_n_s32(0);
+						for(; c + 8 <= taps; c += 8) {
+							const int16x8_t coefficient_vector = vld1q_s16(&coefficients[c]);
+							const int16x8_t source_vector = vld1q_s16(&src[c]);
+							sum = vmlal_s16(sum, vget_low_s16(coefficient_vector), vget_low_s16(source_vector));
+							sum = vmlal_s16(sum, vget_high_s16(coefficient_vector), vget_high_s16(source_vector));
+						}
+						output_value = horizontal_sum(sum);
+					#endif
 				}
-				return short(outputValue >> FixedShift);
+
+				for(; c < taps; ++c) {
+					output_value += coefficients[c] * src[c * stride];
+				}
+				return short(output_value >> FixedShift);
+			#endif
+		}
+
+		/*!
+			Applies the filter to one batch of interleaved stereo input samples, i.e. exactly as if
+			@c apply(src, 2) and @c apply(src + 1, 2) had been called, but with only a single pass
+			over the input.
+
+			@param src The source buffer to apply the filter to.
+			@param target The destination for the left and right results, in that order.
+		*/
+		inline void apply_stereo(const short *src, short *target) const {
+			#ifdef USE_ACCELERATE
+				target[0] = apply(src, 2);
+				target[1] = apply(src + 1, 2);
+			#else
+				const std::size_t taps = filter_coefficients_.size();
+				const short *const coefficients = filter_coefficients_.data();
+				std::size_t c = 0;
+				int32_t left = 0, right = 0;
+
+				#if defined(USE_SSE2_FIR)
+					#ifdef AVX2_TARGET
+					if(use_avx2_) {
+						apply_stereo_avx2(coefficients, src, taps, c, left, right);
+					} else
+					#endif
+					{
+						apply_stereo_sse2(coefficients, src, taps, c, left, right);
+					}
+				#elif defined(USE_NEON_FIR)
+					// NEON can deinterleave directly on load.
+					int32x4_t left_sum = vdupq_n_s32(0), right_sum = vdupq_n_s32(0);
+					for(; c + 8 <= taps; c += 8) {
+						const int16x8_t coefficient_vector = vld1q_s16(&coefficients[c]);
+						const int16x8x2_t source_vectors = vld2q_s16(&src[c * 2]);
+						left_sum = vmlal_s16(left_sum, vget_low_s16(coefficient_vector), vget_low_s16(source_vectors.val[0]));
+						left_sum = vmlal_s16(left_sum, vget_high_s16(coefficient_vector), vget_high_s16(source_vectors.val[0]));
+						right_sum = vmlal_s16(right_sum, vget_low_s16(coefficient_vector), vget_low_s16(source_vectors.val[1]));
+						right_sum = vmlal_s16(right_sum, vget_high_s16(coefficient_vector), vget_high_s16(source_vectors.val[1]));
+					}
+					left = horizontal_sum(left_sum);
+					right = horizontal_sum(right_sum);
+				#endif
+
+				for(; c < taps; ++c) {
+					left += coefficients[c] * src[c * 2];
+					right += coefficients[c] * src[c * 2 + 1];
+				}
+				target[0] = short(left >> FixedShift);
+				target[1] = short(right >> FixedShift);
 			#endif
 		}
 
@@ -98,6 +196,83 @@ class FIRFilter {
 
 		static void coefficients_for_idealised_filter_response(short *filterCoefficients, float *A, float attenuation, std::size_t numberOfTaps);
 		static float ino(float a);
+		static float kaiser_alpha(float attenuation);
+
+#if defined(USE_SSE2_FIR)
+		static inline int32_t horizontal_sum(__m128i sum) {
+			sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0x4e));
+			sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0xb1));
+			return _mm_cvtsi128_si32(sum);
+		}
+
+		/// Forms the dot product of as many complete vectors of @c coefficients and @c src as there are
+		/// in @c taps, advancing @c c past them.
+		static inline int32_t apply_sse2(const short *coefficients, const short *src, std::size_t taps, std::size_t &c) {
+			__m128i sum = _mm_setzero_si128();
+			for(; c + 8 <= taps; c += 8) {
+				sum = _mm_add_epi32(sum, _mm_madd_epi16(
+					_mm_loadu_si128(reinterpret_cast<const __m128i *>(&coefficients[c])),
+					_mm_loadu_si128(reinterpret_cast<const __m128i *>(&src[c]))));
+			}
+			return horizontal_sum(sum);
+		}
+
+		/// As per apply_sse2, but for interleaved stereo, forming separate @c left and @c right products.
+		static inline void apply_stereo_sse2(const short *coefficients, const short *src, std::size_t taps, std::size_t &c, int32_t &left, int32_t &right) {
+			// Shuffle L0 R0 L1 R1 L2 R2 L3 R3 into L0 L1 L2 L3 R0 R1 R2 R3 and multiply
+			// by c0 c1 c2 c3 c0 c1 c2 c3, giving 32-bit lanes L L R R.
+			__m128i sum = _mm_setzero_si128();
+			for(; c + 4 <= taps; c += 4) {
+				const __m128i coefficient_half = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(&coefficients[c]));
+				const __m128i coefficient_vector = _mm_unpacklo_epi64(coefficient_half, coefficient_half);
+				__m128i source_vector = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&src[c * 2]));
+				source_vector = _mm_shufflelo_epi16(source_vector, 0xd8);
+				source_vector = _mm_shufflehi_epi16(source_vector, 0xd8);
+				source_vector = _mm_shuffle_epi32(source_vector, 0xd8);
+				sum = _mm_add_epi32(sum, _mm_madd_epi16(coefficient_vector, source_vector));
+			}
+			left = _mm_cvtsi128_si32(_mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0x01)));
+			right = _mm_cvtsi128_si32(_mm_add_epi32(_mm_shuffle_epi32(sum, 0x02), _mm_shuffle_epi32(sum, 0x03)));
+		}
+
+#ifdef AVX2_TARGET
+		// AVX2 equivalents of the above, selected at runtime if the host supports AVX2.
+		bool use_avx2_ = Numeric::has_avx2();
+
+		AVX2_TARGET static int32_t apply_avx2(const short *coefficients, const short *src, std::size_t taps, std::size_t &c) {
+			__m256i sum = _mm256_setzero_si256();
+			for(; c + 16 <= taps; c += 16) {
+				sum = _mm256_add_epi32(sum, _mm256_madd_epi16(
+					_mm256_loadu_si256(reinterpret_cast<const __m256i *>(&coefficients[c])),
+					_mm256_loadu_si256(reinterpret_cast<const __m256i *>(&src[c]))));
+			}
+			return horizontal_sum(_mm_add_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1)));
+		}
+
+		AVX2_TARGET static void apply_stereo_avx2(const short *coefficients, const short *src, std::size_t taps, std::size_t &c, int32_t &left, int32_t &right) {
+			// As per the SSE2 loop, but on each 128-bit half.
+			__m256i sum = _mm256_setzero_si256();
+			for(; c + 8 <= taps; c += 8) {
+				const __m256i coefficient_vector = _mm256_permute4x64_epi64(
+					_mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i *>(&coefficients[c]))),
+					0x50);
+				__m256i source_vector = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(&src[c * 2]));
+				source_vector = _mm256_shufflelo_epi16(source_vector, 0xd8);
+				source_vector = _mm256_shufflehi_epi16(source_vector, 0xd8);
+				source_vector = _mm256_shuffle_epi32(source_vector, 0xd8);
+				sum = _mm256_add_epi32(sum, _mm256_madd_epi16(coefficient_vector, source_vector));
+			}
+			const __m128i half_sum = _mm_add_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+			left = _mm_cvtsi128_si32(_mm_add_epi32(half_sum, _mm_shuffle_epi32(half_sum, 0x01)));
+			right = _mm_cvtsi128_si32(_mm_add_epi32(_mm_shuffle_epi32(half_sum, 0x02), _mm_shuffle_epi32(half_sum, 0x03)));
+		}
+#endif
+#elif defined(USE_NEON_FIR)
+		static inline int32_t horizontal_sum(int32x4_t sum) {
+			const int32x2_t pair = vadd_s32(vget_low_s32(sum), vget_high_s32(sum));
+			return vget_lane_s32(vpadd_s32(pair, pair), 0);
+		}
+#endif
 };
 
 }
@@ -60,7 +60,7 @@ void Controller::process_event(const Drive::Event &event) {
 }
 
 void Controller::advance(const Cycles cycles) {
-	if(is_reading_) pll_.run_for(Cycles(cycles.as_integral() * clock_rate_multiplier_));
+	if(is_reading_ && is_listening_) pll_.run_for(Cycles(cycles.as_integral() * clock_rate_multiplier_));
 }
 
 void Controller::process_write_completed() {
@@ -114,6 +114,7 @@ void Controller::set_drive(int index_mask) {
 	}
 
 	get_drive().set_event_delegate(this);
+	get_drive().set_event_delegate_is_listening(is_listening_);
 
 	if(preferred_clocking() != former_preference) {
 		update_clocking_observer();
@@ -135,3 +136,8 @@ void Controller::end_writing() {
 bool Controller::is_reading() {
 	return is_reading_;
 }
+
+void Controller::set_is_listening(bool is_listening) {
+	is_listening_ = is_listening;
+	get_drive().set_event_delegate_is_listening(is_listening);
+}
@@ -114,6 +114,13 @@ class Controller:
 		*/
 		bool is_reading();
 
+		/*!
+			Indicates whether the controller currently needs to receive bits from the disk, e.g. because it is
+			performing a command. While it does not, the selected drive announces only index holes and no calls
+			are made to @c process_input_bit. Controllers are listening by default.
+		*/
+		void set_is_listening(bool);
+
 		/*!
 			Returns the connected drive or, if none is connected, an invented one. No guarantees are
 			made about the lifetime or the exclusivity of the invented drive.
@@ -143,6 +150,7 @@ class Controller:
 		Cycles::IntType clock_rate_ = 1;
 
 		bool is_reading_ = true;
+		bool is_listening_ = true;
 
 		DigitalPhaseLockedLoop<Controller> pll_;
 		friend DigitalPhaseLockedLoop<Controller>;
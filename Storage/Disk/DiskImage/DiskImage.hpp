@@ -9,8 +9,10 @@
 #ifndef DiskImage_hpp
 #define DiskImage_hpp
 
+#include <atomic>
 #include <map>
 #include <memory>
+#include <mutex>
 
 #include "../Disk.hpp"
 #include "../Track/Track.hpp"
@@ -81,6 +83,16 @@ class DiskImageHolderBase: public Disk {
 		std::set<Track::Address> unwritten_tracks_;
 		std::map<Track::Address, std::shared_ptr<Track>> cached_tracks_;
 		std::unique_ptr<Concurrency::AsyncTaskQueue<true>> update_queue_;
+
+		// cached_tracks_ is also populated from the update queue, so is guarded by cache_mutex_;
+		// all track reads and writes on the underlying image are serialised by image_mutex_.
+		std::mutex cache_mutex_;
+		std::mutex image_mutex_;
+
+		// Prefetching is centred on the most recently requested head position; incrementing
+		// prefetch_generation_ causes any prefetch in progress to be abandoned.
+		HeadPosition prefetch_position_ = HeadPosition(-1);
+		std::atomic<int> prefetch_generation_ = 0;
 };
 
 /*!
@@ -88,6 +100,10 @@ class DiskImageHolderBase: public Disk {
 	thereby, an intermediate store for modified tracks so that mutable disk images can either
 	update on the fly or perform a block update on closure, as appropriate.
 
+	Whenever a track is requested at a new head position, the tracks within two positions of it,
+	on all heads, are decoded in the background so that they are likely already to be cached by
+	the time that the head steps to them.
+
 	Implements TargetPlatform::TypeDistinguisher to return either no information whatsoever, if
 	the underlying image doesn't implement TypeDistinguisher, or else to pass the call along.
 */
@@ -108,6 +124,14 @@ template <typename T> class DiskImageHolder: public DiskImageHolderBase, public
 	private:
 		T disk_image_;
 
+		/// Obtains the track at @c address from the cache, or else from the disk image. If @c generation is
+		/// non-negative then this is a prefetch, which will be abandoned if the prefetch generation changes.
+		std::shared_ptr<Track> cached_track_at_position(Track::Address address, int generation = -1);
+
+		/// @returns @c true if the track at @c address is cached, storing it to @c track; @c false otherwise.
+		bool find_cached_track(Track::Address address, std::shared_ptr<Track> &track);
+		void prefetch_around(HeadPosition position);
+
 		TargetPlatform::Type target_platform_type() final {
 			if constexpr (std::is_base_of<TargetPlatform::TypeDistinguisher, T>::value) {
 				return static_cast<TargetPlatform::TypeDistinguisher *>(&disk_image_)->target_platform_type();
@@ -24,12 +24,16 @@ template <typename T> void DiskImageHolder<T>::flush_tracks() {
 
 		using TrackMap = std::map<Track::Address, std::shared_ptr<Track>>;
 		std::shared_ptr<TrackMap> track_copies(new TrackMap);
-		for(const auto &address : unwritten_tracks_) {
-			track_copies->insert(std::make_pair(address, std::shared_ptr<Track>(cached_tracks_[address]->clone())));
+		{
+			std::lock_guard lock(cache_mutex_);
+			for(const auto &address : unwritten_tracks_) {
+				track_copies->insert(std::make_pair(address, std::shared_ptr<Track>(cached_tracks_[address]->clone())));
+			}
 		}
 		unwritten_tracks_.clear();
 
 		update_queue_->enqueue([this, track_copies]() {
+			std::lock_guard lock(image_mutex_);
 			disk_image_.set_tracks(*track_copies);
 		});
 	}
@@ -39,6 +43,7 @@ template <typename T> void DiskImageHolder<T>::set_track_at_position(Track::Addr
 	if(disk_image_.get_is_read_only()) return;
 
 	unwritten_tracks_.insert(address);
+	std::lock_guard lock(cache_mutex_);
 	cached_tracks_[address] = track;
 }
 
@@ -46,16 +51,73 @@ template <typename T> std::shared_ptr<Track> DiskImageHolder<T>::get_track_at_po
 	if(address.head >= get_head_count()) return nullptr;
 	if(address.position >= get_maximum_head_position()) return nullptr;
 
-	auto cached_track = cached_tracks_.find(address);
-	if(cached_track != cached_tracks_.end()) return cached_track->second;
+	std::shared_ptr<Track> track;
+	if(!find_cached_track(address, track)) {
+		// Abandon any prefetch in progress so that it releases the image as soon as its current
+		// track is complete, rather than leaving this request to wait behind all of its remaining
+		// tracks. Prefetching then restarts around this position.
+		++prefetch_generation_;
+		prefetch_position_ = HeadPosition(-1);
+		track = cached_track_at_position(address);
+	}
 
-	std::shared_ptr<Track> track = disk_image_.get_track_at_position(address);
-	if(!track) return nullptr;
-	cached_tracks_[address] = track;
+	if(address.position != prefetch_position_) {
+		prefetch_position_ = address.position;
+		prefetch_around(address.position);
+	}
 	return track;
 }
 
+template <typename T> bool DiskImageHolder<T>::find_cached_track(Track::Address address, std::shared_ptr<Track> &track) {
+	std::lock_guard lock(cache_mutex_);
+	const auto cached_track = cached_tracks_.find(address);
+	if(cached_track == cached_tracks_.end()) return false;
+	track = cached_track->second;
+	return true;
+}
+
+template <typename T> std::shared_ptr<Track> DiskImageHolder<T>::cached_track_at_position(Track::Address address, int generation) {
+	std::shared_ptr<Track> track;
+	if(find_cached_track(address, track)) return track;
+
+	std::lock_guard image_lock(image_mutex_);
+
+	// A prefetch that has been abandoned while waiting for the image shouldn't proceed.
+	if(generation >= 0 && generation != prefetch_generation_) return nullptr;
+
+	// The track may have been obtained on another thread while this one was waiting for the image.
+	if(find_cached_track(address, track)) return track;
+
+	// Absent tracks are also cached, to avoid repeated attempts to decode them.
+	track = disk_image_.get_track_at_position(address);
+	std::lock_guard lock(cache_mutex_);
+	return cached_tracks_.emplace(address, track).first->second;
+}
+
+template <typename T> void DiskImageHolder<T>::prefetch_around(HeadPosition position) {
+	if(!update_queue_) update_queue_ = std::make_unique<Concurrency::AsyncTaskQueue<true>>();
+
+	const int generation = ++prefetch_generation_;
+	const int head_count = get_head_count();
+	const HeadPosition maximum_position = get_maximum_head_position();
+	update_queue_->enqueue([this, generation, position, head_count, maximum_position] {
+		// Visit the nearest positions first.
+		for(const int offset: {0, 1, -1, 2, -2}) {
+			const HeadPosition target(position.as_quarter() + offset * 4, 4);
+			if(target < HeadPosition(0) || target >= maximum_position) continue;
+
+			for(int head = 0; head < head_count; head++) {
+				// Stop if the head has moved on since this prefetch was requested.
+				if(generation != prefetch_generation_) return;
+				cached_track_at_position(Track::Address(head, target), generation);
+			}
+		}
+	});
+}
+
 template <typename T> DiskImageHolder<T>::~DiskImageHolder() {
+	// Abandon any prefetching, but complete any writes.
+	++prefetch_generation_;
 	if(update_queue_) update_queue_->flush();
 }
 
@@ -25,16 +25,21 @@ std::shared_ptr<Track> MFMSectorDump::get_track_at_position(Track::Address addre
 	if(address.head >= get_head_count()) return nullptr;
 	if(address.position.as_largest() >= get_maximum_head_position().as_largest()) return nullptr;
 
-	uint8_t sectors[(128 << sector_size_)*sectors_per_track_];
+	const size_t size = size_t(128 << sector_size_) * size_t(sectors_per_track_);
 	const long file_offset = get_file_offset_for_position(address);
 
-	{
-		std::lock_guard lock_guard(file_.get_file_access_mutex());
-		file_.seek(file_offset, SEEK_SET);
-		file_.read(sectors, sizeof(sectors));
+	// Use the file's contents in place if possible; otherwise read them. In either case
+	// the lock is held throughout, as the view may be invalidated by any other call to view.
+	std::lock_guard lock_guard(file_.get_file_access_mutex());
+	const auto view = file_.view(file_offset, size);
+	if(!view.empty()) {
+		return track_for_sectors(view.data(), sectors_per_track_, uint8_t(address.position.as_int()), uint8_t(address.head), first_sector_, sector_size_, is_double_density_);
 	}
 
-	return track_for_sectors(sectors, sectors_per_track_, uint8_t(address.position.as_int()), uint8_t(address.head), first_sector_, sector_size_, is_double_density_);
+	file_.seek(file_offset, SEEK_SET);
+	auto sectors = file_.read(size);
+	sectors.resize(size);
+	return track_for_sectors(sectors.data(), sectors_per_track_, uint8_t(address.position.as_int()), uint8_t(address.head), first_sector_, sector_size_, is_double_density_);
 }
 
 void MFMSectorDump::set_tracks(const std::map<Track::Address, std::shared_ptr<Track>> &tracks) {
@@ -197,6 +197,10 @@ void Drive::set_event_delegate(Storage::Disk::Drive::EventDelegate *delegate) {
 	event_delegate_ = delegate;
 }
 
+void Drive::set_event_delegate_is_listening(bool is_listening) {
+	event_delegate_is_listening_ = is_listening;
+}
+
 void Drive::advance(const Cycles cycles) {
 	cycles_since_index_hole_ += cycles.as_integral();
 	if(event_delegate_) event_delegate_->advance(cycles);
@@ -217,9 +221,20 @@ void Drive::run_for(const Cycles cycles) {
 
 	if(disk_is_rotating_) {
 		if(has_disk_) {
-			Time zero(0);
-
 			auto number_of_cycles = cycles.as_integral();
+			if(should_skip_events()) {
+				number_of_cycles = run_without_events(number_of_cycles);
+			}
+
+			// If events have been skipped, resume from the current position within the track.
+			if(number_of_cycles && track_events_are_stale_) {
+				track_events_are_stale_ = false;
+				reset_timer();
+				random_interval_ = 0.0f;
+				setup_track();
+			}
+
+			Time zero(0);
 			while(number_of_cycles) {
 				auto cycles_until_next_event = get_cycles_until_next_event();
 				auto cycles_to_run_for = std::min(cycles_until_next_event, number_of_cycles);
@@ -322,14 +337,7 @@ void Drive::get_next_event(float duration_already_passed) {
 
 void Drive::process_next_event() {
 	if(current_event_.type == Track::Event::IndexHole) {
-		++ready_index_count_;
-		if(ready_index_count_ == 2 && (ready_type_ == ReadyType::ShugartRDY || ready_type_ == ReadyType::ShugartModifiedRDY)) {
-			is_ready_ = true;
-		}
-		cycles_since_index_hole_ = 0;
-
-		// Begin a 2ms period of holding the index line pulse active.
-		index_pulse_remaining_ = Cycles((get_input_clock_rate() * 2) / 1000);
+		process_index_hole();
 	}
 	if(
 		event_delegate_ &&
@@ -340,6 +348,50 @@ void Drive::process_next_event() {
 	get_next_event(0.0f);
 }
 
+void Drive::process_index_hole() {
+	++ready_index_count_;
+	if(ready_index_count_ == 2 && (ready_type_ == ReadyType::ShugartRDY || ready_type_ == ReadyType::ShugartModifiedRDY)) {
+		is_ready_ = true;
+	}
+	cycles_since_index_hole_ = 0;
+
+	// Begin a 2ms period of holding the index line pulse active.
+	index_pulse_remaining_ = Cycles((get_input_clock_rate() * 2) / 1000);
+}
+
+bool Drive::should_skip_events() const {
+	return is_reading_ && (!event_delegate_ || !event_delegate_is_listening_);
+}
+
+Cycles::IntType Drive::run_without_events(Cycles::IntType number_of_cycles) {
+	track_events_are_stale_ = true;
+
+	// The index hole is passed once every cycles_per_revolution_ cycles.
+	while(true) {
+		const auto cycles_until_index_hole = std::max(cycles_per_revolution_ - cycles_since_index_hole_, Cycles::IntType(0));
+		if(cycles_until_index_hole > number_of_cycles) break;
+
+		advance(Cycles(cycles_until_index_hole));
+		number_of_cycles -= cycles_until_index_hole;
+
+		process_index_hole();
+		if(event_delegate_) {
+			Event event;
+			event.type = Track::Event::IndexHole;
+			event.length = 1.0f;
+			event_delegate_->process_event(event);
+
+			// The delegate may have started listening in response.
+			if(!should_skip_events()) return number_of_cycles;
+		}
+	}
+
+	if(number_of_cycles) {
+		advance(Cycles(number_of_cycles));
+	}
+	return 0;
+}
+
 // MARK: - Track management
 
 std::shared_ptr<Track> Drive::get_track() {
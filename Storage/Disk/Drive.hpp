@@ -160,6 +160,13 @@ class Drive: public ClockingHint::Source, public TimedEventLoop {
 		/// Sets the current event delegate.
 		void set_event_delegate(EventDelegate *);
 
+		/*!
+			Indicates whether the event delegate currently wants to be informed of flux transitions. While it doesn't,
+			and unless writing, the drive tracks rotation arithmetically rather than via the track's events,
+			announcing index holes only. A drive without an event delegate behaves as if its delegate isn't listening.
+		*/
+		void set_event_delegate_is_listening(bool);
+
 		// As per Sleeper.
 		ClockingHint::Preference preferred_clocking() const final;
 
@@ -272,6 +279,17 @@ class Drive: public ClockingHint::Source, public TimedEventLoop {
 
 		// The target (if any) for track events.
 		EventDelegate *event_delegate_ = nullptr;
+		bool event_delegate_is_listening_ = true;
+
+		// Set if time has been spent without track events, in which case the position
+		// within the current track will need to be reestablished before the next.
+		bool track_events_are_stale_ = false;
+
+		// Advances rotation without track events, announcing only index holes, until either the time
+		// supplied has elapsed or the delegate resumes listening; returns the number of cycles remaining.
+		bool should_skip_events() const;
+		Cycles::IntType run_without_events(Cycles::IntType);
+		void process_index_hole();
 
 		/*!
 			@returns the track underneath the current head at the location now stepped to.
@@ -8,13 +8,107 @@
 
 #include "PCMSegment.hpp"
 
+#include "../../../Numeric/LeadingZeroes.hpp"
+
+#include <algorithm>
 #include <cassert>
 #include <cstdlib>
 
 using namespace Storage::Disk;
 
+namespace {
+
+/// Packs @c bits into 64-bit words, MSB first, producing at least @c minimum_size words.
+std::vector<uint64_t> pack(const std::vector<bool> &bits, size_t minimum_size) {
+	std::vector<uint64_t> result(std::max((bits.size() + 63) >> 6, minimum_size));
+
+	auto word = result.begin();
+	uint64_t shift_register = 0;
+	int bits_in_register = 0;
+	for(const auto bit: bits) {
+		shift_register = (shift_register << 1) | (bit ? 1 : 0);
+		if(++bits_in_register == 64) {
+			*word = shift_register;
+			++word;
+			bits_in_register = 0;
+		}
+	}
+	if(bits_in_register) {
+		*word = shift_register << (64 - bits_in_register);
+	}
+
+	return result;
+}
+
+}
+
+// MARK: - PackedPCMSegment
+
+PackedPCMSegment::PackedPCMSegment(const PCMSegment &segment) :
+	length_of_a_bit(segment.length_of_a_bit),
+	bit_count(segment.data.size()),
+	data(pack(segment.data, 0)) {
+	// The fuzzy mask is permitted to be shorter than the data; it is padded or truncated
+	// to match here.
+	if(!segment.fuzzy_mask.empty()) {
+		fuzzy_mask = pack(segment.fuzzy_mask, data.size());
+		fuzzy_mask.resize(data.size());
+		if(bit_count & 63) {
+			fuzzy_mask.back() &= ~(~uint64_t(0) >> (bit_count & 63));
+		}
+	}
+}
+
+PCMSegment PackedPCMSegment::unpacked() const {
+	PCMSegment segment;
+	segment.length_of_a_bit = length_of_a_bit;
+	segment.data.resize(bit_count);
+	for(size_t index = next_set_bit(0); index < bit_count; index = next_set_bit(index + 1)) {
+		segment.data[index] = true;
+	}
+	if(!fuzzy_mask.empty()) {
+		segment.fuzzy_mask.resize(bit_count);
+		for(size_t index = 0; index < bit_count; ++index) {
+			segment.fuzzy_mask[index] = fuzzy_mask[index >> 6] & (TopBit >> (index & 63));
+		}
+	}
+	return segment;
+}
+
+void PackedPCMSegment::clear_bits(size_t begin, size_t end) {
+	if(begin >= end) return;
+
+	const size_t first_word = begin >> 6, last_word = (end - 1) >> 6;
+	const uint64_t first_mask = ~uint64_t(0) >> (begin & 63);
+	const uint64_t last_mask = ~uint64_t(0) << (63 - ((end - 1) & 63));
+
+	if(first_word == last_word) {
+		data[first_word] &= ~(first_mask & last_mask);
+		return;
+	}
+
+	data[first_word] &= ~first_mask;
+	std::fill(data.begin() + ptrdiff_t(first_word + 1), data.begin() + ptrdiff_t(last_word), 0);
+	data[last_word] &= ~last_mask;
+}
+
+size_t PackedPCMSegment::next_set_bit(size_t index) const {
+	if(index >= bit_count) return bit_count;
+
+	size_t word = index >> 6;
+	uint64_t value = data[word] & (~uint64_t(0) >> (index & 63));
+	while(!value) {
+		++word;
+		if(word == data.size()) return bit_count;
+		value = data[word];
+	}
+	return (word << 6) + size_t(Numeric::leading_zeroes(value));
+}
+
+// MARK: - PCMSegmentEventSource
+
 PCMSegmentEventSource::PCMSegmentEventSource(const PCMSegment &segment) :
-		segment_(new PCMSegment(segment)) {
+		segment_(std::make_shared<PackedPCMSegment>(segment)) {
 	// add an extra bit of storage at the bottom if one is going to be needed;
 	// events returned are going to be in integral multiples of the length of a bit
 	// other than the very first and very last which will include a half bit length
@@ -79,16 +173,29 @@ Storage::Disk::Track::Event PCMSegmentEventSource::get_next_event() {
 	// is set, it should be in the centre of its window.
 	next_event_.length.length = bit_pointer_ ? 0 : -(segment_->length_of_a_bit.length >> 1);
 
-	// search for the next bit that is set, if any
-	while(bit_pointer_ < segment_->data.size()) {
-		bool bit = segment_->data[bit_pointer_];
-		++bit_pointer_;	// so this always points one beyond the most recent bit returned
-		next_event_.length.length += segment_->length_of_a_bit.length;
+	// Search for the next bit that is set, if any, a word at a time.
+	const size_t bit_count = segment_->bit_count;
+	if(bit_pointer_ < bit_count) {
+		size_t word = bit_pointer_ >> 6;
+		uint64_t mask = ~uint64_t(0) >> (bit_pointer_ & 63);
+		while(true) {
+			const uint64_t value = (segment_->data[word] | fuzzy_bits(word)) & mask;
+			if(value) {
+				const size_t bit = (word << 6) + size_t(Numeric::leading_zeroes(value));
+
+				// bit_pointer_ always points one beyond the most recent bit returned.
+				next_event_.length.length += unsigned(bit + 1 - bit_pointer_) * segment_->length_of_a_bit.length;
+				bit_pointer_ = bit + 1;
+				return next_event_;
+			}
+
+			++word;
+			mask = ~uint64_t(0);
+			if(word == segment_->data.size()) break;
+		}
 
-		// if this bit is set, or is fuzzy and a random bit of 1 is selected, return the event.
-		if(bit ||
-			(!segment_->fuzzy_mask.empty() && segment_->fuzzy_mask[bit_pointer_] && lfsr_.next())
-		)	return next_event_;
+		next_event_.length.length += unsigned(bit_count - bit_pointer_) * segment_->length_of_a_bit.length;
+		bit_pointer_ = bit_count;
 	}
 
 	// If the end is reached without a bit being set, it'll be index holes from now on.
@@ -98,15 +205,29 @@ Storage::Disk::Track::Event PCMSegmentEventSource::get_next_event() {
 	// allow an extra half bit's length to run from the position of the potential final transition
 	// event to the end of the segment. Otherwise don't allow any extra time, as it's already
 	// been consumed.
-	if(initial_bit_pointer <= segment_->data.size()) {
+	if(initial_bit_pointer <= bit_count) {
 		next_event_.length.length += (segment_->length_of_a_bit.length >> 1);
 		bit_pointer_++;
 	}
 	return next_event_;
 }
 
+uint64_t PCMSegmentEventSource::fuzzy_bits(size_t word) {
+	if(segment_->fuzzy_mask.empty()) return 0;
+
+	// Pick a random value for each fuzzy bit.
+	uint64_t fuzzy_mask = segment_->fuzzy_mask[word];
+	uint64_t result = 0;
+	while(fuzzy_mask) {
+		const uint64_t bit = PackedPCMSegment::TopBit >> Numeric::leading_zeroes(fuzzy_mask);
+		fuzzy_mask ^= bit;
+		if(lfsr_.next()) result |= bit;
+	}
+	return result;
+}
+
 Storage::Time PCMSegmentEventSource::get_length() {
-	return segment_->length_of_a_bit * unsigned(segment_->data.size());
+	return segment_->length();
 }
 
 float PCMSegmentEventSource::seek_to(float time_from_start) {
@@ -114,7 +235,7 @@ float PCMSegmentEventSource::seek_to(float time_from_start) {
 	const float length = get_length().get<float>();
 	if(time_from_start >= length) {
 		next_event_.type = Track::Event::IndexHole;
-		bit_pointer_ = segment_->data.size()+1;
+		bit_pointer_ = segment_->bit_count + 1;
 		return length;
 	}
 
@@ -139,10 +260,10 @@ float PCMSegmentEventSource::seek_to(float time_from_start) {
 	return bit_length * float(bit_pointer_) - half_bit_length;
 }
 
-const PCMSegment &PCMSegmentEventSource::segment() const {
+const PackedPCMSegment &PCMSegmentEventSource::segment() const {
 	return *segment_;
 }
 
-PCMSegment &PCMSegmentEventSource::segment() {
+PackedPCMSegment &PCMSegmentEventSource::segment() {
 	return *segment_;
 }
@@ -149,6 +149,59 @@ struct PCMSegment {
 	}
 };
 
+/*!
+	A segment of PCM-sampled data with its bits packed into 64-bit words, allowing
+	flux transitions to be located a word at a time.
+
+	Bits are stored from the most-significant end of each word onwards; any unused
+	bits in the final word are zero.
+*/
+struct PackedPCMSegment {
+	/// As per PCMSegment.
+	Time length_of_a_bit = Time(1);
+
+	/// The number of bits in this segment.
+	size_t bit_count = 0;
+
+	/// The packed equivalent of PCMSegment::data.
+	std::vector<uint64_t> data;
+
+	/// The packed equivalent of PCMSegment::fuzzy_mask; if not empty then this has the same length as @c data.
+	std::vector<uint64_t> fuzzy_mask;
+
+	PackedPCMSegment() {}
+
+	/// Constructs a PackedPCMSegment with the same contents as @c segment.
+	PackedPCMSegment(const PCMSegment &segment);
+
+	/// @returns A PCMSegment with the same contents as this one.
+	PCMSegment unpacked() const;
+
+	/// @returns @c true if bit @c index indicates a flux transition; @c false otherwise.
+	bool bit(size_t index) const {
+		return data[index >> 6] & (TopBit >> (index & 63));
+	}
+
+	/// Marks bit @c index as indicating a flux transition.
+	void set_bit(size_t index) {
+		data[index >> 6] |= TopBit >> (index & 63);
+	}
+
+	/// Clears all bits from @c begin up to but not including @c end.
+	void clear_bits(size_t begin, size_t end);
+
+	/// @returns The index of the first bit at or after @c index that indicates a flux transition,
+	/// ignoring the fuzzy mask, or @c bit_count if there is no such bit.
+	size_t next_set_bit(size_t index) const;
+
+	/// @returns the total amount of time occupied by all the data stored in this segment.
+	Time length() const {
+		return length_of_a_bit * unsigned(bit_count);
+	}
+
+	static constexpr uint64_t TopBit = 0x8000'0000'0000'0000;
+};
+
 /*!
 	Provides a stream of events by inspecting a PCMSegment.
 */
@@ -193,12 +246,15 @@ class PCMSegmentEventSource {
 		/*!
 			@returns a reference to the underlying segment.
 		*/
-		const PCMSegment &segment() const;
-		PCMSegment &segment();
+		const PackedPCMSegment &segment() const;
+		PackedPCMSegment &segment();
 
 	private:
-		std::shared_ptr<PCMSegment> segment_;
+		std::shared_ptr<PackedPCMSegment> segment_;
 		std::size_t bit_pointer_;
+
+		/// @returns A random selection of the fuzzy bits within @c word of the segment.
+		uint64_t fuzzy_bits(size_t word);
 		Track::Event next_event_;
 		Numeric::LFSR<uint64_t> lfsr_;
 };
@@ -79,7 +79,7 @@ PCMTrack *PCMTrack::resampled_clone(size_t bits_per_track) {
 	// Plot all segments from this track onto the destination.
 	Time start_time;
 	for(const auto &event_source: segment_event_sources_) {
-		const PCMSegment &source = event_source.segment();
+		const PackedPCMSegment &source = event_source.segment();
 		new_track->add_segment(start_time, source, true);
 		start_time += source.length();
 	}
@@ -88,6 +88,10 @@ PCMTrack *PCMTrack::resampled_clone(size_t bits_per_track) {
 	return new_track;
 }
 
+const PackedPCMSegment *PCMTrack::single_segment() const {
+	return segment_event_sources_.size() == 1 ? &segment_event_sources_.front().segment() : nullptr;
+}
+
 Track::Event PCMTrack::get_next_event() {
 	// ask the current segment for a new event
 	Track::Event event = segment_event_sources_[segment_pointer_].get_next_event();
@@ -148,31 +152,33 @@ float PCMTrack::seek_to(float time_since_index_hole) {
 }
 
 void PCMTrack::add_segment(const Time &start_time, const PCMSegment &segment, bool clamp_to_index_hole) {
+	add_segment(start_time, PackedPCMSegment(segment), clamp_to_index_hole);
+}
+
+void PCMTrack::add_segment(const Time &start_time, const PackedPCMSegment &segment, bool clamp_to_index_hole) {
 	// Get a reference to the destination.
-	PCMSegment &destination = segment_event_sources_.front().segment();
+	PackedPCMSegment &destination = segment_event_sources_.front().segment();
 
 	// Determine the range to fill on the target segment.
 	const Time end_time = start_time + segment.length();
-	const size_t start_bit = start_time.length * destination.data.size() / start_time.clock_rate;
-	const size_t end_bit = end_time.length * destination.data.size() / end_time.clock_rate;
+	const size_t start_bit = start_time.length * destination.bit_count / start_time.clock_rate;
+	const size_t end_bit = end_time.length * destination.bit_count / end_time.clock_rate;
 	const size_t target_width = end_bit - start_bit;
-	const size_t half_offset = target_width / (2 * segment.data.size());
+	const size_t half_offset = target_width / (2 * segment.bit_count);
 
-	if(clamp_to_index_hole || end_bit <= destination.data.size()) {
+	if(clamp_to_index_hole || end_bit <= destination.bit_count) {
 		// If clamping is applied, just write a single segment, from the start_bit to whichever is
 		// closer of the end of track and the end_bit.
-		const size_t selected_end_bit = std::min(end_bit, destination.data.size());
+		const size_t selected_end_bit = std::min(end_bit, destination.bit_count);
 
 		// Reset the destination.
-		std::fill(destination.data.begin() + ptrdiff_t(start_bit), destination.data.begin() + ptrdiff_t(selected_end_bit), false);
-
-		// Step through the source data from start to finish, stopping early if it goes out of bounds.
-		for(size_t bit = 0; bit < segment.data.size(); ++bit) {
-			if(segment.data[bit]) {
-				const size_t output_bit = start_bit + half_offset + (bit * target_width) / segment.data.size();
-				if(output_bit >= destination.data.size()) return;
-				destination.data[output_bit] = true;
-			}
+		destination.clear_bits(start_bit, selected_end_bit);
+
+		// Step through the source's flux transitions from start to finish, stopping early if it goes out of bounds.
+		for(size_t bit = segment.next_set_bit(0); bit < segment.bit_count; bit = segment.next_set_bit(bit + 1)) {
+			const size_t output_bit = start_bit + half_offset + (bit * target_width) / segment.bit_count;
+			if(output_bit >= destination.bit_count) return;
+			destination.set_bit(output_bit);
 		}
 	} else {
 		// Clamping is not enabled, so the supplied segment loops over the index hole, arbitrarily many times.
@@ -180,23 +186,23 @@ void PCMTrack::add_segment(const Time &start_time, const PCMSegment &segment, bo
 
 		// This definitely runs over the index hole; check whether the whole track needs clearing, or whether
 		// a centre segment is untouched.
-		if(target_width >= destination.data.size()) {
-			std::fill(destination.data.begin(), destination.data.end(), false);
+		if(target_width >= destination.bit_count) {
+			destination.clear_bits(0, destination.bit_count);
 		} else {
-			std::fill(destination.data.begin(), destination.data.begin() + ptrdiff_t(end_bit % destination.data.size()), false);
-			std::fill(destination.data.begin() + ptrdiff_t(start_bit), destination.data.end(), false);
+			destination.clear_bits(0, end_bit % destination.bit_count);
+			destination.clear_bits(start_bit, destination.bit_count);
 		}
 
 		// Run backwards from final bit back to first, stopping early if overlapping the beginning.
-		for(auto bit = ptrdiff_t(segment.data.size()-1); bit >= 0; --bit) {
+		for(auto bit = ptrdiff_t(segment.bit_count-1); bit >= 0; --bit) {
 			// Store flux transitions only; non-transitions can be ignored.
-			if(segment.data[size_t(bit)]) {
+			if(segment.bit(size_t(bit))) {
 				// Map to the proper output destination; stop if now potentially overwriting where we began.
-				const size_t output_bit = start_bit + half_offset + (size_t(bit) * target_width) / segment.data.size();
-				if(output_bit < end_bit - destination.data.size()) return;
+				const size_t output_bit = start_bit + half_offset + (size_t(bit) * target_width) / segment.bit_count;
+				if(output_bit < end_bit - destination.bit_count) return;
 
 				// Store.
-				destination.data[output_bit % destination.data.size()] = true;
+				destination.set_bit(output_bit % destination.bit_count);
 			}
 		}
 	}
@@ -72,6 +72,11 @@ class PCMTrack: public Track {
 		*/
 		void add_segment(const Time &start_time, const PCMSegment &segment, bool clamp_to_index_hole);
 
+		/*!
+			@returns the segment that fills this track if it consists of a single segment; @c nullptr otherwise.
+		*/
+		const PackedPCMSegment *single_segment() const;
+
 	private:
 		/*!
 			Creates a PCMTrack with a single segment, consisting of @c bits_per_track flux windows,
@@ -79,6 +84,9 @@ class PCMTrack: public Track {
 		*/
 		PCMTrack(unsigned int bits_per_track);
 
+		/// As per the public @c add_segment, but taking a packed segment.
+		void add_segment(const Time &start_time, const PackedPCMSegment &segment, bool clamp_to_index_hole);
+
 		// storage for the segments that describe this track
 		std::vector<PCMSegmentEventSource> segment_event_sources_;
 
@@ -7,12 +7,24 @@
 //
 
 #include "TrackSerialiser.hpp"
+#include "PCMTrack.hpp"
 
 #include <memory>
 
-// TODO: if this is a PCMTrack with only one segment and that segment's bit rate is within tolerance,
-// just return a copy of that segment.
 Storage::Disk::PCMSegment Storage::Disk::track_serialisation(const Track &track, Time length_of_a_bit) {
+	// If this is a PCMTrack with only one segment, of exactly the requested bit rate and without
+	// any fuzzy bits, then that segment is exactly what the PLL would attempt to recover; just
+	// return a copy. The PLL's output would instead begin wherever it achieved lock, so may be
+	// offset by a bit and may differ in the few bits either side of the index hole.
+	if(const auto pcm_track = dynamic_cast<const PCMTrack *>(&track)) {
+		const auto segment = pcm_track->single_segment();
+		if(segment && segment->fuzzy_mask.empty() && segment->length_of_a_bit == length_of_a_bit) {
+			PCMSegment result = segment->unpacked();
+			result.length_of_a_bit = length_of_a_bit;
+			return result;
+		}
+	}
+
 	unsigned int history_size = 16;
 	std::unique_ptr<Track> track_copy(track.clone());
 
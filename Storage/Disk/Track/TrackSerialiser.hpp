@@ -26,6 +26,9 @@ namespace Disk {
 	desireable, e.g. file formats that apply that constraint, or static analysis prior to
 	emulation launch, which works with broad strokes.
 
+	A PCMTrack that consists of a single segment at the requested bit length, without fuzzy
+	bits, is returned exactly as stored rather than as recovered by the PLL.
+
 	@param track The track to serialise.
 	@param length_of_a_bit The expected length of a single bit, as a proportion of the
 	track length.
@@ -11,9 +11,17 @@
 #include <algorithm>
 #include <cstring>
 
+#if defined(__APPLE__) || defined(__unix__)
+#define FILE_HOLDER_CAN_MAP
+#include <sys/mman.h>
+#endif
+
 using namespace Storage;
 
 FileHolder::~FileHolder() {
+#ifdef FILE_HOLDER_CAN_MAP
+	if(mapping_.address) munmap(mapping_.address, mapping_.size);
+#endif
 	if(file_) std::fclose(file_);
 }
 
@@ -189,3 +197,35 @@ struct stat &FileHolder::stats() {
 std::mutex &FileHolder::get_file_access_mutex() {
 	return file_access_mutex_;
 }
+
+FileHolder::View FileHolder::view([[maybe_unused]] long offset, [[maybe_unused]] size_t size) {
+#ifdef FILE_HOLDER_CAN_MAP
+	if(offset < 0 || !size) return View();
+	const size_t end = size_t(offset) + size;
+
+	// Ensure anything written so far will be visible through the mapping.
+	std::fflush(file_);
+
+	// If the file has grown beyond the current mapping, replace it.
+	if(mapping_.size < end) {
+		struct stat file_stats;
+		if(fstat(fileno(file_), &file_stats)) return View();
+
+		const size_t file_size = size_t(file_stats.st_size);
+		if(file_size < end) return View();
+
+		if(mapping_.address) {
+			munmap(mapping_.address, mapping_.size);
+			mapping_ = Mapping();
+		}
+
+		void *const address = mmap(nullptr, file_size, PROT_READ, MAP_SHARED, fileno(file_), 0);
+		if(address == MAP_FAILED) return View();
+		mapping_ = Mapping{address, file_size};
+	}
+
+	return View(static_cast<const uint8_t *>(mapping_.address) + offset, size);
+#else
+	return View();
+#endif
+}
@@ -238,6 +238,42 @@ class FileHolder final {
 		*/
 		std::mutex &get_file_access_mutex();
 
+		/*!
+			A read-only view of a contiguous range of a file's contents.
+		*/
+		class View {
+			public:
+				View() {}
+
+				const uint8_t *data() const		{	return data_;			}
+				size_t size() const				{	return size_;			}
+				bool empty() const				{	return !size_;			}
+				const uint8_t *begin() const	{	return data_;			}
+				const uint8_t *end() const		{	return data_ + size_;	}
+				uint8_t operator[](size_t index) const	{	return data_[index];	}
+
+			private:
+				View(const uint8_t *data, size_t size) : data_(data), size_(size) {}
+				friend FileHolder;
+
+				const uint8_t *data_ = nullptr;
+				size_t size_ = 0;
+		};
+
+		/*!
+			Provides direct access to @c size bytes of the file starting from @c offset, by mapping
+			the file into memory rather than by copying; anything written through this FileHolder is
+			flushed first. This does not affect the reading cursor.
+
+			The view remains valid until the next call to @c view or until this FileHolder is destroyed,
+			whichever is sooner, since a subsequent call may need to remap the file. It won't necessarily
+			reflect subsequent writes.
+
+			@returns a view of the requested bytes, or an empty view if the file doesn't extend that
+				far or can't be mapped on this platform, in which case the caller should use @c read.
+		*/
+		View view(long offset, size_t size);
+
 	private:
 		FILE *file_ = nullptr;
 		const std::string name_;
@@ -246,6 +282,12 @@ class FileHolder final {
 		bool is_read_only_ = false;
 
 		std::mutex file_access_mutex_;
+
+		// A mapping of the whole file, which is replaced if the file grows.
+		struct Mapping {
+			void *address = nullptr;
+			size_t size = 0;
+		} mapping_;
 };
 
 }
@@ -0,0 +1,156 @@
+//
+//  CopyOnWriteDevice.cpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 16/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#include "CopyOnWriteDevice.hpp"
+
+#include "../../Numeric/CRC.hpp"
+
+#include <cassert>
+#include <cstring>
+
+using namespace Storage::MassStorage;
+
+namespace {
+
+constexpr char Signature[] = "CLKDelta";
+constexpr long HeaderSize = sizeof(Signature) - 1 + 12;
+
+}
+
+CopyOnWriteDevice::CopyOnWriteDevice(const std::shared_ptr<MassStorageDevice> &base) : base_(base) {}
+
+CopyOnWriteDevice::CopyOnWriteDevice(const std::shared_ptr<MassStorageDevice> &base, const std::string &delta_file_name) :
+	base_(base), delta_file_name_(delta_file_name) {
+	try {
+		delta_file_ = std::make_unique<FileHolder>(delta_file_name_);
+	} catch(FileHolder::Error) {
+		create_delta_file();
+		return;
+	}
+	if(delta_file_->get_is_known_read_only()) throw Error::ReadOnly;
+
+	// An empty file is as good as a new one.
+	if(!delta_file_->stats().st_size) {
+		create_delta_file();
+		return;
+	}
+
+	// Validate the header, including that this delta was made against this base, then
+	// index the blocks present.
+	const size_t block_size = get_block_size();
+	if(!delta_file_->check_signature(Signature)) throw Error::InvalidFormat;
+	if(delta_file_->get32le() != block_size) throw Error::InvalidFormat;
+	if(delta_file_->get32le() != get_number_of_blocks()) throw Error::InvalidFormat;
+	if(delta_file_->get32le() != base_identity()) throw Error::InvalidFormat;
+
+	const long file_size = long(delta_file_->stats().st_size);
+	long offset = HeaderSize;
+	while(offset + 4 + long(block_size) <= file_size) {
+		delta_file_->seek(offset, SEEK_SET);
+		block_offsets_[delta_file_->get32le()] = offset + 4;
+		offset += 4 + long(block_size);
+	}
+}
+
+void CopyOnWriteDevice::create_delta_file() {
+	// FileHolder's Rewrite mode is write-only, so create or truncate the file
+	// and then reopen it for reading and writing.
+	delta_file_.reset();
+	{
+		FileHolder new_file(delta_file_name_, FileHolder::FileMode::Rewrite);
+		new_file.write(reinterpret_cast<const uint8_t *>(Signature), sizeof(Signature) - 1);
+		new_file.put_le(uint32_t(get_block_size()));
+		new_file.put_le(uint32_t(get_number_of_blocks()));
+		new_file.put_le(base_identity());
+	}
+	delta_file_ = std::make_unique<FileHolder>(delta_file_name_);
+	if(delta_file_->get_is_known_read_only()) throw Error::ReadOnly;
+	block_offsets_.clear();
+}
+
+uint32_t CopyOnWriteDevice::base_identity() {
+	// A CRC of the base's first and last blocks; this is intended to catch a sidecar being
+	// applied to the wrong image, not to detect every modification of the base.
+	CRC::CRC32 crc;
+	const size_t blocks = get_number_of_blocks();
+	if(!blocks) return crc.get_value();
+
+	for(const auto byte: base_->get_block(0)) crc.add(byte);
+	for(const auto byte: base_->get_block(blocks - 1)) crc.add(byte);
+	return crc.get_value();
+}
+
+size_t CopyOnWriteDevice::get_block_size() {
+	return base_->get_block_size();
+}
+
+size_t CopyOnWriteDevice::get_number_of_blocks() {
+	return base_->get_number_of_blocks();
+}
+
+std::vector<uint8_t> CopyOnWriteDevice::get_block(size_t address) {
+	if(delta_file_) {
+		const auto offset = block_offsets_.find(address);
+		if(offset == block_offsets_.end()) return base_->get_block(address);
+
+		delta_file_->seek(offset->second, SEEK_SET);
+		return delta_file_->read(get_block_size());
+	}
+
+	const auto block = blocks_.find(address);
+	if(block == blocks_.end()) return base_->get_block(address);
+	return block->second;
+}
+
+void CopyOnWriteDevice::set_block(size_t address, const std::vector<uint8_t> &contents) {
+	assert(contents.size() == get_block_size());
+
+	if(delta_file_) {
+		auto offset = block_offsets_.find(address);
+		if(offset == block_offsets_.end()) {
+			delta_file_->seek(0, SEEK_END);
+			delta_file_->put_le(uint32_t(address));
+			offset = block_offsets_.emplace(address, delta_file_->tell()).first;
+		} else {
+			delta_file_->seek(offset->second, SEEK_SET);
+		}
+		delta_file_->write(contents);
+		return;
+	}
+
+	blocks_[address] = contents;
+}
+
+void CopyOnWriteDevice::commit() {
+	if(delta_file_) {
+		for(const auto &block: block_offsets_) {
+			base_->set_block(block.first, get_block(block.first));
+		}
+	} else {
+		for(const auto &block: blocks_) {
+			base_->set_block(block.first, block.second);
+		}
+	}
+	discard();
+}
+
+void CopyOnWriteDevice::discard() {
+	if(delta_file_) {
+		create_delta_file();
+	} else {
+		blocks_.clear();
+	}
+}
+
+size_t CopyOnWriteDevice::get_number_of_modified_blocks() const {
+	return delta_file_ ? block_offsets_.size() : blocks_.size();
+}
+
+MassStorageDevice &CopyOnWriteDevice::base() {
+	return *base_;
+}
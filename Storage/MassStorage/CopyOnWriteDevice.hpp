@@ -0,0 +1,94 @@
+//
+//  CopyOnWriteDevice.hpp
+//  Clock Signal
+//
+//  Created by Thomas Harte on 16/10/2026.
+//  Copyright © 2026 Thomas Harte. All rights reserved.
+//
+
+#ifndef CopyOnWriteDevice_hpp
+#define CopyOnWriteDevice_hpp
+
+#include "MassStorageDevice.hpp"
+#include "../FileHolder.hpp"
+
+#include <map>
+#include <memory>
+#include <string>
+
+namespace Storage {
+namespace MassStorage {
+
+/*!
+	Overlays another mass storage device, leaving it unmodified: any blocks that are written
+	are retained in a separate delta, and are subsequently read from there.
+
+	The delta is held either in memory or in a sidecar file. A sidecar file records each
+	modified block once, in place, so that it is only as large as the set of blocks that
+	have been modified, and it persists between sessions.
+
+	The delta can be committed to the underlying device or discarded.
+*/
+class CopyOnWriteDevice: public MassStorageDevice {
+	public:
+		enum class Error {
+			ReadOnly = -1,
+			InvalidFormat = -2
+		};
+
+		/*!
+			Constructs an overlay of @c base that holds its delta in memory.
+		*/
+		CopyOnWriteDevice(const std::shared_ptr<MassStorageDevice> &base);
+
+		/*!
+			Constructs an overlay of @c base that holds its delta in the file named @c delta_file_name,
+			creating it if necessary. If that file already contains a delta then it is resumed.
+
+			@throws Storage::FileHolder::Error::CantOpen if the file can't be created.
+			@throws Error::ReadOnly if the file can't be opened for writing.
+			@throws Error::InvalidFormat if the file isn't a delta, or contains a delta that was made against
+				a different base, i.e. one with a different block size, number of blocks or contents of its
+				first and last blocks.
+		*/
+		CopyOnWriteDevice(const std::shared_ptr<MassStorageDevice> &base, const std::string &delta_file_name);
+
+		/* MassStorageDevice overrides. */
+		size_t get_block_size() final;
+		size_t get_number_of_blocks() final;
+		std::vector<uint8_t> get_block(size_t address) final;
+		void set_block(size_t address, const std::vector<uint8_t> &) final;
+
+		/// Writes all modified blocks to the underlying device, then empties the delta.
+		void commit();
+
+		/// Empties the delta, restoring the contents of the underlying device.
+		void discard();
+
+		/// @returns the number of blocks that differ from the underlying device.
+		size_t get_number_of_modified_blocks() const;
+
+		/// @returns the device that this is an overlay of.
+		MassStorageDevice &base();
+
+	private:
+		std::shared_ptr<MassStorageDevice> base_;
+
+		// In-memory delta.
+		std::map<size_t, std::vector<uint8_t>> blocks_;
+
+		// Sidecar delta: a signature then the base's block size, number of blocks and identity
+		// as 32-bit little-endian values, followed by records of a 32-bit little-endian block
+		// address and that block's contents.
+		const std::string delta_file_name_;
+		std::unique_ptr<FileHolder> delta_file_;
+		std::map<size_t, long> block_offsets_;
+
+		void create_delta_file();
+		uint32_t base_identity();
+};
+
+}
+}
+
+#endif /* CopyOnWriteDevice_hpp */
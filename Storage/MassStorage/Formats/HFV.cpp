@@ -36,6 +36,11 @@ std::vector<uint8_t> HFV::get_block(size_t address) {
 	const auto source_address = mapper_.to_source_address(address);
 	if(source_address >= 0 && size_t(source_address)*get_block_size() < size_t(file_.stats().st_size)) {
 		const long file_offset = long(get_block_size()) * long(source_address);
+		const auto view = file_.view(file_offset, get_block_size());
+		if(!view.empty()) {
+			return mapper_.convert_source_block(source_address, std::vector<uint8_t>(view.begin(), view.end()));
+		}
+
 		file_.seek(file_offset, SEEK_SET);
 		return mapper_.convert_source_block(source_address, file_.read(get_block_size()));
 	} else {
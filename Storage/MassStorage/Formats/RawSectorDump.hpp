@@ -35,6 +35,11 @@ template <size_t sector_size> class RawSectorDump: public MassStorageDevice {
 		}
 
 		std::vector<uint8_t> get_block(size_t address) final {
+			const auto view = file_.view(long(address * sector_size), sector_size);
+			if(!view.empty()) {
+				return std::vector<uint8_t>(view.begin(), view.end());
+			}
+
 			file_.seek(long(address * sector_size), SEEK_SET);
 			return file_.read(sector_size);
 		}
@@ -18,6 +18,12 @@ TimedEventLoop::TimedEventLoop(Cycles::IntType input_clock_rate) :
 	input_clock_rate_(input_clock_rate) {}
 
 void TimedEventLoop::run_for(const Cycles cycles) {
+#ifdef PROFILE_COMPONENTS
+	// Attribute time according to the concrete type, to distinguish e.g. drives from tapes.
+	if(!profile_counter_) profile_counter_ = &Activity::Profiler::counter("TimedEventLoop", &typeid(*this));
+	const Activity::Profiler::Scope profile_scope(*profile_counter_, uint64_t(cycles.as_integral()));
+#endif
+
 	auto remaining_cycles = cycles.as_integral();
 #ifndef NDEBUG
 	decltype(remaining_cycles) cycles_advanced = 0;
@@ -12,6 +12,7 @@
 #include "Storage.hpp"
 #include "../ClockReceiver/ClockReceiver.hpp"
 #include "../SignalProcessing/Stepper.hpp"
+#include "../Activity/Profiler.hpp"
 
 #include <memory>
 
@@ -104,6 +105,10 @@ namespace Storage {
 			Cycles::IntType input_clock_rate_ = 0;
 			Cycles::IntType cycles_until_event_ = 0;
 			float subcycles_until_event_ = 0.0f;
+
+			// Declared regardless of PROFILE_COMPONENTS so that the layout of this class doesn't
+			// depend on how each translation unit was built; it's used only if profiling.
+			Activity::Profiler::Counter *profile_counter_ = nullptr;
 	};
 
 }